@@ -50,17 +50,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/config.h>
 
 namespace Assimp {
 
-void ExportSceneAssbin(const char *pFile, IOSystem *pIOSystem, const aiScene *pScene, const ExportProperties * /*pProperties*/) {
+void ExportSceneAssbin(const char *pFile, IOSystem *pIOSystem, const aiScene *pScene, const ExportProperties *pProperties) {
+    const bool flat = nullptr != pProperties && pProperties->GetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_FLAT_LAYOUT, false);
+    const int compression = nullptr != pProperties ? pProperties->GetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_COMPRESSION, 0) : 0;
     DumpSceneToAssbin(
             pFile,
             "\0", // no command(s).
             pIOSystem,
             pScene,
             false, // shortened?
-            false); // compressed?
+            static_cast<unsigned int>(compression), // compressed?
+            flat); // flat, memory-mappable layout?
 }
 } // end of namespace Assimp
 
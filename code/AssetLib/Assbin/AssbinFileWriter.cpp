@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssbinFileWriter.h"
 
+#include "Common/BlockCompression.h"
 #include "Common/assbin_chunks.h"
 #include "PostProcessing/ProcessHelper.h"
 
@@ -52,13 +53,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/IOStream.hpp>
 
-#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#include <zlib.h>
-#else
-#include "../contrib/zlib/zlib.h"
-#endif
-
 #include <time.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 #if _MSC_VER
 #pragma warning(push)
@@ -213,6 +211,24 @@ inline size_t Write<aiQuatKey>(IOStream *stream, const aiQuatKey &v) {
     return t + Write<aiQuaternion>(stream, v.mValue);
 }
 
+// -----------------------------------------------------------------------------------
+// Serialize a meshlet
+template <>
+inline size_t Write<aiMeshlet>(IOStream *stream, const aiMeshlet &m) {
+    size_t t = Write<unsigned int>(stream, m.mVertexOffset);
+    t += Write<unsigned int>(stream, m.mVertexCount);
+    t += Write<unsigned int>(stream, m.mIndexOffset);
+    t += Write<unsigned int>(stream, m.mTriangleCount);
+    t += Write<aiVector3D>(stream, m.mCenter);
+    t += Write<float>(stream, m.mRadius);
+    t += Write<aiVector3D>(stream, m.mConeApex);
+    t += Write<aiVector3D>(stream, m.mConeAxis);
+    t += Write<float>(stream, m.mConeCutoff);
+    ai_assert(t == 60);
+
+    return t;
+}
+
 template <typename T>
 inline size_t WriteBounds(IOStream *stream, const T *in, unsigned int size) {
     T minc, maxc;
@@ -237,85 +253,193 @@ inline size_t WriteArray(IOStream *stream, const T *in, unsigned int size) {
 /** @class  AssbinChunkWriter
  *  @brief  Chunk writer mechanism for the .assbin file structure
  *
- *  This is a standard in-memory IOStream (most of the code is based on BlobIOStream),
- *  the difference being that this takes another IOStream as a "container" in the
- *  constructor, and when it is destroyed, it appends the magic number, the chunk size,
- *  and the chunk contents to the container stream. This allows relatively easy chunk
- *  chunk construction, even recursively.
+ *  Writes the magic number and a placeholder for the chunk size to the container in the
+ *  constructor, the chunk contents go straight to the container. When it is destroyed,
+ *  it seeks back and patches the chunk size, so the container must be seekable. Nested
+ *  chunks write through to the stream of the outermost chunk.
  */
 class AssbinChunkWriter : public IOStream {
 private:
-    uint8_t *buffer;
-    uint32_t magic;
     IOStream *container;
-    size_t cur_size, cursor, initial;
+    size_t sizePos;
+
+public:
+    AssbinChunkWriter(IOStream *parent, uint32_t magic) :
+            container(parent),
+            sizePos(0) {
+        AssbinChunkWriter *chunk = dynamic_cast<AssbinChunkWriter *>(parent);
+        if (chunk) {
+            container = chunk->container;
+        }
+        container->Write(&magic, sizeof(uint32_t), 1);
+        sizePos = container->Tell();
+        const uint32_t placeholder = 0;
+        container->Write(&placeholder, sizeof(uint32_t), 1);
+    }
+
+    virtual ~AssbinChunkWriter() {
+        const size_t end = container->Tell();
+        const uint32_t size = static_cast<uint32_t>(end - sizePos - sizeof(uint32_t));
+        container->Seek(sizePos, aiOrigin_SET);
+        container->Write(&size, sizeof(uint32_t), 1);
+        container->Seek(end, aiOrigin_SET);
+    }
 
-private:
     // -------------------------------------------------------------------
-    void Grow(size_t need = 0) {
-        size_t new_size = std::max(initial, std::max(need, cur_size + (cur_size >> 1)));
+    virtual size_t Read(void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+        return 0;
+    }
+    virtual aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) {
+        return aiReturn_FAILURE;
+    }
+    virtual size_t Tell() const {
+        return container->Tell() - sizePos - sizeof(uint32_t);
+    }
+    virtual void Flush() {
+        // not implemented
+    }
 
-        const uint8_t *const old = buffer;
-        buffer = new uint8_t[new_size];
+    virtual size_t FileSize() const {
+        return Tell();
+    }
 
-        if (old) {
-            memcpy(buffer, old, cur_size);
-            delete[] old;
-        }
+    // -------------------------------------------------------------------
+    virtual size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) {
+        return container->Write(pvBuffer, pSize, pCount);
+    }
+};
 
-        cur_size = new_size;
+// ----------------------------------------------------------------------------------
+/** @class  AssbinOutputBuffer
+ *  @brief  Collects the many small writes of the chunks before passing them on
+ *
+ *  Seeking back to patch a chunk size stays in the buffer if the size field has not
+ *  been passed on yet, else the output stream has to be seekable. #Flush must be
+ *  called once everything is written.
+ */
+class AssbinOutputBuffer : public IOStream {
+private:
+    static const size_t Capacity = 64 * 1024;
+
+    IOStream *out;
+    std::vector<uint8_t> buffer;
+    size_t start; // position of the buffer in the output stream
+    size_t cursor, used;
+
+    // -------------------------------------------------------------------
+    void FlushBuffer() {
+        out->Write(buffer.data(), 1, used);
+        if (cursor != used && aiReturn_SUCCESS != out->Seek(start + cursor, aiOrigin_SET)) {
+            throw DeadlyExportError("Assbin: The output stream must be seekable");
+        }
+        start += cursor;
+        cursor = used = 0;
     }
 
 public:
-    AssbinChunkWriter(IOStream *container, uint32_t magic, size_t initial = 4096) :
-            buffer(nullptr),
-            magic(magic),
-            container(container),
-            cur_size(0),
+    explicit AssbinOutputBuffer(IOStream *out) :
+            out(out),
+            buffer(Capacity),
+            start(out->Tell()),
             cursor(0),
-            initial(initial) {
+            used(0) {
         // empty
     }
 
-    virtual ~AssbinChunkWriter() {
-        if (container) {
-            container->Write(&magic, sizeof(uint32_t), 1);
-            container->Write(&cursor, sizeof(uint32_t), 1);
-            container->Write(buffer, 1, cursor);
+    // -------------------------------------------------------------------
+    virtual size_t Read(void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+        return 0;
+    }
+    virtual aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+        if (aiOrigin_SET != pOrigin) {
+            return aiReturn_FAILURE;
+        }
+        if (pOffset >= start && pOffset <= start + used) {
+            cursor = pOffset - start;
+            return aiReturn_SUCCESS;
+        }
+        FlushBuffer();
+        if (aiReturn_SUCCESS != out->Seek(pOffset, aiOrigin_SET)) {
+            throw DeadlyExportError("Assbin: The output stream must be seekable");
+        }
+        start = pOffset;
+        return aiReturn_SUCCESS;
+    }
+    virtual size_t Tell() const {
+        return start + cursor;
+    }
+    virtual void Flush() {
+        FlushBuffer();
+        out->Flush();
+    }
+    virtual size_t FileSize() const {
+        return start + used;
+    }
+
+    // -------------------------------------------------------------------
+    virtual size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) {
+        const size_t size = pSize * pCount;
+        if (cursor + size > Capacity) {
+            FlushBuffer();
+            if (size >= Capacity) {
+                out->Write(pvBuffer, 1, size);
+                start += size;
+                return pCount;
+            }
         }
-        if (buffer) delete[] buffer;
+        ::memcpy(buffer.data() + cursor, pvBuffer, size);
+        cursor += size;
+        used = std::max(used, cursor);
+        return pCount;
     }
+};
 
-    void *GetBufferPointer() { return buffer; }
+// ----------------------------------------------------------------------------------
+/** @class  AssbinMemoryStream
+ *  @brief  Seekable in-memory stream, used if the output stream can't seek
+ */
+class AssbinMemoryStream : public IOStream {
+private:
+    std::vector<uint8_t> buffer;
+    size_t cursor;
+
+public:
+    AssbinMemoryStream() :
+            cursor(0) {
+        // empty
+    }
+
+    const uint8_t *GetBufferPointer() const { return buffer.data(); }
 
     // -------------------------------------------------------------------
     virtual size_t Read(void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
         return 0;
     }
-    virtual aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) {
-        return aiReturn_FAILURE;
+    virtual aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+        if (aiOrigin_SET != pOrigin || pOffset > buffer.size()) {
+            return aiReturn_FAILURE;
+        }
+        cursor = pOffset;
+        return aiReturn_SUCCESS;
     }
     virtual size_t Tell() const {
         return cursor;
     }
     virtual void Flush() {
-        // not implemented
+        // nothing to be done
     }
-
     virtual size_t FileSize() const {
-        return cursor;
+        return buffer.size();
     }
 
     // -------------------------------------------------------------------
     virtual size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) {
-        pSize *= pCount;
-        if (cursor + pSize > cur_size) {
-            Grow(cursor + pSize);
+        const size_t size = pSize * pCount;
+        if (cursor + size > buffer.size()) {
+            buffer.resize(cursor + size);
         }
-
-        memcpy(buffer + cursor, pvBuffer, pSize);
-        cursor += pSize;
-
+        ::memcpy(buffer.data() + cursor, pvBuffer, size);
+        cursor += size;
         return pCount;
     }
 };
@@ -329,59 +453,139 @@ public:
 class AssbinFileWriter {
 private:
     bool shortened;
-    bool compressed;
+    unsigned int compression;
+    bool flat;
+
+    // an array which is moved to the data section of the flat layout
+    struct FlatArray {
+        const void *data;
+        size_t size;
+        uint64_t offset;
+        const aiMesh *faces; // if set, the array is gathered from the faces of this mesh
+        bool faceSizes; // ... and holds their sizes instead of their indices
+    };
+    std::vector<FlatArray> flatArrays;
+    uint64_t flatSize;
 
 protected:
     // -----------------------------------------------------------------------------------
-    void WriteBinaryNode(IOStream *container, const aiNode *node) {
-        AssbinChunkWriter chunk(container, ASSBIN_CHUNK_AINODE);
+    static uint64_t AlignFlat(uint64_t offset) {
+        return (offset + ASSBIN_FLAT_ALIGNMENT - 1) & ~static_cast<uint64_t>(ASSBIN_FLAT_ALIGNMENT - 1);
+    }
 
-        unsigned int nb_metadata = (node->mMetaData != nullptr ? node->mMetaData->mNumProperties : 0);
+    // -----------------------------------------------------------------------------------
+    // Moves an array to the data section, only its offset is written to the chunk
+    void WriteFlatArray(IOStream *chunk, const void *data, size_t size, const aiMesh *faces = nullptr, bool faceSizes = false) {
+        flatSize = AlignFlat(flatSize);
 
-        Write<aiString>(&chunk, node->mName);
-        Write<aiMatrix4x4>(&chunk, node->mTransformation);
-        Write<unsigned int>(&chunk, node->mNumChildren);
-        Write<unsigned int>(&chunk, node->mNumMeshes);
-        Write<unsigned int>(&chunk, nb_metadata);
+        FlatArray array = { data, size, flatSize, faces, faceSizes };
+        flatArrays.push_back(array);
+        flatSize += size;
 
-        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-            Write<unsigned int>(&chunk, node->mMeshes[i]);
+        Write<uint64_t>(chunk, array.offset);
+    }
+
+    // -----------------------------------------------------------------------------------
+    // Writes an array inline or, for the flat layout, into the data section
+    template <typename T>
+    void WriteArrayOrOffset(IOStream *chunk, const T *in, unsigned int size) {
+        if (flat) {
+            WriteFlatArray(chunk, in, sizeof(T) * size);
+        } else {
+            WriteArray<T>(chunk, in, size);
         }
+    }
 
-        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-            WriteBinaryNode(&chunk, node->mChildren[i]);
+    // -----------------------------------------------------------------------------------
+    // Writes the faces of a mesh as one index buffer into the data section
+    void WriteFlatFaces(IOStream *chunk, const aiMesh *mesh) {
+        unsigned int faceSize = mesh->mNumFaces ? mesh->mFaces[0].mNumIndices : 0;
+        size_t numIndices = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            numIndices += mesh->mFaces[i].mNumIndices;
+            if (mesh->mFaces[i].mNumIndices != faceSize) {
+                faceSize = 0;
+            }
         }
 
-        for (unsigned int i = 0; i < nb_metadata; ++i) {
-            const aiString &key = node->mMetaData->mKeys[i];
-            aiMetadataType type = node->mMetaData->mValues[i].mType;
-            void *value = node->mMetaData->mValues[i].mData;
+        // the arrays are gathered from the faces when the data section is written
+        Write<unsigned int>(chunk, faceSize);
+        Write<unsigned int>(chunk, static_cast<unsigned int>(numIndices));
+        if (mesh->HasIndexBuffer() && mesh->mNumIndices == numIndices) {
+            WriteFlatArray(chunk, mesh->mIndices, numIndices * sizeof(uint32_t));
+        } else {
+            WriteFlatArray(chunk, nullptr, numIndices * sizeof(uint32_t), mesh, false);
+        }
+        if (0 == faceSize) {
+            WriteFlatArray(chunk, nullptr, mesh->mNumFaces * sizeof(uint32_t), mesh, true);
+        }
+    }
 
-            Write<aiString>(&chunk, key);
-            Write<uint16_t>(&chunk, (uint16_t)type);
+    // -----------------------------------------------------------------------------------
+    // Writes the indices or the sizes of all faces of a mesh, batched to keep the writes large
+    static void WriteFlatFaceArray(IOStream *out, const aiMesh *mesh, bool faceSizes) {
+        static const size_t BatchSize = 4096;
+        uint32_t batch[BatchSize];
+        size_t used = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            const aiFace &f = mesh->mFaces[i];
+            const unsigned int count = faceSizes ? 1 : f.mNumIndices;
+            if (used + count > BatchSize) {
+                out->Write(batch, sizeof(uint32_t), used);
+                used = 0;
+            }
+            if (faceSizes) {
+                batch[used++] = f.mNumIndices;
+            } else if (count > BatchSize) {
+                out->Write(f.mIndices, sizeof(uint32_t), count);
+            } else {
+                ::memcpy(batch + used, f.mIndices, count * sizeof(uint32_t));
+                used += count;
+            }
+        }
+        out->Write(batch, sizeof(uint32_t), used);
+    }
+
+    // -----------------------------------------------------------------------------------
+    // Writes the keys and values of a metadata container, the number of entries is written
+    // by the caller
+    void WriteMetadataEntries(IOStream *chunk, const aiMetadata *metadata) {
+        for (unsigned int i = 0; i < metadata->mNumProperties; ++i) {
+            const aiString &key = metadata->mKeys[i];
+            aiMetadataType type = metadata->mValues[i].mType;
+            void *value = metadata->mValues[i].mData;
+
+            Write<aiString>(chunk, key);
+            Write<uint16_t>(chunk, (uint16_t)type);
 
             switch (type) {
             case AI_BOOL:
-                Write<bool>(&chunk, *((bool *)value));
+                Write<bool>(chunk, *((bool *)value));
                 break;
             case AI_INT32:
-                Write<int32_t>(&chunk, *((int32_t *)value));
+                Write<int32_t>(chunk, *((int32_t *)value));
                 break;
             case AI_UINT64:
-                Write<uint64_t>(&chunk, *((uint64_t *)value));
+                Write<uint64_t>(chunk, *((uint64_t *)value));
                 break;
             case AI_FLOAT:
-                Write<float>(&chunk, *((float *)value));
+                Write<float>(chunk, *((float *)value));
                 break;
             case AI_DOUBLE:
-                Write<double>(&chunk, *((double *)value));
+                Write<double>(chunk, *((double *)value));
                 break;
             case AI_AISTRING:
-                Write<aiString>(&chunk, *((aiString *)value));
+                Write<aiString>(chunk, *((aiString *)value));
                 break;
             case AI_AIVECTOR3D:
-                Write<aiVector3D>(&chunk, *((aiVector3D *)value));
+                Write<aiVector3D>(chunk, *((aiVector3D *)value));
                 break;
+            case AI_AIMETADATA: {
+                const aiMetadata *child = static_cast<const aiMetadata *>(value);
+                Write<unsigned int>(chunk, child->mNumProperties);
+                WriteMetadataEntries(chunk, child);
+                break;
+            }
 #ifdef SWIG
                 case FORCE_32BIT:
 #endif // SWIG
@@ -391,6 +595,31 @@ protected:
         }
     }
 
+    // -----------------------------------------------------------------------------------
+    void WriteBinaryNode(IOStream *container, const aiNode *node) {
+        AssbinChunkWriter chunk(container, ASSBIN_CHUNK_AINODE);
+
+        unsigned int nb_metadata = (node->mMetaData != nullptr ? node->mMetaData->mNumProperties : 0);
+
+        Write<aiString>(&chunk, node->mName);
+        Write<aiMatrix4x4>(&chunk, node->mTransformation);
+        Write<unsigned int>(&chunk, node->mNumChildren);
+        Write<unsigned int>(&chunk, node->mNumMeshes);
+        Write<unsigned int>(&chunk, nb_metadata);
+
+        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+            Write<unsigned int>(&chunk, node->mMeshes[i]);
+        }
+
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            WriteBinaryNode(&chunk, node->mChildren[i]);
+        }
+
+        if (nb_metadata) {
+            WriteMetadataEntries(&chunk, node->mMetaData);
+        }
+    }
+
     // -----------------------------------------------------------------------------------
     void WriteBinaryTexture(IOStream *container, const aiTexture *tex) {
         AssbinChunkWriter chunk(container, ASSBIN_CHUNK_AITEXTURE);
@@ -399,8 +628,11 @@ protected:
         Write<unsigned int>(&chunk, tex->mHeight);
         // Write the texture format, but don't include the null terminator.
         chunk.Write(tex->achFormatHint, sizeof(char), HINTMAXTEXTURELEN - 1);
+        Write<aiString>(&chunk, tex->mFilename);
 
-        if (!shortened) {
+        if (flat) {
+            WriteFlatArray(&chunk, tex->pcData, tex->mHeight ? size_t(tex->mWidth) * tex->mHeight * 4 : tex->mWidth);
+        } else if (!shortened) {
             if (!tex->mHeight) {
                 chunk.Write(tex->pcData, 1, tex->mWidth);
             } else {
@@ -423,7 +655,7 @@ protected:
             WriteBounds(&chunk, b->mWeights, b->mNumWeights);
         } // else write as usual
         else
-            WriteArray<aiVertexWeight>(&chunk, b->mWeights, b->mNumWeights);
+            WriteArrayOrOffset(&chunk, b->mWeights, b->mNumWeights);
     }
 
     // -----------------------------------------------------------------------------------
@@ -467,14 +699,14 @@ protected:
                 WriteBounds(&chunk, mesh->mVertices, mesh->mNumVertices);
             } // else write as usual
             else
-                WriteArray<aiVector3D>(&chunk, mesh->mVertices, mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mVertices, mesh->mNumVertices);
         }
         if (mesh->mNormals) {
             if (shortened) {
                 WriteBounds(&chunk, mesh->mNormals, mesh->mNumVertices);
             } // else write as usual
             else
-                WriteArray<aiVector3D>(&chunk, mesh->mNormals, mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mNormals, mesh->mNumVertices);
         }
         if (mesh->mTangents && mesh->mBitangents) {
             if (shortened) {
@@ -482,8 +714,8 @@ protected:
                 WriteBounds(&chunk, mesh->mBitangents, mesh->mNumVertices);
             } // else write as usual
             else {
-                WriteArray<aiVector3D>(&chunk, mesh->mTangents, mesh->mNumVertices);
-                WriteArray<aiVector3D>(&chunk, mesh->mBitangents, mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mTangents, mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mBitangents, mesh->mNumVertices);
             }
         }
         for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
@@ -494,7 +726,7 @@ protected:
                 WriteBounds(&chunk, mesh->mColors[n], mesh->mNumVertices);
             } // else write as usual
             else
-                WriteArray<aiColor4D>(&chunk, mesh->mColors[n], mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mColors[n], mesh->mNumVertices);
         }
         for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
             if (!mesh->mTextureCoords[n])
@@ -507,7 +739,7 @@ protected:
                 WriteBounds(&chunk, mesh->mTextureCoords[n], mesh->mNumVertices);
             } // else write as usual
             else
-                WriteArray<aiVector3D>(&chunk, mesh->mTextureCoords[n], mesh->mNumVertices);
+                WriteArrayOrOffset(&chunk, mesh->mTextureCoords[n], mesh->mNumVertices);
         }
 
         // write faces. There are no floating-point calculations involved
@@ -531,6 +763,8 @@ protected:
                 }
                 Write<unsigned int>(&chunk, hash);
             }
+        } else if (flat) {
+            WriteFlatFaces(&chunk, mesh);
         } else // else write as usual
         {
             // if there are less than 2^16 vertices, we can simply use 16 bit integers ...
@@ -550,6 +784,21 @@ protected:
             }
         }
 
+        Write<aiString>(&chunk, mesh->mName);
+        Write<aiVector3D>(&chunk, mesh->mAABB.mMin);
+        Write<aiVector3D>(&chunk, mesh->mAABB.mMax);
+
+        // write meshlets
+        const unsigned int numMeshlets = mesh->HasMeshlets() ? mesh->mNumMeshlets : 0;
+        Write<unsigned int>(&chunk, numMeshlets);
+        if (numMeshlets) {
+            Write<unsigned int>(&chunk, mesh->mNumMeshletVertices);
+            Write<unsigned int>(&chunk, mesh->mNumMeshletIndices);
+            WriteArrayOrOffset(&chunk, mesh->mMeshlets, numMeshlets);
+            WriteArrayOrOffset(&chunk, mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+            WriteArrayOrOffset(&chunk, mesh->mMeshletIndices, mesh->mNumMeshletIndices);
+        }
+
         // write bones
         if (mesh->mNumBones) {
             for (unsigned int a = 0; a < mesh->mNumBones; ++a) {
@@ -599,7 +848,7 @@ protected:
 
             } // else write as usual
             else
-                WriteArray<aiVectorKey>(&chunk, nd->mPositionKeys, nd->mNumPositionKeys);
+                WriteArrayOrOffset(&chunk, nd->mPositionKeys, nd->mNumPositionKeys);
         }
         if (nd->mRotationKeys) {
             if (shortened) {
@@ -607,7 +856,7 @@ protected:
 
             } // else write as usual
             else
-                WriteArray<aiQuatKey>(&chunk, nd->mRotationKeys, nd->mNumRotationKeys);
+                WriteArrayOrOffset(&chunk, nd->mRotationKeys, nd->mNumRotationKeys);
         }
         if (nd->mScalingKeys) {
             if (shortened) {
@@ -615,7 +864,7 @@ protected:
 
             } // else write as usual
             else
-                WriteArray<aiVectorKey>(&chunk, nd->mScalingKeys, nd->mNumScalingKeys);
+                WriteArrayOrOffset(&chunk, nd->mScalingKeys, nd->mNumScalingKeys);
         }
     }
 
@@ -655,6 +904,12 @@ protected:
             Write<float>(&chunk, l->mAngleInnerCone);
             Write<float>(&chunk, l->mAngleOuterCone);
         }
+
+        Write<aiVector3D>(&chunk, l->mPosition);
+        Write<aiVector3D>(&chunk, l->mDirection);
+        Write<aiVector3D>(&chunk, l->mUp);
+        Write<float>(&chunk, l->mSize.x);
+        Write<float>(&chunk, l->mSize.y);
     }
 
     // -----------------------------------------------------------------------------------
@@ -669,64 +924,95 @@ protected:
         Write<float>(&chunk, cam->mClipPlaneNear);
         Write<float>(&chunk, cam->mClipPlaneFar);
         Write<float>(&chunk, cam->mAspect);
+        Write<float>(&chunk, cam->mOrthographicWidth);
     }
 
     // -----------------------------------------------------------------------------------
     void WriteBinaryScene(IOStream *container, const aiScene *scene) {
         AssbinChunkWriter chunk(container, ASSBIN_CHUNK_AISCENE);
+        WriteBinarySceneContent(&chunk, scene);
+    }
 
+    // -----------------------------------------------------------------------------------
+    void WriteBinarySceneContent(IOStream *container, const aiScene *scene) {
         // basic scene information
-        Write<unsigned int>(&chunk, scene->mFlags);
-        Write<unsigned int>(&chunk, scene->mNumMeshes);
-        Write<unsigned int>(&chunk, scene->mNumMaterials);
-        Write<unsigned int>(&chunk, scene->mNumAnimations);
-        Write<unsigned int>(&chunk, scene->mNumTextures);
-        Write<unsigned int>(&chunk, scene->mNumLights);
-        Write<unsigned int>(&chunk, scene->mNumCameras);
+        Write<unsigned int>(container, scene->mFlags);
+        Write<unsigned int>(container, scene->mNumMeshes);
+        Write<unsigned int>(container, scene->mNumMaterials);
+        Write<unsigned int>(container, scene->mNumAnimations);
+        Write<unsigned int>(container, scene->mNumTextures);
+        Write<unsigned int>(container, scene->mNumLights);
+        Write<unsigned int>(container, scene->mNumCameras);
+        Write<aiString>(container, scene->mName);
+
+        const unsigned int nb_metadata = (scene->mMetaData != nullptr ? scene->mMetaData->mNumProperties : 0);
+        Write<unsigned int>(container, nb_metadata);
+        if (nb_metadata) {
+            WriteMetadataEntries(container, scene->mMetaData);
+        }
 
         // write node graph
-        WriteBinaryNode(&chunk, scene->mRootNode);
+        WriteBinaryNode(container, scene->mRootNode);
 
         // write all meshes
         for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
             const aiMesh *mesh = scene->mMeshes[i];
-            WriteBinaryMesh(&chunk, mesh);
+            WriteBinaryMesh(container, mesh);
         }
 
         // write materials
         for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
             const aiMaterial *mat = scene->mMaterials[i];
-            WriteBinaryMaterial(&chunk, mat);
+            WriteBinaryMaterial(container, mat);
         }
 
         // write all animations
         for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
             const aiAnimation *anim = scene->mAnimations[i];
-            WriteBinaryAnim(&chunk, anim);
+            WriteBinaryAnim(container, anim);
         }
 
         // write all textures
         for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
             const aiTexture *mesh = scene->mTextures[i];
-            WriteBinaryTexture(&chunk, mesh);
+            WriteBinaryTexture(container, mesh);
         }
 
         // write lights
         for (unsigned int i = 0; i < scene->mNumLights; ++i) {
             const aiLight *l = scene->mLights[i];
-            WriteBinaryLight(&chunk, l);
+            WriteBinaryLight(container, l);
         }
 
         // write cameras
         for (unsigned int i = 0; i < scene->mNumCameras; ++i) {
             const aiCamera *cam = scene->mCameras[i];
-            WriteBinaryCamera(&chunk, cam);
+            WriteBinaryCamera(container, cam);
         }
     }
 
+    // -----------------------------------------------------------------------------------
+    // Writes the data section of the flat layout, each array is aligned
+    void WriteFlatData(IOStream *out, uint64_t padding) {
+        static const uint8_t zeros[ASSBIN_FLAT_ALIGNMENT] = { 0 };
+        out->Write(zeros, 1, static_cast<size_t>(padding));
+
+        uint64_t cursor = 0;
+        for (const FlatArray &array : flatArrays) {
+            out->Write(zeros, 1, static_cast<size_t>(array.offset - cursor));
+            if (nullptr != array.faces) {
+                WriteFlatFaceArray(out, array.faces, array.faceSizes);
+            } else {
+                out->Write(array.data, 1, array.size);
+            }
+            cursor = array.offset + array.size;
+        }
+        ai_assert(cursor == flatSize);
+    }
+
 public:
-    AssbinFileWriter(bool shortened, bool compressed) :
-            shortened(shortened), compressed(compressed) {
+    AssbinFileWriter(bool shortened, unsigned int compression, bool flat) :
+            shortened(shortened), compression(flat ? 0 : compression), flat(flat && !shortened), flatSize(0) {
     }
 
     // -----------------------------------------------------------------------------------
@@ -744,6 +1030,13 @@ public:
         };
 
         try {
+            // chunk sizes are patched once they are known, so the file is written in memory
+            // first if the output stream can't seek
+            AssbinMemoryStream memory;
+            const bool seekable = (aiReturn_SUCCESS == out->Seek(out->Tell(), aiOrigin_SET));
+            IOStream *target = seekable ? out : &memory;
+            AssbinOutputBuffer buffer(target);
+
             time_t tt = time(nullptr);
 #if _WIN32
             tm *p = gmtime(&tt);
@@ -760,57 +1053,68 @@ public:
 #else
             ai_snprintf(s, 64, "ASSIMP.binary-dump.%s", asctime(p));
 #endif
-            out->Write(s, 44, 1);
+            buffer.Write(s, 44, 1);
             // == 44 bytes
 
-            Write<unsigned int>(out, ASSBIN_VERSION_MAJOR);
-            Write<unsigned int>(out, ASSBIN_VERSION_MINOR);
-            Write<unsigned int>(out, aiGetVersionRevision());
-            Write<unsigned int>(out, aiGetCompileFlags());
-            Write<uint16_t>(out, shortened);
-            Write<uint16_t>(out, compressed);
+            Write<unsigned int>(&buffer, flat ? ASSBIN_FLAT_VERSION_MAJOR : ASSBIN_VERSION_MAJOR);
+            Write<unsigned int>(&buffer, flat ? ASSBIN_FLAT_VERSION_MINOR : ASSBIN_VERSION_MINOR);
+            Write<unsigned int>(&buffer, aiGetVersionRevision());
+            Write<unsigned int>(&buffer, aiGetCompileFlags());
+            Write<uint16_t>(&buffer, shortened);
+            Write<uint16_t>(&buffer, compression ? ASSBIN_COMPRESSION_BLOCKS : ASSBIN_COMPRESSION_NONE);
             // ==  20 bytes
 
             char buff[256] = { 0 };
             ai_snprintf(buff, 256, "%s", pFile);
-            out->Write(buff, sizeof(char), 256);
+            buffer.Write(buff, sizeof(char), 256);
 
             memset(buff, 0, sizeof(buff));
             ai_snprintf(buff, 128, "%s", cmd);
-            out->Write(buff, sizeof(char), 128);
+            buffer.Write(buff, sizeof(char), 128);
 
-            // leave 64 bytes free for future extensions
+            // leave 64 bytes free for future extensions, the flat layout fills in the
+            // position of its data section once the chunks are written
+            const size_t extensionPos = buffer.Tell();
             memset(buff, 0xcd, 64);
-            out->Write(buff, sizeof(char), 64);
+            buffer.Write(buff, sizeof(char), 64);
             // == 435 bytes
 
             // ==== total header size: 512 bytes
-            ai_assert(out->Tell() == ASSBIN_HEADER_LENGTH);
+            ai_assert(buffer.Tell() == ASSBIN_HEADER_LENGTH);
 
             // Up to here the data is uncompressed. For compressed files, the rest
-            // is compressed using standard DEFLATE from zlib.
-            if (compressed) {
-                AssbinChunkWriter uncompressedStream(nullptr, 0);
-                WriteBinaryScene(&uncompressedStream, pScene);
-
-                uLongf uncompressedSize = static_cast<uLongf>(uncompressedStream.Tell());
-                uLongf compressedSize = (uLongf)compressBound(uncompressedSize);
-                uint8_t *compressedBuffer = new uint8_t[compressedSize];
-
-                int res = compress2(compressedBuffer, &compressedSize, (const Bytef *)uncompressedStream.GetBufferPointer(), uncompressedSize, 9);
-                if (res != Z_OK) {
-                    delete[] compressedBuffer;
-                    throw DeadlyExportError("Compression failed.");
-                }
-
-                out->Write(&uncompressedSize, sizeof(uint32_t), 1);
-                out->Write(compressedBuffer, sizeof(char), compressedSize);
-
-                delete[] compressedBuffer;
+            // is split into blocks which are compressed independently.
+            if (flat) {
+                WriteBinaryScene(&buffer, pScene);
+                const uint64_t chunksEnd = buffer.Tell();
+                const uint64_t flatOffset = AlignFlat(chunksEnd);
+
+                const uint32_t bom = ASSBIN_FLAT_BYTE_ORDER_MARK, realSize = sizeof(ai_real);
+                buffer.Seek(extensionPos, aiOrigin_SET);
+                Write<uint64_t>(&buffer, flatOffset);
+                Write<uint64_t>(&buffer, flatSize);
+                Write<uint32_t>(&buffer, bom);
+                Write<uint32_t>(&buffer, realSize);
+                buffer.Seek(static_cast<size_t>(chunksEnd), aiOrigin_SET);
+
+                WriteFlatData(&buffer, flatOffset - chunksEnd);
+                buffer.Flush();
+            } else if (compression) {
+                // blocks are compressed and written as soon as a batch of them is complete
+                buffer.Flush();
+                BlockCompressIOStream compressed(target, static_cast<BlockCodec>(compression));
+                AssbinOutputBuffer compressedBuffer(&compressed);
+                WriteBinaryScene(&compressedBuffer, pScene);
+                compressedBuffer.Flush();
+                compressed.Finish();
             } else {
-                WriteBinaryScene(out, pScene);
+                WriteBinaryScene(&buffer, pScene);
+                buffer.Flush();
             }
 
+            if (!seekable) {
+                out->Write(memory.GetBufferPointer(), 1, memory.FileSize());
+            }
             CloseIOStream();
         } catch (...) {
             CloseIOStream();
@@ -821,8 +1125,8 @@ public:
 
 void DumpSceneToAssbin(
         const char *pFile, const char *cmd, IOSystem *pIOSystem,
-        const aiScene *pScene, bool shortened, bool compressed) {
-    AssbinFileWriter fileWriter(shortened, compressed);
+        const aiScene *pScene, bool shortened, unsigned int compression, bool flat) {
+    AssbinFileWriter fileWriter(shortened, compression, flat);
     fileWriter.WriteBinaryDump(pFile, cmd, pIOSystem, pScene);
 }
 #if _MSC_VER
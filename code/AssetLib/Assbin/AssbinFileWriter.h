@@ -52,13 +52,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+// ------------------------------------------------------------------------------------------------
+/** @brief Writes a scene to an Assbin file.
+ *
+ *  @param compression 0 to write uncompressed data, else the BlockCodec to compress
+ *      the data with. Compressed data is written as a container of independently
+ *      compressed blocks, so passing true selects DEFLATE.
+ *  @param flat Write the flat, memory-mappable layout. It is never compressed. */
+// ------------------------------------------------------------------------------------------------
 void ASSIMP_API DumpSceneToAssbin(
         const char *pFile,
         const char *cmd,
         IOSystem *pIOSystem,
         const aiScene *pScene,
         bool shortened,
-        bool compressed);
+        unsigned int compression,
+        bool flat = false);
 
 }
 
@@ -49,13 +49,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "AssetLib/Assbin/AssbinLoader.h"
+#include "Common/BlockCompression.h"
 #include "Common/assbin_chunks.h"
+#include <assimp/Importer.hpp>
+#include <assimp/MappedFile.h>
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/anim.h>
 #include <assimp/importerdesc.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <vector>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #include <zlib.h>
@@ -83,6 +89,11 @@ const aiImporterDesc *AssbinImporter::GetInfo() const {
     return &desc;
 }
 
+// -----------------------------------------------------------------------------------
+void AssbinImporter::SetupProperties(const Importer *pImp) {
+    contiguousIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
+}
+
 // -----------------------------------------------------------------------------------
 bool AssbinImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /*checkSig*/) const {
     IOStream *in = pIOHandler->Open(pFile);
@@ -193,6 +204,22 @@ aiQuatKey Read<aiQuatKey>(IOStream *stream) {
     return v;
 }
 
+// -----------------------------------------------------------------------------------
+template <>
+aiMeshlet Read<aiMeshlet>(IOStream *stream) {
+    aiMeshlet m;
+    m.mVertexOffset = Read<unsigned int>(stream);
+    m.mVertexCount = Read<unsigned int>(stream);
+    m.mIndexOffset = Read<unsigned int>(stream);
+    m.mTriangleCount = Read<unsigned int>(stream);
+    m.mCenter = Read<aiVector3D>(stream);
+    m.mRadius = Read<float>(stream);
+    m.mConeApex = Read<aiVector3D>(stream);
+    m.mConeAxis = Read<aiVector3D>(stream);
+    m.mConeCutoff = Read<float>(stream);
+    return m;
+}
+
 // -----------------------------------------------------------------------------------
 template <typename T>
 void ReadArray(IOStream *stream, T *out, unsigned int size) {
@@ -204,6 +231,34 @@ void ReadArray(IOStream *stream, T *out, unsigned int size) {
     }
 }
 
+// -----------------------------------------------------------------------------------
+// Returns an array stored in the data section of the flat layout, the chunk only holds its offset
+template <typename T>
+const T *AssbinImporter::GetFlatArray(IOStream *stream, size_t count) {
+    ai_assert(nullptr != flatData);
+
+    const uint64_t offset = Read<uint64_t>(stream);
+    if (offset % ASSBIN_FLAT_ALIGNMENT != 0 || offset > flatSize || count > (flatSize - offset) / sizeof(T)) {
+        throw DeadlyImportError("ASSBIN: Array offset is out of range");
+    }
+    return reinterpret_cast<const T *>(flatData + offset);
+}
+
+// -----------------------------------------------------------------------------------
+template <typename T>
+void AssbinImporter::ReadArrayOrFlat(IOStream *stream, T *&out, size_t count) {
+    if (nullptr != flatData) {
+        // the flat layout stores the in-memory representation, so this is a plain copy.
+        // The range is checked before allocating, the count comes from the file.
+        const T *data = GetFlatArray<T>(stream, count);
+        out = new T[count];
+        ::memcpy(static_cast<void *>(out), data, count * sizeof(T));
+    } else {
+        out = new T[count];
+        ReadArray<T>(stream, out, static_cast<unsigned int>(count));
+    }
+}
+
 // -----------------------------------------------------------------------------------
 template <typename T>
 void ReadBounds(IOStream *stream, T * /*p*/, unsigned int n) {
@@ -211,6 +266,56 @@ void ReadBounds(IOStream *stream, T * /*p*/, unsigned int n) {
     stream->Seek(sizeof(T) * n, aiOrigin_CUR);
 }
 
+// -----------------------------------------------------------------------------------
+aiMetadata *AssbinImporter::ReadMetadata(IOStream *stream, unsigned int count) {
+    std::unique_ptr<aiMetadata> metadata(aiMetadata::Alloc(count));
+    for (unsigned int i = 0; i < count; ++i) {
+        metadata->mKeys[i] = Read<aiString>(stream);
+        metadata->mValues[i].mType = (aiMetadataType)Read<uint16_t>(stream);
+        void *data = nullptr;
+
+        switch (metadata->mValues[i].mType) {
+        case AI_BOOL:
+            data = new bool(Read<bool>(stream));
+            break;
+        case AI_INT32:
+            data = new int32_t(Read<int32_t>(stream));
+            break;
+        case AI_UINT64:
+            data = new uint64_t(Read<uint64_t>(stream));
+            break;
+        case AI_FLOAT:
+            data = new float(Read<float>(stream));
+            break;
+        case AI_DOUBLE:
+            data = new double(Read<double>(stream));
+            break;
+        case AI_AISTRING:
+            data = new aiString(Read<aiString>(stream));
+            break;
+        case AI_AIVECTOR3D:
+            data = new aiVector3D(Read<aiVector3D>(stream));
+            break;
+        case AI_AIMETADATA:
+            // nested metadata is only written since version 1.1
+            if (extended) {
+                data = ReadMetadata(stream, Read<unsigned int>(stream));
+            } else {
+                data = new aiMetadata();
+            }
+            break;
+#ifndef SWIG
+        case FORCE_32BIT:
+#endif // SWIG
+        default:
+            break;
+        }
+
+        metadata->mValues[i].mData = data;
+    }
+    return metadata.release();
+}
+
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryNode(IOStream *stream, aiNode **onode, aiNode *parent) {
     if (Read<uint32_t>(stream) != ASSBIN_CHUNK_AINODE)
@@ -246,43 +351,7 @@ void AssbinImporter::ReadBinaryNode(IOStream *stream, aiNode **onode, aiNode *pa
     }
 
     if (nb_metadata > 0) {
-        node->mMetaData = aiMetadata::Alloc(nb_metadata);
-        for (unsigned int i = 0; i < nb_metadata; ++i) {
-            node->mMetaData->mKeys[i] = Read<aiString>(stream);
-            node->mMetaData->mValues[i].mType = (aiMetadataType)Read<uint16_t>(stream);
-            void *data = nullptr;
-
-            switch (node->mMetaData->mValues[i].mType) {
-            case AI_BOOL:
-                data = new bool(Read<bool>(stream));
-                break;
-            case AI_INT32:
-                data = new int32_t(Read<int32_t>(stream));
-                break;
-            case AI_UINT64:
-                data = new uint64_t(Read<uint64_t>(stream));
-                break;
-            case AI_FLOAT:
-                data = new ai_real(Read<ai_real>(stream));
-                break;
-            case AI_DOUBLE:
-                data = new double(Read<double>(stream));
-                break;
-            case AI_AISTRING:
-                data = new aiString(Read<aiString>(stream));
-                break;
-            case AI_AIVECTOR3D:
-                data = new aiVector3D(Read<aiVector3D>(stream));
-                break;
-#ifndef SWIG
-            case FORCE_32BIT:
-#endif // SWIG
-            default:
-                break;
-            }
-
-            node->mMetaData->mValues[i].mData = data;
-        }
+        node->mMetaData = ReadMetadata(stream, nb_metadata);
     }
     *onode = node.release();
 }
@@ -303,8 +372,7 @@ void AssbinImporter::ReadBinaryBone(IOStream *stream, aiBone *b) {
         ReadBounds(stream, b->mWeights, b->mNumWeights);
     } else {
         // else write as usual
-        b->mWeights = new aiVertexWeight[b->mNumWeights];
-        ReadArray<aiVertexWeight>(stream, b->mWeights, b->mNumWeights);
+        ReadArrayOrFlat(stream, b->mWeights, b->mNumWeights);
     }
 }
 
@@ -333,8 +401,7 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBounds(stream, mesh->mVertices, mesh->mNumVertices);
         } else {
             // else write as usual
-            mesh->mVertices = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream, mesh->mVertices, mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mVertices, mesh->mNumVertices);
         }
     }
     if (c & ASSBIN_MESH_HAS_NORMALS) {
@@ -342,8 +409,7 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBounds(stream, mesh->mNormals, mesh->mNumVertices);
         } else {
             // else write as usual
-            mesh->mNormals = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream, mesh->mNormals, mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mNormals, mesh->mNumVertices);
         }
     }
     if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS) {
@@ -352,10 +418,8 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBounds(stream, mesh->mBitangents, mesh->mNumVertices);
         } else {
             // else write as usual
-            mesh->mTangents = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream, mesh->mTangents, mesh->mNumVertices);
-            mesh->mBitangents = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream, mesh->mBitangents, mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mTangents, mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mBitangents, mesh->mNumVertices);
         }
     }
     for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
@@ -367,8 +431,7 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBounds(stream, mesh->mColors[n], mesh->mNumVertices);
         } else {
             // else write as usual
-            mesh->mColors[n] = new aiColor4D[mesh->mNumVertices];
-            ReadArray<aiColor4D>(stream, mesh->mColors[n], mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mColors[n], mesh->mNumVertices);
         }
     }
     for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
@@ -383,8 +446,7 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBounds(stream, mesh->mTextureCoords[n], mesh->mNumVertices);
         } else {
             // else write as usual
-            mesh->mTextureCoords[n] = new aiVector3D[mesh->mNumVertices];
-            ReadArray<aiVector3D>(stream, mesh->mTextureCoords[n], mesh->mNumVertices);
+            ReadArrayOrFlat(stream, mesh->mTextureCoords[n], mesh->mNumVertices);
         }
     }
 
@@ -394,23 +456,78 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
     // using Assimp's standard hashing function.
     if (shortened) {
         Read<unsigned int>(stream);
+    } else if (nullptr != flatData) {
+        ReadFlatFaces(stream, mesh);
     } else {
         // else write as usual
         // if there are less than 2^16 vertices, we can simply use 16 bit integers ...
+        // In contiguous mode the indices are collected first, their total is not stored.
+        std::vector<unsigned int> indices;
+        if (contiguousIndices) {
+            indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+        }
         mesh->mFaces = new aiFace[mesh->mNumFaces];
         for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
             aiFace &f = mesh->mFaces[i];
 
             static_assert(AI_MAX_FACE_INDICES <= 0xffff, "AI_MAX_FACE_INDICES <= 0xffff");
             f.mNumIndices = Read<uint16_t>(stream);
-            f.mIndices = new unsigned int[f.mNumIndices];
+            unsigned int *out;
+            if (contiguousIndices) {
+                indices.resize(indices.size() + f.mNumIndices);
+                out = indices.data() + indices.size() - f.mNumIndices;
+            } else {
+                out = f.mIndices = new unsigned int[f.mNumIndices];
+            }
 
             for (unsigned int a = 0; a < f.mNumIndices; ++a) {
                 // Check if unsigned  short ( 16 bit  ) are big enought for the indices
                 if (fitsIntoUI16(mesh->mNumVertices)) {
-                    f.mIndices[a] = Read<uint16_t>(stream);
+                    out[a] = Read<uint16_t>(stream);
                 } else {
-                    f.mIndices[a] = Read<unsigned int>(stream);
+                    out[a] = Read<unsigned int>(stream);
+                }
+            }
+        }
+
+        if (contiguousIndices) {
+            if (indices.size() > std::numeric_limits<unsigned int>::max()) {
+                throw DeadlyImportError("ASSBIN: Too many face indices in mesh");
+            }
+            mesh->mNumIndices = static_cast<unsigned int>(indices.size());
+            mesh->mIndices = new unsigned int[indices.size()];
+            if (!indices.empty()) {
+                ::memcpy(mesh->mIndices, indices.data(), indices.size() * sizeof(unsigned int));
+            }
+            unsigned int *cursor = mesh->mIndices;
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                aiFace &f = mesh->mFaces[i];
+                f.mIndices = f.mNumIndices ? cursor : nullptr;
+                cursor += f.mNumIndices;
+            }
+        }
+    }
+
+    if (extended) {
+        mesh->mName = Read<aiString>(stream);
+        mesh->mAABB.mMin = Read<aiVector3D>(stream);
+        mesh->mAABB.mMax = Read<aiVector3D>(stream);
+
+        // read meshlets
+        const unsigned int numMeshlets = Read<unsigned int>(stream);
+        if (numMeshlets) {
+            mesh->mNumMeshletVertices = Read<unsigned int>(stream);
+            mesh->mNumMeshletIndices = Read<unsigned int>(stream);
+            ReadArrayOrFlat(stream, mesh->mMeshlets, numMeshlets);
+            mesh->mNumMeshlets = numMeshlets;
+            ReadArrayOrFlat(stream, mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+            ReadArrayOrFlat(stream, mesh->mMeshletIndices, mesh->mNumMeshletIndices);
+
+            for (unsigned int i = 0; i < numMeshlets; ++i) {
+                const aiMeshlet &m = mesh->mMeshlets[i];
+                if (m.mVertexCount > mesh->mNumMeshletVertices - std::min(m.mVertexOffset, mesh->mNumMeshletVertices) ||
+                        static_cast<uint64_t>(m.mTriangleCount) * 3 > mesh->mNumMeshletIndices - std::min(m.mIndexOffset, mesh->mNumMeshletIndices)) {
+                    throw DeadlyImportError("ASSBIN: Meshlet is out of range");
                 }
             }
         }
@@ -426,6 +543,51 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
     }
 }
 
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadFlatFaces(IOStream *stream, aiMesh *mesh) {
+    const unsigned int faceSize = Read<unsigned int>(stream);
+    const unsigned int numIndices = Read<unsigned int>(stream);
+    const unsigned int *indices = GetFlatArray<unsigned int>(stream, numIndices);
+    const unsigned int *counts = nullptr;
+    if (0 == faceSize) {
+        counts = GetFlatArray<unsigned int>(stream, mesh->mNumFaces);
+    } else if (static_cast<uint64_t>(faceSize) * mesh->mNumFaces != numIndices) {
+        throw DeadlyImportError("ASSBIN: Index count does not match the number of faces");
+    }
+
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    unsigned int cursor = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        aiFace &f = mesh->mFaces[i];
+        f.mNumIndices = (nullptr != counts ? counts[i] : faceSize);
+        if (f.mNumIndices > numIndices - cursor) {
+            throw DeadlyImportError("ASSBIN: Index count does not match the number of faces");
+        }
+        cursor += f.mNumIndices;
+    }
+    if (cursor != numIndices) {
+        throw DeadlyImportError("ASSBIN: Index count does not match the number of faces");
+    }
+
+    // the indices are stored contiguously already, they are copied in one go if the
+    // caller asked for an index buffer
+    mesh->AllocateFaceIndices(contiguousIndices);
+    if (contiguousIndices) {
+        if (numIndices) {
+            ::memcpy(mesh->mIndices, indices, numIndices * sizeof(unsigned int));
+        }
+        return;
+    }
+    cursor = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        aiFace &f = mesh->mFaces[i];
+        if (f.mNumIndices) {
+            ::memcpy(f.mIndices, indices + cursor, f.mNumIndices * sizeof(unsigned int));
+        }
+        cursor += f.mNumIndices;
+    }
+}
+
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryMaterialProperty(IOStream *stream, aiMaterialProperty *prop) {
     if (Read<uint32_t>(stream) != ASSBIN_CHUNK_AIMATERIALPROPERTY)
@@ -480,8 +642,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream *stream, aiNodeAnim *nd) {
 
         } // else write as usual
         else {
-            nd->mPositionKeys = new aiVectorKey[nd->mNumPositionKeys];
-            ReadArray<aiVectorKey>(stream, nd->mPositionKeys, nd->mNumPositionKeys);
+            ReadArrayOrFlat(stream, nd->mPositionKeys, nd->mNumPositionKeys);
         }
     }
     if (nd->mNumRotationKeys) {
@@ -490,8 +651,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream *stream, aiNodeAnim *nd) {
 
         } else {
             // else write as usual
-            nd->mRotationKeys = new aiQuatKey[nd->mNumRotationKeys];
-            ReadArray<aiQuatKey>(stream, nd->mRotationKeys, nd->mNumRotationKeys);
+            ReadArrayOrFlat(stream, nd->mRotationKeys, nd->mNumRotationKeys);
         }
     }
     if (nd->mNumScalingKeys) {
@@ -500,8 +660,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream *stream, aiNodeAnim *nd) {
 
         } else {
             // else write as usual
-            nd->mScalingKeys = new aiVectorKey[nd->mNumScalingKeys];
-            ReadArray<aiVectorKey>(stream, nd->mScalingKeys, nd->mNumScalingKeys);
+            ReadArrayOrFlat(stream, nd->mScalingKeys, nd->mNumScalingKeys);
         }
     }
 }
@@ -535,8 +694,20 @@ void AssbinImporter::ReadBinaryTexture(IOStream *stream, aiTexture *tex) {
     tex->mWidth = Read<unsigned int>(stream);
     tex->mHeight = Read<unsigned int>(stream);
     stream->Read(tex->achFormatHint, sizeof(char), HINTMAXTEXTURELEN - 1);
+    if (extended) {
+        tex->mFilename = Read<aiString>(stream);
+    }
 
-    if (!shortened) {
+    if (nullptr != flatData) {
+        // compressed data is a byte array of mWidth bytes
+        if (!tex->mHeight) {
+            const uint8_t *data = GetFlatArray<uint8_t>(stream, tex->mWidth);
+            tex->pcData = new aiTexel[tex->mWidth];
+            ::memcpy(tex->pcData, data, tex->mWidth);
+        } else {
+            ReadArrayOrFlat(stream, tex->pcData, static_cast<size_t>(tex->mWidth) * tex->mHeight);
+        }
+    } else if (!shortened) {
         if (!tex->mHeight) {
             tex->pcData = new aiTexel[tex->mWidth];
             stream->Read(tex->pcData, 1, tex->mWidth);
@@ -570,6 +741,14 @@ void AssbinImporter::ReadBinaryLight(IOStream *stream, aiLight *l) {
         l->mAngleInnerCone = Read<float>(stream);
         l->mAngleOuterCone = Read<float>(stream);
     }
+
+    if (extended) {
+        l->mPosition = Read<aiVector3D>(stream);
+        l->mDirection = Read<aiVector3D>(stream);
+        l->mUp = Read<aiVector3D>(stream);
+        l->mSize.x = Read<float>(stream);
+        l->mSize.y = Read<float>(stream);
+    }
 }
 
 // -----------------------------------------------------------------------------------
@@ -586,6 +765,9 @@ void AssbinImporter::ReadBinaryCamera(IOStream *stream, aiCamera *cam) {
     cam->mClipPlaneNear = Read<float>(stream);
     cam->mClipPlaneFar = Read<float>(stream);
     cam->mAspect = Read<float>(stream);
+    if (extended) {
+        cam->mOrthographicWidth = Read<float>(stream);
+    }
 }
 
 // -----------------------------------------------------------------------------------
@@ -601,6 +783,13 @@ void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
     scene->mNumTextures = Read<unsigned int>(stream);
     scene->mNumLights = Read<unsigned int>(stream);
     scene->mNumCameras = Read<unsigned int>(stream);
+    if (extended) {
+        scene->mName = Read<aiString>(stream);
+        const unsigned int nb_metadata = Read<unsigned int>(stream);
+        if (nb_metadata > 0) {
+            scene->mMetaData = ReadMetadata(stream, nb_metadata);
+        }
+    }
 
     // Read node graph
     //scene->mRootNode = new aiNode[1];
@@ -667,6 +856,44 @@ void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
     }
 }
 
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadFlatScene(IOStream *stream, aiScene *scene) {
+    const uint64_t dataOffset = Read<uint64_t>(stream);
+    const uint64_t dataSize = Read<uint64_t>(stream);
+    const uint32_t byteOrder = Read<uint32_t>(stream);
+    const uint32_t realSize = Read<uint32_t>(stream);
+    if (byteOrder != ASSBIN_FLAT_BYTE_ORDER_MARK || realSize != sizeof(ai_real)) {
+        throw DeadlyImportError("ASSBIN: File was written with a different byte order or floating-point precision");
+    }
+
+    const size_t fileSize = stream->FileSize();
+    if (dataOffset < ASSBIN_HEADER_LENGTH || dataOffset > fileSize || dataSize > fileSize - dataOffset) {
+        throw DeadlyImportError("ASSBIN: Data section is out of range");
+    }
+
+    // map the file if possible, else read it in one go
+    MappedFile mapping(stream);
+    std::vector<uint8_t> buffer;
+    const uint8_t *data = mapping.GetData();
+    if (!mapping.IsValid() || mapping.GetSize() < fileSize) {
+        buffer.resize(fileSize);
+        stream->Seek(0, aiOrigin_SET);
+        if (stream->Read(buffer.data(), 1, fileSize) != fileSize) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+        data = buffer.data();
+    }
+
+    flatData = data + dataOffset;
+    flatSize = dataSize;
+
+    MemoryIOStream chunks(data + ASSBIN_HEADER_LENGTH, static_cast<size_t>(dataOffset) - ASSBIN_HEADER_LENGTH);
+    ReadBinaryScene(&chunks, scene);
+
+    flatData = nullptr;
+    flatSize = 0;
+}
+
 // -----------------------------------------------------------------------------------
 void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
     IOStream *stream = pIOHandler->Open(pFile, "rb");
@@ -679,24 +906,40 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
 
     unsigned int versionMajor = Read<unsigned int>(stream);
     unsigned int versionMinor = Read<unsigned int>(stream);
-    if (versionMinor != ASSBIN_VERSION_MINOR || versionMajor != ASSBIN_VERSION_MAJOR) {
+    const bool flat = (versionMinor == ASSBIN_FLAT_VERSION_MINOR && versionMajor == ASSBIN_FLAT_VERSION_MAJOR);
+    if (!flat && (versionMinor > ASSBIN_VERSION_MINOR || versionMajor != ASSBIN_VERSION_MAJOR)) {
         throw DeadlyImportError("Invalid version, data format not compatible!");
     }
+    // files written before version 1.1 lack mesh names, bounding boxes, meshlets and scene metadata
+    extended = flat || versionMinor >= 1;
+    flatData = nullptr;
+    flatSize = 0;
 
     /*unsigned int versionRevision =*/Read<unsigned int>(stream);
     /*unsigned int compileFlags =*/Read<unsigned int>(stream);
 
     shortened = Read<uint16_t>(stream) > 0;
-    compressed = Read<uint16_t>(stream) > 0;
+    const uint16_t compression = Read<uint16_t>(stream);
+    compressed = compression != ASSBIN_COMPRESSION_NONE;
 
     if (shortened)
         throw DeadlyImportError("Shortened binaries are not supported!");
 
     stream->Seek(256, aiOrigin_CUR); // original filename
     stream->Seek(128, aiOrigin_CUR); // options
+
+    if (flat) {
+        ReadFlatScene(stream, pScene);
+        pIOHandler->Close(stream);
+        return;
+    }
     stream->Seek(64, aiOrigin_CUR); // padding
 
-    if (compressed) {
+    if (compression == ASSBIN_COMPRESSION_BLOCKS) {
+        // blocks are decompressed in parallel while the scene is read
+        BlockDecompressIOStream io(stream);
+        ReadBinaryScene(&io, pScene);
+    } else if (compressed) {
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
@@ -59,6 +59,7 @@ struct aiAnimation;
 struct aiTexture;
 struct aiLight;
 struct aiCamera;
+struct aiMetadata;
 
 #ifndef ASSIMP_BUILD_NO_ASSBIN_IMPORTER
 
@@ -72,6 +73,10 @@ class AssbinImporter : public BaseImporter
 private:
     bool shortened;
     bool compressed;
+    bool extended;
+    const uint8_t *flatData;
+    uint64_t flatSize;
+    bool contiguousIndices = false;
 
 public:
     virtual bool CanRead(
@@ -80,6 +85,7 @@ public:
         bool checkSig
     ) const;
     virtual const aiImporterDesc* GetInfo() const;
+    virtual void SetupProperties(const Importer* pImp);
     virtual void InternReadFile(
     const std::string& pFile,
         aiScene* pScene,
@@ -88,6 +94,7 @@ public:
     void ReadHeader();
     void ReadBinaryScene( IOStream * stream, aiScene* pScene );
     void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent );
+    aiMetadata* ReadMetadata( IOStream * stream, unsigned int count );
     void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
     void ReadBinaryBone( IOStream * stream, aiBone* bone );
     void ReadBinaryMaterial(IOStream * stream, aiMaterial* mat);
@@ -97,6 +104,14 @@ public:
     void ReadBinaryTexture(IOStream * stream, aiTexture* tex);
     void ReadBinaryLight( IOStream * stream, aiLight* l );
     void ReadBinaryCamera( IOStream * stream, aiCamera* cam );
+    void ReadFlatScene( IOStream * stream, aiScene* pScene );
+    void ReadFlatFaces( IOStream * stream, aiMesh* mesh );
+
+private:
+    template <typename T>
+    const T *GetFlatArray( IOStream * stream, size_t count );
+    template <typename T>
+    void ReadArrayOrFlat( IOStream * stream, T *& out, size_t count );
 };
 
 } // end of namespace Assimp
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ColladaLoader.h"
 #include "ColladaParser.h"
+#include "Common/ParallelFor.h"
 #include <assimp/ColladaMetaData.h>
 #include <assimp/CreateAnimMesh.h>
 #include <assimp/Defines.h>
@@ -58,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace Assimp {
@@ -97,6 +99,9 @@ ColladaLoader::ColladaLoader() :
         mMeshIndexByID(),
         mMaterialIndexByName(),
         mMeshes(),
+        mTargetMeshes(),
+        mPendingMeshes(),
+        mDeferMeshes(false),
         newMats(),
         mCameras(),
         mLights(),
@@ -105,6 +110,7 @@ ColladaLoader::ColladaLoader() :
         noSkeletonMesh(false),
         ignoreUpDirection(false),
         useColladaName(false),
+        mContiguousIndices(false),
         mNodeNameCounter(0) {
     // empty
 }
@@ -154,6 +160,7 @@ void ColladaLoader::SetupProperties(const Importer *pImp) {
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, 0) != 0;
     ignoreUpDirection = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_IGNORE_UP_DIRECTION, 0) != 0;
     useColladaName = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_USE_COLLADA_NAMES, 0) != 0;
+    mContiguousIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -172,6 +179,7 @@ void ColladaLoader::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     mMaterialIndexByName.clear();
     mMeshes.clear();
     mTargetMeshes.clear();
+    mPendingMeshes.clear();
     newMats.clear();
     mLights.clear();
     mCameras.clear();
@@ -195,8 +203,16 @@ void ColladaLoader::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     // create the materials first, for the meshes to find
     BuildMaterials(parser, pScene);
 
-    // build the node hierarchy from it
+    // morph targets copy the data of other meshes while they are built, so with morph
+    // controllers around all meshes are built right away
+    mDeferMeshes = std::none_of(parser.mControllerLibrary.begin(), parser.mControllerLibrary.end(),
+            [](const ColladaParser::ControllerLibrary::value_type &controller) {
+                return controller.second.mType == Collada::Morph;
+            });
+
+    // build the node hierarchy from it, then the geometry of the meshes it refers to
     pScene->mRootNode = BuildHierarchy(parser, parser.mRootNode);
+    FillPendingMeshes();
 
     // ... then fill the materials with the now adjusted settings
     FillMaterials(parser, pScene);
@@ -548,7 +564,17 @@ void ColladaLoader::BuildMeshesForNode(const ColladaParser &pParser, const Node
                 newMeshRefs.push_back(dstMeshIt->second);
             } else {
                 // else we have to add the mesh to the collection and store its newly assigned index at the node
-                aiMesh *dstMesh = CreateMesh(pParser, srcMesh, submesh, srcController, vertexStart, faceStart);
+                aiMesh *dstMesh = nullptr;
+                if (mDeferMeshes && nullptr == srcController) {
+                    // plain geometry, it's copied along with all others once the hierarchy is complete
+                    dstMesh = new aiMesh;
+                    dstMesh->mName = useColladaName ? srcMesh->mName : srcMesh->mId;
+                    dstMesh->mNumVertices = static_cast<unsigned int>(std::accumulate(srcMesh->mFaceSize.begin() + faceStart,
+                            srcMesh->mFaceSize.begin() + faceStart + submesh.mNumFaces, size_t(0)));
+                    mPendingMeshes.push_back({ dstMesh, srcMesh, &submesh, vertexStart, faceStart });
+                } else {
+                    dstMesh = CreateMesh(pParser, srcMesh, submesh, srcController, vertexStart, faceStart);
+                }
 
                 // store the mesh, and store its new index in the node
                 newMeshRefs.push_back(mMeshes.size());
@@ -619,71 +645,8 @@ aiMesh *ColladaLoader::CreateMesh(const ColladaParser &pParser, const Mesh *pSrc
         dstMesh->mName = pSrcMesh->mId;
     }
 
-    // count the vertices addressed by its faces
-    const size_t numVertices = std::accumulate(pSrcMesh->mFaceSize.begin() + pStartFace,
-            pSrcMesh->mFaceSize.begin() + pStartFace + pSubMesh.mNumFaces, size_t(0));
-
-    // copy positions
-    dstMesh->mNumVertices = static_cast<unsigned int>(numVertices);
-    dstMesh->mVertices = new aiVector3D[numVertices];
-    std::copy(pSrcMesh->mPositions.begin() + pStartVertex, pSrcMesh->mPositions.begin() + pStartVertex + numVertices, dstMesh->mVertices);
-
-    // normals, if given. HACK: (thom) Due to the glorious Collada spec we never
-    // know if we have the same number of normals as there are positions. So we
-    // also ignore any vertex attribute if it has a different count
-    if (pSrcMesh->mNormals.size() >= pStartVertex + numVertices) {
-        dstMesh->mNormals = new aiVector3D[numVertices];
-        std::copy(pSrcMesh->mNormals.begin() + pStartVertex, pSrcMesh->mNormals.begin() + pStartVertex + numVertices, dstMesh->mNormals);
-    }
-
-    // tangents, if given.
-    if (pSrcMesh->mTangents.size() >= pStartVertex + numVertices) {
-        dstMesh->mTangents = new aiVector3D[numVertices];
-        std::copy(pSrcMesh->mTangents.begin() + pStartVertex, pSrcMesh->mTangents.begin() + pStartVertex + numVertices, dstMesh->mTangents);
-    }
-
-    // bitangents, if given.
-    if (pSrcMesh->mBitangents.size() >= pStartVertex + numVertices) {
-        dstMesh->mBitangents = new aiVector3D[numVertices];
-        std::copy(pSrcMesh->mBitangents.begin() + pStartVertex, pSrcMesh->mBitangents.begin() + pStartVertex + numVertices, dstMesh->mBitangents);
-    }
-
-    // same for texture coords, as many as we have
-    // empty slots are not allowed, need to pack and adjust UV indexes accordingly
-    for (size_t a = 0, real = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
-        if (pSrcMesh->mTexCoords[a].size() >= pStartVertex + numVertices) {
-            dstMesh->mTextureCoords[real] = new aiVector3D[numVertices];
-            for (size_t b = 0; b < numVertices; ++b) {
-                dstMesh->mTextureCoords[real][b] = pSrcMesh->mTexCoords[a][pStartVertex + b];
-            }
-
-            dstMesh->mNumUVComponents[real] = pSrcMesh->mNumUVComponents[a];
-            ++real;
-        }
-    }
-
-    // same for vertex colors, as many as we have. again the same packing to avoid empty slots
-    for (size_t a = 0, real = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
-        if (pSrcMesh->mColors[a].size() >= pStartVertex + numVertices) {
-            dstMesh->mColors[real] = new aiColor4D[numVertices];
-            std::copy(pSrcMesh->mColors[a].begin() + pStartVertex, pSrcMesh->mColors[a].begin() + pStartVertex + numVertices, dstMesh->mColors[real]);
-            ++real;
-        }
-    }
-
-    // create faces. Due to the fact that each face uses unique vertices, we can simply count up on each vertex
-    size_t vertex = 0;
-    dstMesh->mNumFaces = static_cast<unsigned int>(pSubMesh.mNumFaces);
-    dstMesh->mFaces = new aiFace[dstMesh->mNumFaces];
-    for (size_t a = 0; a < dstMesh->mNumFaces; ++a) {
-        size_t s = pSrcMesh->mFaceSize[pStartFace + a];
-        aiFace &face = dstMesh->mFaces[a];
-        face.mNumIndices = static_cast<unsigned int>(s);
-        face.mIndices = new unsigned int[s];
-        for (size_t b = 0; b < s; ++b) {
-            face.mIndices[b] = static_cast<unsigned int>(vertex++);
-        }
-    }
+    FillMeshGeometry(dstMesh.get(), pSrcMesh, pSubMesh, pStartVertex, pStartFace);
+    const size_t numVertices = dstMesh->mNumVertices;
 
     // create morph target meshes if any
     std::vector<aiMesh *> targetMeshes;
@@ -894,6 +857,101 @@ aiMesh *ColladaLoader::CreateMesh(const ColladaParser &pParser, const Mesh *pSrc
     return dstMesh.release();
 }
 
+// ------------------------------------------------------------------------------------------------
+// Copies vertices and faces of the given ColladaMesh face subset into the given mesh
+void ColladaLoader::FillMeshGeometry(aiMesh *pDstMesh, const Mesh *pSrcMesh, const SubMesh &pSubMesh,
+        size_t pStartVertex, size_t pStartFace) const {
+    aiMesh *dstMesh = pDstMesh;
+
+    // count the vertices addressed by its faces
+    const size_t numVertices = std::accumulate(pSrcMesh->mFaceSize.begin() + pStartFace,
+            pSrcMesh->mFaceSize.begin() + pStartFace + pSubMesh.mNumFaces, size_t(0));
+
+    // copy positions
+    dstMesh->mNumVertices = static_cast<unsigned int>(numVertices);
+    dstMesh->mVertices = new aiVector3D[numVertices];
+    std::copy(pSrcMesh->mPositions.begin() + pStartVertex, pSrcMesh->mPositions.begin() + pStartVertex + numVertices, dstMesh->mVertices);
+
+    // normals, if given. HACK: (thom) Due to the glorious Collada spec we never
+    // know if we have the same number of normals as there are positions. So we
+    // also ignore any vertex attribute if it has a different count
+    if (pSrcMesh->mNormals.size() >= pStartVertex + numVertices) {
+        dstMesh->mNormals = new aiVector3D[numVertices];
+        std::copy(pSrcMesh->mNormals.begin() + pStartVertex, pSrcMesh->mNormals.begin() + pStartVertex + numVertices, dstMesh->mNormals);
+    }
+
+    // tangents, if given.
+    if (pSrcMesh->mTangents.size() >= pStartVertex + numVertices) {
+        dstMesh->mTangents = new aiVector3D[numVertices];
+        std::copy(pSrcMesh->mTangents.begin() + pStartVertex, pSrcMesh->mTangents.begin() + pStartVertex + numVertices, dstMesh->mTangents);
+    }
+
+    // bitangents, if given.
+    if (pSrcMesh->mBitangents.size() >= pStartVertex + numVertices) {
+        dstMesh->mBitangents = new aiVector3D[numVertices];
+        std::copy(pSrcMesh->mBitangents.begin() + pStartVertex, pSrcMesh->mBitangents.begin() + pStartVertex + numVertices, dstMesh->mBitangents);
+    }
+
+    // same for texture coords, as many as we have
+    // empty slots are not allowed, need to pack and adjust UV indexes accordingly
+    for (size_t a = 0, real = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        if (pSrcMesh->mTexCoords[a].size() >= pStartVertex + numVertices) {
+            dstMesh->mTextureCoords[real] = new aiVector3D[numVertices];
+            for (size_t b = 0; b < numVertices; ++b) {
+                dstMesh->mTextureCoords[real][b] = pSrcMesh->mTexCoords[a][pStartVertex + b];
+            }
+
+            dstMesh->mNumUVComponents[real] = pSrcMesh->mNumUVComponents[a];
+            ++real;
+        }
+    }
+
+    // same for vertex colors, as many as we have. again the same packing to avoid empty slots
+    for (size_t a = 0, real = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        if (pSrcMesh->mColors[a].size() >= pStartVertex + numVertices) {
+            dstMesh->mColors[real] = new aiColor4D[numVertices];
+            std::copy(pSrcMesh->mColors[a].begin() + pStartVertex, pSrcMesh->mColors[a].begin() + pStartVertex + numVertices, dstMesh->mColors[real]);
+            ++real;
+        }
+    }
+
+    // create faces. Due to the fact that each face uses unique vertices, we can simply count up on each vertex
+    dstMesh->mNumFaces = static_cast<unsigned int>(pSubMesh.mNumFaces);
+    dstMesh->mFaces = new aiFace[dstMesh->mNumFaces];
+    for (size_t a = 0; a < dstMesh->mNumFaces; ++a) {
+        dstMesh->mFaces[a].mNumIndices = static_cast<unsigned int>(pSrcMesh->mFaceSize[pStartFace + a]);
+    }
+    dstMesh->AllocateFaceIndices(mContiguousIndices);
+    if (dstMesh->HasIndexBuffer()) {
+        for (unsigned int i = 0; i < dstMesh->mNumIndices; ++i) {
+            dstMesh->mIndices[i] = i;
+        }
+        return;
+    }
+
+    unsigned int vertex = 0;
+    for (size_t a = 0; a < dstMesh->mNumFaces; ++a) {
+        aiFace &face = dstMesh->mFaces[a];
+        for (unsigned int b = 0; b < face.mNumIndices; ++b) {
+            face.mIndices[b] = vertex++;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the geometry of all deferred meshes. Each one only reads its source mesh.
+void ColladaLoader::FillPendingMeshes() {
+    size_t work = 0;
+    for (const PendingMesh &pending : mPendingMeshes) {
+        work += pending.mSubMesh->mNumFaces;
+    }
+    ParallelFor(0, mPendingMeshes.size(), [this](size_t i) {
+        const PendingMesh &pending = mPendingMeshes[i];
+        FillMeshGeometry(pending.mMesh, pending.mSrcMesh, *pending.mSubMesh, pending.mStartVertex, pending.mStartFace);
+    }, 1, work);
+    mPendingMeshes.clear();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Stores all meshes in the given scene
 void ColladaLoader::StoreSceneMeshes(aiScene *pScene) {
@@ -119,6 +119,13 @@ protected:
     aiMesh *CreateMesh(const ColladaParser &pParser, const Collada::Mesh *pSrcMesh, const Collada::SubMesh &pSubMesh,
             const Collada::Controller *pSrcController, size_t pStartVertex, size_t pStartFace);
 
+    /** Copies vertices and faces of a ColladaMesh face subset into the given mesh */
+    void FillMeshGeometry(aiMesh *pDstMesh, const Collada::Mesh *pSrcMesh, const Collada::SubMesh &pSubMesh,
+            size_t pStartVertex, size_t pStartFace) const;
+
+    /** Copies the geometry of all meshes deferred by BuildMeshesForNode(), concurrently */
+    void FillPendingMeshes();
+
     /** Builds cameras for the given node and references them */
     void BuildCamerasForNode(const ColladaParser &pParser, const Collada::Node *pNode,
             aiNode *pTarget);
@@ -221,6 +228,19 @@ protected:
     /** Accumulated morph target meshes */
     std::vector<aiMesh *> mTargetMeshes;
 
+    /** A mesh whose vertices and faces are copied once the node hierarchy is complete */
+    struct PendingMesh {
+        aiMesh *mMesh;
+        const Collada::Mesh *mSrcMesh;
+        const Collada::SubMesh *mSubMesh;
+        size_t mStartVertex;
+        size_t mStartFace;
+    };
+    std::vector<PendingMesh> mPendingMeshes;
+
+    /** Whether plain meshes may be deferred, false if morph targets need mesh data early */
+    bool mDeferMeshes;
+
     /** Temporary material list */
     std::vector<std::pair<Collada::Effect *, aiMaterial *>> newMats;
 
@@ -240,6 +260,9 @@ protected:
     bool ignoreUpDirection;
     bool useColladaName;
 
+    /** Store the face indices in one buffer, see aiMesh::mIndices */
+    bool mContiguousIndices;
+
     /** Used by FindNameForNode() to generate unique node names */
     unsigned int mNodeNameCounter;
 };
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_COLLADA_IMPORTER
 
 #include "ColladaParser.h"
+#include "Common/ParallelFor.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/StringUtils.h>
 #include <assimp/ZipArchiveIOSystem.h>
@@ -55,12 +56,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
 #include <memory>
+#include <set>
 
 using namespace Assimp;
 using namespace Assimp::Collada;
 using namespace Assimp::Formatter;
 
-static void ReportWarning(const char *msg, ...) {
+static std::string FormatWarning(const char *msg, ...) {
     ai_assert(nullptr != msg);
 
     va_list args;
@@ -71,7 +73,26 @@ static void ReportWarning(const char *msg, ...) {
     ai_assert(iLen > 0);
 
     va_end(args);
-    ASSIMP_LOG_WARN_F("Validation warning: ", std::string(szBuffer, iLen));
+    return "Validation warning: " + std::string(szBuffer, iLen);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finds an accessor or data array referenced from within a geometry. The geometry's own sources
+// are searched first, the global libraries only if the geometry is not read concurrently.
+template <typename Type>
+static const Type &ResolveGeometryReference(const std::map<std::string, Type> &pLocal, const std::map<std::string, Type> &pGlobal,
+        bool pGlobalLookup, const std::string &pURL) {
+    typename std::map<std::string, Type>::const_iterator it = pLocal.find(pURL);
+    if (it == pLocal.end() && pGlobalLookup) {
+        it = pGlobal.find(pURL);
+        if (it != pGlobal.end()) {
+            return it->second;
+        }
+    }
+    if (it == pLocal.end()) {
+        throw DeadlyImportError("Unable to resolve library reference \"", pURL, "\".");
+    }
+    return it->second;
 }
 
 static bool FindCommonKey(const std::string &collada_key, const MetaKeyPairVector &key_renaming, size_t &found_index) {
@@ -632,7 +653,11 @@ void ColladaParser::ReadController(XmlNode &node, Collada::Controller &controlle
         const std::string &currentName = currentNode.name();
         if (currentName == "morph") {
             controller.mType = Morph;
-            controller.mMeshId = currentNode.attribute("source").as_string();
+            std::string id = currentNode.attribute("source").as_string();
+            if (!id.empty() && id[0] == '#') {
+                id.erase(0, 1);
+            }
+            controller.mMeshId = id;
             int methodIndex = currentNode.attribute("method").as_int();
             if (methodIndex > 0) {
                 std::string method;
@@ -651,10 +676,11 @@ void ColladaParser::ReadController(XmlNode &node, Collada::Controller &controlle
             std::string v;
             XmlParser::getValueAsString(currentNode, v);
             const char *content = v.c_str();
+            const char *end = content + v.size();
             for (unsigned int a = 0; a < 16; a++) {
                 SkipSpacesAndLineEnd(&content);
                 // read a number
-                content = fast_atoreal_move<ai_real>(content, controller.mBindShapeMatrix[a]);
+                content = fast_atoreal_move<ai_real>(content, end, controller.mBindShapeMatrix[a]);
                 // skip whitespace after it
                 SkipSpacesAndLineEnd(&content);
             }
@@ -665,7 +691,7 @@ void ColladaParser::ReadController(XmlNode &node, Collada::Controller &controlle
         } else if (currentName == "vertex_weights") {
             ReadControllerWeights(currentNode, controller);
         } else if (currentName == "targets") {
-            for (XmlNode currentChildNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
+            for (XmlNode &currentChildNode : currentNode.children()) {
                 const std::string &currentChildName = currentChildNode.name();
                 if (currentChildName == "input") {
                     const char *semantics = currentChildNode.attribute("semantic").as_string();
@@ -1316,6 +1342,11 @@ void ColladaParser::ReadGeometryLibrary(XmlNode &node) {
     if (node.empty()) {
         return;
     }
+
+    // collect the geometries first, each one only depends on its own subtree
+    std::vector<XmlNode> geometryNodes;
+    std::vector<std::unique_ptr<Mesh>> meshes;
+    std::set<std::string> ids;
     for (XmlNode &currentNode : node.children()) {
         const std::string &currentName = currentNode.name();
         if (currentName == "geometry") {
@@ -1325,37 +1356,88 @@ void ColladaParser::ReadGeometryLibrary(XmlNode &node) {
             XmlParser::getStdStrAttribute(currentNode, "id", id);
             // create a mesh and store it in the library under its (resolved) ID
             // Skip and warn if ID is not unique
-            if (mMeshLibrary.find(id) == mMeshLibrary.cend()) {
+            if (mMeshLibrary.find(id) == mMeshLibrary.cend() && ids.insert(id).second) {
                 std::unique_ptr<Mesh> mesh(new Mesh(id));
 
                 XmlParser::getStdStrAttribute(currentNode, "name", mesh->mName);
-
-                // read on from there
-                ReadGeometry(currentNode, *mesh);
-                // Read successfully, add to library
-                mMeshLibrary.insert({ id, mesh.release() });
+                geometryNodes.push_back(currentNode);
+                meshes.push_back(std::move(mesh));
             }
         }
     }
+
+    // read on from there, each geometry into its own context
+    std::vector<GeometryContext> contexts(meshes.size());
+    std::vector<char> failed(meshes.size(), 0);
+    ParallelFor(0, meshes.size(), [&](size_t i) {
+        contexts[i].mGlobalLookup = false;
+        try {
+            ReadGeometry(geometryNodes[i], *meshes[i], contexts[i]);
+        } catch (const DeadlyImportError &) {
+            failed[i] = 1;
+        }
+    });
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        if (failed[i]) {
+            // probably refers to sources outside of it. Read it once more, now that all
+            // sources in front of it are known, exactly as if reading serially.
+            std::unique_ptr<Mesh> mesh(new Mesh(meshes[i]->mId));
+            mesh->mName = meshes[i]->mName;
+            meshes[i] = std::move(mesh);
+            contexts[i] = GeometryContext();
+            ReadGeometry(geometryNodes[i], *meshes[i], contexts[i]);
+        }
+        MergeGeometryContext(*meshes[i], contexts[i]);
+
+        // Read successfully, add to library
+        const std::string id = meshes[i]->mId;
+        mMeshLibrary.insert({ id, meshes[i].release() });
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the sources read for a geometry to the global libraries and logs its messages
+void ColladaParser::MergeGeometryContext(Mesh &pMesh, GeometryContext &pContext) {
+    for (auto &message : pContext.mMessages) {
+        if (message.first) {
+            ASSIMP_LOG_ERROR(message.second);
+        } else {
+            ASSIMP_LOG_WARN(message.second);
+        }
+    }
+
+    // resolved pointers refer to the context, which is about to go away
+    for (InputChannel &channel : pMesh.mPerVertexData) {
+        channel.mResolved = nullptr;
+    }
+    for (auto &data : pContext.mDataLibrary) {
+        std::swap(mDataLibrary[data.first], data.second);
+    }
+    for (auto &accessor : pContext.mAccessorLibrary) {
+        Accessor &acc = mAccessorLibrary[accessor.first];
+        std::swap(acc, accessor.second);
+        acc.mData = nullptr;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Reads a geometry from the geometry library.
-void ColladaParser::ReadGeometry(XmlNode &node, Collada::Mesh &pMesh) {
+void ColladaParser::ReadGeometry(XmlNode &node, Collada::Mesh &pMesh, GeometryContext &pContext) {
     if (node.empty()) {
         return;
     }
     for (XmlNode &currentNode : node.children()) {
         const std::string &currentName = currentNode.name();
         if (currentName == "mesh") {
-            ReadMesh(currentNode, pMesh);
+            ReadMesh(currentNode, pMesh, pContext);
         }
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Reads a mesh from the geometry library
-void ColladaParser::ReadMesh(XmlNode &node, Mesh &pMesh) {
+void ColladaParser::ReadMesh(XmlNode &node, Mesh &pMesh, GeometryContext &pContext) {
     if (node.empty()) {
         return;
     }
@@ -1366,20 +1448,26 @@ void ColladaParser::ReadMesh(XmlNode &node, Mesh &pMesh) {
     while (xmlIt.getNext(currentNode)) {
         const std::string &currentName = currentNode.name();
         if (currentName == "source") {
-            ReadSource(currentNode);
+            ReadSource(currentNode, pContext.mDataLibrary, pContext.mAccessorLibrary);
         } else if (currentName == "vertices") {
-            ReadVertexData(currentNode, pMesh);
+            ReadVertexData(currentNode, pMesh, pContext);
         } else if (currentName == "triangles" || currentName == "lines" || currentName == "linestrips" ||
                 currentName == "polygons" || currentName == "polylist" || currentName == "trifans" ||
                 currentName == "tristrips") {
-            ReadIndexData(currentNode, pMesh);
+            ReadIndexData(currentNode, pMesh, pContext);
         }
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-// Reads a source element
+// Reads a source element into the global libraries
 void ColladaParser::ReadSource(XmlNode &node) {
+    ReadSource(node, mDataLibrary, mAccessorLibrary);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads a source element into the given libraries
+void ColladaParser::ReadSource(XmlNode &node, DataLibrary &pDataLibrary, AccessorLibrary &pAccessorLibrary) {
     if (node.empty()) {
         return;
     }
@@ -1392,19 +1480,19 @@ void ColladaParser::ReadSource(XmlNode &node) {
     while (xmlIt.getNext(currentNode)) {
         const std::string &currentName = currentNode.name();
         if (currentName == "float_array" || currentName == "IDREF_array" || currentName == "Name_array") {
-            ReadDataArray(currentNode);
+            ReadDataArray(currentNode, pDataLibrary);
         } else if (currentName == "technique_common") {
             XmlNode technique = currentNode.child("accessor");
             if (!technique.empty()) {
-                ReadAccessor(technique, sourceID);
+                ReadAccessor(technique, sourceID, pAccessorLibrary);
             }
         }
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-// Reads a data array holding a number of floats, and stores it in the global library
-void ColladaParser::ReadDataArray(XmlNode &node) {
+// Reads a data array holding a number of floats, and stores it in the given library
+void ColladaParser::ReadDataArray(XmlNode &node, DataLibrary &pDataLibrary) {
     std::string name = node.name();
     bool isStringArray = (name == "IDREF_array" || name == "Name_array");
 
@@ -1417,10 +1505,11 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
     XmlParser::getValueAsString(node, v);
     v = ai_trim(v);
     const char *content = v.c_str();
+    const char *end = content + v.size();
 
     // read values and store inside an array in the data library
-    mDataLibrary[id] = Data();
-    Data &data = mDataLibrary[id];
+    pDataLibrary[id] = Data();
+    Data &data = pDataLibrary[id];
     data.mIsStringArray = isStringArray;
 
     // some exporters write empty data arrays, but we need to conserve them anyways because others might reference them
@@ -1452,7 +1541,7 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
                 ai_real value;
                 // read a number
                 //SkipSpacesAndLineEnd(&content);
-                content = fast_atoreal_move<ai_real>(content, value);
+                content = fast_atoreal_move<ai_real>(content, end, value);
                 data.mValues.push_back(value);
                 // skip whitespace after it
                 SkipSpacesAndLineEnd(&content);
@@ -1462,8 +1551,8 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Reads an accessor and stores it in the global library
-void ColladaParser::ReadAccessor(XmlNode &node, const std::string &pID) {
+// Reads an accessor and stores it in the given library
+void ColladaParser::ReadAccessor(XmlNode &node, const std::string &pID, AccessorLibrary &pAccessorLibrary) {
     // read accessor attributes
     std::string source;
     XmlParser::getStdStrAttribute(node, "source", source);
@@ -1482,8 +1571,8 @@ void ColladaParser::ReadAccessor(XmlNode &node, const std::string &pID) {
         XmlParser::getUIntAttribute(node, "stride", stride);
     }
     // store in the library under the given ID
-    mAccessorLibrary[pID] = Accessor();
-    Accessor &acc = mAccessorLibrary[pID];
+    pAccessorLibrary[pID] = Accessor();
+    Accessor &acc = pAccessorLibrary[pID];
     acc.mCount = count;
     acc.mOffset = offset;
     acc.mStride = stride;
@@ -1555,13 +1644,13 @@ void ColladaParser::ReadAccessor(XmlNode &node, const std::string &pID) {
 
 // ------------------------------------------------------------------------------------------------
 // Reads input declarations of per-vertex mesh data into the given mesh
-void ColladaParser::ReadVertexData(XmlNode &node, Mesh &pMesh) {
+void ColladaParser::ReadVertexData(XmlNode &node, Mesh &pMesh, GeometryContext &pContext) {
     // extract the ID of the <vertices> element. Not that we care, but to catch strange referencing schemes we should warn about
     XmlParser::getStdStrAttribute(node, "id", pMesh.mVertexID);
     for (XmlNode &currentNode : node.children()) {
         const std::string &currentName = currentNode.name();
         if (currentName == "input") {
-            ReadInputChannel(currentNode, pMesh.mPerVertexData);
+            ReadInputChannel(currentNode, pMesh.mPerVertexData, pContext);
         } else {
             throw DeadlyImportError("Unexpected sub element <", currentName, "> in tag <vertices>");
         }
@@ -1570,7 +1659,7 @@ void ColladaParser::ReadVertexData(XmlNode &node, Mesh &pMesh) {
 
 // ------------------------------------------------------------------------------------------------
 // Reads input declarations of per-index mesh data into the given mesh
-void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
+void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh, GeometryContext &pContext) {
     std::vector<size_t> vcount;
     std::vector<InputChannel> perIndexData;
 
@@ -1614,7 +1703,7 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
     while (xmlIt.getNext(currentNode)) {
         const std::string &currentName = currentNode.name();
         if (currentName == "input") {
-            ReadInputChannel(currentNode, perIndexData);
+            ReadInputChannel(currentNode, perIndexData, pContext);
         } else if (currentName == "vcount") {
             if (!currentNode.empty()) {
                 if (numPrimitives) // It is possible to define a mesh without any primitives
@@ -1638,7 +1727,7 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
         } else if (currentName == "p") {
             if (!currentNode.empty()) {
                 // now here the actual fun starts - these are the indices to construct the mesh data from
-                actualPrimitives += ReadPrimitives(currentNode, pMesh, perIndexData, numPrimitives, vcount, primType);
+                actualPrimitives += ReadPrimitives(currentNode, pMesh, perIndexData, numPrimitives, vcount, primType, pContext);
             }
         } else if (currentName == "extra") {
             // skip
@@ -1663,13 +1752,13 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
 
 // ------------------------------------------------------------------------------------------------
 // Reads a single input channel element and stores it in the given array, if valid
-void ColladaParser::ReadInputChannel(XmlNode &node, std::vector<InputChannel> &poChannels) {
+void ColladaParser::ReadInputChannel(XmlNode &node, std::vector<InputChannel> &poChannels, GeometryContext &pContext) {
     InputChannel channel;
 
     // read semantic
     std::string semantic;
     XmlParser::getStdStrAttribute(node, "semantic", semantic);
-    channel.mType = GetTypeForSemantic(semantic);
+    channel.mType = GetTypeForSemantic(semantic, pContext);
 
     // read source
     std::string source;
@@ -1702,7 +1791,7 @@ void ColladaParser::ReadInputChannel(XmlNode &node, std::vector<InputChannel> &p
 // ------------------------------------------------------------------------------------------------
 // Reads a <p> primitive index list and assembles the mesh data into the given mesh
 size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<InputChannel> &pPerIndexChannels,
-        size_t pNumPrimitives, const std::vector<size_t> &pVCount, PrimitiveType pPrimType) {
+        size_t pNumPrimitives, const std::vector<size_t> &pVCount, PrimitiveType pPrimType, GeometryContext &pContext) {
     // determine number of indices coming per vertex
     // find the offset index for all per-vertex channels
     size_t numOffsets = 1;
@@ -1758,7 +1847,8 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
     if (expectedPointCount > 0 && indices.size() != expectedPointCount * numOffsets) {
         if (pPrimType == Prim_Lines) {
             // HACK: We just fix this number since SketchUp 15.3.331 writes the wrong 'count' for 'lines'
-            ReportWarning("Expected different index count in <p> element, %zu instead of %zu.", indices.size(), expectedPointCount * numOffsets);
+            pContext.mMessages.emplace_back(false, FormatWarning("Expected different index count in <p> element, %zu instead of %zu.",
+                    indices.size(), expectedPointCount * numOffsets));
             pNumPrimitives = (indices.size() / numOffsets) / 2;
         } else {
             throw DeadlyImportError("Expected different index count in <p> element.");
@@ -1775,11 +1865,11 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
         }
 
         // find accessor
-        input.mResolved = &ResolveLibraryReference(mAccessorLibrary, input.mAccessor);
+        input.mResolved = &ResolveGeometryReference(pContext.mAccessorLibrary, mAccessorLibrary, pContext.mGlobalLookup, input.mAccessor);
         // resolve accessor's data pointer as well, if necessary
         const Accessor *acc = input.mResolved;
         if (!acc->mData) {
-            acc->mData = &ResolveLibraryReference(mDataLibrary, acc->mSource);
+            acc->mData = &ResolveGeometryReference(pContext.mDataLibrary, mDataLibrary, pContext.mGlobalLookup, acc->mSource);
         }
     }
     // and the same for the per-index channels
@@ -1799,11 +1889,11 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
         }
 
         // find accessor
-        input.mResolved = &ResolveLibraryReference(mAccessorLibrary, input.mAccessor);
+        input.mResolved = &ResolveGeometryReference(pContext.mAccessorLibrary, mAccessorLibrary, pContext.mGlobalLookup, input.mAccessor);
         // resolve accessor's data pointer as well, if necessary
         const Accessor *acc = input.mResolved;
         if (!acc->mData) {
-            acc->mData = &ResolveLibraryReference(mDataLibrary, acc->mSource);
+            acc->mData = &ResolveGeometryReference(pContext.mDataLibrary, mDataLibrary, pContext.mGlobalLookup, acc->mSource);
         }
     }
 
@@ -1832,33 +1922,33 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
         case Prim_Lines:
             numPoints = 2;
             for (size_t currentVertex = 0; currentVertex < numPoints; currentVertex++)
-                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
             break;
         case Prim_LineStrip:
             numPoints = 2;
             for (size_t currentVertex = 0; currentVertex < numPoints; currentVertex++)
-                CopyVertex(currentVertex, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+                CopyVertex(currentVertex, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
             break;
         case Prim_Triangles:
             numPoints = 3;
             for (size_t currentVertex = 0; currentVertex < numPoints; currentVertex++)
-                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
             break;
         case Prim_TriStrips:
             numPoints = 3;
-            ReadPrimTriStrips(numOffsets, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+            ReadPrimTriStrips(numOffsets, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
             break;
         case Prim_Polylist:
             numPoints = pVCount[currentPrimitive];
             for (size_t currentVertex = 0; currentVertex < numPoints; currentVertex++)
-                CopyVertex(polylistStartVertex + currentVertex, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, 0, indices);
+                CopyVertex(polylistStartVertex + currentVertex, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, 0, indices, pContext);
             polylistStartVertex += numPoints;
             break;
         case Prim_TriFans:
         case Prim_Polygon:
             numPoints = indices.size() / numOffsets;
             for (size_t currentVertex = 0; currentVertex < numPoints; currentVertex++)
-                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+                CopyVertex(currentVertex, numOffsets, numPoints, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
             break;
         default:
             // LineStrip is not supported due to expected index unmangling
@@ -1878,7 +1968,7 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
 ///For example if TEXCOORD present in both <vertices> and <polylist> tags this function will create wrong uv coordinates.
 ///It's not clear from COLLADA documentation is this allowed or not. For now only exporter fixed to avoid such behavior
 void ColladaParser::CopyVertex(size_t currentVertex, size_t numOffsets, size_t numPoints, size_t perVertexOffset, Mesh &pMesh,
-        std::vector<InputChannel> &pPerIndexChannels, size_t currentPrimitive, const std::vector<size_t> &indices) {
+        std::vector<InputChannel> &pPerIndexChannels, size_t currentPrimitive, const std::vector<size_t> &indices, GeometryContext &pContext) {
     // calculate the base offset of the vertex whose attributes we ant to copy
     size_t baseOffset = currentPrimitive * numOffsets * numPoints + currentVertex * numOffsets;
 
@@ -1887,11 +1977,11 @@ void ColladaParser::CopyVertex(size_t currentVertex, size_t numOffsets, size_t n
 
     // extract per-vertex channels using the global per-vertex offset
     for (std::vector<InputChannel>::iterator it = pMesh.mPerVertexData.begin(); it != pMesh.mPerVertexData.end(); ++it) {
-        ExtractDataObjectFromChannel(*it, indices[baseOffset + perVertexOffset], pMesh);
+        ExtractDataObjectFromChannel(*it, indices[baseOffset + perVertexOffset], pMesh, pContext);
     }
     // and extract per-index channels using there specified offset
     for (std::vector<InputChannel>::iterator it = pPerIndexChannels.begin(); it != pPerIndexChannels.end(); ++it) {
-        ExtractDataObjectFromChannel(*it, indices[baseOffset + it->mOffset], pMesh);
+        ExtractDataObjectFromChannel(*it, indices[baseOffset + it->mOffset], pMesh, pContext);
     }
 
     // store the vertex-data index for later assignment of bone vertex weights
@@ -1899,22 +1989,22 @@ void ColladaParser::CopyVertex(size_t currentVertex, size_t numOffsets, size_t n
 }
 
 void ColladaParser::ReadPrimTriStrips(size_t numOffsets, size_t perVertexOffset, Mesh &pMesh, std::vector<InputChannel> &pPerIndexChannels,
-        size_t currentPrimitive, const std::vector<size_t> &indices) {
+        size_t currentPrimitive, const std::vector<size_t> &indices, GeometryContext &pContext) {
     if (currentPrimitive % 2 != 0) {
         //odd tristrip triangles need their indices mangled, to preserve winding direction
-        CopyVertex(1, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
-        CopyVertex(0, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
-        CopyVertex(2, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+        CopyVertex(1, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
+        CopyVertex(0, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
+        CopyVertex(2, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
     } else { //for non tristrips or even tristrip triangles
-        CopyVertex(0, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
-        CopyVertex(1, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
-        CopyVertex(2, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices);
+        CopyVertex(0, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
+        CopyVertex(1, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
+        CopyVertex(2, numOffsets, 1, perVertexOffset, pMesh, pPerIndexChannels, currentPrimitive, indices, pContext);
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Extracts a single object from an input channel and stores it in the appropriate mesh data array
-void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, size_t pLocalIndex, Mesh &pMesh) {
+void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, size_t pLocalIndex, Mesh &pMesh, GeometryContext &pContext) {
     // ignore vertex referrer - we handle them that separate
     if (pInput.mType == IT_Vertex) {
         return;
@@ -1941,7 +2031,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
             if (pInput.mIndex == 0) {
                 pMesh.mPositions.push_back(aiVector3D(obj[0], obj[1], obj[2]));
             } else {
-                ASSIMP_LOG_ERROR("Collada: just one vertex position stream supported");
+                pContext.mMessages.emplace_back(true, "Collada: just one vertex position stream supported");
             }
             break;
         case IT_Normal:
@@ -1953,7 +2043,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
             if (pInput.mIndex == 0) {
                 pMesh.mNormals.push_back(aiVector3D(obj[0], obj[1], obj[2]));
             } else {
-                ASSIMP_LOG_ERROR("Collada: just one vertex normal stream supported");
+                pContext.mMessages.emplace_back(true, "Collada: just one vertex normal stream supported");
             }
             break;
         case IT_Tangent:
@@ -1965,7 +2055,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
             if (pInput.mIndex == 0) {
                 pMesh.mTangents.push_back(aiVector3D(obj[0], obj[1], obj[2]));
             } else {
-                ASSIMP_LOG_ERROR("Collada: just one vertex tangent stream supported");
+                pContext.mMessages.emplace_back(true, "Collada: just one vertex tangent stream supported");
             }
             break;
         case IT_Bitangent:
@@ -1978,7 +2068,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
             if (pInput.mIndex == 0) {
                 pMesh.mBitangents.push_back(aiVector3D(obj[0], obj[1], obj[2]));
             } else {
-                ASSIMP_LOG_ERROR("Collada: just one vertex bitangent stream supported");
+                pContext.mMessages.emplace_back(true, "Collada: just one vertex bitangent stream supported");
             }
             break;
         case IT_Texcoord:
@@ -1994,7 +2084,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
                     pMesh.mNumUVComponents[pInput.mIndex] = 3;
                 }
             } else {
-                ASSIMP_LOG_ERROR("Collada: too many texture coordinate sets. Skipping.");
+                pContext.mMessages.emplace_back(true, "Collada: too many texture coordinate sets. Skipping.");
             }
             break;
         case IT_Color:
@@ -2011,7 +2101,7 @@ void ColladaParser::ExtractDataObjectFromChannel(const InputChannel &pInput, siz
                 }
                 pMesh.mColors[pInput.mIndex].push_back(result);
             } else {
-                ASSIMP_LOG_ERROR("Collada: too many vertex color sets. Skipping.");
+                pContext.mMessages.emplace_back(true, "Collada: too many vertex color sets. Skipping.");
             }
 
             break;
@@ -2179,11 +2269,12 @@ void ColladaParser::ReadNodeTransformation(XmlNode &node, Node *pNode, Transform
     std::string value;
     XmlParser::getValueAsString(node, value);
     const char *content = value.c_str();
+    const char *end = content + value.size();
 
     // read as many parameters and store in the transformation
     for (unsigned int a = 0; a < sNumParameters[pType]; a++) {
         // read a number
-        content = fast_atoreal_move<ai_real>(content, tf.f[a]);
+        content = fast_atoreal_move<ai_real>(content, end, tf.f[a]);
         // skip whitespace after it
         SkipSpacesAndLineEnd(&content);
     }
@@ -2379,9 +2470,9 @@ aiMatrix4x4 ColladaParser::CalculateResultTransform(const std::vector<Transform>
 
 // ------------------------------------------------------------------------------------------------
 // Determines the input data type for the given semantic string
-Collada::InputType ColladaParser::GetTypeForSemantic(const std::string &semantic) {
+Collada::InputType ColladaParser::GetTypeForSemantic(const std::string &semantic, GeometryContext &pContext) {
     if (semantic.empty()) {
-        ASSIMP_LOG_WARN("Vertex input type is empty.");
+        pContext.mMessages.emplace_back(false, "Vertex input type is empty.");
         return IT_Invalid;
     }
 
@@ -2400,7 +2491,7 @@ Collada::InputType ColladaParser::GetTypeForSemantic(const std::string &semantic
     else if (semantic == "TANGENT" || semantic == "TEXTANGENT")
         return IT_Tangent;
 
-    ASSIMP_LOG_WARN_F("Unknown vertex input type \"", semantic, "\". Ignoring.");
+    pContext.mMessages.emplace_back(false, "Unknown vertex input type \"" + semantic + "\". Ignoring.");
     return IT_Invalid;
 }
 
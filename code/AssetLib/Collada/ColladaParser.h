@@ -73,6 +73,10 @@ protected:
     /** Map for generic metadata as aiString */
     typedef std::map<std::string, aiString> StringMetaData;
 
+    /** Data arrays and accessors by ID */
+    using DataLibrary = std::map<std::string, Collada::Data>;
+    using AccessorLibrary = std::map<std::string, Collada::Accessor>;
+
     /** Constructor from XML file */
     ColladaParser(IOSystem *pIOHandler, const std::string &pFile);
 
@@ -175,51 +179,60 @@ protected:
     /** Reads the geometry library contents */
     void ReadGeometryLibrary(XmlNode &node);
 
+    /** Data read for a single geometry, see below */
+    struct GeometryContext;
+
     /** Reads a geometry from the geometry library. */
-    void ReadGeometry(XmlNode &node, Collada::Mesh &pMesh);
+    void ReadGeometry(XmlNode &node, Collada::Mesh &pMesh, GeometryContext &pContext);
+
+    /** Moves the sources of a geometry into the global libraries and logs its messages */
+    void MergeGeometryContext(Collada::Mesh &pMesh, GeometryContext &pContext);
 
     /** Reads a mesh from the geometry library */
-    void ReadMesh(XmlNode &node, Collada::Mesh &pMesh);
+    void ReadMesh(XmlNode &node, Collada::Mesh &pMesh, GeometryContext &pContext);
 
     /** Reads a source element - a combination of raw data and an accessor defining
          * things that should not be redefinable. Yes, that's another rant.
          */
     void ReadSource(XmlNode &node);
+    void ReadSource(XmlNode &node, DataLibrary &pDataLibrary, AccessorLibrary &pAccessorLibrary);
 
     /** Reads a data array holding a number of elements, and stores it in the global library.
          * Currently supported are array of floats and arrays of strings.
          */
-    void ReadDataArray(XmlNode &node);
+    void ReadDataArray(XmlNode &node, DataLibrary &pDataLibrary);
 
     /** Reads an accessor and stores it in the global library under the given ID -
          * accessors use the ID of the parent <source> element
          */
-    void ReadAccessor(XmlNode &node, const std::string &pID);
+    void ReadAccessor(XmlNode &node, const std::string &pID, AccessorLibrary &pAccessorLibrary);
 
     /** Reads input declarations of per-vertex mesh data into the given mesh */
-    void ReadVertexData(XmlNode &node, Collada::Mesh &pMesh);
+    void ReadVertexData(XmlNode &node, Collada::Mesh &pMesh, GeometryContext &pContext);
 
     /** Reads input declarations of per-index mesh data into the given mesh */
-    void ReadIndexData(XmlNode &node, Collada::Mesh &pMesh);
+    void ReadIndexData(XmlNode &node, Collada::Mesh &pMesh, GeometryContext &pContext);
 
     /** Reads a single input channel element and stores it in the given array, if valid */
-    void ReadInputChannel(XmlNode &node, std::vector<Collada::InputChannel> &poChannels);
+    void ReadInputChannel(XmlNode &node, std::vector<Collada::InputChannel> &poChannels, GeometryContext &pContext);
 
     /** Reads a <p> primitive index list and assembles the mesh data into the given mesh */
     size_t ReadPrimitives(XmlNode &node, Collada::Mesh &pMesh, std::vector<Collada::InputChannel> &pPerIndexChannels,
-            size_t pNumPrimitives, const std::vector<size_t> &pVCount, Collada::PrimitiveType pPrimType);
+            size_t pNumPrimitives, const std::vector<size_t> &pVCount, Collada::PrimitiveType pPrimType, GeometryContext &pContext);
 
     /** Copies the data for a single primitive into the mesh, based on the InputChannels */
     void CopyVertex(size_t currentVertex, size_t numOffsets, size_t numPoints, size_t perVertexOffset,
             Collada::Mesh &pMesh, std::vector<Collada::InputChannel> &pPerIndexChannels,
-            size_t currentPrimitive, const std::vector<size_t> &indices);
+            size_t currentPrimitive, const std::vector<size_t> &indices, GeometryContext &pContext);
 
     /** Reads one triangle of a tristrip into the mesh */
     void ReadPrimTriStrips(size_t numOffsets, size_t perVertexOffset, Collada::Mesh &pMesh,
-            std::vector<Collada::InputChannel> &pPerIndexChannels, size_t currentPrimitive, const std::vector<size_t> &indices);
+            std::vector<Collada::InputChannel> &pPerIndexChannels, size_t currentPrimitive, const std::vector<size_t> &indices,
+            GeometryContext &pContext);
 
     /** Extracts a single object from an input channel and stores it in the appropriate mesh data array */
-    void ExtractDataObjectFromChannel(const Collada::InputChannel &pInput, size_t pLocalIndex, Collada::Mesh &pMesh);
+    void ExtractDataObjectFromChannel(const Collada::InputChannel &pInput, size_t pLocalIndex, Collada::Mesh &pMesh,
+            GeometryContext &pContext);
 
     /** Reads the library of node hierarchies and scene parts */
     void ReadSceneLibrary(XmlNode &node);
@@ -247,7 +260,7 @@ protected:
     aiMatrix4x4 CalculateResultTransform(const std::vector<Collada::Transform> &pTransforms) const;
 
     /** Determines the input data type for the given semantic string */
-    Collada::InputType GetTypeForSemantic(const std::string &pSemantic);
+    Collada::InputType GetTypeForSemantic(const std::string &pSemantic, GeometryContext &pContext);
 
     /** Finds the item in the given library by its reference, throws if not found */
     template <typename Type>
@@ -262,13 +275,25 @@ protected:
 
     /** All data arrays found in the file by ID. Might be referred to by actually
          everyone. Collada, you are a steaming pile of indirection. */
-    using DataLibrary = std::map<std::string, Collada::Data> ;
     DataLibrary mDataLibrary;
 
     /** Same for accessors which define how the data in a data array is accessed. */
-    using AccessorLibrary = std::map<std::string, Collada::Accessor> ;
     AccessorLibrary mAccessorLibrary;
 
+    /** Sources and log messages of a single geometry. Geometries are read concurrently,
+         each into its own context, and merged into the global libraries in file order. */
+    struct GeometryContext {
+        DataLibrary mDataLibrary;
+        AccessorLibrary mAccessorLibrary;
+
+        /** Messages to log after reading, the flag marks errors */
+        std::vector<std::pair<bool, std::string>> mMessages;
+
+        /** Whether references may be resolved in the global libraries. Only the
+             geometries read one after the other may look there. */
+        bool mGlobalLookup = true;
+    };
+
     /** Mesh library: mesh by ID */
     using MeshLibrary = std::map<std::string, Collada::Mesh *>;
     MeshLibrary mMeshLibrary;
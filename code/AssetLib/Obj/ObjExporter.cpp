@@ -60,50 +60,51 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
 void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/) {
-    // invoke the exporter
     ObjExporter exporter(pFile, pScene);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
+    // invoke the exporter, it streams both the main OBJ file and the material script straight into the files
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
         if (outfile == nullptr) {
             throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
         }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+        TextStreamWriter output(outfile.get());
+        exporter.WriteGeometryFile(output);
+        output.Flush();
+        if (!output.IsGood()) {
+            throw DeadlyExportError("could not write output .obj file: " + std::string(pFile));
+        }
     }
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
         if (outfile == nullptr) {
             throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
         }
-        outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+        TextStreamWriter output(outfile.get());
+        exporter.WriteMaterialFile(output);
+        output.Flush();
+        if (!output.IsGood()) {
+            throw DeadlyExportError("could not write output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
+        }
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ without the material file. Prototyped and registered in Exporter.cpp
 void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* ) {
-    // invoke the exporter
-    ObjExporter exporter(pFile, pScene, true);
+    ObjExporter exporter(pFile, pScene);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    // invoke the exporter, it streams the main OBJ file straight into the file
+    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+    if (outfile == nullptr) {
+        throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
     }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-        if (outfile == nullptr) {
-            throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-        }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    TextStreamWriter output(outfile.get());
+    exporter.WriteGeometryFile(output, true);
+    output.Flush();
+    if (!output.IsGood()) {
+        throw DeadlyExportError("could not write output .obj file: " + std::string(pFile));
     }
-
-
 }
 
 } // end of namespace Assimp
@@ -111,7 +112,7 @@ void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* p
 static const std::string MaterialExt = ".mtl";
 
 // ------------------------------------------------------------------------------------------------
-ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMtl)
+ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene)
 : filename(_filename)
 , pScene(pScene)
 , vn()
@@ -123,17 +124,7 @@ ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMt
 , mVpMap()
 , mMeshes()
 , endl("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-    mOutputMat.imbue(l);
-    mOutputMat.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
-    WriteGeometryFile(noMtl);
-    if ( !noMtl ) {
-        WriteMaterialFile();
-    }
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -165,7 +156,7 @@ std::string ObjExporter::GetMaterialLibFileName() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteHeader(std::ostringstream& out) {
+void ObjExporter::WriteHeader(TextStreamWriter& out) {
     out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
     out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.'
         << aiGetVersionRevision() << ")" << endl  << endl;
@@ -190,77 +181,77 @@ std::string ObjExporter::GetMaterialName(unsigned int index) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteMaterialFile() {
-    WriteHeader(mOutputMat);
+void ObjExporter::WriteMaterialFile(TextStreamWriter& out) {
+    WriteHeader(out);
 
     for(unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
         const aiMaterial* const mat = pScene->mMaterials[i];
 
         int illum = 1;
-        mOutputMat << "newmtl " << GetMaterialName(i)  << endl;
+        out << "newmtl " << GetMaterialName(i)  << endl;
 
         aiColor4D c;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_DIFFUSE,c)) {
-            mOutputMat << "Kd " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Kd " << c.r << " " << c.g << " " << c.b << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_AMBIENT,c)) {
-            mOutputMat << "Ka " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ka " << c.r << " " << c.g << " " << c.b << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_SPECULAR,c)) {
-            mOutputMat << "Ks " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ks " << c.r << " " << c.g << " " << c.b << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_EMISSIVE,c)) {
-            mOutputMat << "Ke " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Ke " << c.r << " " << c.g << " " << c.b << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_TRANSPARENT,c)) {
-            mOutputMat << "Tf " << c.r << " " << c.g << " " << c.b << endl;
+            out << "Tf " << c.r << " " << c.g << " " << c.b << endl;
         }
 
         ai_real o;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_OPACITY,o)) {
-            mOutputMat << "d " << o << endl;
+            out << "d " << o << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_REFRACTI,o)) {
-            mOutputMat << "Ni " << o << endl;
+            out << "Ni " << o << endl;
         }
 
         if(AI_SUCCESS == mat->Get(AI_MATKEY_SHININESS,o) && o) {
-            mOutputMat << "Ns " << o << endl;
+            out << "Ns " << o << endl;
             illum = 2;
         }
 
-        mOutputMat << "illum " << illum << endl;
+        out << "illum " << illum << endl;
 
         aiString s;
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_DIFFUSE(0),s)) {
-            mOutputMat << "map_Kd " << s.data << endl;
+            out << "map_Kd " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_AMBIENT(0),s)) {
-            mOutputMat << "map_Ka " << s.data << endl;
+            out << "map_Ka " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SPECULAR(0),s)) {
-            mOutputMat << "map_Ks " << s.data << endl;
+            out << "map_Ks " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SHININESS(0),s)) {
-            mOutputMat << "map_Ns " << s.data << endl;
+            out << "map_Ns " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_OPACITY(0),s)) {
-            mOutputMat << "map_d " << s.data << endl;
+            out << "map_d " << s.data << endl;
         }
         if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_HEIGHT(0),s) || AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_NORMALS(0),s)) {
             // implementations seem to vary here, so write both variants
-            mOutputMat << "bump " << s.data << endl;
-            mOutputMat << "map_bump " << s.data << endl;
+            out << "bump " << s.data << endl;
+            out << "map_bump " << s.data << endl;
         }
 
-        mOutputMat << endl;
+        out << endl;
     }
 }
 
-void ObjExporter::WriteGeometryFile(bool noMtl) {
-    WriteHeader(mOutput);
+void ObjExporter::WriteGeometryFile(TextStreamWriter& out, bool noMtl) {
+    WriteHeader(out);
     if (!noMtl)
-        mOutput << "mtllib "  << GetMaterialLibName() << endl << endl;
+        out << "mtllib "  << GetMaterialLibName() << endl << endl;
 
     // collect mesh geometry
     aiMatrix4x4 mBase;
@@ -269,65 +260,65 @@ void ObjExporter::WriteGeometryFile(bool noMtl) {
     // write vertex positions with colors, if any
     mVpMap.getKeys( vp );
     if ( !useVc ) {
-        mOutput << "# " << vp.size() << " vertex positions" << endl;
+        out << "# " << vp.size() << " vertex positions" << endl;
         for ( const vertexData& v : vp ) {
-            mOutput << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << endl;
+            out << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << endl;
         }
     } else {
-        mOutput << "# " << vp.size() << " vertex positions and colors" << endl;
+        out << "# " << vp.size() << " vertex positions and colors" << endl;
         for ( const vertexData& v : vp ) {
-            mOutput << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << " " << v.vc.r << " " << v.vc.g << " " << v.vc.b << endl;
+            out << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << " " << v.vc.r << " " << v.vc.g << " " << v.vc.b << endl;
         }
     }
-    mOutput << endl;
+    out << endl;
 
     // write uv coordinates
     mVtMap.getKeys(vt);
-    mOutput << "# " << vt.size() << " UV coordinates" << endl;
+    out << "# " << vt.size() << " UV coordinates" << endl;
     for(const aiVector3D& v : vt) {
-        mOutput << "vt " << v.x << " " << v.y << " " << v.z << endl;
+        out << "vt " << v.x << " " << v.y << " " << v.z << endl;
     }
-    mOutput << endl;
+    out << endl;
 
     // write vertex normals
     mVnMap.getKeys(vn);
-    mOutput << "# " << vn.size() << " vertex normals" << endl;
+    out << "# " << vn.size() << " vertex normals" << endl;
     for(const aiVector3D& v : vn) {
-        mOutput << "vn " << v.x << " " << v.y << " " << v.z << endl;
+        out << "vn " << v.x << " " << v.y << " " << v.z << endl;
     }
-    mOutput << endl;
+    out << endl;
 
     // now write all mesh instances
     for(const MeshInstance& m : mMeshes) {
-        mOutput << "# Mesh \'" << m.name << "\' with " << m.faces.size() << " faces" << endl;
+        out << "# Mesh \'" << m.name << "\' with " << m.faces.size() << " faces" << endl;
         if (!m.name.empty()) {
-            mOutput << "g " << m.name << endl;
+            out << "g " << m.name << endl;
         }
         if ( !noMtl ) {
-            mOutput << "usemtl " << m.matname << endl;
+            out << "usemtl " << m.matname << endl;
         }
 
         for(const Face& f : m.faces) {
-            mOutput << f.kind << ' ';
+            out << f.kind << ' ';
             for(const FaceVertex& fv : f.indices) {
-                mOutput << ' ' << fv.vp;
+                out << ' ' << fv.vp;
 
                 if (f.kind != 'p') {
                     if (fv.vt || f.kind == 'f') {
-                        mOutput << '/';
+                        out << '/';
                     }
                     if (fv.vt) {
-                        mOutput << fv.vt;
+                        out << fv.vt;
                     }
                     if (f.kind == 'f' && fv.vn) {
-                        mOutput << '/' << fv.vn;
+                        out << '/' << fv.vn;
                     }
                 }
             }
 
-            mOutput << endl;
+            out << endl;
         }
-        mOutput << endl;
+        out << endl;
     }
 }
 
@@ -47,7 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_OBJEXPORTER_H_INC
 
 #include <assimp/types.h>
-#include <sstream>
+#include "Common/TextStreamWriter.h"
+
+#include <string>
 #include <vector>
 #include <map>
 
@@ -63,13 +65,15 @@ namespace Assimp {
 class ObjExporter {
 public:
     /// Constructor for a specific scene to export
-    ObjExporter(const char* filename, const aiScene* pScene, bool noMtl=false);
+    ObjExporter(const char* filename, const aiScene* pScene);
     ~ObjExporter();
     std::string GetMaterialLibName();
     std::string GetMaterialLibFileName();
-    
-    /// public string-streams to write all output into
-    std::ostringstream mOutput, mOutputMat;
+
+    /// Streams the main OBJ file, must be called once only
+    void WriteGeometryFile(TextStreamWriter& out, bool noMtl=false);
+    /// Streams the material script
+    void WriteMaterialFile(TextStreamWriter& out);
 
 private:
     // intermediate data structures
@@ -95,9 +99,7 @@ private:
         std::vector<Face> faces;
     };
 
-    void WriteHeader(std::ostringstream& out);
-    void WriteMaterialFile();
-    void WriteGeometryFile(bool noMtl=false);
+    void WriteHeader(TextStreamWriter& out);
     std::string GetMaterialName(unsigned int index);
     void AddMesh(const aiString& name, const aiMesh* m, const aiMatrix4x4& mat);
     void AddNode(const aiNode* nd, const aiMatrix4x4& mParent);
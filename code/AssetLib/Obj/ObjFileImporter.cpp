@@ -77,7 +77,8 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
         m_Buffer(),
         m_pRootObject(nullptr),
-        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {}
+        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())),
+        m_contiguousIndices(false) {}
 
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
@@ -104,6 +105,11 @@ const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    m_contiguousIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Obj-file import implementation
 void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, IOSystem *pIOHandler) {
@@ -370,14 +376,12 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
                 for (size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 2;
-                    f.mIndices = new unsigned int[2];
                 }
                 continue;
             } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
                 for (size_t i = 0; i < inp->m_vertices.size(); ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 1;
-                    f.mIndices = new unsigned int[1];
                 }
                 continue;
             }
@@ -385,10 +389,8 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
             aiFace *pFace = &pMesh->mFaces[outIndex++];
             const unsigned int uiNumIndices = (unsigned int)face->m_vertices.size();
             uiIdxCount += pFace->mNumIndices = (unsigned int)uiNumIndices;
-            if (pFace->mNumIndices > 0) {
-                pFace->mIndices = new unsigned int[uiNumIndices];
-            }
         }
+        pMesh->AllocateFaceIndices(m_contiguousIndices);
     }
 
     // Create mesh vertices
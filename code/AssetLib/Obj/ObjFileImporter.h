@@ -76,6 +76,9 @@ private:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const;
 
+    //! \brief  Reads the loader configuration.
+    void SetupProperties(const Importer *pImp);
+
     //! \brief  File import implementation.
     void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler);
 
@@ -113,6 +116,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Store the face indices in one buffer, see aiMesh::mIndices
+    bool m_contiguousIndices;
 };
 
 // ------------------------------------------------------------------------------------------------
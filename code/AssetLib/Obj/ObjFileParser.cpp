@@ -228,7 +228,7 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     }
 }
 
-void ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
+size_t ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
     size_t index = 0;
     m_DataIt = getNextWord<DataArrayIt>(m_DataIt, m_DataItEnd);
     if (*m_DataIt == '\\') {
@@ -247,6 +247,14 @@ void ObjFileParser::copyNextWord(char *pBuffer, size_t length) {
 
     ai_assert(index < length);
     pBuffer[index] = '\0';
+    return index;
+}
+
+ai_real ObjFileParser::getNextReal() {
+    const size_t length = copyNextWord(m_buffer, Buffersize);
+    ai_real value;
+    fast_atoreal_move<ai_real>(m_buffer, m_buffer + length, value);
+    return value;
 }
 
 static bool isDataDefinitionEnd(const char *tmp) {
@@ -294,21 +302,13 @@ size_t ObjFileParser::getTexCoordVector(std::vector<aiVector3D> &point3d_array)
     size_t numComponents = getNumComponentsInDataDefinition();
     ai_real x, y, z;
     if (2 == numComponents) {
-        copyNextWord(m_buffer, Buffersize);
-        x = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        y = (ai_real)fast_atof(m_buffer);
+        x = getNextReal();
+        y = getNextReal();
         z = 0.0;
     } else if (3 == numComponents) {
-        copyNextWord(m_buffer, Buffersize);
-        x = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        y = (ai_real)fast_atof(m_buffer);
-
-        copyNextWord(m_buffer, Buffersize);
-        z = (ai_real)fast_atof(m_buffer);
+        x = getNextReal();
+        y = getNextReal();
+        z = getNextReal();
     } else {
         throw DeadlyImportError("OBJ: Invalid number of components");
     }
@@ -330,14 +330,9 @@ size_t ObjFileParser::getTexCoordVector(std::vector<aiVector3D> &point3d_array)
 
 void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array) {
     ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
+    x = getNextReal();
+    y = getNextReal();
+    z = getNextReal();
 
     point3d_array.emplace_back(x, y, z);
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
@@ -345,17 +340,10 @@ void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array) {
 
 void ObjFileParser::getHomogeneousVector3(std::vector<aiVector3D> &point3d_array) {
     ai_real x, y, z, w;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    w = (ai_real)fast_atof(m_buffer);
+    x = getNextReal();
+    y = getNextReal();
+    z = getNextReal();
+    w = getNextReal();
 
     if (w == 0)
         throw DeadlyImportError("OBJ: Invalid component in homogeneous vector (Division by zero)");
@@ -366,25 +354,15 @@ void ObjFileParser::getHomogeneousVector3(std::vector<aiVector3D> &point3d_array
 
 void ObjFileParser::getTwoVectors3(std::vector<aiVector3D> &point3d_array_a, std::vector<aiVector3D> &point3d_array_b) {
     ai_real x, y, z;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
+    x = getNextReal();
+    y = getNextReal();
+    z = getNextReal();
 
     point3d_array_a.emplace_back(x, y, z);
 
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    z = (ai_real)fast_atof(m_buffer);
+    x = getNextReal();
+    y = getNextReal();
+    z = getNextReal();
 
     point3d_array_b.emplace_back(x, y, z);
 
@@ -393,11 +371,8 @@ void ObjFileParser::getTwoVectors3(std::vector<aiVector3D> &point3d_array_a, std
 
 void ObjFileParser::getVector2(std::vector<aiVector2D> &point2d_array) {
     ai_real x, y;
-    copyNextWord(m_buffer, Buffersize);
-    x = (ai_real)fast_atof(m_buffer);
-
-    copyNextWord(m_buffer, Buffersize);
-    y = (ai_real)fast_atof(m_buffer);
+    x = getNextReal();
+    y = getNextReal();
 
     point2d_array.emplace_back(x, y);
 
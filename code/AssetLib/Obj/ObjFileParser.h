@@ -91,8 +91,10 @@ public:
 protected:
     /// Parse the loaded file
     void parseFile(IOStreamBuffer<char> &streamBuffer);
-    /// Method to copy the new delimited word in the current line.
-    void copyNextWord(char *pBuffer, size_t length);
+    /// Method to copy the new delimited word in the current line, returns its length.
+    size_t copyNextWord(char *pBuffer, size_t length);
+    /// Method to parse the next word in the current line as a real number.
+    ai_real getNextReal();
     /// Method to copy the new line.
     //    void copyNextLine(char *pBuffer, size_t length);
     /// Get the number of components in a line.
@@ -68,34 +68,34 @@ template<> const char* type_of(double&) { return "double"; }
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it streams straight into the file
+    PlyExporter exporter(pFile, outfile.get(), pScene);
+
+    exporter.mOutput.Flush();
+    if (!exporter.mOutput.IsGood()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene, true);
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile(pIOSystem->Open(pFile, "wb"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write(exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()), 1);
+    // invoke the exporter, it streams straight into the file
+    PlyExporter exporter(pFile, outfile.get(), pScene, true);
+
+    exporter.mOutput.Flush();
+    if (!exporter.mOutput.IsGood()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 #define PLY_EXPORT_HAS_NORMALS 0x1
@@ -104,15 +104,11 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+PlyExporter::PlyExporter(const char* _filename, IOStream* pStream, const aiScene* pScene, bool binary)
+: mOutput(pStream)
+, filename(_filename)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
     unsigned int faces = 0u, vertices = 0u, components = 0u;
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
         const aiMesh& m = *pScene->mMeshes[i];
@@ -327,42 +323,42 @@ void PlyExporter::WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
     aiVector2D defaultUV(-1, -1);
     aiColor4D defaultColor(-1, -1, -1, -1);
     for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-        mOutput.write(reinterpret_cast<const char*>(&m->mVertices[i].x), 12);
+        mOutput.Write(&m->mVertices[i].x, 12);
         if (components & PLY_EXPORT_HAS_NORMALS) {
             if (m->HasNormals()) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mNormals[i].x), 12);
+                mOutput.Write(&m->mNormals[i].x, 12);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+                mOutput.Write(&defaultNormal.x, 12);
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
             if (m->HasTextureCoords(c)) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mTextureCoords[c][i].x), 8);
+                mOutput.Write(&m->mTextureCoords[c][i].x, 8);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultUV.x), 8);
+                mOutput.Write(&defaultUV.x, 8);
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
             if (m->HasVertexColors(c)) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mColors[c][i].r), 16);
+                mOutput.Write(&m->mColors[c][i].r, 16);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultColor.r), 16);
+                mOutput.Write(&defaultColor.r, 16);
             }
         }
 
         if (components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
             if (m->HasTangentsAndBitangents()) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mTangents[i].x), 12);
-                mOutput.write(reinterpret_cast<const char*>(&m->mBitangents[i].x), 12);
+                mOutput.Write(&m->mTangents[i].x, 12);
+                mOutput.Write(&m->mBitangents[i].x, 12);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+                mOutput.Write(&defaultNormal.x, 12);
+                mOutput.Write(&defaultNormal.x, 12);
             }
         }
     }
@@ -383,15 +379,15 @@ void PlyExporter::WriteMeshIndices(const aiMesh* m, unsigned int offset)
 
 // Generic method in case we want to use different data types for the indices or make this configurable.
 template<typename NumIndicesType, typename IndexType>
-void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, std::ostringstream& output)
+void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, TextStreamWriter& output)
 {
     for (unsigned int i = 0; i < m->mNumFaces; ++i) {
         const aiFace& f = m->mFaces[i];
         NumIndicesType numIndices = static_cast<NumIndicesType>(f.mNumIndices);
-        output.write(reinterpret_cast<const char*>(&numIndices), sizeof(NumIndicesType));
+        output.Write(&numIndices, sizeof(NumIndicesType));
         for (unsigned int c = 0; c < f.mNumIndices; ++c) {
             IndexType index = f.mIndices[c] + offset;
-            output.write(reinterpret_cast<const char*>(&index), sizeof(IndexType));
+            output.Write(&index, sizeof(IndexType));
         }
     }
 }
@@ -47,10 +47,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include <assimp/ByteSwapper.h>
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
 
 using namespace ::Assimp;
@@ -81,6 +86,116 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 
     return props[idx];
 }
+
+// ------------------------------------------------------------------------------------------------
+// Mapping applied to decoded binary values: (value + offset) / divisor + bias
+struct ValueMapping {
+    ai_real offset;
+    ai_real divisor;
+    ai_real bias;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Same normalization as PLYImporter::NormalizeColorValue, expressed as a mapping
+ValueMapping GetColorMapping(PLY::EDataType eType) {
+    const ValueMapping mappings[] = {
+        { (ai_real)(0xFF / 2), (ai_real)0xFF, 0.0f }, // EDT_Char
+        { 0.0f, (ai_real)0xFF, 0.0f }, // EDT_UChar
+        { (ai_real)(0xFFFF / 2), (ai_real)0xFFFF, 0.0f }, // EDT_Short
+        { 0.0f, (ai_real)0xFFFF, 0.0f }, // EDT_UShort
+        { 0.0f, (ai_real)0xFF, 0.5f }, // EDT_Int
+        { 0.0f, (ai_real)0xFFFF, 0.0f }, // EDT_UInt
+        { 0.0f, 1.0f, 0.0f }, // EDT_Float
+        { 0.0f, 1.0f, 0.0f } // EDT_Double
+    };
+    if (eType >= EDT_INVALID) {
+        const ValueMapping zero = { 0.0f, 1.0f, 0.0f };
+        return zero;
+    }
+    return mappings[eType];
+}
+
+inline int8_t SwapValue(int8_t value) {
+    return value;
+}
+
+inline uint8_t SwapValue(uint8_t value) {
+    return value;
+}
+
+template <typename T>
+inline T SwapValue(T value) {
+    return ByteSwap::Swapped(value);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decodes one property of count fixed-size records into every outStride-th real of out.
+// Kept free of branches so the compiler can vectorize the conversion.
+template <typename T, bool Swap>
+void DecodeColumn(const char *data, unsigned int stride, unsigned int count,
+        const ValueMapping &mapping, ai_real *out, unsigned int outStride) {
+    const ai_real offset = mapping.offset, divisor = mapping.divisor, bias = mapping.bias;
+    for (unsigned int i = 0; i < count; ++i) {
+        T value;
+        ::memcpy(&value, data + static_cast<size_t>(i) * stride, sizeof(T));
+        if (Swap) {
+            value = SwapValue(value);
+        }
+        out[static_cast<size_t>(i) * outStride] = ((ai_real)value + offset) / divisor + bias;
+    }
+}
+
+template <bool Swap>
+void DecodeColumn(PLY::EDataType eType, const char *data, unsigned int stride, unsigned int count,
+        const ValueMapping &mapping, ai_real *out, unsigned int outStride) {
+    switch (eType) {
+    case EDT_Char:
+        DecodeColumn<int8_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_UChar:
+        DecodeColumn<uint8_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_Short:
+        DecodeColumn<int16_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_UShort:
+        DecodeColumn<uint16_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_Int:
+        DecodeColumn<int32_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_UInt:
+        DecodeColumn<uint32_t, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_Float:
+        DecodeColumn<float, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    case EDT_Double:
+        DecodeColumn<double, Swap>(data, stride, count, mapping, out, outStride);
+        break;
+    default:
+        break;
+    }
+}
+
+void DecodeColumn(PLY::EDataType eType, bool bigEndian, const char *data, unsigned int stride, unsigned int count,
+        const ValueMapping &mapping, ai_real *out, unsigned int outStride) {
+    if (bigEndian) {
+        DecodeColumn<true>(eType, data, stride, count, mapping, out, outStride);
+    } else {
+        DecodeColumn<false>(eType, data, stride, count, mapping, out, outStride);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads a scalar property as real, missing properties yield zero
+inline ai_real GetReal(const std::vector<PLY::PropertyInstance> &props, unsigned int idx, PLY::EDataType eType) {
+    if (0xFFFFFFFF == idx) {
+        return 0.0f;
+    }
+
+    return PLY::PropertyInstance::ConvertTo<ai_real>(GetProperty(props, idx).avList.front(), eType);
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -88,7 +203,8 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mContiguousIndices(false) {
     // empty
 }
 
@@ -120,6 +236,11 @@ bool PLYImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::SetupProperties(const Importer *pImp) {
+    mContiguousIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *PLYImporter::GetInfo() const {
     return &desc;
@@ -186,6 +307,12 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     PLY::DOM sPlyDom;
     this->pcDOM = &sPlyDom;
 
+    // layouts are resolved per element of this file
+    mVertexLayout = VertexLayout();
+    mFaceLayout = FaceLayout();
+    mFaceIndices.clear();
+    mFaceOffsets.clear();
+
     if (TokenMatch(szMe, "format", 6)) {
         if (TokenMatch(szMe, "ascii", 5)) {
             SkipLine(szMe, (const char **)&szMe);
@@ -238,6 +365,7 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     if (mGeneratedMesh == nullptr) {
         throw DeadlyImportError("Invalid .ply file: Unable to extract mesh data ");
     }
+    FinishFaceIndices();
 
     // if no face list is existing we assume that the vertex
     // list is containing a list of points
@@ -274,211 +402,231 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     }
 }
 
-void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos) {
+// Resolve which property of the vertex element feeds which vertex component
+void PLYImporter::SetupVertexLayout(const PLY::Element *pcElement) {
     ai_assert(nullptr != pcElement);
-    ai_assert(nullptr != instElement);
-
-    ai_uint aiPositions[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiTypes[3] = { EDT_Char, EDT_Char, EDT_Char };
-
-    ai_uint aiNormal[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiNormalTypes[3] = { EDT_Char, EDT_Char, EDT_Char };
 
-    unsigned int aiColors[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiColorsTypes[4] = { EDT_Char, EDT_Char, EDT_Char, EDT_Char };
+    mVertexLayout = VertexLayout();
+    mVertexLayout.mElement = pcElement;
+    mVertexLayout.mStride = pcElement->GetBinaryStride();
 
-    unsigned int aiTexcoord[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
-    PLY::EDataType aiTexcoordTypes[2] = { EDT_Char, EDT_Char };
-
-    // now check whether which normal components are available
-    unsigned int _a(0), cnt(0);
+    unsigned int _a = 0, offset = 0;
     for (std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
             a != pcElement->alProperties.end(); ++a, ++_a) {
+        const unsigned int propOffset = offset;
+        offset += PLY::PropertyInstance::GetBinarySize((*a).eType);
         if ((*a).bIsList) {
             continue;
         }
 
-        // Positions
-        if (PLY::EST_XCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[0] = _a;
-            aiTypes[0] = (*a).eType;
-        } else if (PLY::EST_YCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[1] = _a;
-            aiTypes[1] = (*a).eType;
-        } else if (PLY::EST_ZCoord == (*a).Semantic) {
-            ++cnt;
-            aiPositions[2] = _a;
-            aiTypes[2] = (*a).eType;
-        } else if (PLY::EST_XNormal == (*a).Semantic) {
-            // Normals
-            ++cnt;
-            aiNormal[0] = _a;
-            aiNormalTypes[0] = (*a).eType;
-        } else if (PLY::EST_YNormal == (*a).Semantic) {
-            ++cnt;
-            aiNormal[1] = _a;
-            aiNormalTypes[1] = (*a).eType;
-        } else if (PLY::EST_ZNormal == (*a).Semantic) {
-            ++cnt;
-            aiNormal[2] = _a;
-            aiNormalTypes[2] = (*a).eType;
-        } else if (PLY::EST_Red == (*a).Semantic) {
-            // Colors
-            ++cnt;
-            aiColors[0] = _a;
-            aiColorsTypes[0] = (*a).eType;
-        } else if (PLY::EST_Green == (*a).Semantic) {
-            ++cnt;
-            aiColors[1] = _a;
-            aiColorsTypes[1] = (*a).eType;
-        } else if (PLY::EST_Blue == (*a).Semantic) {
-            ++cnt;
-            aiColors[2] = _a;
-            aiColorsTypes[2] = (*a).eType;
-        } else if (PLY::EST_Alpha == (*a).Semantic) {
-            ++cnt;
-            aiColors[3] = _a;
-            aiColorsTypes[3] = (*a).eType;
-        } else if (PLY::EST_UTextureCoord == (*a).Semantic) {
-            // Texture coordinates
-            ++cnt;
-            aiTexcoord[0] = _a;
-            aiTexcoordTypes[0] = (*a).eType;
-        } else if (PLY::EST_VTextureCoord == (*a).Semantic) {
-            ++cnt;
-            aiTexcoord[1] = _a;
-            aiTexcoordTypes[1] = (*a).eType;
+        PropertySlot *slot = nullptr;
+        switch ((*a).Semantic) {
+        case PLY::EST_XCoord:
+            slot = &mVertexLayout.mPositions[0];
+            break;
+        case PLY::EST_YCoord:
+            slot = &mVertexLayout.mPositions[1];
+            break;
+        case PLY::EST_ZCoord:
+            slot = &mVertexLayout.mPositions[2];
+            break;
+        case PLY::EST_XNormal:
+            slot = &mVertexLayout.mNormals[0];
+            break;
+        case PLY::EST_YNormal:
+            slot = &mVertexLayout.mNormals[1];
+            break;
+        case PLY::EST_ZNormal:
+            slot = &mVertexLayout.mNormals[2];
+            break;
+        case PLY::EST_Red:
+            slot = &mVertexLayout.mColors[0];
+            break;
+        case PLY::EST_Green:
+            slot = &mVertexLayout.mColors[1];
+            break;
+        case PLY::EST_Blue:
+            slot = &mVertexLayout.mColors[2];
+            break;
+        case PLY::EST_Alpha:
+            slot = &mVertexLayout.mColors[3];
+            break;
+        case PLY::EST_UTextureCoord:
+            slot = &mVertexLayout.mTexCoords[0];
+            break;
+        case PLY::EST_VTextureCoord:
+            slot = &mVertexLayout.mTexCoords[1];
+            break;
+        default:
+            break;
+        }
+
+        if (nullptr != slot) {
+            slot->mIndex = _a;
+            slot->mType = (*a).eType;
+            slot->mOffset = propOffset;
+            mVertexLayout.mValid = true;
         }
     }
 
     // check whether we have a valid source for the vertex data
-    if (0 != cnt) {
-        // Position
-        aiVector3D vOut;
-        if (0xFFFFFFFF != aiPositions[0]) {
-            vOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiPositions[0]).avList.front(), aiTypes[0]);
-        }
+    if (!mVertexLayout.mValid) {
+        return;
+    }
 
-        if (0xFFFFFFFF != aiPositions[1]) {
-            vOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiPositions[1]).avList.front(), aiTypes[1]);
-        }
+    mVertexLayout.mHasNormals = mVertexLayout.mNormals[0].IsValid() ||
+                                mVertexLayout.mNormals[1].IsValid() ||
+                                mVertexLayout.mNormals[2].IsValid();
+    mVertexLayout.mHasColors = mVertexLayout.mColors[0].IsValid() ||
+                               mVertexLayout.mColors[1].IsValid() ||
+                               mVertexLayout.mColors[2].IsValid() ||
+                               mVertexLayout.mColors[3].IsValid();
+    mVertexLayout.mHasTexCoords = mVertexLayout.mTexCoords[0].IsValid() ||
+                                  mVertexLayout.mTexCoords[1].IsValid();
+
+    // create the aiMesh and all output arrays up front, vertices are
+    // decoded straight into them
+    if (nullptr == mGeneratedMesh) {
+        mGeneratedMesh = new aiMesh();
+        mGeneratedMesh->mMaterialIndex = 0;
+    }
 
-        if (0xFFFFFFFF != aiPositions[2]) {
-            vOut.z = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiPositions[2]).avList.front(), aiTypes[2]);
-        }
+    if (nullptr == mGeneratedMesh->mVertices) {
+        mGeneratedMesh->mNumVertices = pcElement->NumOccur;
+        mGeneratedMesh->mVertices = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
 
-        // Normals
-        aiVector3D nOut;
-        bool haveNormal = false;
-        if (0xFFFFFFFF != aiNormal[0]) {
-            nOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiNormal[0]).avList.front(), aiNormalTypes[0]);
-            haveNormal = true;
-        }
+    if (mVertexLayout.mHasNormals && nullptr == mGeneratedMesh->mNormals) {
+        mGeneratedMesh->mNormals = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
 
-        if (0xFFFFFFFF != aiNormal[1]) {
-            nOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiNormal[1]).avList.front(), aiNormalTypes[1]);
-            haveNormal = true;
-        }
+    if (mVertexLayout.mHasColors && nullptr == mGeneratedMesh->mColors[0]) {
+        mGeneratedMesh->mColors[0] = new aiColor4D[mGeneratedMesh->mNumVertices];
+    }
 
-        if (0xFFFFFFFF != aiNormal[2]) {
-            nOut.z = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiNormal[2]).avList.front(), aiNormalTypes[2]);
-            haveNormal = true;
-        }
+    if (mVertexLayout.mHasTexCoords && nullptr == mGeneratedMesh->mTextureCoords[0]) {
+        mGeneratedMesh->mNumUVComponents[0] = 2;
+        mGeneratedMesh->mTextureCoords[0] = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+}
 
-        //Colors
-        aiColor4D cOut;
-        bool haveColor = false;
-        if (0xFFFFFFFF != aiColors[0]) {
-            cOut.r = NormalizeColorValue(GetProperty(instElement->alProperties,
-                                                 aiColors[0])
-                                                 .avList.front(),
-                    aiColorsTypes[0]);
-            haveColor = true;
-        }
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != instElement);
 
-        if (0xFFFFFFFF != aiColors[1]) {
-            cOut.g = NormalizeColorValue(GetProperty(instElement->alProperties,
-                                                 aiColors[1])
-                                                 .avList.front(),
-                    aiColorsTypes[1]);
-            haveColor = true;
-        }
+    if (mVertexLayout.mElement != pcElement) {
+        SetupVertexLayout(pcElement);
+    }
 
-        if (0xFFFFFFFF != aiColors[2]) {
-            cOut.b = NormalizeColorValue(GetProperty(instElement->alProperties,
-                                                 aiColors[2])
-                                                 .avList.front(),
-                    aiColorsTypes[2]);
-            haveColor = true;
-        }
+    if (!mVertexLayout.mValid || pos >= mGeneratedMesh->mNumVertices) {
+        return;
+    }
 
-        // assume 1.0 for the alpha channel if it is not set
-        if (0xFFFFFFFF == aiColors[3]) {
-            cOut.a = 1.0;
-        } else {
-            cOut.a = NormalizeColorValue(GetProperty(instElement->alProperties,
-                                                 aiColors[3])
-                                                 .avList.front(),
-                    aiColorsTypes[3]);
+    const std::vector<PLY::PropertyInstance> &props = instElement->alProperties;
+
+    // Position
+    aiVector3D &vOut = mGeneratedMesh->mVertices[pos];
+    vOut.x = GetReal(props, mVertexLayout.mPositions[0].mIndex, mVertexLayout.mPositions[0].mType);
+    vOut.y = GetReal(props, mVertexLayout.mPositions[1].mIndex, mVertexLayout.mPositions[1].mType);
+    vOut.z = GetReal(props, mVertexLayout.mPositions[2].mIndex, mVertexLayout.mPositions[2].mType);
 
-            haveColor = true;
+    // Normals
+    if (mVertexLayout.mHasNormals) {
+        aiVector3D &nOut = mGeneratedMesh->mNormals[pos];
+        nOut.x = GetReal(props, mVertexLayout.mNormals[0].mIndex, mVertexLayout.mNormals[0].mType);
+        nOut.y = GetReal(props, mVertexLayout.mNormals[1].mIndex, mVertexLayout.mNormals[1].mType);
+        nOut.z = GetReal(props, mVertexLayout.mNormals[2].mIndex, mVertexLayout.mNormals[2].mType);
+    }
+
+    //Colors
+    if (mVertexLayout.mHasColors) {
+        aiColor4D &cOut = mGeneratedMesh->mColors[0][pos];
+        for (unsigned int c = 0; c < 4; ++c) {
+            const PropertySlot &slot = mVertexLayout.mColors[c];
+
+            // assume 1.0 for the alpha channel if it is not set
+            ai_real value = (3 == c) ? 1.0f : 0.0f;
+            if (slot.IsValid()) {
+                value = NormalizeColorValue(GetProperty(props, slot.mIndex).avList.front(), slot.mType);
+            }
+            cOut[c] = value;
         }
+    }
 
-        //Texture coordinates
-        aiVector3D tOut;
+    //Texture coordinates
+    if (mVertexLayout.mHasTexCoords) {
+        aiVector3D &tOut = mGeneratedMesh->mTextureCoords[0][pos];
+        tOut.x = GetReal(props, mVertexLayout.mTexCoords[0].mIndex, mVertexLayout.mTexCoords[0].mType);
+        tOut.y = GetReal(props, mVertexLayout.mTexCoords[1].mIndex, mVertexLayout.mTexCoords[1].mType);
         tOut.z = 0;
-        bool haveTextureCoords = false;
-        if (0xFFFFFFFF != aiTexcoord[0]) {
-            tOut.x = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiTexcoord[0]).avList.front(), aiTexcoordTypes[0]);
-            haveTextureCoords = true;
-        }
+    }
+}
 
-        if (0xFFFFFFFF != aiTexcoord[1]) {
-            tOut.y = PLY::PropertyInstance::ConvertTo<ai_real>(
-                    GetProperty(instElement->alProperties, aiTexcoord[1]).avList.front(), aiTexcoordTypes[1]);
-            haveTextureCoords = true;
-        }
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::LoadVertexBlock(const PLY::Element *pcElement, const char *data, unsigned int stride,
+        unsigned int first, unsigned int count, bool bigEndian) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != data);
 
-        //create aiMesh if needed
-        if (nullptr == mGeneratedMesh) {
-            mGeneratedMesh = new aiMesh();
-            mGeneratedMesh->mMaterialIndex = 0;
-        }
+    if (mVertexLayout.mElement != pcElement) {
+        SetupVertexLayout(pcElement);
+    }
 
-        if (nullptr == mGeneratedMesh->mVertices) {
-            mGeneratedMesh->mNumVertices = pcElement->NumOccur;
-            mGeneratedMesh->mVertices = new aiVector3D[mGeneratedMesh->mNumVertices];
+    if (!mVertexLayout.mValid || first >= mGeneratedMesh->mNumVertices) {
+        return;
+    }
+    ai_assert(stride == mVertexLayout.mStride);
+
+    count = std::min(count, mGeneratedMesh->mNumVertices - first);
+
+    // each component is decoded as one strided column of the block
+    const ValueMapping identity = { 0.0f, 1.0f, 0.0f };
+    const unsigned int vecStride = sizeof(aiVector3D) / sizeof(ai_real);
+    for (unsigned int c = 0; c < 3; ++c) {
+        const PropertySlot &slot = mVertexLayout.mPositions[c];
+        if (slot.IsValid()) {
+            DecodeColumn(slot.mType, bigEndian, data + slot.mOffset, stride, count, identity,
+                    &mGeneratedMesh->mVertices[first].x + c, vecStride);
         }
+    }
 
-        mGeneratedMesh->mVertices[pos] = vOut;
+    if (mVertexLayout.mHasNormals) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const PropertySlot &slot = mVertexLayout.mNormals[c];
+            if (slot.IsValid()) {
+                DecodeColumn(slot.mType, bigEndian, data + slot.mOffset, stride, count, identity,
+                        &mGeneratedMesh->mNormals[first].x + c, vecStride);
+            }
+        }
+    }
 
-        if (haveNormal) {
-            if (nullptr == mGeneratedMesh->mNormals)
-                mGeneratedMesh->mNormals = new aiVector3D[mGeneratedMesh->mNumVertices];
-            mGeneratedMesh->mNormals[pos] = nOut;
+    if (mVertexLayout.mHasColors) {
+        aiColor4D *colors = &mGeneratedMesh->mColors[0][first];
+        const unsigned int colorStride = sizeof(aiColor4D) / sizeof(ai_real);
+        for (unsigned int c = 0; c < 4; ++c) {
+            const PropertySlot &slot = mVertexLayout.mColors[c];
+            if (slot.IsValid()) {
+                DecodeColumn(slot.mType, bigEndian, data + slot.mOffset, stride, count, GetColorMapping(slot.mType),
+                        &colors->r + c, colorStride);
+            }
         }
 
-        if (haveColor) {
-            if (nullptr == mGeneratedMesh->mColors[0])
-                mGeneratedMesh->mColors[0] = new aiColor4D[mGeneratedMesh->mNumVertices];
-            mGeneratedMesh->mColors[0][pos] = cOut;
+        // assume 1.0 for the alpha channel if it is not set
+        if (!mVertexLayout.mColors[3].IsValid()) {
+            for (unsigned int i = 0; i < count; ++i) {
+                colors[i].a = 1.0f;
+            }
         }
+    }
 
-        if (haveTextureCoords) {
-            if (nullptr == mGeneratedMesh->mTextureCoords[0]) {
-                mGeneratedMesh->mNumUVComponents[0] = 2;
-                mGeneratedMesh->mTextureCoords[0] = new aiVector3D[mGeneratedMesh->mNumVertices];
+    if (mVertexLayout.mHasTexCoords) {
+        for (unsigned int c = 0; c < 2; ++c) {
+            const PropertySlot &slot = mVertexLayout.mTexCoords[c];
+            if (slot.IsValid()) {
+                DecodeColumn(slot.mType, bigEndian, data + slot.mOffset, stride, count, identity,
+                        &mGeneratedMesh->mTextureCoords[0][first].x + c, vecStride);
             }
-            mGeneratedMesh->mTextureCoords[0][pos] = tOut;
         }
     }
 }
@@ -511,53 +659,33 @@ ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val,
 }
 
 // ------------------------------------------------------------------------------------------------
-// Try to extract proper faces from the PLY DOM
-void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInstance *instElement,
-        unsigned int pos) {
+// Resolve the index and texture coordinate lists of a face or triangle strip element
+void PLYImporter::SetupFaceLayout(const PLY::Element *pcElement) {
     ai_assert(nullptr != pcElement);
-    ai_assert(nullptr != instElement);
 
-    if (mGeneratedMesh == nullptr) {
-        throw DeadlyImportError("Invalid .ply file: Vertices should be declared before faces");
-    }
-
-    bool bOne = false;
-
-    // index of the vertex index list
-    unsigned int iProperty = 0xFFFFFFFF;
-    PLY::EDataType eType = EDT_Char;
-    bool bIsTriStrip = false;
+    mFaceLayout = FaceLayout();
+    mFaceLayout.mElement = pcElement;
 
     // index of the material index property
     //unsigned int iMaterialIndex = 0xFFFFFFFF;
     //PLY::EDataType eType2 = EDT_Char;
 
-    // texture coordinates
-    unsigned int iTextureCoord = 0xFFFFFFFF;
-    PLY::EDataType eType3 = EDT_Char;
-
     // face = unique number of vertex indices
     if (PLY::EEST_Face == pcElement->eSemantic) {
         unsigned int _a = 0;
         for (std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
                 a != pcElement->alProperties.end(); ++a, ++_a) {
-            if (PLY::EST_VertexIndex == (*a).Semantic) {
-                // must be a dynamic list!
-                if (!(*a).bIsList) {
-                    continue;
-                }
+            // must be a dynamic list!
+            if (!(*a).bIsList) {
+                continue;
+            }
 
-                iProperty = _a;
-                bOne = true;
-                eType = (*a).eType;
+            if (PLY::EST_VertexIndex == (*a).Semantic) {
+                mFaceLayout.mIndices.mIndex = _a;
+                mFaceLayout.mIndices.mType = (*a).eType;
             } else if (PLY::EST_TextureCoordinates == (*a).Semantic) {
-                // must be a dynamic list!
-                if (!(*a).bIsList) {
-                    continue;
-                }
-                iTextureCoord = _a;
-                bOne = true;
-                eType3 = (*a).eType;
+                mFaceLayout.mTexCoords.mIndex = _a;
+                mFaceLayout.mTexCoords.mType = (*a).eType;
             }
         }
     }
@@ -571,34 +699,69 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
             if (!(*a).bIsList) {
                 continue;
             }
-            iProperty = _a;
-            bOne = true;
-            bIsTriStrip = true;
-            eType = (*a).eType;
+            mFaceLayout.mIndices.mIndex = _a;
+            mFaceLayout.mIndices.mType = (*a).eType;
+            mFaceLayout.mIsTriStrip = true;
             break;
         }
     }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Try to extract proper faces from the PLY DOM
+void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInstance *instElement,
+        unsigned int pos) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != instElement);
+
+    if (mGeneratedMesh == nullptr) {
+        throw DeadlyImportError("Invalid .ply file: Vertices should be declared before faces");
+    }
+
+    if (mFaceLayout.mElement != pcElement) {
+        SetupFaceLayout(pcElement);
+    }
+
+    const unsigned int iProperty = mFaceLayout.mIndices.mIndex;
+    const PLY::EDataType eType = mFaceLayout.mIndices.mType;
+    const unsigned int iTextureCoord = mFaceLayout.mTexCoords.mIndex;
+    const PLY::EDataType eType3 = mFaceLayout.mTexCoords.mType;
 
     // check whether we have at least one per-face information set
-    if (bOne) {
+    if (mFaceLayout.mIndices.IsValid() || mFaceLayout.mTexCoords.IsValid()) {
         if (mGeneratedMesh->mFaces == nullptr) {
             mGeneratedMesh->mNumFaces = pcElement->NumOccur;
             mGeneratedMesh->mFaces = new aiFace[mGeneratedMesh->mNumFaces];
         }
 
-        if (!bIsTriStrip) {
+        if (!mFaceLayout.mIsTriStrip) {
             // parse the list of vertex indices
+            const unsigned int *indices = nullptr;
             if (0xFFFFFFFF != iProperty) {
                 const unsigned int iNum = (unsigned int)GetProperty(instElement->alProperties, iProperty).avList.size();
                 mGeneratedMesh->mFaces[pos].mNumIndices = iNum;
-                mGeneratedMesh->mFaces[pos].mIndices = new unsigned int[iNum];
+
+                // in contiguous mode the indices go straight into the later index buffer
+                unsigned int *out;
+                if (mContiguousIndices) {
+                    if (mFaceOffsets.empty()) {
+                        mFaceOffsets.resize(mGeneratedMesh->mNumFaces, 0xFFFFFFFF);
+                        mFaceIndices.reserve(static_cast<size_t>(mGeneratedMesh->mNumFaces) * 3);
+                    }
+                    mFaceOffsets[pos] = static_cast<unsigned int>(mFaceIndices.size());
+                    mFaceIndices.resize(mFaceIndices.size() + iNum);
+                    out = mFaceIndices.data() + mFaceOffsets[pos];
+                } else {
+                    out = mGeneratedMesh->mFaces[pos].mIndices = new unsigned int[iNum];
+                }
 
                 std::vector<PLY::PropertyInstance::ValueUnion>::const_iterator p =
                         GetProperty(instElement->alProperties, iProperty).avList.begin();
 
                 for (unsigned int a = 0; a < iNum; ++a, ++p) {
-                    mGeneratedMesh->mFaces[pos].mIndices[a] = PLY::PropertyInstance::ConvertTo<unsigned int>(*p, eType);
+                    out[a] = PLY::PropertyInstance::ConvertTo<unsigned int>(*p, eType);
                 }
+                indices = out;
             }
 
             // parse the material index
@@ -616,10 +779,10 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
                 std::vector<PLY::PropertyInstance::ValueUnion>::const_iterator p =
                         GetProperty(instElement->alProperties, iTextureCoord).avList.begin();
 
-                if ((iNum / 3) == 2) // X Y coord
+                if ((iNum / 3) == 2 && indices != nullptr) // X Y coord
                 {
                     for (unsigned int a = 0; a < iNum; ++a, ++p) {
-                        unsigned int vindex = mGeneratedMesh->mFaces[pos].mIndices[a / 2];
+                        unsigned int vindex = indices[a / 2];
                         if (vindex < mGeneratedMesh->mNumVertices) {
                             if (mGeneratedMesh->mTextureCoords[0] == nullptr) {
                                 mGeneratedMesh->mNumUVComponents[0] = 2;
@@ -687,6 +850,48 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::FinishFaceIndices() {
+    if (mFaceOffsets.empty()) {
+        return;
+    }
+
+    // faces of a triangle strip element still own their indices, move them over as well
+    size_t numIndices = mFaceIndices.size();
+    for (unsigned int i = 0; i < mGeneratedMesh->mNumFaces; ++i) {
+        if (mFaceOffsets[i] == 0xFFFFFFFF) {
+            numIndices += mGeneratedMesh->mFaces[i].mNumIndices;
+        }
+    }
+    if (numIndices > std::numeric_limits<unsigned int>::max()) {
+        throw DeadlyImportError("Invalid .ply file: Too many face indices");
+    }
+
+    mGeneratedMesh->mNumIndices = static_cast<unsigned int>(numIndices);
+    mGeneratedMesh->mIndices = new unsigned int[numIndices];
+    if (!mFaceIndices.empty()) {
+        ::memcpy(mGeneratedMesh->mIndices, mFaceIndices.data(), mFaceIndices.size() * sizeof(unsigned int));
+    }
+
+    unsigned int *next = mGeneratedMesh->mIndices + mFaceIndices.size();
+    for (unsigned int i = 0; i < mGeneratedMesh->mNumFaces; ++i) {
+        aiFace &face = mGeneratedMesh->mFaces[i];
+        if (mFaceOffsets[i] != 0xFFFFFFFF) {
+            face.mIndices = mGeneratedMesh->mIndices + mFaceOffsets[i];
+            continue;
+        }
+        if (face.mNumIndices) {
+            ::memcpy(next, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+        }
+        delete[] face.mIndices;
+        face.mIndices = next;
+        next += face.mNumIndices;
+    }
+
+    mFaceIndices.clear();
+    mFaceOffsets.clear();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a RGBA color in [0...1] range
 void PLYImporter::GetMaterialColor(const std::vector<PLY::PropertyInstance> &avList,
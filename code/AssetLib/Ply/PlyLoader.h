@@ -73,11 +73,27 @@ public:
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler,
             bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Reads the loader configuration, see BaseImporter::SetupProperties().
+     */
+    void SetupProperties(const Importer *pImp);
+
     // -------------------------------------------------------------------
     /** Extract a vertex from the DOM
     */
     void LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos);
 
+    // -------------------------------------------------------------------
+    /** Decode a block of fixed-size binary vertex records
+    *  @param data First record of the block
+    *  @param stride Size of one record in bytes
+    *  @param first Index of the first vertex in the block
+    *  @param count Number of records in the block
+    *  @param bigEndian Whether the values need to be byte-swapped
+    */
+    void LoadVertexBlock(const PLY::Element *pcElement, const char *data, unsigned int stride,
+            unsigned int first, unsigned int count, bool bigEndian);
+
     // -------------------------------------------------------------------
     /** Extract a face from the DOM
     */
@@ -119,6 +135,72 @@ protected:
             PLY::PropertyInstance::ValueUnion val,
             PLY::EDataType eType);
 
+    // -------------------------------------------------------------------
+    /** Resolve the property slots of a vertex element and allocate the
+    *  output arrays. Done once per element instead of once per vertex.
+    */
+    void SetupVertexLayout(const PLY::Element *pcElement);
+
+    // -------------------------------------------------------------------
+    /** Resolve the property slots of a face or triangle strip element.
+    */
+    void SetupFaceLayout(const PLY::Element *pcElement);
+
+    // -------------------------------------------------------------------
+    /** Hand the indices collected by LoadFace over to the generated mesh
+    *  as its index buffer, see aiMesh::mIndices.
+    */
+    void FinishFaceIndices();
+
+    /** Property slot: index into the element's property list and the
+    *  stored data type. 0xFFFFFFFF marks a missing property. */
+    struct PropertySlot {
+        unsigned int mIndex;
+        PLY::EDataType mType;
+        unsigned int mOffset; //!< Byte offset in a fixed-size binary record
+
+        PropertySlot() AI_NO_EXCEPT :
+                mIndex(0xFFFFFFFF), mType(EDT_Char), mOffset(0) {
+            // empty
+        }
+
+        bool IsValid() const {
+            return 0xFFFFFFFF != mIndex;
+        }
+    };
+
+    /** Vertex properties of the element currently being loaded */
+    struct VertexLayout {
+        const PLY::Element *mElement;
+        PropertySlot mPositions[3];
+        PropertySlot mNormals[3];
+        PropertySlot mColors[4];
+        PropertySlot mTexCoords[2];
+        unsigned int mStride; //!< Record size, 0 if not fixed-size
+        bool mHasNormals;
+        bool mHasColors;
+        bool mHasTexCoords;
+        bool mValid;
+
+        VertexLayout() AI_NO_EXCEPT :
+                mElement(nullptr), mStride(0), mHasNormals(false), mHasColors(false), mHasTexCoords(false), mValid(false) {
+            // empty
+        }
+    };
+
+    /** Face properties of the element currently being loaded */
+    struct FaceLayout {
+        const PLY::Element *mElement;
+        PropertySlot mIndices;
+        PropertySlot mTexCoords;
+        bool mIsTriStrip;
+
+        FaceLayout() AI_NO_EXCEPT :
+                mElement(nullptr), mIsTriStrip(false) {
+            // empty
+        }
+    };
+
     /** Buffer to hold the loaded file */
     unsigned char *mBuffer;
 
@@ -127,6 +209,21 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Cached layout of the vertex element */
+    VertexLayout mVertexLayout;
+
+    /** Cached layout of the face element */
+    FaceLayout mFaceLayout;
+
+    /** Store the face indices in one buffer, see aiMesh::mIndices */
+    bool mContiguousIndices;
+
+    /** Indices of all faces read so far in contiguous mode */
+    std::vector<unsigned int> mFaceIndices;
+
+    /** Start of each face in mFaceIndices, 0xFFFFFFFF if not read yet */
+    std::vector<unsigned int> mFaceOffsets;
 };
 
 } // end of namespace Assimp
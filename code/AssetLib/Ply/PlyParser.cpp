@@ -49,8 +49,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/fast_atof.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
+
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Appends the next file block to the unread rest of the binary buffer
+void AppendNextBlock(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char *&pCur, unsigned int &bufferSize) {
+    std::vector<char> nbuffer;
+    if (!streamBuffer.getNextBlock(nbuffer)) {
+        throw DeadlyImportError("Invalid .ply file: File corrupted");
+    }
+
+    //concat buffer contents
+    buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
+    buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
+    bufferSize = static_cast<unsigned int>(buffer.size());
+    pCur = (char *)&buffer[0];
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 PLY::EDataType PLY::Property::ParseDataType(std::vector<char> &buffer) {
     ai_assert(!buffer.empty());
@@ -320,6 +342,19 @@ bool PLY::Element::ParseElement(IOStreamBuffer<char> &streamBuffer, std::vector<
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::Element::GetBinaryStride() const {
+    unsigned int stride = 0;
+    for (std::vector<PLY::Property>::const_iterator a = alProperties.begin(); a != alProperties.end(); ++a) {
+        const unsigned int size = PLY::PropertyInstance::GetBinarySize((*a).eType);
+        if ((*a).bIsList || 0 == size) {
+            return 0;
+        }
+        stride += size;
+    }
+    return stride;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::DOM::SkipSpaces(std::vector<char> &buffer) {
     const char *pCur = buffer.empty() ? nullptr : (char *)&buffer[0];
@@ -555,13 +590,16 @@ bool PLY::ElementInstanceList::ParseInstanceList(
         }
     } else {
         const char *pCur = (const char *)&buffer[0];
-        // be sure to have enough storage
+        const char *end = pCur + buffer.size();
+
+        // vertices and faces are handed to the loader one by one, reuse a
+        // single instance so its value lists keep their storage
+        ElementInstance elt;
         for (unsigned int i = 0; i < pcElement->NumOccur; ++i) {
             if (p_pcOut)
-                PLY::ElementInstance::ParseInstance(pCur, pcElement, &p_pcOut->alInstances[i]);
+                PLY::ElementInstance::ParseInstance(pCur, end, pcElement, &p_pcOut->alInstances[i]);
             else {
-                ElementInstance elt;
-                PLY::ElementInstance::ParseInstance(pCur, pcElement, &elt);
+                PLY::ElementInstance::ParseInstance(pCur, end, pcElement, &elt);
 
                 // Create vertex or face
                 if (pcElement->eSemantic == EEST_Vertex) {
@@ -578,6 +616,7 @@ bool PLY::ElementInstanceList::ParseInstanceList(
 
             streamBuffer.getNextLine(buffer);
             pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            end = (buffer.empty()) ? nullptr : pCur + buffer.size();
         }
     }
     return true;
@@ -595,15 +634,35 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
         bool p_bBE /* = false */) {
     ai_assert(nullptr != pcElement);
 
+    // vertex records without list properties have a constant size, decode
+    // them in whole blocks straight from the read buffer
+    const unsigned int stride = pcElement->GetBinaryStride();
+    if (nullptr == p_pcOut && EEST_Vertex == pcElement->eSemantic && 0 != stride) {
+        unsigned int i = 0;
+        while (i < pcElement->NumOccur) {
+            while (bufferSize < stride) {
+                AppendNextBlock(streamBuffer, buffer, pCur, bufferSize);
+            }
+
+            const unsigned int count = std::min(pcElement->NumOccur - i, bufferSize / stride);
+            loader->LoadVertexBlock(pcElement, pCur, stride, i, count, p_bBE);
+
+            pCur += static_cast<size_t>(count) * stride;
+            bufferSize -= count * stride;
+            i += count;
+        }
+        return true;
+    }
+
     // we can add special handling code for unknown element semantics since
     // we can't skip it as a whole block (we don't know its exact size
     // due to the fact that lists could be contained in the property list
     // of the unknown element)
+    ElementInstance elt;
     for (unsigned int i = 0; i < pcElement->NumOccur; ++i) {
         if (p_pcOut)
             PLY::ElementInstance::ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, pcElement, &p_pcOut->alInstances[i], p_bBE);
         else {
-            ElementInstance elt;
             PLY::ElementInstance::ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, pcElement, &elt, p_bBE);
 
             // Create vertex or face
@@ -623,7 +682,7 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::ElementInstance::ParseInstance(const char *&pCur,
+bool PLY::ElementInstance::ParseInstance(const char *&pCur, const char *end,
         const PLY::Element *pcElement,
         PLY::ElementInstance *p_pcOut) {
     ai_assert(nullptr != pcElement);
@@ -635,7 +694,8 @@ bool PLY::ElementInstance::ParseInstance(const char *&pCur,
     std::vector<PLY::PropertyInstance>::iterator i = p_pcOut->alProperties.begin();
     std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
     for (; i != p_pcOut->alProperties.end(); ++i, ++a) {
-        if (!(PLY::PropertyInstance::ParseInstance(pCur, &(*a), &(*i)))) {
+        (*i).avList.clear();
+        if (!(PLY::PropertyInstance::ParseInstance(pCur, end, &(*a), &(*i)))) {
             ASSIMP_LOG_WARN("Unable to parse property instance. "
                             "Skipping this element instance");
 
@@ -664,6 +724,7 @@ bool PLY::ElementInstance::ParseInstanceBinary(
     std::vector<PLY::PropertyInstance>::iterator i = p_pcOut->alProperties.begin();
     std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
     for (; i != p_pcOut->alProperties.end(); ++i, ++a) {
+        (*i).avList.clear();
         if (!(PLY::PropertyInstance::ParseInstanceBinary(streamBuffer, buffer, pCur, bufferSize, &(*a), &(*i), p_bBE))) {
             ASSIMP_LOG_WARN("Unable to parse binary property instance. "
                             "Skipping this element instance");
@@ -675,7 +736,7 @@ bool PLY::ElementInstance::ParseInstanceBinary(
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::PropertyInstance::ParseInstance(const char *&pCur,
+bool PLY::PropertyInstance::ParseInstance(const char *&pCur, const char *end,
         const PLY::Property *prop, PLY::PropertyInstance *p_pcOut) {
     ai_assert(nullptr != prop);
     ai_assert(nullptr != p_pcOut);
@@ -688,7 +749,7 @@ bool PLY::PropertyInstance::ParseInstance(const char *&pCur,
     if (prop->bIsList) {
         // parse the number of elements in the list
         PLY::PropertyInstance::ValueUnion v;
-        PLY::PropertyInstance::ParseValue(pCur, prop->eFirstType, &v);
+        PLY::PropertyInstance::ParseValue(pCur, end, prop->eFirstType, &v);
 
         // convert to unsigned int
         unsigned int iNum = PLY::PropertyInstance::ConvertTo<unsigned int>(v, prop->eFirstType);
@@ -699,13 +760,13 @@ bool PLY::PropertyInstance::ParseInstance(const char *&pCur,
             if (!SkipSpaces(&pCur))
                 return false;
 
-            PLY::PropertyInstance::ParseValue(pCur, prop->eType, &p_pcOut->avList[i]);
+            PLY::PropertyInstance::ParseValue(pCur, end, prop->eType, &p_pcOut->avList[i]);
         }
     } else {
         // parse the property
         PLY::PropertyInstance::ValueUnion v;
 
-        PLY::PropertyInstance::ParseValue(pCur, prop->eType, &v);
+        PLY::PropertyInstance::ParseValue(pCur, end, prop->eType, &v);
         p_pcOut->avList.push_back(v);
     }
     SkipSpacesAndLineEnd(&pCur);
@@ -765,7 +826,7 @@ PLY::PropertyInstance::ValueUnion PLY::PropertyInstance::DefaultValue(PLY::EData
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::PropertyInstance::ParseValue(const char *&pCur,
+bool PLY::PropertyInstance::ParseValue(const char *&pCur, const char *end,
         PLY::EDataType eType,
         PLY::PropertyInstance::ValueUnion *out) {
     ai_assert(nullptr != pCur);
@@ -792,13 +853,13 @@ bool PLY::PropertyInstance::ParseValue(const char *&pCur,
         // technically this should cast to float, but people tend to use float descriptors for double data
         // this is the best way to not risk losing precision on import and it doesn't hurt to do this
         ai_real f;
-        pCur = fast_atoreal_move<ai_real>(pCur, f);
+        pCur = fast_atoreal_move<ai_real>(pCur, end, f);
         out->fFloat = (ai_real)f;
         break;
 
     case EDT_Double:
         double d;
-        pCur = fast_atoreal_move<double>(pCur, d);
+        pCur = fast_atoreal_move<double>(pCur, end, d);
         out->fDouble = (double)d;
         break;
 
@@ -812,56 +873,46 @@ bool PLY::PropertyInstance::ParseValue(const char *&pCur,
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
-        std::vector<char> &buffer,
-        const char *&pCur,
-        unsigned int &bufferSize,
-        PLY::EDataType eType,
-        PLY::PropertyInstance::ValueUnion *out,
-        bool p_bBE) {
-    ai_assert(nullptr != out);
-
-    //calc element size
-    unsigned int lsize = 0;
+unsigned int PLY::PropertyInstance::GetBinarySize(PLY::EDataType eType) {
     switch (eType) {
     case EDT_Char:
     case EDT_UChar:
-        lsize = 1;
-        break;
+        return 1;
 
     case EDT_UShort:
     case EDT_Short:
-        lsize = 2;
-        break;
+        return 2;
 
     case EDT_UInt:
     case EDT_Int:
     case EDT_Float:
-        lsize = 4;
-        break;
+        return 4;
 
     case EDT_Double:
-        lsize = 8;
-        break;
+        return 8;
 
     case EDT_INVALID:
     default:
         break;
     }
 
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
+        std::vector<char> &buffer,
+        const char *&pCur,
+        unsigned int &bufferSize,
+        PLY::EDataType eType,
+        PLY::PropertyInstance::ValueUnion *out,
+        bool p_bBE) {
+    ai_assert(nullptr != out);
+
     //read the next file block if needed
+    const unsigned int lsize = GetBinarySize(eType);
     if (bufferSize < lsize) {
-        std::vector<char> nbuffer;
-        if (streamBuffer.getNextBlock(nbuffer)) {
-            //concat buffer contents
-            buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
-            buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
-            nbuffer.clear();
-            bufferSize = static_cast<unsigned int>(buffer.size());
-            pCur = (char *)&buffer[0];
-        } else {
-            throw DeadlyImportError("Invalid .ply file: File corrupted");
-        }
+        AppendNextBlock(streamBuffer, buffer, pCur, bufferSize);
     }
 
     bool ret = true;
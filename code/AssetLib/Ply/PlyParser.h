@@ -277,6 +277,10 @@ public:
     //! How many times will the element occur?
     unsigned int NumOccur;
 
+    // -------------------------------------------------------------------
+    //! Size of one binary instance in bytes. Returns 0 if the element
+    //! contains list properties and has no constant size.
+    unsigned int GetBinaryStride() const;
 
     // -------------------------------------------------------------------
     //! Parse an element from a string.
@@ -327,7 +331,7 @@ public:
 
     // -------------------------------------------------------------------
     //! Parse a property instance
-    static bool ParseInstance(const char* &pCur,
+    static bool ParseInstance(const char* &pCur, const char* end,
         const Property* prop, PropertyInstance* p_pcOut);
 
     // -------------------------------------------------------------------
@@ -341,7 +345,11 @@ public:
 
     // -------------------------------------------------------------------
     //! Parse a value
-    static bool ParseValue(const char* &pCur, EDataType eType, ValueUnion* out);
+    static bool ParseValue(const char* &pCur, const char* end, EDataType eType, ValueUnion* out);
+
+    // -------------------------------------------------------------------
+    //! Get the size of a binary value in bytes, 0 for invalid types
+    static unsigned int GetBinarySize(EDataType eType);
 
     // -------------------------------------------------------------------
     //! Parse a binary value
@@ -370,7 +378,7 @@ public:
 
     // -------------------------------------------------------------------
     //! Parse an element instance
-    static bool ParseInstance(const char* &pCur,
+    static bool ParseInstance(const char* &pCur, const char* end,
         const Element* pcElement, ElementInstance* p_pcOut);
 
     // -------------------------------------------------------------------
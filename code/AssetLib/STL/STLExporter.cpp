@@ -63,39 +63,38 @@ void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
 
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds );
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it streams straight into the file
+    STLExporter exporter(pFile, outfile.get(), pScene, exportPointClouds );
+
+    exporter.mOutput.Flush();
+    if (!exporter.mOutput.IsGood()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+    }
 }
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties )
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
-
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds, true);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    if (exportPointClouds) {
+        throw DeadlyExportError("This functionality is not yet implemented for binary output.");
     }
-    
-    // we're still here - export successfully completed. Write the file.
+
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it streams straight into the file
+    STLExporter exporter(pFile, outfile.get(), pScene, exportPointClouds, true);
+
+    exporter.mOutput.Flush();
+    if (!exporter.mOutput.IsGood()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
@@ -104,19 +103,16 @@ static const char *SolidToken = "solid";
 static const char *EndSolidToken = "endsolid";
 
 // ------------------------------------------------------------------------------------------------
-STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool exportPointClouds, bool binary)
-: filename(_filename)
+STLExporter::STLExporter(const char* _filename, IOStream* pStream, const aiScene* pScene, bool exportPointClouds, bool binary)
+: mOutput(pStream)
+, filename(_filename)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
     if (binary) {
         char buf[80] = {0} ;
         buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
         buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
-        mOutput.write(buf, 80);
+        mOutput.Write(buf, 80);
         unsigned int meshnum = 0;
         for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
             for (unsigned int j = 0; j < pScene->mMeshes[i]->mNumFaces; ++j) {
@@ -124,11 +120,7 @@ STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool expo
             }
         }
         AI_SWAP4(meshnum);
-        mOutput.write((char *)&meshnum, 4);
-
-        if (exportPointClouds) {
-            throw DeadlyExportError("This functionality is not yet implemented for binary output.");
-        }
+        mOutput.Write(&meshnum, 4);
 
         for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
             WriteMeshBinary(pScene->mMeshes[i]);
@@ -218,15 +210,15 @@ void STLExporter::WriteMeshBinary(const aiMesh* m)
         float ny = (float) nor.y;
         float nz = (float) nor.z;
         AI_SWAP4(nx); AI_SWAP4(ny); AI_SWAP4(nz);
-        mOutput.write((char *)&nx, 4); mOutput.write((char *)&ny, 4); mOutput.write((char *)&nz, 4);
+        mOutput.Write(&nx, 4); mOutput.Write(&ny, 4); mOutput.Write(&nz, 4);
         for(unsigned int a = 0; a < f.mNumIndices; ++a) {
             const aiVector3D& v  = m->mVertices[f.mIndices[a]];
             float vx = (float) v.x, vy = (float) v.y, vz = (float) v.z;
             AI_SWAP4(vx); AI_SWAP4(vy); AI_SWAP4(vz);
-            mOutput.write((char *)&vx, 4); mOutput.write((char *)&vy, 4); mOutput.write((char *)&vz, 4);
+            mOutput.Write(&vx, 4); mOutput.Write(&vy, 4); mOutput.Write(&vz, 4);
         }
         char dummy[2] = {0};
-        mOutput.write(dummy, 2);
+        mOutput.Write(dummy, 2);
     }
 }
 
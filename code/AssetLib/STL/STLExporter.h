@@ -46,7 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "Common/TextStreamWriter.h"
+
+#include <string>
 
 struct aiScene;
 struct aiNode;
@@ -61,10 +63,10 @@ class STLExporter
 {
 public:
     /// Constructor for a specific scene to export
-    STLExporter(const char* filename, const aiScene* pScene, bool exportPOintClouds, bool binary = false);
+    STLExporter(const char* filename, IOStream* pStream, const aiScene* pScene, bool exportPOintClouds, bool binary = false);
 
-    /// public stringstreams to write all output into
-    std::ostringstream mOutput;
+    /// public writer all output is streamed through
+    TextStreamWriter mOutput;
 
 private:
     void WritePointCloud(const std::string &name, const aiScene* pScene);
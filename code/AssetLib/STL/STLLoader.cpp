@@ -45,12 +45,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "STLLoader.h"
+#include "Common/ParallelFor.h"
+#include <assimp/MappedFile.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <limits>
 #include <memory>
 
 using namespace Assimp;
@@ -74,7 +81,7 @@ static const aiImporterDesc desc = {
 // 1) 80 byte header
 // 2) 4 byte face count
 // 3) 50 bytes per face
-static bool IsBinarySTL(const char *buffer, unsigned int fileSize) {
+static bool IsBinarySTL(const char *buffer, size_t fileSize) {
     if (fileSize < 84) {
         return false;
     }
@@ -82,7 +89,7 @@ static bool IsBinarySTL(const char *buffer, unsigned int fileSize) {
     const char *facecount_pos = buffer + 80;
     uint32_t faceCount(0);
     ::memcpy(&faceCount, facecount_pos, sizeof(uint32_t));
-    const uint32_t expectedBinaryFileSize = faceCount * 50 + 84;
+    const uint64_t expectedBinaryFileSize = static_cast<uint64_t>(faceCount) * 50 + 84;
 
     return expectedBinaryFileSize == fileSize;
 }
@@ -93,7 +100,7 @@ static const char UnicodeBoundary = 127;
 // An ascii STL buffer will begin with "solid NAME", where NAME is optional.
 // Note: The "solid NAME" check is necessary, but not sufficient, to determine
 // if the buffer is ASCII; a binary header could also begin with "solid NAME".
-static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
+static bool IsAsciiSTL(const char *buffer, size_t fileSize) {
     if (IsBinarySTL(buffer, fileSize))
         return false;
 
@@ -122,6 +129,188 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Facets decoded per block of the parallel binary loader
+static const size_t FacetGrain = 4096;
+
+// Minimum number of bytes per chunk of the parallel ASCII parser
+static const size_t MinAsciiChunkSize = 1024 * 1024;
+
+// Facet range of a solid in an ASCII file
+struct SolidRange {
+    std::string name;
+    const char *begin;
+    const char *end;
+};
+
+// A run of facets of an ASCII solid and the data parsed from it
+struct FacetChunk {
+    const char *begin;
+    const char *end;
+    bool followedByFacet;
+    std::vector<aiVector3D> positions;
+    std::vector<aiVector3D> normals;
+    unsigned int numIncomplete;
+    unsigned int numOverfull;
+    unsigned int numMissingNormals;
+
+    FacetChunk(const char *_begin, const char *_end, bool _followedByFacet) :
+            begin(_begin), end(_end), followedByFacet(_followedByFacet), numIncomplete(0), numOverfull(0), numMissingNormals(0) {
+        // empty
+    }
+};
+
+// Returns the next 'endsolid' keyword starting a token in [begin, end), or end
+static const char *FindEndSolid(const char *begin, const char *end) {
+    // 's' is rare in the facet keywords, search for it first
+    const char *p = begin + 3;
+    while (p < end) {
+        p = static_cast<const char *>(::memchr(p, 's', end - p));
+        if (nullptr == p) {
+            break;
+        }
+        if (p + 5 <= end && p - 3 > begin && IsSpaceOrNewLine(p[-4]) && !::strncmp(p - 3, "endsolid", 8)) {
+            return p - 3;
+        }
+        ++p;
+    }
+    return end;
+}
+
+// Returns the next 'facet' keyword starting a token in [begin, end), or end
+static const char *FindFacet(const char *begin, const char *end) {
+    const char *p = begin;
+    while (p < end) {
+        p = static_cast<const char *>(::memchr(p, 'f', end - p));
+        if (nullptr == p) {
+            break;
+        }
+        if (p + 5 < end && p > begin && IsSpaceOrNewLine(p[-1]) && !::strncmp(p, "facet", 5) &&
+                IsSpaceOrNewLine(p[5]) && p[5] != '\0') {
+            return p;
+        }
+        ++p;
+    }
+    return end;
+}
+
+// Parses the three coordinates of a normal or vertex
+static const char *ParseVector(const char *sz, const char *end, aiVector3D &out) {
+    ai_real values[3];
+    unsigned int numParsed = 0;
+    sz = fast_atoreal_move_n<ai_real>(sz, end, values, 3, &numParsed);
+    if (3 != numParsed) {
+        throw DeadlyImportError("STL: a vector with three components was expected");
+    }
+    out.Set(values[0], values[1], values[2]);
+    return sz;
+}
+
+// Parses all facets of a chunk. Runs on worker threads, so problems are
+// counted instead of logged.
+static void ParseFacets(FacetChunk &chunk) {
+    // try to guess how many vertices we could have
+    // assume we'll need 160 bytes for each face
+    const size_t sizeEstimate = std::max<size_t>(1u, static_cast<size_t>(chunk.end - chunk.begin) / 160u) * 3;
+    chunk.positions.reserve(sizeEstimate);
+    chunk.normals.reserve(sizeEstimate);
+
+    const char *sz = chunk.begin;
+    unsigned int faceVertexCounter = 3;
+    for (;;) {
+        // go to the next token
+        if (!SkipSpacesAndLineEnd(&sz) || sz >= chunk.end) {
+            break;
+        }
+        // facet normal -0.13 -0.13 -0.98
+        if (!strncmp(sz, "facet", 5) && IsSpaceOrNewLine(*(sz + 5)) && *(sz + 5) != '\0') {
+
+            if (faceVertexCounter != 3) {
+                ++chunk.numIncomplete;
+            }
+            faceVertexCounter = 0;
+            chunk.normals.push_back(aiVector3D());
+            aiVector3D *vn = &chunk.normals.back();
+
+            sz += 6;
+            SkipSpaces(&sz);
+            if (strncmp(sz, "normal", 6)) {
+                ++chunk.numMissingNormals;
+            } else {
+                if (sz[6] == '\0') {
+                    throw DeadlyImportError("STL: unexpected EOF while parsing facet");
+                }
+                sz += 7;
+                sz = ParseVector(sz, chunk.end, *vn);
+                const aiVector3D normal = *vn;
+                chunk.normals.push_back(normal);
+                chunk.normals.push_back(normal);
+            }
+        } else if (!strncmp(sz, "vertex", 6) && ::IsSpaceOrNewLine(*(sz + 6))) { // vertex 1.50000 1.50000 0.00000
+            if (faceVertexCounter >= 3) {
+                ++chunk.numOverfull;
+                ++sz;
+            } else {
+                if (sz[6] == '\0') {
+                    throw DeadlyImportError("STL: unexpected EOF while parsing facet");
+                }
+                sz += 7;
+                chunk.positions.push_back(aiVector3D());
+                sz = ParseVector(sz, chunk.end, chunk.positions.back());
+                faceVertexCounter++;
+            }
+        } else { // else skip the whole identifier
+            do {
+                ++sz;
+            } while (!::IsSpaceOrNewLine(*sz));
+        }
+    }
+
+    // the next chunk starts with a new facet
+    if (chunk.followedByFacet && faceVertexCounter != 3) {
+        ++chunk.numIncomplete;
+    }
+}
+
+// Mixes the bits of a float into a hash, -0 and 0 compare equal and hash the same
+inline uint32_t HashFloat(uint32_t seed, ai_real value) {
+    const float f = static_cast<float>(value) + 0.0f;
+    uint32_t bits;
+    ::memcpy(&bits, &f, sizeof(bits));
+    return (seed ^ bits) * 0x01000193u;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hash of all attributes of a vertex which take part in welding
+uint32_t HashVertex(const aiMesh *mesh, unsigned int i) {
+    uint32_t seed = 0x811c9dc5u;
+    const aiVector3D &p = mesh->mVertices[i];
+    seed = HashFloat(HashFloat(HashFloat(seed, p.x), p.y), p.z);
+    if (mesh->mNormals) {
+        const aiVector3D &n = mesh->mNormals[i];
+        seed = HashFloat(HashFloat(HashFloat(seed, n.x), n.y), n.z);
+    }
+    if (mesh->mColors[0]) {
+        const aiColor4D &c = mesh->mColors[0][i];
+        seed = HashFloat(HashFloat(HashFloat(HashFloat(seed, c.r), c.g), c.b), c.a);
+    }
+    return seed ^ (seed >> 16);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsSameVertex(const aiMesh *mesh, unsigned int a, unsigned int b) {
+    if (mesh->mVertices[a] != mesh->mVertices[b]) {
+        return false;
+    }
+    if (mesh->mNormals && mesh->mNormals[a] != mesh->mNormals[b]) {
+        return false;
+    }
+    if (mesh->mColors[0] && mesh->mColors[0][a] != mesh->mColors[0][b]) {
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -129,7 +318,9 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mWeldVertices(false),
+        mContiguousIndices(false) {
    // empty
 }
 
@@ -157,17 +348,25 @@ bool STLImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+    mContiguousIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh *pMesh) {
+static void addFacesToMesh(aiMesh *pMesh, bool contiguous) {
     pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        pMesh->mFaces[i].mNumIndices = 3;
+    }
+    pMesh->AllocateFaceIndices(contiguous);
     for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
-
         aiFace &face = pMesh->mFaces[i];
-        face.mIndices = new unsigned int[face.mNumIndices = 3];
         for (unsigned int o = 0; o < 3; ++o, ++p) {
             face.mIndices[o] = p;
         }
@@ -184,15 +383,22 @@ void STLImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("Failed to open STL file ", pFile, ".");
     }
 
-    mFileSize = (unsigned int)file->FileSize();
+    mFileSize = file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
-    // (terminate it with zero)
+    // binary files are decoded straight from a mapping of the file if
+    // possible. Everything else is copied to a memory buffer (terminated
+    // with zero) for parsing.
+    MappedFile mapping(file.get());
     std::vector<char> buffer2;
-    TextFileToBuffer(file.get(), buffer2);
+    if (mapping.IsValid() && mapping.GetSize() >= mFileSize &&
+            IsBinarySTL(reinterpret_cast<const char *>(mapping.GetData()), mFileSize)) {
+        mBuffer = reinterpret_cast<const char *>(mapping.GetData());
+    } else {
+        TextFileToBuffer(file.get(), buffer2);
+        mBuffer = &buffer2[0];
+    }
 
     mScene = pScene;
-    mBuffer = &buffer2[0];
 
     // the default vertex color is light gray.
     mClrColorDefault.r = mClrColorDefault.g = mClrColorDefault.b = mClrColorDefault.a = (ai_real)0.6;
@@ -236,28 +442,12 @@ void STLImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 // ------------------------------------------------------------------------------------------------
 // Read an ASCII STL file
 void STLImporter::LoadASCIIFile(aiNode *root) {
-    std::vector<aiMesh *> meshes;
-    std::vector<aiNode *> nodes;
     const char *sz = mBuffer;
     const char *bufferEnd = mBuffer + mFileSize;
-    std::vector<aiVector3D> positionBuffer;
-    std::vector<aiVector3D> normalBuffer;
 
-    // try to guess how many vertices we could have
-    // assume we'll need 160 bytes for each face
-    size_t sizeEstimate = std::max(1u, mFileSize / 160u) * 3;
-    positionBuffer.reserve(sizeEstimate);
-    normalBuffer.reserve(sizeEstimate);
-
-    while (IsAsciiSTL(sz, static_cast<unsigned int>(bufferEnd - sz))) {
-        std::vector<unsigned int> meshIndices;
-        aiMesh *pMesh = new aiMesh();
-        pMesh->mMaterialIndex = 0;
-        meshIndices.push_back((unsigned int)meshes.size());
-        meshes.push_back(pMesh);
-        aiNode *node = new aiNode;
-        node->mParent = root;
-        nodes.push_back(node);
+    // find the name and the facet range of every solid first
+    std::vector<SolidRange> solids;
+    while (IsAsciiSTL(sz, static_cast<size_t>(bufferEnd - sz))) {
         SkipSpaces(&sz);
         ai_assert(!IsLineEnd(sz));
 
@@ -269,127 +459,130 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
         }
 
         size_t temp = (size_t)(sz - szMe);
-        // setup the name of the node
-        if ( temp ) {
-            if (temp >= MAXLEN) {
-                throw DeadlyImportError("STL: Node name too long");
+        if (temp >= MAXLEN) {
+            throw DeadlyImportError("STL: Node name too long");
+        }
+
+        SolidRange solid;
+        solid.name.assign(szMe, temp);
+        solid.begin = sz;
+        solid.end = FindEndSolid(sz, bufferEnd);
+        solids.push_back(solid);
+
+        if (solid.end == bufferEnd) {
+            // seems we're finished although there was no end marker
+            ASSIMP_LOG_WARN("STL: unexpected EOF. \'endsolid\' keyword was expected");
+            sz = bufferEnd;
+        } else {
+            sz = solid.end;
+            do {
+                ++sz;
+            } while (!::IsLineEnd(*sz));
+            SkipSpacesAndLineEnd(&sz);
+        }
+    }
+
+    // split the solids into chunks at 'facet' keywords and parse the chunks
+    // in parallel, the chunks keep the file order
+    const size_t chunkSize = std::max<size_t>(MinAsciiChunkSize, mFileSize / (GetParallelWorkerCount() * 4));
+    std::vector<FacetChunk> chunks;
+    std::vector<size_t> firstChunk(solids.size() + 1);
+    for (size_t s = 0; s < solids.size(); ++s) {
+        firstChunk[s] = chunks.size();
+        const char *begin = solids[s].begin;
+        while (begin < solids[s].end) {
+            const char *end = solids[s].end;
+            if (static_cast<size_t>(end - begin) > chunkSize) {
+                end = FindFacet(begin + chunkSize, solids[s].end);
             }
-            std::string name(szMe, temp);
-            node->mName.Set(name.c_str());
-            pMesh->mName.Set(name.c_str());
+            chunks.push_back(FacetChunk(begin, end, end != solids[s].end));
+            begin = end;
+        }
+    }
+    firstChunk[solids.size()] = chunks.size();
+
+    ParallelFor(0, chunks.size(), [&](size_t i) {
+        ParseFacets(chunks[i]);
+    });
+
+    // stitch the chunks of every solid together
+    std::vector<aiMesh *> meshes;
+    std::vector<aiNode *> nodes;
+    for (size_t s = 0; s < solids.size(); ++s) {
+        std::vector<unsigned int> meshIndices;
+        aiMesh *pMesh = new aiMesh();
+        pMesh->mMaterialIndex = 0;
+        meshIndices.push_back((unsigned int)meshes.size());
+        meshes.push_back(pMesh);
+        aiNode *node = new aiNode;
+        node->mParent = root;
+        nodes.push_back(node);
+
+        // setup the name of the node
+        if (!solids[s].name.empty()) {
+            node->mName.Set(solids[s].name.c_str());
+            pMesh->mName.Set(solids[s].name.c_str());
         } else {
             mScene->mRootNode->mName.Set("<STL_ASCII>");
         }
 
-        unsigned int faceVertexCounter = 3;
-        for (;;) {
-            // go to the next token
-            if (!SkipSpacesAndLineEnd(&sz)) {
-                // seems we're finished although there was no end marker
-                ASSIMP_LOG_WARN("STL: unexpected EOF. \'endsolid\' keyword was expected");
-                break;
-            }
-            // facet normal -0.13 -0.13 -0.98
-            if (!strncmp(sz, "facet", 5) && IsSpaceOrNewLine(*(sz + 5)) && *(sz + 5) != '\0') {
+        size_t numPositions = 0, numNormals = 0;
+        unsigned int numIncomplete = 0, numOverfull = 0, numMissingNormals = 0;
+        for (size_t c = firstChunk[s]; c < firstChunk[s + 1]; ++c) {
+            numPositions += chunks[c].positions.size();
+            numNormals += chunks[c].normals.size();
+            numIncomplete += chunks[c].numIncomplete;
+            numOverfull += chunks[c].numOverfull;
+            numMissingNormals += chunks[c].numMissingNormals;
+        }
 
-                if (faceVertexCounter != 3) {
-                    ASSIMP_LOG_WARN("STL: A new facet begins but the old is not yet complete");
-                }
-                faceVertexCounter = 0;
-                normalBuffer.push_back(aiVector3D());
-                aiVector3D *vn = &normalBuffer.back();
-
-                sz += 6;
-                SkipSpaces(&sz);
-                if (strncmp(sz, "normal", 6)) {
-                    ASSIMP_LOG_WARN("STL: a facet normal vector was expected but not found");
-                } else {
-                    if (sz[6] == '\0') {
-                        throw DeadlyImportError("STL: unexpected EOF while parsing facet");
-                    }
-                    sz += 7;
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->x);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->y);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->z);
-                    normalBuffer.push_back(*vn);
-                    normalBuffer.push_back(*vn);
-                }
-            } else if (!strncmp(sz, "vertex", 6) && ::IsSpaceOrNewLine(*(sz + 6))) { // vertex 1.50000 1.50000 0.00000
-                if (faceVertexCounter >= 3) {
-                    ASSIMP_LOG_ERROR("STL: a facet with more than 3 vertices has been found");
-                    ++sz;
-                } else {
-                    if (sz[6] == '\0') {
-                        throw DeadlyImportError("STL: unexpected EOF while parsing facet");
-                    }
-                    sz += 7;
-                    SkipSpaces(&sz);
-                    positionBuffer.push_back(aiVector3D());
-                    aiVector3D *vn = &positionBuffer.back();
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->x);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->y);
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn->z);
-                    faceVertexCounter++;
-                }
-            } else if (!::strncmp(sz, "endsolid", 8)) {
-                do {
-                    ++sz;
-                } while (!::IsLineEnd(*sz));
-                SkipSpacesAndLineEnd(&sz);
-                // finished!
-                break;
-            } else { // else skip the whole identifier
-                do {
-                    ++sz;
-                } while (!::IsSpaceOrNewLine(*sz));
-            }
+        if (numIncomplete) {
+            ASSIMP_LOG_WARN_F("STL: A new facet begins but the old is not yet complete (", numIncomplete, " times)");
+        }
+        if (numMissingNormals) {
+            ASSIMP_LOG_WARN_F("STL: a facet normal vector was expected but not found (", numMissingNormals, " times)");
+        }
+        if (numOverfull) {
+            ASSIMP_LOG_ERROR_F("STL: ", numOverfull, " facets with more than 3 vertices have been found");
         }
 
-        if (positionBuffer.empty()) {
+        if (0 == numPositions) {
             pMesh->mNumFaces = 0;
             ASSIMP_LOG_WARN("STL: mesh is empty or invalid; no data loaded");
         }
-        if (positionBuffer.size() % 3 != 0) {
+        if (numPositions % 3 != 0) {
             pMesh->mNumFaces = 0;
             throw DeadlyImportError("STL: Invalid number of vertices");
         }
-        if (normalBuffer.size() != positionBuffer.size()) {
+        if (numNormals != numPositions) {
             pMesh->mNumFaces = 0;
             throw DeadlyImportError("Normal buffer size does not match position buffer size");
         }
+        if (numPositions > std::numeric_limits<unsigned int>::max()) {
+            throw DeadlyImportError("STL: too many vertices in solid");
+        }
 
-        // only process positionbuffer when filled, else exception when accessing with index operator
-        // see line 353: only warning is triggered
-        // see line 373(now): access to empty positionbuffer with index operator forced exception
-        if (!positionBuffer.empty()) {
-            pMesh->mNumFaces = static_cast<unsigned int>(positionBuffer.size() / 3);
-            pMesh->mNumVertices = static_cast<unsigned int>(positionBuffer.size());
+        // only process the buffers when filled, else exception when accessing with index operator
+        if (0 != numPositions) {
+            pMesh->mNumFaces = static_cast<unsigned int>(numPositions / 3);
+            pMesh->mNumVertices = static_cast<unsigned int>(numPositions);
             pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-            for (size_t i=0; i<pMesh->mNumVertices; ++i ) {
-                pMesh->mVertices[i].x = positionBuffer[i].x;
-                pMesh->mVertices[i].y = positionBuffer[i].y;                
-                pMesh->mVertices[i].z = positionBuffer[i].z;
-            }
-            positionBuffer.clear();
-        }
-        // also only process normalBuffer when filled, else exception when accessing with index operator
-        if (!normalBuffer.empty()) {
             pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-            for (size_t i=0; i<pMesh->mNumVertices; ++i ) {
-                pMesh->mNormals[i].x = normalBuffer[i].x;
-                pMesh->mNormals[i].y = normalBuffer[i].y;                
-                pMesh->mNormals[i].z = normalBuffer[i].z;
+
+            aiVector3D *vp = pMesh->mVertices;
+            aiVector3D *vn = pMesh->mNormals;
+            for (size_t c = firstChunk[s]; c < firstChunk[s + 1]; ++c) {
+                vp = std::copy(chunks[c].positions.begin(), chunks[c].positions.end(), vp);
+                vn = std::copy(chunks[c].normals.begin(), chunks[c].normals.end(), vn);
+
+                // release the chunk right away, ASCII files can be huge
+                std::vector<aiVector3D>().swap(chunks[c].positions);
+                std::vector<aiVector3D>().swap(chunks[c].normals);
             }
-            normalBuffer.clear();
         }
 
         // now copy faces
-        addFacesToMesh(pMesh);
+        addFacesToMesh(pMesh, mContiguousIndices);
 
         // assign the meshes to the current node
         pushMeshesToNode(meshIndices, node);
@@ -448,103 +641,94 @@ bool STLImporter::LoadBinaryFile() {
     // now read the number of facets
     mScene->mRootNode->mName.Set("<STL_BINARY>");
 
-    pMesh->mNumFaces = *((uint32_t *)sz);
+    uint32_t numFaces = 0;
+    ::memcpy(&numFaces, sz, sizeof(uint32_t));
     sz += 4;
 
-    if (mFileSize < 84 + pMesh->mNumFaces * 50) {
+    if (mFileSize < 84 + static_cast<size_t>(numFaces) * 50) {
         throw DeadlyImportError("STL: file is too small to hold all facets");
     }
 
-    if (!pMesh->mNumFaces) {
+    if (!numFaces) {
         throw DeadlyImportError("STL: file is empty. There are no facets defined");
     }
 
+    if (numFaces > std::numeric_limits<unsigned int>::max() / 3) {
+        throw DeadlyImportError("STL: too many facets");
+    }
+
+    pMesh->mNumFaces = numFaces;
     pMesh->mNumVertices = pMesh->mNumFaces * 3;
 
     aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
     aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    typedef aiVector3t<float> aiVector3F;
-    aiVector3F *theVec;
-    aiVector3F theVec3F;
+    // facets are independent, decode them in parallel blocks
+    const unsigned char *facets = sz;
+    std::atomic<bool> hasColors(false);
+    ParallelFor(0, pMesh->mNumFaces, [&](size_t i) {
+        const unsigned char *facet = facets + i * 50;
 
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
         // NOTE: Blender sometimes writes empty normals ... this is not
         // our fault ... the RemoveInvalidData helper step should fix that
+        float values[12];
+        ::memcpy(values, facet, sizeof(values));
 
         // There's one normal for the face in the STL; use it three times
         // for vertex normals
-        theVec = (aiVector3F *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
-        *(vn + 1) = *vn;
-        *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
+        const aiVector3D normal(values[0], values[1], values[2]);
+        aiVector3D *n = vn + i * 3;
+        aiVector3D *p = vp + i * 3;
+        for (unsigned int v = 0; v < 3; ++v) {
+            n[v] = normal;
+            p[v].Set(values[3 + v * 3], values[4 + v * 3], values[5 + v * 3]);
+        }
 
+        uint16_t color;
+        ::memcpy(&color, facet + 48, sizeof(uint16_t));
         if (color & (1 << 15)) {
-            // seems we need to take the color
-            if (!pMesh->mColors[0]) {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
+            hasColors.store(true, std::memory_order_relaxed);
+        }
+    }, FacetGrain);
+
+    if (hasColors) {
+        // seems we need to take the color
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+        aiColor4D *colors = pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        const aiColor4D clrDefault = mClrColorDefault;
+        ParallelFor(0, pMesh->mNumFaces, [&](size_t i) {
+            uint16_t color;
+            ::memcpy(&color, facets + i * 50 + 48, sizeof(uint16_t));
+
+            aiColor4D *clr = colors + i * 3;
+            if (color & (1 << 15)) {
+                clr->a = 1.0;
+                const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+                if (bIsMaterialise) // this is reversed
+                {
+                    clr->r = (color & 0x31u) * invVal;
+                    clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
+                    clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
+                } else {
+                    clr->b = (color & 0x31u) * invVal;
+                    clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
+                    clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
                 }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
-
-                ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
-            }
-            aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
             } else {
-                clr->b = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
+                *clr = clrDefault;
             }
             // assign the color to all vertices of the face
             *(clr + 1) = *clr;
             *(clr + 2) = *clr;
-        }
+        }, FacetGrain);
     }
 
     // now copy faces
-    addFacesToMesh(pMesh);
+    if (mWeldVertices) {
+        WeldVertices(pMesh);
+    } else {
+        addFacesToMesh(pMesh, mContiguousIndices);
+    }
 
     aiNode *root = mScene->mRootNode;
 
@@ -570,6 +754,86 @@ bool STLImporter::LoadBinaryFile() {
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Merge identical vertices of an unindexed mesh
+void STLImporter::WeldVertices(aiMesh *pMesh) {
+    ai_assert(nullptr != pMesh);
+
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // hashing is the expensive part and independent per vertex
+    std::vector<uint32_t> hashes(numVertices);
+    ParallelFor(0, numVertices, [&](size_t i) {
+        hashes[i] = HashVertex(pMesh, static_cast<unsigned int>(i));
+    }, FacetGrain);
+
+    // open addressing with linear probing, the table holds the first occurrence of every
+    // distinct vertex and is kept at most half full
+    size_t tableSize = 16;
+    while (tableSize < static_cast<size_t>(numVertices) * 2) {
+        tableSize <<= 1;
+    }
+    const size_t mask = tableSize - 1;
+    std::vector<unsigned int> table(tableSize, UINT_MAX);
+
+    std::vector<unsigned int> remap(numVertices);
+    std::vector<unsigned int> firstOccurrence;
+    firstOccurrence.reserve(numVertices / 4);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        size_t slot = hashes[i] & mask;
+        for (;;) {
+            const unsigned int candidate = table[slot];
+            if (UINT_MAX == candidate) {
+                table[slot] = i;
+                remap[i] = static_cast<unsigned int>(firstOccurrence.size());
+                firstOccurrence.push_back(i);
+                break;
+            }
+            if (hashes[candidate] == hashes[i] && IsSameVertex(pMesh, candidate, i)) {
+                remap[i] = remap[candidate];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    const unsigned int numUnique = static_cast<unsigned int>(firstOccurrence.size());
+    ASSIMP_LOG_DEBUG_F("STL: welded ", numVertices, " vertices to ", numUnique);
+
+    aiVector3D *vertices = new aiVector3D[numUnique];
+    aiVector3D *normals = new aiVector3D[numUnique];
+    for (unsigned int i = 0; i < numUnique; ++i) {
+        vertices[i] = pMesh->mVertices[firstOccurrence[i]];
+        normals[i] = pMesh->mNormals[firstOccurrence[i]];
+    }
+    delete[] pMesh->mVertices;
+    delete[] pMesh->mNormals;
+    pMesh->mVertices = vertices;
+    pMesh->mNormals = normals;
+
+    if (pMesh->mColors[0]) {
+        aiColor4D *colors = new aiColor4D[numUnique];
+        for (unsigned int i = 0; i < numUnique; ++i) {
+            colors[i] = pMesh->mColors[0][firstOccurrence[i]];
+        }
+        delete[] pMesh->mColors[0];
+        pMesh->mColors[0] = colors;
+    }
+    pMesh->mNumVertices = numUnique;
+
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        pMesh->mFaces[i].mNumIndices = 3;
+    }
+    pMesh->AllocateFaceIndices(mContiguousIndices);
+    for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
+        aiFace &face = pMesh->mFaces[i];
+        for (unsigned int o = 0; o < 3; ++o, ++p) {
+            face.mIndices[o] = remap[p];
+        }
+    }
+}
+
 void STLImporter::pushMeshesToNode(std::vector<unsigned int> &meshIndices, aiNode *node) {
     ai_assert(nullptr != node);
     if (meshIndices.empty()) {
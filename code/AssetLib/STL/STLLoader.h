@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declarations
 struct aiNode;
+struct aiMesh;
 
 namespace Assimp {
 
@@ -76,6 +77,11 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /**
+     * @brief   Reads the loader configuration, see BaseImporter::SetupProperties().
+     */
+    void SetupProperties(const Importer* pImp);
+
 protected:
 
     /**
@@ -104,19 +110,31 @@ protected:
 
     void pushMeshesToNode( std::vector<unsigned int> &meshIndices, aiNode *node );
 
+    /**
+     * @brief   Merges identical vertices of an unindexed mesh and sets up
+     *          indexed faces.
+     */
+    void WeldVertices( aiMesh *pMesh );
+
 protected:
 
     /** Buffer to hold the loaded file */
     const char* mBuffer;
 
     /** Size of the file, in bytes */
-    unsigned int mFileSize;
+    size_t mFileSize;
 
     /** Output scene */
     aiScene* mScene;
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Merge identical vertices of binary files while loading */
+    bool mWeldVertices;
+
+    /** Store the face indices in one buffer, see aiMesh::mIndices */
+    bool mContiguousIndices;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,363 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  AnimationSampler.cpp
+ *  @brief Implementation of the AnimationSampler class
+ */
+#include <assimp/AnimationSampler.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Keys of one track, stored component by component: x, y, z and w for rotations
+struct Track {
+    std::vector<double> mTimes;
+    std::vector<ai_real> mValues[4];
+    unsigned int mCursor = 0;
+
+    bool Empty() const {
+        return mTimes.empty();
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+struct Channel {
+    Track mPosition;
+    Track mRotation;
+    Track mScaling;
+    aiAnimBehaviour mPreState;
+    aiAnimBehaviour mPostState;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Two keys and the interpolation factor between them
+struct KeyPair {
+    unsigned int mFirst;
+    unsigned int mSecond;
+    ai_real mFactor;
+};
+
+// ------------------------------------------------------------------------------------------------
+void CopyTrack(const aiVectorKey *keys, unsigned int numKeys, Track &track) {
+    track.mTimes.resize(numKeys);
+    for (unsigned int c = 0; c < 3; ++c) {
+        track.mValues[c].resize(numKeys);
+    }
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        track.mTimes[i] = keys[i].mTime;
+        track.mValues[0][i] = keys[i].mValue.x;
+        track.mValues[1][i] = keys[i].mValue.y;
+        track.mValues[2][i] = keys[i].mValue.z;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void CopyTrack(const aiQuatKey *keys, unsigned int numKeys, Track &track) {
+    track.mTimes.resize(numKeys);
+    for (unsigned int c = 0; c < 4; ++c) {
+        track.mValues[c].resize(numKeys);
+    }
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        track.mTimes[i] = keys[i].mTime;
+        track.mValues[0][i] = keys[i].mValue.x;
+        track.mValues[1][i] = keys[i].mValue.y;
+        track.mValues[2][i] = keys[i].mValue.z;
+        track.mValues[3][i] = keys[i].mValue.w;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Index of the key at or before time, time must lie within the keys of the track. The key of
+// the previous call and the one after it are tried before searching.
+unsigned int FindKey(Track &track, double time) {
+    const std::vector<double> &times = track.mTimes;
+    const size_t last = times.size() - 1;
+    const unsigned int cursor = track.mCursor;
+    if (cursor < last && times[cursor] <= time) {
+        if (time < times[cursor + 1]) {
+            return cursor;
+        }
+        if (cursor + 2 <= last && time < times[cursor + 2]) {
+            return ++track.mCursor;
+        }
+    }
+
+    const size_t index = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+    track.mCursor = static_cast<unsigned int>(std::min(std::max<size_t>(index, 1), last) - 1);
+    return track.mCursor;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves a time outside of [first, last) back into it, for aiAnimBehaviour_REPEAT
+double Wrap(double time, double first, double last) {
+    const double length = last - first;
+    if (length <= 0.0) {
+        return first;
+    }
+    double offset = std::fmod(time - first, length);
+    if (offset < 0.0) {
+        offset += length;
+    }
+    return first + offset;
+}
+
+// ------------------------------------------------------------------------------------------------
+KeyPair Interval(const Track &track, unsigned int first, double time) {
+    const double start = track.mTimes[first];
+    const double length = track.mTimes[first + 1] - start;
+    const ai_real factor = length > 0.0 ? static_cast<ai_real>((time - start) / length) : ai_real(0.0);
+    return { first, first + 1, factor };
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finds the keys to interpolate at time. Extrapolation (aiAnimBehaviour_LINEAR) returns factors
+// outside of [0, 1] and is only used if allowed for the track.
+KeyPair Locate(Track &track, const Channel &channel, double time, bool extrapolate) {
+    const std::vector<double> &times = track.mTimes;
+    const unsigned int last = static_cast<unsigned int>(times.size() - 1);
+    if (0 == last) {
+        return { 0, 0, 0 };
+    }
+
+    if (time < times[0]) {
+        if (aiAnimBehaviour_REPEAT == channel.mPreState) {
+            time = Wrap(time, times[0], times[last]);
+        } else if (aiAnimBehaviour_LINEAR == channel.mPreState && extrapolate) {
+            return Interval(track, 0, time);
+        } else {
+            return { 0, 0, 0 };
+        }
+    } else if (time >= times[last]) {
+        if (aiAnimBehaviour_REPEAT == channel.mPostState) {
+            time = Wrap(time, times[0], times[last]);
+        } else if (aiAnimBehaviour_LINEAR == channel.mPostState && extrapolate) {
+            return Interval(track, last - 1, time);
+        } else {
+            return { last, last, 0 };
+        }
+    }
+    return Interval(track, FindKey(track, time), time);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D SampleVector(Track &track, const Channel &channel, double time) {
+    const KeyPair keys = Locate(track, channel, time, true);
+    const ai_real *x = track.mValues[0].data();
+    const ai_real *y = track.mValues[1].data();
+    const ai_real *z = track.mValues[2].data();
+    const ai_real f = keys.mFactor;
+    return aiVector3D(x[keys.mFirst] + (x[keys.mSecond] - x[keys.mFirst]) * f,
+            y[keys.mFirst] + (y[keys.mSecond] - y[keys.mFirst]) * f,
+            z[keys.mFirst] + (z[keys.mSecond] - z[keys.mFirst]) * f);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+struct AnimationSampler::Impl {
+    std::vector<Channel> mChannels;
+
+    // Rotations to interpolate in the current call, component by component
+    std::vector<ai_real> mStart[4];
+    std::vector<ai_real> mEnd[4];
+    std::vector<ai_real> mFactor;
+    std::vector<unsigned int> mTarget;
+
+    std::vector<ChannelPose> mPoses;
+
+    void AddRotation(const Track &track, const KeyPair &keys, unsigned int target);
+    void InterpolateRotations(ChannelPose *poses);
+};
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Impl::AddRotation(const Track &track, const KeyPair &keys, unsigned int target) {
+    for (unsigned int c = 0; c < 4; ++c) {
+        mStart[c].push_back(track.mValues[c][keys.mFirst]);
+        mEnd[c].push_back(track.mValues[c][keys.mSecond]);
+    }
+    mFactor.push_back(keys.mFactor);
+    mTarget.push_back(target);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Slerp of all collected rotations, computed like aiQuaternion::Interpolate. The loop only
+// reads and writes contiguous arrays, so the compiler is free to vectorize it.
+void AnimationSampler::Impl::InterpolateRotations(ChannelPose *poses) {
+    const size_t count = mFactor.size();
+    const ai_real *ax = mStart[0].data(), *ay = mStart[1].data(), *az = mStart[2].data(), *aw = mStart[3].data();
+    ai_real *bx = mEnd[0].data(), *by = mEnd[1].data(), *bz = mEnd[2].data(), *bw = mEnd[3].data();
+    const ai_real *factor = mFactor.data();
+
+    // the results overwrite the end rotations
+    for (size_t i = 0; i < count; ++i) {
+        ai_real cosom = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+        const ai_real sign = cosom < ai_real(0.0) ? ai_real(-1.0) : ai_real(1.0);
+        cosom *= sign;
+
+        ai_real sclp = ai_real(1.0) - factor[i];
+        ai_real sclq = factor[i];
+        if ((ai_real(1.0) - cosom) > ai_real(0.0001)) {
+            const ai_real omega = std::acos(cosom);
+            const ai_real sinom = std::sin(omega);
+            sclp = std::sin((ai_real(1.0) - factor[i]) * omega) / sinom;
+            sclq = std::sin(factor[i] * omega) / sinom;
+        }
+        sclq *= sign;
+
+        bx[i] = sclp * ax[i] + sclq * bx[i];
+        by[i] = sclp * ay[i] + sclq * by[i];
+        bz[i] = sclp * az[i] + sclq * bz[i];
+        bw[i] = sclp * aw[i] + sclq * bw[i];
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        poses[mTarget[i]].mRotation = aiQuaternion(bw[i], bx[i], by[i], bz[i]);
+    }
+    for (unsigned int c = 0; c < 4; ++c) {
+        mStart[c].clear();
+        mEnd[c].clear();
+    }
+    mFactor.clear();
+    mTarget.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::AnimationSampler(const aiAnimation *anim) :
+        mImpl(new Impl) {
+    ai_assert(nullptr != anim);
+
+    mImpl->mChannels.resize(anim->mNumChannels);
+    for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+        const aiNodeAnim *nodeAnim = anim->mChannels[i];
+        Channel &channel = mImpl->mChannels[i];
+        CopyTrack(nodeAnim->mPositionKeys, nodeAnim->mNumPositionKeys, channel.mPosition);
+        CopyTrack(nodeAnim->mRotationKeys, nodeAnim->mNumRotationKeys, channel.mRotation);
+        CopyTrack(nodeAnim->mScalingKeys, nodeAnim->mNumScalingKeys, channel.mScaling);
+        channel.mPreState = nodeAnim->mPreState;
+        channel.mPostState = nodeAnim->mPostState;
+    }
+    for (unsigned int c = 0; c < 4; ++c) {
+        mImpl->mStart[c].reserve(anim->mNumChannels);
+        mImpl->mEnd[c].reserve(anim->mNumChannels);
+    }
+    mImpl->mFactor.reserve(anim->mNumChannels);
+    mImpl->mTarget.reserve(anim->mNumChannels);
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::~AnimationSampler() {
+    delete mImpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetNumChannels() const {
+    return static_cast<unsigned int>(mImpl->mChannels.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Sample(double time, ChannelPose *poses) {
+    ai_assert(nullptr != poses || mImpl->mChannels.empty());
+
+    for (unsigned int i = 0; i < mImpl->mChannels.size(); ++i) {
+        Channel &channel = mImpl->mChannels[i];
+        ChannelPose &pose = poses[i];
+        pose = ChannelPose();
+
+        if (!channel.mPosition.Empty()) {
+            pose.mPosition = SampleVector(channel.mPosition, channel, time);
+        }
+        if (!channel.mScaling.Empty()) {
+            pose.mScaling = SampleVector(channel.mScaling, channel, time);
+        }
+        if (!channel.mRotation.Empty()) {
+            // rotations are not extrapolated, slerp beyond the keys is meaningless
+            const KeyPair keys = Locate(channel.mRotation, channel, time, false);
+            if (keys.mFirst == keys.mSecond) {
+                const Track &track = channel.mRotation;
+                pose.mRotation = aiQuaternion(track.mValues[3][keys.mFirst], track.mValues[0][keys.mFirst],
+                        track.mValues[1][keys.mFirst], track.mValues[2][keys.mFirst]);
+            } else {
+                mImpl->AddRotation(channel.mRotation, keys, i);
+            }
+        }
+    }
+    mImpl->InterpolateRotations(poses);
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Sample(double time, aiMatrix4x4 *transforms) {
+    ai_assert(nullptr != transforms || mImpl->mChannels.empty());
+
+    mImpl->mPoses.resize(mImpl->mChannels.size());
+    Sample(time, mImpl->mPoses.data());
+    for (size_t i = 0; i < mImpl->mPoses.size(); ++i) {
+        const ChannelPose &pose = mImpl->mPoses[i];
+        transforms[i] = aiMatrix4x4(pose.mScaling, pose.mRotation, pose.mPosition);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::SampleFrames(double startTime, double timeStep, unsigned int numFrames, ChannelPose *poses) {
+    const size_t numChannels = mImpl->mChannels.size();
+    for (unsigned int frame = 0; frame < numFrames; ++frame) {
+        Sample(startTime + frame * timeStep, poses + frame * numChannels);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::ResetCursors() {
+    for (Channel &channel : mImpl->mChannels) {
+        channel.mPosition.mCursor = 0;
+        channel.mRotation.mCursor = 0;
+        channel.mScaling.mCursor = 0;
+    }
+}
+
+} // namespace Assimp
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
+#include <assimp/MemoryTracker.hpp>
 
 #include "CApi/CInterfaceIOWrapper.h"
 #include "Importer.h"
@@ -496,6 +497,46 @@ void aiGetMemoryRequirements(const C_STRUCT aiScene *pIn,
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the number of recorded memory phases of a particular import.
+unsigned int aiGetMemoryPhaseCount(const C_STRUCT aiScene *pIn) {
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    const ScenePrivateData *priv = ScenePriv(pIn);
+    if (!priv || !priv->mOrigImporter) {
+        ReportSceneNotFoundError();
+        return 0;
+    }
+
+    const MemoryTracker *tracker = priv->mOrigImporter->GetMemoryTracker();
+    return nullptr != tracker ? tracker->GetNumPhases() : 0;
+    ASSIMP_END_EXCEPTION_REGION(unsigned int);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a recorded memory phase of a particular import.
+aiReturn aiGetMemoryPhaseInfo(const C_STRUCT aiScene *pIn,
+        unsigned int index,
+        C_STRUCT aiMemoryPhaseInfo *info) {
+    ai_assert(nullptr != info);
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    const ScenePrivateData *priv = ScenePriv(pIn);
+    if (!priv || !priv->mOrigImporter) {
+        ReportSceneNotFoundError();
+        return aiReturn_FAILURE;
+    }
+
+    const MemoryTracker *tracker = priv->mOrigImporter->GetMemoryTracker();
+    const aiMemoryPhaseInfo *phase = nullptr != tracker ? tracker->GetPhase(index) : nullptr;
+    if (nullptr == phase) {
+        return aiReturn_FAILURE;
+    }
+    *info = *phase;
+    return aiReturn_SUCCESS;
+    ASSIMP_END_EXCEPTION_REGION(aiReturn);
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiPropertyStore *aiCreatePropertyStore(void) {
     return reinterpret_cast<aiPropertyStore *>(new PropertyMap());
@@ -0,0 +1,233 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  AsyncLogStream.cpp
+ *  @brief Implementation of AsyncLogStream
+ */
+#include <assimp/AsyncLogStream.hpp>
+#include <assimp/Logger.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <memory>
+#include <thread>
+#endif
+
+namespace Assimp {
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+
+// ----------------------------------------------------------------------------------
+// Bounded multi-producer queue after Dmitry Vyukov. Each slot carries a sequence number
+// which tells producers and the consumer whether it is free or holds a message.
+struct AsyncLogStream::Impl {
+    // room for a message of DefaultLogger, including its prefix and the new-line
+    static const size_t MaxLength = MAX_LOG_MESSAGE_LENGTH + 32;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        char message[MaxLength];
+    };
+
+    LogStream *target;
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<size_t> enqueuePos;
+    std::atomic<size_t> dequeuePos;
+    std::atomic<unsigned int> dropped;
+    std::atomic<bool> stop;
+    std::mutex wakeupMutex;
+    std::condition_variable wakeup;
+    std::thread worker;
+
+    Impl(LogStream *target_, unsigned int capacity) :
+            target(target_),
+            slots(),
+            mask(0),
+            enqueuePos(0),
+            dequeuePos(0),
+            dropped(0),
+            stop(false) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        worker = std::thread(&Impl::Run, this);
+    }
+
+    ~Impl() {
+        stop.store(true);
+        wakeup.notify_one();
+        worker.join();
+        delete target;
+    }
+
+    void Push(const char *message) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        for (;;) {
+            slot = &slots[pos & mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+            if (0 == diff) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the buffer is full
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        const size_t length = std::min(::strlen(message), MaxLength - 1);
+        ::memcpy(slot->message, message, length);
+        slot->message[length] = '\0';
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        wakeup.notify_one();
+    }
+
+    // writes all messages which are ready, returns false if there were none
+    bool Drain() {
+        bool any = false;
+        for (;;) {
+            const size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Slot &slot = slots[pos & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return any;
+            }
+            target->write(slot.message);
+            slot.sequence.store(pos + mask + 1, std::memory_order_release);
+            dequeuePos.store(pos + 1, std::memory_order_release);
+            any = true;
+        }
+    }
+
+    void Run() {
+        while (!stop.load()) {
+            if (!Drain()) {
+                // producers don't take the mutex, so a wakeup may be missed, hence the timeout
+                std::unique_lock<std::mutex> lock(wakeupMutex);
+                wakeup.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+        Drain();
+    }
+
+    void Flush() {
+        const size_t end = enqueuePos.load();
+        while (dequeuePos.load(std::memory_order_acquire) < end) {
+            wakeup.notify_one();
+            std::this_thread::yield();
+        }
+    }
+};
+
+#else // ASSIMP_BUILD_NO_PARALLEL
+
+// ----------------------------------------------------------------------------------
+// Without threads, messages are written right away.
+struct AsyncLogStream::Impl {
+    LogStream *target;
+    unsigned int dropped;
+
+    Impl(LogStream *target_, unsigned int /*capacity*/) :
+            target(target_),
+            dropped(0) {}
+
+    ~Impl() {
+        delete target;
+    }
+
+    void Push(const char *message) {
+        target->write(message);
+    }
+
+    void Flush() {
+        // nothing to be done
+    }
+};
+
+#endif // ASSIMP_BUILD_NO_PARALLEL
+
+// ----------------------------------------------------------------------------------
+AsyncLogStream::AsyncLogStream(LogStream *target, unsigned int capacity) :
+        mImpl(new Impl(target, capacity)) {
+    ai_assert(nullptr != target);
+}
+
+// ----------------------------------------------------------------------------------
+AsyncLogStream::~AsyncLogStream() {
+    delete mImpl;
+}
+
+// ----------------------------------------------------------------------------------
+void AsyncLogStream::write(const char *message) {
+    mImpl->Push(message);
+}
+
+// ----------------------------------------------------------------------------------
+void AsyncLogStream::flush() {
+    mImpl->Flush();
+}
+
+// ----------------------------------------------------------------------------------
+unsigned int AsyncLogStream::getNumDropped() const {
+    return mImpl->dropped;
+}
+
+} // namespace Assimp
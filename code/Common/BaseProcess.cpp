@@ -94,7 +94,17 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsRequested(const Importer * /*pImp*/) const {
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::SupportsIndexBuffer() const {
+    return false;
+}
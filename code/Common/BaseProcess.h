@@ -194,11 +194,30 @@ public:
     */
     virtual bool IsActive(unsigned int pFlags) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is enabled by a configuration
+     * property of the importer. All bits of #aiPostProcessSteps are taken,
+     * so newer steps are enabled this way and run in addition to the
+     * steps given by the flags.
+     * @param pImp Importer instance to read the properties from.
+     * @return true if the step should run, the default implementation
+     *   returns false.
+    */
+    virtual bool IsRequested(const Importer *pImp) const;
+
     // -------------------------------------------------------------------
     /** Check whether this step expects its input vertex data to be
      *  in verbose format. */
     virtual bool RequireVerboseFormat() const;
 
+    // -------------------------------------------------------------------
+    /** Check whether this step works on meshes whose faces point into
+     *  aiMesh::mIndices. Such steps only read the faces or change their
+     *  indices in place. Before any other step runs, the Importer gives
+     *  each face its own index array again.
+     *  @return The default implementation returns false. */
+    virtual bool SupportsIndexBuffer() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * The function deletes the scene if the postprocess step fails (
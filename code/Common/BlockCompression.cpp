@@ -0,0 +1,595 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file BlockCompression.cpp
+ *  @brief Implementation of the block container.
+ */
+#include "BlockCompression.h"
+#include "ParallelFor.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#   include <zlib.h>
+#else
+#   include "../contrib/zlib/zlib.h"
+#endif
+
+#ifdef ASSIMP_BUILD_ZSTD
+#   include <zstd.h>
+#endif
+
+namespace Assimp {
+
+// size of the container header and of each block header, in bytes
+static const size_t ContainerHeaderSize = 24;
+static const size_t BlockHeaderSize = 8;
+
+// size of the fixed part of a patch table entry, in bytes
+static const size_t PatchHeaderSize = 12;
+
+// upper limit for the block size, the decoder allocates a batch of blocks at once
+static const size_t MaxBlockSize = 256 * 1024 * 1024;
+
+// ------------------------------------------------------------------------------------------------
+static size_t GetBatchSize() {
+    // two blocks per thread keep all workers busy if the blocks compress unevenly
+    return std::max<size_t>(2, 2 * GetParallelWorkerCount());
+}
+
+// ------------------------------------------------------------------------------------------------
+static void CompressBlock(BlockCodec codec, const unsigned char *in, size_t size, std::vector<unsigned char> &out) {
+    if (codec == BlockCodec_Deflate) {
+        uLongf packed = compressBound(static_cast<uLong>(size));
+        out.resize(packed);
+        if (Z_OK != compress2(out.data(), &packed, in, static_cast<uLong>(size), 9)) {
+            throw DeadlyExportError("Compression failed.");
+        }
+        out.resize(packed);
+        return;
+    }
+#ifdef ASSIMP_BUILD_ZSTD
+    if (codec == BlockCodec_ZStd) {
+        out.resize(ZSTD_compressBound(size));
+        const size_t packed = ZSTD_compress(out.data(), out.size(), in, size, 3);
+        if (ZSTD_isError(packed)) {
+            throw DeadlyExportError("Compression failed: ", ZSTD_getErrorName(packed));
+        }
+        out.resize(packed);
+        return;
+    }
+#endif
+    throw DeadlyExportError("Unsupported compression codec");
+}
+
+// ------------------------------------------------------------------------------------------------
+static void DecompressBlock(BlockCodec codec, const std::vector<unsigned char> &in, std::vector<unsigned char> &out) {
+    if (codec == BlockCodec_Deflate) {
+        uLongf size = static_cast<uLongf>(out.size());
+        if (Z_OK != uncompress(out.data(), &size, in.data(), static_cast<uLong>(in.size())) || size != out.size()) {
+            throw DeadlyImportError("Zlib decompression failed.");
+        }
+        return;
+    }
+#ifdef ASSIMP_BUILD_ZSTD
+    if (codec == BlockCodec_ZStd) {
+        const size_t size = ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+        if (ZSTD_isError(size) || size != out.size()) {
+            throw DeadlyImportError("Zstd decompression failed.");
+        }
+        return;
+    }
+#endif
+    throw DeadlyImportError("Unsupported compression codec");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsBlockCodecSupported(BlockCodec codec) {
+    switch (codec) {
+    case BlockCodec_Deflate:
+        return true;
+    case BlockCodec_ZStd:
+#ifdef ASSIMP_BUILD_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteCompressedBlocks(IOStream *out, const void *data, size_t size, BlockCodec codec, size_t blockSize) {
+    BlockCompressIOStream stream(out, codec, size, blockSize);
+    stream.Write(data, 1, size);
+    stream.Finish();
+}
+
+// ------------------------------------------------------------------------------------------------
+BlockCompressIOStream::BlockCompressIOStream(IOStream *out, BlockCodec codec, uint64_t size, size_t blockSize) :
+        mOut(out),
+        mCodec(codec),
+        mBlockSize(blockSize),
+        mSize(size),
+        mHeaderPos(0),
+        mPos(0),
+        mEnd(0),
+        mFlushed(0),
+        mPending(),
+        mPacked(),
+        mPatches() {
+    ai_assert(nullptr != mOut);
+    if (!IsBlockCodecSupported(codec)) {
+        throw DeadlyExportError("Unsupported compression codec, assimp might have been built without support for it");
+    }
+    if (0 == blockSize || blockSize > MaxBlockSize) {
+        throw DeadlyExportError("Invalid compression block size");
+    }
+
+    // the total size and the patch table offset are completed by Finish() if necessary
+    const uint32_t header[2] = { static_cast<uint32_t>(codec), static_cast<uint32_t>(blockSize) };
+    const uint64_t sizes[2] = { mSize == UnknownSize ? 0 : mSize, 0 };
+    mHeaderPos = mOut->Tell();
+    mOut->Write(header, sizeof(uint32_t), 2);
+    mOut->Write(sizes, sizeof(uint64_t), 2);
+
+    if (mSize == UnknownSize) {
+        mPacked.resize(GetBatchSize());
+    } else {
+        const uint64_t numBlocks = (mSize + mBlockSize - 1) / mBlockSize;
+        const size_t batchSize = static_cast<size_t>(std::min<uint64_t>(GetBatchSize(), numBlocks));
+        mPending.reserve(static_cast<size_t>(std::min<uint64_t>(batchSize * mBlockSize, mSize)));
+        mPacked.resize(batchSize);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+BlockCompressIOStream::~BlockCompressIOStream() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockCompressIOStream::WriteBatch() {
+    const size_t count = (mPending.size() + mBlockSize - 1) / mBlockSize;
+    ai_assert(count <= mPacked.size());
+    ParallelFor(0, count, [&](size_t i) {
+        const size_t offset = i * mBlockSize;
+        CompressBlock(mCodec, mPending.data() + offset, std::min(mBlockSize, mPending.size() - offset), mPacked[i]);
+    });
+
+    // write in order, so the container can be read sequentially
+    for (size_t i = 0; i < count; ++i) {
+        const size_t offset = i * mBlockSize;
+        const uint32_t sizes[2] = {
+            static_cast<uint32_t>(std::min(mBlockSize, mPending.size() - offset)),
+            static_cast<uint32_t>(mPacked[i].size())
+        };
+        mOut->Write(sizes, sizeof(uint32_t), 2);
+        mOut->Write(mPacked[i].data(), 1, mPacked[i].size());
+    }
+    mFlushed += mPending.size();
+    mPending.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockCompressIOStream::Overwrite(const unsigned char *in, size_t size) {
+    ai_assert(mPos + size <= mEnd);
+
+    // bytes which have been compressed already become a patch, pending bytes are changed in place
+    if (mPos < mFlushed) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(size, mFlushed - mPos));
+
+        // merge with all patches the new one overlaps or touches, so they stay disjoint
+        uint64_t begin = mPos, end = mPos + n;
+        auto first = mPatches.lower_bound(begin);
+        if (first != mPatches.begin()) {
+            auto prev = std::prev(first);
+            if (prev->first + prev->second.size() >= begin) {
+                first = prev;
+            }
+        }
+        auto last = first;
+        while (last != mPatches.end() && last->first <= end) {
+            begin = std::min(begin, last->first);
+            end = std::max<uint64_t>(end, last->first + last->second.size());
+            ++last;
+        }
+
+        std::vector<unsigned char> merged(static_cast<size_t>(end - begin));
+        for (auto it = first; it != last; ++it) {
+            std::copy(it->second.begin(), it->second.end(), merged.begin() + static_cast<size_t>(it->first - begin));
+        }
+        std::copy(in, in + n, merged.begin() + static_cast<size_t>(mPos - begin));
+        mPatches.erase(first, last);
+        mPatches[begin].swap(merged);
+
+        in += n;
+        size -= n;
+        mPos += n;
+    }
+    if (size) {
+        ::memcpy(&mPending[static_cast<size_t>(mPos - mFlushed)], in, size);
+        mPos += size;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockCompressIOStream::Finish() {
+    if (mSize != UnknownSize && mEnd != mSize) {
+        throw DeadlyExportError("Compressed stream size mismatch");
+    }
+    if (!mPending.empty()) {
+        WriteBatch();
+    }
+
+    uint64_t patchTable = 0;
+    if (!mPatches.empty()) {
+        patchTable = mOut->Tell() - mHeaderPos;
+        const uint64_t count = mPatches.size();
+        mOut->Write(&count, sizeof(uint64_t), 1);
+        for (const auto &patch : mPatches) {
+            const uint32_t size = static_cast<uint32_t>(patch.second.size());
+            mOut->Write(&patch.first, sizeof(uint64_t), 1);
+            mOut->Write(&size, sizeof(uint32_t), 1);
+            mOut->Write(patch.second.data(), 1, patch.second.size());
+        }
+    }
+
+    // complete the header if it was written without knowing everything
+    if (mSize == UnknownSize || 0 != patchTable) {
+        const size_t end = mOut->Tell();
+        const uint64_t sizes[2] = { mEnd, patchTable };
+        if (aiReturn_SUCCESS != mOut->Seek(mHeaderPos + 2 * sizeof(uint32_t), aiOrigin_SET)) {
+            throw DeadlyExportError("Block container: The output stream must be seekable");
+        }
+        mOut->Write(sizes, sizeof(uint64_t), 2);
+        mOut->Seek(end, aiOrigin_SET);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockCompressIOStream::Read(void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    ai_assert(false); // write-only stream
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockCompressIOStream::Write(const void *pvBuffer, size_t pSize, size_t pCount) {
+    const size_t batchBytes = mPacked.size() * mBlockSize;
+    const unsigned char *in = static_cast<const unsigned char *>(pvBuffer);
+    size_t remaining = pSize * pCount;
+    if (mSize != UnknownSize && mPos + remaining > mSize) {
+        throw DeadlyExportError("Compressed stream size mismatch");
+    }
+
+    // after seeking back, data written before is replaced first
+    if (mPos < mEnd) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(remaining, mEnd - mPos));
+        Overwrite(in, n);
+        in += n;
+        remaining -= n;
+    }
+
+    while (remaining) {
+        const size_t chunk = std::min(remaining, batchBytes - mPending.size());
+        mPending.insert(mPending.end(), in, in + chunk);
+        in += chunk;
+        remaining -= chunk;
+        mPos += chunk;
+        mEnd = mPos;
+        if (mPending.size() == batchBytes) {
+            WriteBatch();
+        }
+    }
+    return pCount;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn BlockCompressIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    uint64_t target = 0;
+    if (aiOrigin_SET == pOrigin) {
+        target = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mEnd) {
+            return AI_FAILURE;
+        }
+        target = mEnd - pOffset;
+    } else {
+        target = mPos + pOffset;
+    }
+
+    // only data written before can be replaced, there must be no gaps
+    if (target > mEnd) {
+        return AI_FAILURE;
+    }
+    mPos = target;
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockCompressIOStream::Tell() const {
+    return static_cast<size_t>(mPos);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockCompressIOStream::FileSize() const {
+    return static_cast<size_t>(mEnd);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockCompressIOStream::Flush() {
+    // blocks are written as soon as a batch is complete, partial blocks can't be flushed
+}
+
+// ------------------------------------------------------------------------------------------------
+BlockDecompressIOStream::BlockDecompressIOStream(IOStream *source) :
+        mSource(source),
+        mCodec(BlockCodec_Deflate),
+        mBlockSize(0),
+        mSize(0),
+        mPos(0),
+        mSourceSize(0),
+        mBlocks(),
+        mPatches(),
+        mMaxPatchSize(0),
+        mNextHeader(0),
+        mBatchFirst(0),
+        mBatch(),
+        mPacked() {
+    ai_assert(nullptr != mSource);
+
+    const size_t start = mSource->Tell();
+    uint32_t header[2] = { 0, 0 };
+    uint64_t sizes[2] = { 0, 0 };
+    if (2 != mSource->Read(header, sizeof(uint32_t), 2) || 2 != mSource->Read(sizes, sizeof(uint64_t), 2)) {
+        throw DeadlyImportError("Unexpected EOF");
+    }
+
+    mCodec = static_cast<BlockCodec>(header[0]);
+    mBlockSize = header[1];
+    mSize = static_cast<size_t>(sizes[0]);
+    mSourceSize = mSource->FileSize();
+    if (!IsBlockCodecSupported(mCodec)) {
+        throw DeadlyImportError("Unsupported compression codec, assimp might have been built without support for it");
+    }
+    if ((0 == mBlockSize && 0 != mSize) || mBlockSize > MaxBlockSize || sizes[0] > std::numeric_limits<size_t>::max()) {
+        throw DeadlyImportError("Invalid compression block size");
+    }
+
+    mNextHeader = start + ContainerHeaderSize;
+    if (0 != sizes[1]) {
+        ReadPatches(start, sizes[1]);
+    }
+    mBatchFirst = mBlockSize ? (mSize + mBlockSize - 1) / mBlockSize : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockDecompressIOStream::ReadPatches(size_t start, uint64_t offset) {
+    uint64_t count = 0;
+    if (offset > mSourceSize - start || aiReturn_SUCCESS != mSource->Seek(static_cast<size_t>(start + offset), aiOrigin_SET) ||
+            1 != mSource->Read(&count, sizeof(uint64_t), 1)) {
+        throw DeadlyImportError("Invalid patch table");
+    }
+
+    // sizes come from the file, so check them against what is left of it before allocating
+    size_t left = mSourceSize - mSource->Tell();
+    if (count > left / PatchHeaderSize) {
+        throw DeadlyImportError("Invalid patch table");
+    }
+    mPatches.resize(static_cast<size_t>(count));
+    for (Patch &patch : mPatches) {
+        uint64_t position = 0;
+        uint32_t size = 0;
+        if (1 != mSource->Read(&position, sizeof(uint64_t), 1) || 1 != mSource->Read(&size, sizeof(uint32_t), 1)) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+        left -= PatchHeaderSize;
+        const size_t previousEnd = (&patch == mPatches.data()) ? 0 : (&patch)[-1].offset + (&patch)[-1].data.size();
+        if (size > left || position > mSize || size > mSize - position || position < previousEnd) {
+            throw DeadlyImportError("Invalid patch table");
+        }
+        patch.offset = static_cast<size_t>(position);
+        patch.data.resize(size);
+        if (size && 1 != mSource->Read(patch.data.data(), size, 1)) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+        left -= size;
+        mMaxPatchSize = std::max<size_t>(mMaxPatchSize, size);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+BlockDecompressIOStream::~BlockDecompressIOStream() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockDecompressIOStream::DiscoverBlocks(size_t last) {
+    // block headers are chained, so we have to walk them to find a block
+    while (mBlocks.size() <= last) {
+        uint32_t sizes[2] = { 0, 0 };
+        if (aiReturn_SUCCESS != mSource->Seek(mNextHeader, aiOrigin_SET) || 2 != mSource->Read(sizes, sizeof(uint32_t), 2)) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+
+        // the compressed size is checked against the file before anything gets allocated for it
+        const size_t index = mBlocks.size();
+        const size_t expected = std::min(mBlockSize, mSize - index * mBlockSize);
+        if (sizes[0] != expected || sizes[1] > mSourceSize - std::min(mSourceSize, mNextHeader + BlockHeaderSize)) {
+            throw DeadlyImportError("Invalid compressed block");
+        }
+
+        Block block;
+        block.offset = mNextHeader + BlockHeaderSize;
+        block.rawSize = sizes[0];
+        block.packedSize = sizes[1];
+        mBlocks.push_back(block);
+        mNextHeader = block.offset + block.packedSize;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockDecompressIOStream::LoadBatch(size_t first) {
+    const size_t numBlocks = (mSize + mBlockSize - 1) / mBlockSize;
+    const size_t count = std::min(GetBatchSize(), numBlocks - first);
+    DiscoverBlocks(first + count - 1);
+
+    // read sequentially, then decompress in parallel
+    mBatch.resize(count);
+    mPacked.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Block &block = mBlocks[first + i];
+        mPacked[i].resize(block.packedSize);
+        mBatch[i].resize(block.rawSize);
+        if (aiReturn_SUCCESS != mSource->Seek(block.offset, aiOrigin_SET) ||
+                (block.packedSize && 1 != mSource->Read(mPacked[i].data(), block.packedSize, 1))) {
+            throw DeadlyImportError("Unexpected EOF");
+        }
+    }
+
+    mBatchFirst = numBlocks; // invalid until decompressed completely
+    ParallelFor(0, count, [&](size_t i) {
+        DecompressBlock(mCodec, mPacked[i], mBatch[i]);
+    });
+    ApplyPatches(first);
+    mBatchFirst = first;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockDecompressIOStream::ApplyPatches(size_t first) {
+    if (mPatches.empty()) {
+        return;
+    }
+
+    // patches are sorted by offset, the first one to look at may start in front of the batch
+    const size_t begin = first * mBlockSize;
+    const size_t end = begin + (mBatch.size() - 1) * mBlockSize + mBatch.back().size();
+    const size_t from = begin - std::min(begin, mMaxPatchSize);
+    std::vector<Patch>::const_iterator it = std::lower_bound(mPatches.begin(), mPatches.end(), from,
+            [](const Patch &patch, size_t offset) { return patch.offset < offset; });
+    for (; it != mPatches.end() && it->offset < end; ++it) {
+        for (size_t i = 0; i < it->data.size(); ++i) {
+            const size_t pos = it->offset + i;
+            if (pos >= begin && pos < end) {
+                const size_t index = pos / mBlockSize;
+                mBatch[index - first][pos - index * mBlockSize] = it->data[i];
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockDecompressIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    ai_assert(nullptr != pvBuffer);
+    ai_assert(0 != pSize);
+
+    const size_t cnt = std::min(pCount, (mSize - std::min(mPos, mSize)) / pSize);
+    unsigned char *out = static_cast<unsigned char *>(pvBuffer);
+    size_t remaining = cnt * pSize;
+    while (remaining > 0) {
+        const size_t index = mPos / mBlockSize;
+        if (index < mBatchFirst || index >= mBatchFirst + mBatch.size()) {
+            LoadBatch(index);
+        }
+
+        const std::vector<unsigned char> &block = mBatch[index - mBatchFirst];
+        const size_t offset = mPos - index * mBlockSize;
+        const size_t n = std::min(remaining, block.size() - offset);
+        ::memcpy(out, block.data() + offset, n);
+        out += n;
+        mPos += n;
+        remaining -= n;
+    }
+    return cnt;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockDecompressIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    ai_assert(false); // read-only stream
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn BlockDecompressIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t target = 0;
+    if (aiOrigin_SET == pOrigin) {
+        target = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        target = mSize - pOffset;
+    } else {
+        target = mPos + pOffset;
+    }
+    if (target > mSize) {
+        return AI_FAILURE;
+    }
+
+    // blocks are loaded lazily by the next read
+    mPos = target;
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockDecompressIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BlockDecompressIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlockDecompressIOStream::Flush() {
+    // read-only stream, nothing to be done
+}
+
+} // end of namespace Assimp
@@ -0,0 +1,232 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file BlockCompression.h
+ *  @brief Container of independently compressed blocks, compressed and decompressed in parallel.
+ */
+#pragma once
+#ifndef AI_BLOCKCOMPRESSION_H_INC
+#define AI_BLOCKCOMPRESSION_H_INC
+
+#include <assimp/IOStream.hpp>
+
+#include <map>
+#include <vector>
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** @brief Compression codecs for block containers.
+ *
+ *  The numeric values are stored in the container header, don't change them. */
+// --------------------------------------------------------------------------------------------
+enum BlockCodec {
+    BlockCodec_Deflate = 1, ///< zlib, always available
+    BlockCodec_ZStd = 2 ///< zstd, only if assimp was built with ASSIMP_BUILD_ZSTD
+};
+
+/// Default number of uncompressed bytes per block.
+static const size_t BlockDefaultSize = 1024 * 1024;
+
+// --------------------------------------------------------------------------------------------
+/** @brief Returns whether assimp was built with support for a given codec. */
+// --------------------------------------------------------------------------------------------
+ASSIMP_API bool IsBlockCodecSupported(BlockCodec codec);
+
+// --------------------------------------------------------------------------------------------
+/** @brief Writes a buffer as a block container.
+ *
+ *  Layout (little endian, as everything in assimp's binary formats):
+ *  @verbatim
+ *  integer     codec (BlockCodec)
+ *  integer     uncompressed size of each block, except for the last one
+ *  int64       total uncompressed size
+ *  int64       offset of the patch table from the start of the container, 0 if none
+ *  [for each block]
+ *      integer     uncompressed size of the block
+ *      integer     compressed size of the block
+ *      byte[n]     compressed data
+ *  [patch table]
+ *      int64       number of patches
+ *      [for each patch, sorted by offset, patches don't overlap]
+ *          int64       offset in the uncompressed data
+ *          integer     size of the patch
+ *          byte[n]     data replacing the uncompressed bytes
+ *  @endverbatim
+ *  Blocks are compressed in batches on all worker threads, so only a few compressed
+ *  blocks are held in memory at a time.
+ *  @param out Stream to write to
+ *  @param data Data to compress
+ *  @param size Number of bytes in @c data
+ *  @param codec Codec to use, must be supported
+ *  @param blockSize Uncompressed bytes per block
+ *  @throw DeadlyExportError if compression fails. */
+// --------------------------------------------------------------------------------------------
+ASSIMP_API void WriteCompressedBlocks(IOStream *out, const void *data, size_t size,
+        BlockCodec codec, size_t blockSize = BlockDefaultSize);
+
+// --------------------------------------------------------------------------------------------
+/** @brief Write-only IOStream which produces a block container.
+ *
+ *  The layout is the same as for #WriteCompressedBlocks. Written data is collected until
+ *  a batch of blocks is complete, the batch is then compressed on all worker threads and
+ *  written out. Memory usage is bounded by the batch size, independent of the amount of
+ *  data written.
+ *
+ *  Data written before can be overwritten by seeking back, which allows writers to
+ *  patch size fields once they are known. Bytes which are still pending are changed in
+ *  place, bytes in blocks which have been compressed already go to the patch table. If
+ *  the total size is not given up front or there are patches, #Finish seeks back in the
+ *  output stream to complete the container header. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API BlockCompressIOStream : public IOStream {
+public:
+    /// Passed as size if the total size is not known on construction.
+    static const uint64_t UnknownSize = ~static_cast<uint64_t>(0);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Construction, writes the container header.
+     *  @param out Stream to write to, not owned. It must outlive this object.
+     *  @param codec Codec to use, must be supported
+     *  @param size Total number of bytes which will be written, or #UnknownSize
+     *  @param blockSize Uncompressed bytes per block
+     *  @throw DeadlyExportError if the codec or the block size is invalid. */
+    BlockCompressIOStream(IOStream *out, BlockCodec codec, uint64_t size = UnknownSize, size_t blockSize = BlockDefaultSize);
+
+    /// Destructor. Data not written by #Finish is lost.
+    ~BlockCompressIOStream() override;
+
+    // ----------------------------------------------------------------------------
+    /** @brief Compresses and writes the remaining blocks and the patch table.
+     *  @throw DeadlyExportError if compression fails, the number of bytes written
+     *    differs from the size given on construction or the header can't be completed
+     *    because the output stream is not seekable. */
+    void Finish();
+
+    // IOStream interface, see there for documentation.
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+private:
+    void WriteBatch();
+    void Overwrite(const unsigned char *in, size_t size);
+
+private:
+    IOStream *mOut;
+    BlockCodec mCodec;
+    size_t mBlockSize;
+    uint64_t mSize;
+    size_t mHeaderPos;
+    uint64_t mPos;
+    uint64_t mEnd;
+    uint64_t mFlushed;
+    std::vector<unsigned char> mPending;
+    std::vector<std::vector<unsigned char>> mPacked;
+    std::map<uint64_t, std::vector<unsigned char>> mPatches; ///< Disjoint, by offset
+};
+
+// --------------------------------------------------------------------------------------------
+/** @brief Read-only IOStream on top of a block container.
+ *
+ *  Blocks are read in batches of one block per worker thread and decompressed in
+ *  parallel, patches are applied to them right after. Memory usage is bounded by the
+ *  batch size and the patch table, independent of the size of the container. Seeking
+ *  is supported in both directions. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API BlockDecompressIOStream : public IOStream {
+public:
+    // ----------------------------------------------------------------------------
+    /** @brief Construction from a source stream positioned at the container header.
+     *  @param source Source stream, not owned. It must outlive this object.
+     *  @throw DeadlyImportError if the header is invalid or the codec is unsupported. */
+    explicit BlockDecompressIOStream(IOStream *source);
+
+    /// Destructor.
+    ~BlockDecompressIOStream() override;
+
+    // IOStream interface, see there for documentation.
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+private:
+    struct Block {
+        size_t offset; ///< Position of the compressed data in the source stream
+        size_t rawSize; ///< Uncompressed size
+        size_t packedSize; ///< Compressed size
+    };
+    struct Patch {
+        size_t offset; ///< Position in the uncompressed data
+        std::vector<unsigned char> data;
+    };
+
+    void ReadPatches(size_t start, uint64_t offset);
+    void DiscoverBlocks(size_t last);
+    void LoadBatch(size_t first);
+    void ApplyPatches(size_t first);
+
+private:
+    IOStream *mSource;
+    BlockCodec mCodec;
+    size_t mBlockSize;
+    size_t mSize;
+    size_t mPos;
+    size_t mSourceSize;
+    std::vector<Block> mBlocks;
+    std::vector<Patch> mPatches;
+    size_t mMaxPatchSize;
+    size_t mNextHeader;
+    size_t mBatchFirst;
+    std::vector<std::vector<unsigned char>> mBatch;
+    std::vector<std::vector<unsigned char>> mPacked;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_BLOCKCOMPRESSION_H_INC
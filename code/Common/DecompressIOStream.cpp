@@ -0,0 +1,575 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file DecompressIOStream.cpp
+ *  @brief Implementation of the on-the-fly decompressing IOStream.
+ */
+#include "DecompressIOStream.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#   include <zlib.h>
+#else
+#   include "../contrib/zlib/zlib.h"
+#endif
+
+#ifdef ASSIMP_BUILD_ZSTD
+#   include <zstd.h>
+#endif
+
+namespace Assimp {
+
+// size of the compressed input buffer and of the buffer used to skip data
+static const size_t InputBufferSize = 64 * 1024;
+static const size_t ScratchBufferSize = 64 * 1024;
+
+// the deflate window (and thus the dictionary saved at each checkpoint) is 32k
+static const size_t DeflateWindowSize = 32 * 1024;
+
+// the maximum compression ratio deflate can achieve is a bit below 1:1032, so the
+// 32 bit ISIZE field in the gzip trailer is exact for files smaller than this
+static const size_t MaxCompressedSizeForISize = 0xffffffffu / 1032;
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t ReadLE32(const unsigned char *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// ------------------------------------------------------------------------------------------------
+struct DecompressIOStream::Decoder {
+    z_stream zstream;
+    bool zinit;
+#ifdef ASSIMP_BUILD_ZSTD
+    ZSTD_DStream *zstd;
+    bool frameDone;
+#endif
+    const unsigned char *next;
+    size_t avail;
+
+    Decoder() :
+            zinit(false),
+#ifdef ASSIMP_BUILD_ZSTD
+            zstd(nullptr),
+            frameDone(true),
+#endif
+            next(nullptr),
+            avail(0) {
+        ::memset(&zstream, 0, sizeof(z_stream));
+    }
+
+    ~Decoder() {
+        if (zinit) {
+            inflateEnd(&zstream);
+        }
+#ifdef ASSIMP_BUILD_ZSTD
+        if (nullptr != zstd) {
+            ZSTD_freeDStream(zstd);
+        }
+#endif
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+DecompressIOStream::Format DecompressIOStream::DetectFormat(const void *magic, size_t size) {
+    if (nullptr == magic || size < 4) {
+        return Format_Unknown;
+    }
+
+    const unsigned char *b = static_cast<const unsigned char *>(magic);
+    if (b[0] == 0x1f && b[1] == 0x8b && b[2] == 8) {
+        return Format_GZip;
+    }
+    if (b[0] == 0x28 && b[1] == 0xb5 && b[2] == 0x2f && b[3] == 0xfd) {
+        return Format_ZStd;
+    }
+
+    // zstd skippable frame, used for instance by the seekable format
+    if ((b[0] & 0xf0) == 0x50 && b[1] == 0x2a && b[2] == 0x4d && b[3] == 0x18) {
+        return Format_ZStd;
+    }
+    return Format_Unknown;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecompressIOStream::IsFormatSupported(Format format) {
+    switch (format) {
+    case Format_GZip:
+        return true;
+    case Format_ZStd:
+#ifdef ASSIMP_BUILD_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+DecompressIOStream::DecompressIOStream(std::shared_ptr<IOStream> source, Format format, size_t checkpointSpan) :
+        mSource(source),
+        mFormat(format),
+        mCheckpointSpan(std::max(checkpointSpan, DeflateWindowSize)),
+        mDecoder(new Decoder),
+        mCheckpoints(),
+        mInput(InputBufferSize),
+        mScratch(),
+        mSourcePos(0),
+        mSizeVerified(true),
+        mPos(0),
+        mSize(0),
+        mEof(false) {
+    if (nullptr == mSource) {
+        throw DeadlyImportError("DecompressIOStream: No source stream");
+    }
+    if (!IsFormatSupported(mFormat)) {
+        throw DeadlyImportError("DecompressIOStream: Unsupported compression format, "
+                "assimp might have been built without support for it");
+    }
+
+    // take the size from the container if possible, else decode everything once
+    const bool known = (mFormat == Format_GZip ? ReadGZipSize() : ReadZStdFrames());
+    Restart(nullptr);
+    if (!known) {
+        mSize = ScanSize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+DecompressIOStream::~DecompressIOStream() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    ai_assert(nullptr != pvBuffer);
+    ai_assert(0 != pSize);
+
+    const size_t cnt = std::min(pCount, (mSize - std::min(mPos, mSize)) / pSize);
+    const size_t read = Decompress(pvBuffer, cnt * pSize);
+    if (mPos == mSize && !mSizeVerified) {
+        VerifyEnd();
+    }
+    return read / pSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    ai_assert(false); // read-only stream
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn DecompressIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t target = 0;
+    if (aiOrigin_SET == pOrigin) {
+        target = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        target = mSize - pOffset;
+    } else {
+        target = mPos + pOffset;
+    }
+    if (target > mSize) {
+        return AI_FAILURE;
+    }
+
+    // find the last checkpoint in front of the target position
+    const Checkpoint *best = nullptr;
+    for (const Checkpoint &cp : mCheckpoints) {
+        if (cp.out > target) {
+            break;
+        }
+        best = &cp;
+    }
+
+    // restart only if we have to go back or if a checkpoint gets us closer
+    if (target < mPos || (nullptr != best && best->out > mPos)) {
+        Restart(best);
+    }
+    const size_t distance = target - mPos;
+    if (Skip(distance) != distance) {
+        return AI_FAILURE;
+    }
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DecompressIOStream::Flush() {
+    // read-only stream, nothing to be done
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::GetNumCheckpoints() const {
+    return mCheckpoints.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecompressIOStream::Refill() {
+    ai_assert(0 == mDecoder->avail);
+
+    const size_t read = mSource->Read(mInput.data(), 1, mInput.size());
+    mSourcePos += read;
+    mDecoder->next = mInput.data();
+    mDecoder->avail = read;
+    return read > 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DecompressIOStream::AddCheckpoint(int bits) {
+    const size_t last = mCheckpoints.empty() ? 0 : mCheckpoints.back().out;
+    if (mPos < last + mCheckpointSpan) {
+        return;
+    }
+
+    Checkpoint cp;
+    cp.out = mPos;
+    cp.in = mSourcePos - mDecoder->avail;
+    cp.bits = bits;
+    if (mFormat == Format_GZip) {
+        uInt len = static_cast<uInt>(DeflateWindowSize);
+        cp.window.resize(DeflateWindowSize);
+        if (Z_OK != inflateGetDictionary(&mDecoder->zstream, cp.window.data(), &len)) {
+            return;
+        }
+        cp.window.resize(len);
+    }
+    mCheckpoints.push_back(std::move(cp));
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecompressIOStream::ReadGZipSize() {
+    // zlib streams have no trailer, gzip streams need at least a header and a trailer
+    const size_t compressed = mSource->FileSize();
+    unsigned char header[2] = { 0 }, trailer[4] = { 0 };
+    if (compressed < 18 || aiReturn_SUCCESS != mSource->Seek(0, aiOrigin_SET) || 1 != mSource->Read(header, 2, 1) ||
+            header[0] != 0x1f || header[1] != 0x8b) {
+        return false;
+    }
+    if (aiReturn_SUCCESS != mSource->Seek(compressed - 4, aiOrigin_SET) || 1 != mSource->Read(trailer, 4, 1)) {
+        return false;
+    }
+
+    // ISIZE is the size modulo 2^32. Deflate expands data by at most 5 bytes per 64k block,
+    // which gives a lower bound, and the smallest candidate above it is taken. That is only
+    // ambiguous for files large enough to decompress to 4 GB, VerifyEnd() checks those.
+    const uint64_t payload = compressed - 18;
+    const uint64_t overhead = 5 * (payload / 65535 + 1);
+    const uint64_t lower = payload > overhead ? payload - overhead : 0;
+    uint64_t size = ReadLE32(trailer);
+    while (size < lower) {
+        size += static_cast<uint64_t>(1) << 32;
+    }
+    if (size > std::numeric_limits<size_t>::max()) {
+        return false;
+    }
+    mSize = static_cast<size_t>(size);
+    mSizeVerified = (compressed <= MaxCompressedSizeForISize);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecompressIOStream::ReadZStdFrames() {
+    // walk the frame and block headers, each frame start becomes a checkpoint. Nothing is
+    // decoded, so this fails as soon as a frame does not tell its content size.
+    static const size_t DictIdSizes[4] = { 0, 1, 2, 4 };
+    static const size_t ContentSizeSizes[4] = { 1, 2, 4, 8 };
+
+    const size_t compressed = mSource->FileSize();
+    std::vector<Checkpoint> frames;
+    uint64_t in = 0, out = 0;
+    while (in < compressed) {
+        unsigned char h[18] = { 0 };
+        const size_t avail = static_cast<size_t>(std::min<uint64_t>(sizeof(h), compressed - in));
+        if (avail < 8 || aiReturn_SUCCESS != mSource->Seek(static_cast<size_t>(in), aiOrigin_SET) ||
+                1 != mSource->Read(h, avail, 1)) {
+            return false;
+        }
+
+        const uint32_t magic = ReadLE32(h);
+        if ((magic & 0xfffffff0u) == 0x184d2a50u) {
+            in += 8 + static_cast<uint64_t>(ReadLE32(h + 4)); // skippable frame
+            continue;
+        }
+        if (magic != 0xfd2fb528u) {
+            return false;
+        }
+
+        const unsigned int descriptor = h[4];
+        const unsigned int contentSizeFlag = descriptor >> 6;
+        const bool singleSegment = 0 != (descriptor & 0x20);
+        if (0 == contentSizeFlag && !singleSegment) {
+            return false;
+        }
+        size_t pos = 5 + (singleSegment ? 0 : 1) + DictIdSizes[descriptor & 3];
+        const size_t bytes = ContentSizeSizes[contentSizeFlag];
+        if (pos + bytes > avail) {
+            return false;
+        }
+        uint64_t contentSize = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            contentSize |= static_cast<uint64_t>(h[pos + i]) << (8 * i);
+        }
+        contentSize += (2 == bytes ? 256 : 0);
+
+        Checkpoint cp;
+        cp.out = static_cast<size_t>(out);
+        cp.in = static_cast<size_t>(in);
+        cp.bits = 0;
+        frames.push_back(std::move(cp));
+
+        // skip the blocks, the last one has the lowest header bit set
+        in += pos + bytes;
+        for (bool last = false; !last;) {
+            unsigned char b[3] = { 0 };
+            if (in + 3 > compressed || aiReturn_SUCCESS != mSource->Seek(static_cast<size_t>(in), aiOrigin_SET) ||
+                    1 != mSource->Read(b, 3, 1)) {
+                return false;
+            }
+            const uint32_t block = static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) | (static_cast<uint32_t>(b[2]) << 16);
+            const uint32_t type = (block >> 1) & 3;
+            if (3 == type) {
+                return false;
+            }
+            last = 0 != (block & 1);
+            in += 3 + (1 == type ? 1 : block >> 3); // RLE blocks store a single byte
+        }
+        in += (descriptor & 4) ? 4 : 0; // content checksum
+
+        out += contentSize;
+        if (out > std::numeric_limits<size_t>::max()) {
+            return false;
+        }
+    }
+    if (in != compressed) {
+        return false;
+    }
+
+    mCheckpoints.swap(frames);
+    mSize = static_cast<size_t>(out);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DecompressIOStream::Restart(const Checkpoint *from) {
+    Decoder &d = *mDecoder;
+    d.next = nullptr;
+    d.avail = 0;
+    mSourcePos = (nullptr == from ? 0 : from->in - (from->bits ? 1 : 0));
+    mPos = (nullptr == from ? 0 : from->out);
+    mEof = false;
+
+    if (aiReturn_SUCCESS != mSource->Seek(mSourcePos, aiOrigin_SET)) {
+        throw DeadlyImportError("DecompressIOStream: Failed to seek in the compressed stream");
+    }
+
+    if (mFormat == Format_GZip) {
+        if (d.zinit) {
+            inflateEnd(&d.zstream);
+            d.zinit = false;
+        }
+        ::memset(&d.zstream, 0, sizeof(z_stream));
+
+        // 32 + MAX_WBITS detects gzip and zlib headers, checkpoints resume raw deflate data
+        const int windowBits = (nullptr == from ? 32 + MAX_WBITS : -MAX_WBITS);
+        if (Z_OK != inflateInit2(&d.zstream, windowBits)) {
+            throw DeadlyImportError("DecompressIOStream: Failed to initialize zlib");
+        }
+        d.zinit = true;
+
+        if (nullptr != from) {
+            if (from->bits) {
+                if (!Refill()) {
+                    throw DeadlyImportError("DecompressIOStream: Unexpected end of compressed data");
+                }
+                inflatePrime(&d.zstream, from->bits, *d.next >> (8 - from->bits));
+                ++d.next;
+                --d.avail;
+            }
+            inflateSetDictionary(&d.zstream, from->window.data(), static_cast<uInt>(from->window.size()));
+        }
+    }
+#ifdef ASSIMP_BUILD_ZSTD
+    else if (mFormat == Format_ZStd) {
+        if (nullptr == d.zstd) {
+            d.zstd = ZSTD_createDStream();
+        }
+        if (nullptr == d.zstd || ZSTD_isError(ZSTD_initDStream(d.zstd))) {
+            throw DeadlyImportError("DecompressIOStream: Failed to initialize zstd");
+        }
+        d.frameDone = true;
+    }
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::Decompress(void *out, size_t size) {
+    Decoder &d = *mDecoder;
+    unsigned char *dest = static_cast<unsigned char *>(out);
+    size_t produced = 0;
+
+    while (produced < size && !mEof) {
+        if (0 == d.avail && !Refill()) {
+#ifdef ASSIMP_BUILD_ZSTD
+            if (mFormat == Format_ZStd && d.frameDone) {
+                mEof = true;
+                break;
+            }
+#endif
+            throw DeadlyImportError("DecompressIOStream: Unexpected end of compressed data");
+        }
+
+        size_t written = 0;
+        if (mFormat == Format_GZip) {
+            z_stream &zs = d.zstream;
+            zs.next_in = const_cast<Bytef *>(d.next);
+            zs.avail_in = static_cast<uInt>(std::min(d.avail, static_cast<size_t>(UINT_MAX)));
+            zs.next_out = dest + produced;
+            zs.avail_out = static_cast<uInt>(std::min(size - produced, static_cast<size_t>(UINT_MAX)));
+
+            const uInt availOut = zs.avail_out;
+            const int ret = inflate(&zs, Z_BLOCK);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                throw DeadlyImportError("DecompressIOStream: Failure decompressing deflate data");
+            }
+
+            d.avail -= static_cast<size_t>(zs.next_in - d.next);
+            d.next = zs.next_in;
+            written = availOut - zs.avail_out;
+            produced += written;
+            mPos += written;
+
+            if (ret == Z_STREAM_END) {
+                mEof = true;
+            } else if ((zs.data_type & 128) && !(zs.data_type & 64)) {
+                // at the end of a deflate block, the decoder state is cheap to save
+                AddCheckpoint(zs.data_type & 7);
+            }
+        }
+#ifdef ASSIMP_BUILD_ZSTD
+        else if (mFormat == Format_ZStd) {
+            ZSTD_inBuffer in = { d.next, d.avail, 0 };
+            ZSTD_outBuffer o = { dest + produced, size - produced, 0 };
+            const size_t ret = ZSTD_decompressStream(d.zstd, &o, &in);
+            if (ZSTD_isError(ret)) {
+                throw DeadlyImportError("DecompressIOStream: Failure decompressing zstd data: ", ZSTD_getErrorName(ret));
+            }
+
+            d.next += in.pos;
+            d.avail -= in.pos;
+            written = o.pos;
+            produced += written;
+            mPos += written;
+
+            // zstd frames are independent, so each frame boundary is a potential checkpoint
+            d.frameDone = (0 == ret);
+            if (d.frameDone) {
+                AddCheckpoint(0);
+            }
+        }
+#endif
+    }
+    return produced;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::Skip(size_t count) {
+    if (mScratch.empty()) {
+        mScratch.resize(ScratchBufferSize);
+    }
+
+    size_t skipped = 0;
+    while (skipped < count) {
+        const size_t chunk = std::min(count - skipped, mScratch.size());
+        const size_t read = Decompress(mScratch.data(), chunk);
+        skipped += read;
+        if (read < chunk) {
+            break;
+        }
+    }
+    return skipped;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DecompressIOStream::ScanSize() {
+    // decode and discard everything once, this records the checkpoints for the whole file on the way
+    while (!mEof) {
+        Skip(ScratchBufferSize);
+    }
+    const size_t size = mPos;
+    Restart(nullptr);
+    return size;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DecompressIOStream::VerifyEnd() {
+    unsigned char c = 0;
+    if (0 != Decompress(&c, 1)) {
+        throw DeadlyImportError("DecompressIOStream: The data is larger than the gzip trailer tells, "
+                "compressed files of 4 GB and more are not supported");
+    }
+    mSizeVerified = true;
+}
+
+} // end of namespace Assimp
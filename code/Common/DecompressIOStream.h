@@ -0,0 +1,159 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file DecompressIOStream.h
+ *  @brief Read-only IOStream which decompresses gzip/zlib or zstd data on the fly.
+ */
+#pragma once
+#ifndef AI_DECOMPRESSIOSTREAM_H_INC
+#define AI_DECOMPRESSIOSTREAM_H_INC
+
+#include <assimp/IOStream.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** @brief Implementation of IOStream which inflates a compressed source stream on read.
+ *
+ *  Only a fixed size input buffer is held in memory, the decompressed data is never
+ *  materialized as a whole, so a consumer which reads everything into its own buffer
+ *  keeps the only uncompressed copy. To allow for random access, the stream records
+ *  checkpoints while decompressing (every @c checkpointSpan bytes of output for deflate,
+ *  at every frame boundary for zstd). Seeking backwards restarts the decoder at the
+ *  closest checkpoint instead of at the beginning of the file, seeking forward decodes
+ *  and discards data up to the requested position.
+ *
+ *  The uncompressed size is taken from the gzip trailer or from the zstd frame headers,
+ *  which also yields the zstd checkpoints without decoding anything. Only zlib streams
+ *  and zstd frames without a content size are decoded once up front to find the size.
+ *
+ *  The source stream must contain a single compressed stream starting at offset 0. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API DecompressIOStream : public IOStream {
+public:
+    /// Supported compression formats.
+    enum Format {
+        Format_Unknown = 0, ///< Not a compressed stream (or not supported)
+        Format_GZip,        ///< gzip or zlib wrapped deflate stream
+        Format_ZStd         ///< zstd stream, one or more frames
+    };
+
+    /// Default distance (in uncompressed bytes) between two deflate checkpoints.
+    static const size_t DefaultCheckpointSpan = 1024 * 1024;
+
+    // ----------------------------------------------------------------------------
+    /** @brief Identifies the compression format from the leading bytes of a file.
+     *  @param magic First bytes of the file
+     *  @param size Number of valid bytes in @c magic, should be at least 4
+     *  @return Format_Unknown if the data is not compressed in a supported way.
+     *    Format_ZStd is only returned if assimp was built with zstd support. */
+    static Format DetectFormat(const void *magic, size_t size);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Returns whether assimp was built with support for a given format. */
+    static bool IsFormatSupported(Format format);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Construction from a compressed source stream.
+     *  @param source Compressed input, the stream is shared with the caller.
+     *  @param format Compression format of @c source.
+     *  @param checkpointSpan Distance between two seek checkpoints in bytes of
+     *    uncompressed data. Each deflate checkpoint costs 32k of memory.
+     *  @throw DeadlyImportError if the decoder cannot be initialized. */
+    DecompressIOStream(std::shared_ptr<IOStream> source, Format format,
+            size_t checkpointSpan = DefaultCheckpointSpan);
+
+    /// Destructor, releases the decoder. The source stream is not closed.
+    ~DecompressIOStream() override;
+
+    // IOStream interface, see there for documentation.
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+    /// Returns the number of seek checkpoints recorded so far.
+    size_t GetNumCheckpoints() const;
+
+private:
+    /// Decoder state needed to resume decompression at a given output offset.
+    struct Checkpoint {
+        size_t out; ///< Offset in the uncompressed data
+        size_t in; ///< Offset of the first complete byte in the compressed data
+        int bits; ///< Number of bits of the preceding byte still to be consumed
+        std::vector<unsigned char> window; ///< Deflate dictionary (empty for zstd)
+    };
+    struct Decoder;
+
+    size_t Decompress(void *out, size_t size);
+    void Restart(const Checkpoint *from);
+    bool Refill();
+    void AddCheckpoint(int bits);
+    bool ReadGZipSize();
+    bool ReadZStdFrames();
+    size_t ScanSize();
+    void VerifyEnd();
+    size_t Skip(size_t count);
+
+private:
+    std::shared_ptr<IOStream> mSource;
+    Format mFormat;
+    size_t mCheckpointSpan;
+    std::unique_ptr<Decoder> mDecoder;
+    std::vector<Checkpoint> mCheckpoints;
+    std::vector<unsigned char> mInput;
+    std::vector<unsigned char> mScratch;
+    size_t mSourcePos;
+    bool mSizeVerified;
+    size_t mPos;
+    size_t mSize;
+    bool mEof;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_DECOMPRESSIOSTREAM_H_INC
@@ -56,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdio.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/NullLogger.hpp>
+#include <atomic>
 #include <iostream>
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
@@ -70,6 +71,9 @@ namespace Assimp {
 NullLogger DefaultLogger::s_pNullLogger;
 Logger *DefaultLogger::m_pLogger = &DefaultLogger::s_pNullLogger;
 
+// Changed whenever the logger is replaced, so threads forget the last message of the old one
+static std::atomic<unsigned int> s_loggerGeneration(0);
+
 static const unsigned int SeverityAll = Logger::Info | Logger::Err | Logger::Warn | Logger::Debugging;
 
 // ----------------------------------------------------------------------------------
@@ -137,6 +141,7 @@ Logger *DefaultLogger::create(const char *name /*= "AssimpLog.txt"*/,
     }
 
     m_pLogger = new DefaultLogger(severity);
+    ++s_loggerGeneration;
 
     // Attach default log streams
     // Stream the log to the MSVC debugger?
@@ -230,6 +235,7 @@ void DefaultLogger::set(Logger *logger) {
     }
 
     DefaultLogger::m_pLogger = logger;
+    ++s_loggerGeneration;
 }
 
 // ----------------------------------------------------------------------------------
@@ -237,6 +243,11 @@ bool DefaultLogger::isNullLogger() {
     return m_pLogger == &s_pNullLogger;
 }
 
+// ----------------------------------------------------------------------------------
+bool DefaultLogger::isNullLogger(const Logger *logger) {
+    return logger == &s_pNullLogger;
+}
+
 // ----------------------------------------------------------------------------------
 Logger *DefaultLogger::get() {
     return m_pLogger;
@@ -255,6 +266,7 @@ void DefaultLogger::kill() {
     }
     delete m_pLogger;
     m_pLogger = &s_pNullLogger;
+    ++s_loggerGeneration;
 }
 
 // ----------------------------------------------------------------------------------
@@ -371,8 +383,8 @@ bool DefaultLogger::detachStream(LogStream *pStream, unsigned int severity) {
 // ----------------------------------------------------------------------------------
 //  Constructor
 DefaultLogger::DefaultLogger(LogSeverity severity) :
-        Logger(severity), noRepeatMsg(false), lastLen(0) {
-    lastMsg[0] = '\0';
+        Logger(severity) {
+    // empty
 }
 
 // ----------------------------------------------------------------------------------
@@ -384,27 +396,49 @@ DefaultLogger::~DefaultLogger() {
     }
 }
 
+// ----------------------------------------------------------------------------------
+// The last message of a thread, repeated messages are skipped. This is kept per thread,
+// so threads logging at the same time don't need to synchronize. It is reset once the
+// logger has been replaced, a new logger may well be allocated at the old address.
+struct LastMessage {
+    unsigned int generation;
+    bool noRepeatMsg;
+    char lastMsg[MAX_LOG_MESSAGE_LENGTH * 2];
+    size_t lastLen;
+};
+
+static thread_local LastMessage s_lastMessage = { ~0u, false, { '\0' }, 0 };
+
 // ----------------------------------------------------------------------------------
 //  Writes message to stream
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev) {
     ai_assert(nullptr != message);
 
-    // Check whether this is a repeated message
-    if (!::strncmp(message, lastMsg, lastLen - 1)) {
-        if (!noRepeatMsg) {
-            noRepeatMsg = true;
+    LastMessage &last = s_lastMessage;
+    const unsigned int generation = s_loggerGeneration.load(std::memory_order_relaxed);
+    if (last.generation != generation) {
+        last.generation = generation;
+        last.noRepeatMsg = false;
+        last.lastMsg[0] = '\0';
+        last.lastLen = 0;
+    }
+
+    // Check whether this is a repeated message, there is none after a reset
+    if (last.lastLen > 0 && !::strncmp(message, last.lastMsg, last.lastLen - 1)) {
+        if (!last.noRepeatMsg) {
+            last.noRepeatMsg = true;
             message = "Skipping one or more lines with the same contents\n";
         } else
             return;
     } else {
         // append a new-line character to the message to be printed
-        lastLen = ::strlen(message);
-        ::memcpy(lastMsg, message, lastLen + 1);
-        ::strcat(lastMsg + lastLen, "\n");
+        last.lastLen = ::strlen(message);
+        ::memcpy(last.lastMsg, message, last.lastLen + 1);
+        ::strcat(last.lastMsg + last.lastLen, "\n");
 
-        message = lastMsg;
-        noRepeatMsg = false;
-        ++lastLen;
+        message = last.lastMsg;
+        last.noRepeatMsg = false;
+        ++last.lastLen;
     }
     for (ConstStreamIt it = m_StreamArray.begin();
             it != m_StreamArray.end();
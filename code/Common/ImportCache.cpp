@@ -0,0 +1,722 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportCache.cpp
+ *  @brief Implementation of the on-disk import cache.
+ */
+#include "ImportCache.h"
+#include "Importer.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Hash.h>
+#include <assimp/ai_assert.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+#include <assimp/version.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#   include <process.h>
+#   include <windows.h>
+// windows.h defines macros which clash with the members of IOSystem
+#   undef CreateDirectory
+#   undef DeleteFile
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+// the cache stores its entries as Assbin files, so it needs both the reader and the writer
+#if !defined(ASSIMP_BUILD_NO_EXPORT) && !defined(ASSIMP_BUILD_NO_ASSBIN_EXPORTER) && !defined(ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
+#   define AI_IMPORTCACHE_ENABLED
+#   include "AssetLib/Assbin/AssbinFileWriter.h"
+#   include "AssetLib/Assbin/AssbinLoader.h"
+#endif
+
+namespace Assimp {
+
+// header line of the index file, bump the version if the format of the entries changes
+static const char *IndexHeader = "assimp-import-cache 3";
+static const char *IndexFileName = "index.txt";
+static const char *LockFileName = "index.lock";
+
+// ------------------------------------------------------------------------------------------------
+// Exclusive lock on the index of a cache directory, held while the index is read, modified
+// and written. The lock file serializes processes, the mutex serializes the threads of this
+// process because POSIX record locks are owned by the whole process.
+class IndexLock {
+public:
+    explicit IndexLock(const std::string &path) :
+            mGuard(GetMutex()) {
+#ifdef _WIN32
+        mFile = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OVERLAPPED overlapped = {};
+        if (INVALID_HANDLE_VALUE != mFile && !::LockFileEx(mFile, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) {
+            ::CloseHandle(mFile);
+            mFile = INVALID_HANDLE_VALUE;
+        }
+        const bool locked = INVALID_HANDLE_VALUE != mFile;
+#else
+        mFile = ::open(path.c_str(), O_RDWR | O_CREAT, 0666);
+        struct flock lock = {};
+        lock.l_type = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+        int res = -1;
+        while (-1 != mFile && -1 == (res = ::fcntl(mFile, F_SETLKW, &lock)) && EINTR == errno) {
+            // interrupted by a signal, try again
+        }
+        if (-1 != mFile && -1 == res) {
+            ::close(mFile);
+            mFile = -1;
+        }
+        const bool locked = -1 != mFile;
+#endif
+        if (!locked) {
+            ASSIMP_LOG_WARN_F("Import cache: Failed to lock ", path, ", other processes may modify the index concurrently");
+        }
+    }
+
+    ~IndexLock() {
+#ifdef _WIN32
+        if (INVALID_HANDLE_VALUE != mFile) {
+            OVERLAPPED overlapped = {};
+            ::UnlockFileEx(mFile, 0, 1, 0, &overlapped);
+            ::CloseHandle(mFile);
+        }
+#else
+        if (-1 != mFile) {
+            // closing the file releases the lock
+            ::close(mFile);
+        }
+#endif
+    }
+
+private:
+    static std::mutex &GetMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::lock_guard<std::mutex> mGuard;
+#ifdef _WIN32
+    HANDLE mFile;
+#else
+    int mFile;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+// Returns a file name in the same directory which no other process or thread uses, so a file
+// can be written completely before it is renamed to its final name
+static std::string GetTempPath(const std::string &path) {
+    static std::atomic<unsigned int> counter(0);
+#ifdef _WIN32
+    const unsigned long pid = static_cast<unsigned long>(::_getpid());
+#else
+    const unsigned long pid = static_cast<unsigned long>(::getpid());
+#endif
+    std::ostringstream name;
+    name << path << '.' << pid << '-' << counter++ << ".tmp";
+    return name.str();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replaces a file atomically, readers see either the old or the new file, never a partial one
+static bool ReplaceFile(const std::string &from, const std::string &to) {
+#ifdef _WIN32
+    return 0 != ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    return 0 == ::rename(from.c_str(), to.c_str());
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// 64 bit FNV-1a, the 32 bit hashes used elsewhere in assimp are too weak to identify files
+class KeyHash {
+public:
+    KeyHash() :
+            mHash(0xcbf29ce484222325ull) {}
+
+    void Update(const void *data, size_t size) {
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            mHash = (mHash ^ p[i]) * 0x100000001b3ull;
+        }
+    }
+
+    template <typename T>
+    void Update(const T &value) {
+        Update(&value, sizeof(T));
+    }
+
+    void Update(const std::string &value) {
+        Update<size_t>(value.length());
+        Update(value.data(), value.length());
+    }
+
+    std::string GetHex() const {
+        char buffer[17];
+        ::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(mHash));
+        return buffer;
+    }
+
+private:
+    uint64_t mHash;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Hashes the contents of a file, returns false if it can't be opened
+static bool HashFile(IOSystem *io, const std::string &file, KeyHash &hash) {
+    IOStream *stream = io->Open(file, "rb");
+    if (nullptr == stream) {
+        return false;
+    }
+    std::vector<unsigned char> buffer(64 * 1024);
+    size_t read = 0;
+    while (0 != (read = stream->Read(buffer.data(), 1, buffer.size()))) {
+        hash.Update(buffer.data(), read);
+    }
+    hash.Update<size_t>(stream->FileSize());
+    io->Close(stream);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the hash of a file as it is written to the dependency file, "-" if it doesn't exist
+static std::string GetDependencyHash(IOSystem *io, const std::string &file) {
+    KeyHash hash;
+    return HashFile(io, file, hash) ? hash.GetHex() : std::string("-");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Properties which are set by the Importer itself, they must not be part of the key
+static bool IsInternalProperty(ImporterPimpl::KeyType key) {
+    static const ImporterPimpl::KeyType internal[] = {
+        SuperFastHash("importerIndex"),
+        SuperFastHash("sourceFilePath"),
+        SuperFastHash(AI_CONFIG_APP_SCALE_KEY),
+        SuperFastHash(AI_CONFIG_IMPORT_CACHE_DIRECTORY),
+        SuperFastHash(AI_CONFIG_IMPORT_CACHE_MAX_SIZE),
+        SuperFastHash(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES),
+        SuperFastHash(AI_CONFIG_GLOB_MEASURE_TIME),
+        SuperFastHash(AI_CONFIG_GLOB_TRACK_MEMORY)
+    };
+    for (ImporterPimpl::KeyType k : internal) {
+        if (k == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Map>
+static void HashProperties(KeyHash &hash, const Map &properties) {
+    // std::map is ordered, so the same properties always give the same hash
+    for (const auto &property : properties) {
+        if (!IsInternalProperty(property.first)) {
+            hash.Update(property.first);
+            hash.Update(property.second);
+        }
+    }
+    hash.Update<size_t>(0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether Assbin can represent a scene. Vertex animations and the links which
+// ArmaturePopulate adds to the bones are not serialized, such scenes are imported every time.
+static bool IsCacheable(const aiScene *scene) {
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        if (mesh->mNumAnimMeshes) {
+            return false;
+        }
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            if (nullptr != mesh->mBones[b]->mArmature || nullptr != mesh->mBones[b]->mNode) {
+                return false;
+            }
+        }
+    }
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        if (scene->mAnimations[i]->mNumMeshChannels || scene->mAnimations[i]->mNumMorphMeshChannels) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+DependencyTracker::DependencyTracker(const std::string &file, IOSystem *wrapped) :
+        mFile(file),
+        mWrapped(wrapped),
+        mFiles() {
+    ai_assert(nullptr != mWrapped);
+}
+
+// ------------------------------------------------------------------------------------------------
+IOSystem *DependencyTracker::GetWrapped() const {
+    return mWrapped;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::set<std::string> &DependencyTracker::GetFiles() const {
+    return mFiles;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DependencyTracker::Record(const char *pFile) const {
+    // the main file is part of the key already
+    if (nullptr != pFile && !mWrapped->ComparePaths(pFile, mFile.c_str())) {
+        mFiles.insert(pFile);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::Exists(const char *pFile) const {
+    Record(pFile);
+    return mWrapped->Exists(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+char DependencyTracker::getOsSeparator() const {
+    return mWrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream *DependencyTracker::Open(const char *pFile, const char *pMode) {
+    Record(pFile);
+    return mWrapped->Open(pFile, pMode);
+}
+
+// ------------------------------------------------------------------------------------------------
+void DependencyTracker::Close(IOStream *pFile) {
+    mWrapped->Close(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::ComparePaths(const char *one, const char *second) const {
+    return mWrapped->ComparePaths(one, second);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::PushDirectory(const std::string &path) {
+    return mWrapped->PushDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &DependencyTracker::CurrentDirectory() const {
+    return mWrapped->CurrentDirectory();
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t DependencyTracker::StackSize() const {
+    return mWrapped->StackSize();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::PopDirectory() {
+    return mWrapped->PopDirectory();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::CreateDirectory(const std::string &path) {
+    return mWrapped->CreateDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::ChangeDirectory(const std::string &path) {
+    return mWrapped->ChangeDirectory(path);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyTracker::DeleteFile(const std::string &file) {
+    return mWrapped->DeleteFile(file);
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string &directory, size_t maxSize) :
+        mDirectory(directory),
+        mMaxSize(maxSize),
+        mIOSystem(new DefaultIOSystem()),
+        mEntries(),
+        mUsed(),
+        mTotalSize(0),
+        mTick(0) {
+    mIOSystem->CreateDirectory(mDirectory);
+    ReadIndex();
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::~ImportCache() {
+    // hits are only recorded in memory, they are written to the index once
+    if (!mUsed.empty()) {
+        IndexLock lock(GetFilePath(LockFileName));
+        ReadIndex();
+        WriteIndex();
+    }
+    delete mIOSystem;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string &ImportCache::GetDirectory() const {
+    return mDirectory;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::SetMaxSize(size_t maxSize) {
+    mMaxSize = maxSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetFilePath(const std::string &name) const {
+    return mDirectory + mIOSystem->getOsSeparator() + name;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetEntryPath(const std::string &key) const {
+    return GetFilePath(key + ".assbin");
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetDependencyPath(const std::string &key) const {
+    return GetFilePath(key + ".deps");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::CheckDependencies(const std::string &key, IOSystem *io) const {
+    IOStream *stream = mIOSystem->Open(GetDependencyPath(key), "rb");
+    if (nullptr == stream) {
+        return false;
+    }
+    std::string text(stream->FileSize(), '\0');
+    const bool ok = text.empty() || 1 == stream->Read(&text[0], text.size(), 1);
+    mIOSystem->Close(stream);
+    if (!ok) {
+        return false;
+    }
+
+    // one line per file, the hash of its contents followed by its path
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string::size_type space = line.find(' ');
+        if (std::string::npos == space) {
+            return false;
+        }
+        const std::string file = line.substr(space + 1);
+        if (line.compare(0, space, GetDependencyHash(io, file)) != 0) {
+            ASSIMP_LOG_DEBUG_F("Import cache: ", file, " has changed since entry ", key, " was stored");
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::MakeKey(IOSystem *io, const std::string &file, unsigned int flags, const ImporterPimpl &pimpl) const {
+    KeyHash hash;
+    if (!HashFile(io, file, hash)) {
+        return std::string();
+    }
+
+    hash.Update(file);
+    hash.Update(flags);
+    hash.Update(aiGetVersionMajor());
+    hash.Update(aiGetVersionMinor());
+    hash.Update(aiGetVersionRevision());
+    hash.Update(aiGetCompileFlags());
+    hash.Update<size_t>(sizeof(ai_real));
+
+    HashProperties(hash, pimpl.mIntProperties);
+    HashProperties(hash, pimpl.mFloatProperties);
+    for (const auto &property : pimpl.mStringProperties) {
+        if (!IsInternalProperty(property.first)) {
+            hash.Update(property.first);
+            hash.Update(property.second);
+        }
+    }
+    HashProperties(hash, pimpl.mMatrixProperties);
+
+    return hash.GetHex();
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene *ImportCache::Load(const std::string &key, Importer *pImp) {
+    std::map<std::string, Entry>::iterator it = mEntries.find(key);
+    if (it == mEntries.end()) {
+        // another importer may have stored the entry since the index was read. The index
+        // is replaced atomically, so it can be read without the lock.
+        ReadIndex();
+        it = mEntries.find(key);
+        if (it == mEntries.end()) {
+            return nullptr;
+        }
+    }
+
+    const std::string path = GetEntryPath(key);
+    aiScene *scene = nullptr;
+#ifdef AI_IMPORTCACHE_ENABLED
+    if (!CheckDependencies(key, pImp->GetIOHandler())) {
+        // stale, the entry is replaced once the file is imported again
+        mTotalSize -= it->second.size;
+        mEntries.erase(it);
+        mUsed.erase(key);
+        return nullptr;
+    }
+    if (mIOSystem->Exists(path)) {
+        AssbinImporter reader;
+        scene = reader.ReadFile(pImp, path, mIOSystem);
+    }
+#else
+    (void)pImp;
+#endif
+    if (nullptr == scene) {
+        // The entry was evicted or is broken. It is not deleted here, another process may
+        // have replaced it already, and a broken entry is replaced once the file is imported.
+        ASSIMP_LOG_WARN_F("Import cache: Failed to read entry ", key);
+        mTotalSize -= it->second.size;
+        mEntries.erase(it);
+        mUsed.erase(key);
+        return nullptr;
+    }
+
+    // the index is updated with the next stored entry or when the cache is destroyed
+    it->second.lastUse = ++mTick;
+    mUsed.insert(key);
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::Store(const std::string &key, const aiScene *scene, const DependencyTracker &dependencies) {
+#ifdef AI_IMPORTCACHE_ENABLED
+    if (!IsCacheable(scene)) {
+        ASSIMP_LOG_DEBUG_F("Import cache: Scene holds data which can't be stored, not caching entry ", key);
+        return false;
+    }
+
+    // the files are hashed after the import, so changes made during it are missed
+    std::ostringstream deps;
+    for (const std::string &file : dependencies.GetFiles()) {
+        if (std::string::npos != file.find_first_of("\r\n")) {
+            ASSIMP_LOG_DEBUG_F("Import cache: Can't record the dependency ", file, ", not caching entry ", key);
+            return false;
+        }
+        deps << GetDependencyHash(dependencies.GetWrapped(), file) << ' ' << file << '\n';
+    }
+
+    // the entry is written under a temporary name, so readers never see a partial file
+    const std::string path = GetEntryPath(key);
+    const std::string temp = GetTempPath(path);
+    try {
+        DumpSceneToAssbin(temp.c_str(), "", mIOSystem, scene, false, 0, true);
+    } catch (const std::exception &e) {
+        ASSIMP_LOG_WARN_F("Import cache: Failed to write entry ", key, ": ", e.what());
+        mIOSystem->DeleteFile(temp);
+        return false;
+    }
+
+    size_t size = 0;
+    IOStream *stream = mIOSystem->Open(temp, "rb");
+    if (nullptr != stream) {
+        size = stream->FileSize();
+        mIOSystem->Close(stream);
+    }
+
+    const std::string text = deps.str();
+    const std::string depsPath = GetDependencyPath(key);
+    const std::string depsTemp = GetTempPath(depsPath);
+    stream = mIOSystem->Open(depsTemp, "wb");
+    const bool ok = nullptr != stream && (text.empty() || 1 == stream->Write(text.data(), text.size(), 1));
+    if (nullptr != stream) {
+        mIOSystem->Close(stream);
+    }
+    if (!ok) {
+        ASSIMP_LOG_WARN_F("Import cache: Failed to write the dependencies of entry ", key);
+        mIOSystem->DeleteFile(depsTemp);
+        mIOSystem->DeleteFile(temp);
+        return false;
+    }
+    size += text.size();
+
+    IndexLock lock(GetFilePath(LockFileName));
+    if (!ReplaceFile(depsTemp, depsPath) || !ReplaceFile(temp, path)) {
+        ASSIMP_LOG_WARN_F("Import cache: Failed to rename entry ", key);
+        mIOSystem->DeleteFile(depsTemp);
+        mIOSystem->DeleteFile(temp);
+        return false;
+    }
+
+    // merge the changes of other importers before the index is written
+    ReadIndex();
+    std::map<std::string, Entry>::iterator it = mEntries.find(key);
+    if (it != mEntries.end()) {
+        mTotalSize -= it->second.size;
+    }
+    Entry &entry = mEntries[key];
+    entry.size = size;
+    entry.lastUse = ++mTick;
+    mTotalSize += size;
+
+    Evict();
+    WriteIndex();
+    return mEntries.find(key) != mEntries.end();
+#else
+    (void)key;
+    (void)scene;
+    (void)dependencies;
+    return false;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Evict() {
+    while (mTotalSize > mMaxSize && !mEntries.empty()) {
+        std::map<std::string, Entry>::iterator oldest = mEntries.begin();
+        for (std::map<std::string, Entry>::iterator it = mEntries.begin(); it != mEntries.end(); ++it) {
+            if (it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
+            }
+        }
+
+        ASSIMP_LOG_DEBUG_F("Import cache: Evicting entry ", oldest->first);
+        mIOSystem->DeleteFile(GetEntryPath(oldest->first));
+        mIOSystem->DeleteFile(GetDependencyPath(oldest->first));
+        mTotalSize -= oldest->second.size;
+        mUsed.erase(oldest->first);
+        mEntries.erase(oldest);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::ReadIndex() {
+    // entries used since the index was written keep their use, everything else is
+    // replaced with the index on disk, which holds the changes of other importers
+    std::vector<std::pair<size_t, std::string>> used;
+    for (const std::string &key : mUsed) {
+        std::map<std::string, Entry>::const_iterator it = mEntries.find(key);
+        if (it != mEntries.end()) {
+            used.push_back(std::make_pair(it->second.lastUse, key));
+        }
+    }
+    mEntries.clear();
+    mUsed.clear();
+    mTotalSize = 0;
+
+    IOStream *stream = mIOSystem->Open(GetFilePath(IndexFileName), "rb");
+    if (nullptr == stream) {
+        return;
+    }
+
+    std::string text(stream->FileSize(), '\0');
+    const bool ok = text.empty() || 1 == stream->Read(&text[0], text.size(), 1);
+    mIOSystem->Close(stream);
+    if (!ok) {
+        return;
+    }
+
+    std::istringstream in(text);
+    std::string line;
+    if (!std::getline(in, line) || line != IndexHeader) {
+        ASSIMP_LOG_WARN_F("Import cache: Ignoring index of unknown format in ", mDirectory);
+        return;
+    }
+
+    std::string key;
+    Entry entry;
+    while (in >> key >> entry.size >> entry.lastUse) {
+        if (!mIOSystem->Exists(GetEntryPath(key))) {
+            continue;
+        }
+        mEntries[key] = entry;
+        mTotalSize += entry.size;
+        mTick = std::max(mTick, entry.lastUse);
+    }
+
+    // the uses recorded here are more recent than anything in the index
+    std::sort(used.begin(), used.end());
+    for (const auto &use : used) {
+        std::map<std::string, Entry>::iterator it = mEntries.find(use.second);
+        if (it != mEntries.end()) {
+            it->second.lastUse = ++mTick;
+            mUsed.insert(use.second);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::WriteIndex() {
+    std::ostringstream out;
+    out << IndexHeader << '\n';
+    for (const auto &entry : mEntries) {
+        out << entry.first << ' ' << entry.second.size << ' ' << entry.second.lastUse << '\n';
+    }
+
+    // the index is replaced atomically, so it can be read without taking the lock
+    const std::string text = out.str();
+    const std::string path = GetFilePath(IndexFileName);
+    const std::string temp = GetTempPath(path);
+    IOStream *stream = mIOSystem->Open(temp, "wb");
+    bool ok = nullptr != stream && 1 == stream->Write(text.data(), text.size(), 1);
+    if (nullptr != stream) {
+        mIOSystem->Close(stream);
+    }
+    ok = ok && ReplaceFile(temp, path);
+    if (!ok) {
+        ASSIMP_LOG_WARN_F("Import cache: Failed to write the index in ", mDirectory);
+        mIOSystem->DeleteFile(temp);
+        return;
+    }
+    mUsed.clear();
+}
+
+} // end of namespace Assimp
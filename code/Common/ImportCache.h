@@ -0,0 +1,194 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportCache.h
+ *  @brief On-disk cache of post-processed scenes, used by #Assimp::Importer.
+ */
+#pragma once
+#ifndef AI_IMPORTCACHE_H_INC
+#define AI_IMPORTCACHE_H_INC
+
+#include <assimp/IOSystem.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+
+struct aiScene;
+
+namespace Assimp {
+
+class Importer;
+class ImporterPimpl;
+
+// --------------------------------------------------------------------------------------------
+/** @brief IO system which records the files an import opens besides the main file.
+ *
+ *  Wraps the IO system of the importer while a file is imported for the cache, the
+ *  recorded files are stored with the entry. Files which could not be opened are
+ *  recorded as well, the entry is stale once one of them shows up. */
+// --------------------------------------------------------------------------------------------
+class DependencyTracker : public IOSystem {
+public:
+    /** @brief Constructor.
+     *  @param file Main file of the import, it is not recorded
+     *  @param wrapped IO system to forward all calls to */
+    DependencyTracker(const std::string &file, IOSystem *wrapped);
+
+    /// Returns the wrapped IO system.
+    IOSystem *GetWrapped() const;
+
+    /// Returns the files opened or looked for since construction.
+    const std::set<std::string> &GetFiles() const;
+
+    bool Exists(const char *pFile) const override;
+    char getOsSeparator() const override;
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override;
+    void Close(IOStream *pFile) override;
+    bool ComparePaths(const char *one, const char *second) const override;
+    bool PushDirectory(const std::string &path) override;
+    const std::string &CurrentDirectory() const override;
+    size_t StackSize() const override;
+    bool PopDirectory() override;
+    bool CreateDirectory(const std::string &path) override;
+    bool ChangeDirectory(const std::string &path) override;
+    bool DeleteFile(const std::string &file) override;
+
+private:
+    void Record(const char *pFile) const;
+
+private:
+    std::string mFile;
+    IOSystem *mWrapped;
+    mutable std::set<std::string> mFiles;
+};
+
+// --------------------------------------------------------------------------------------------
+/** @brief Content-addressed cache of imported and post-processed scenes.
+ *
+ *  Entries are keyed by a hash of the file contents, the file name, the post-processing
+ *  flags, all configuration properties and the version of assimp, and they are stored
+ *  as flat Assbin files in a local directory. The directory also holds an index with
+ *  the size and the last use of each entry, the least recently used entries are evicted
+ *  once the total size exceeds the limit.
+ *
+ *  The key only covers the main file. The files the import opened besides it (materials,
+ *  textures, external references) are recorded by a DependencyTracker and stored next
+ *  to the entry together with a hash of their contents, a hit requires all of them to
+ *  be unchanged. Scenes with data Assbin can't hold (vertex animations, bone links from
+ *  ArmaturePopulate) are not stored.
+ *
+ *  Several importers and processes can share a directory: entries and the index are
+ *  written to temporary files which are renamed once complete, and the index is only
+ *  modified while holding a lock file. Hits don't write the index, they are merged into
+ *  it with the next stored entry or when the cache is destroyed. */
+// --------------------------------------------------------------------------------------------
+class ImportCache {
+public:
+    // ----------------------------------------------------------------------------
+    /** @brief Constructor.
+     *  @param directory Directory to store the entries in, it is created if needed.
+     *  @param maxSize Maximum total size of all entries, in bytes. */
+    ImportCache(const std::string &directory, size_t maxSize);
+
+    /// Destructor.
+    ~ImportCache();
+
+    /// Returns the directory of the cache.
+    const std::string &GetDirectory() const;
+
+    /// Sets the maximum total size of all entries, in bytes.
+    void SetMaxSize(size_t maxSize);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Computes the key of an import.
+     *  @param io IO system to read the file with
+     *  @param file File to be imported
+     *  @param flags Post-processing flags
+     *  @param pimpl Importer state holding the configuration properties
+     *  @return Key of the import, empty if the file cannot be read. */
+    std::string MakeKey(IOSystem *io, const std::string &file, unsigned int flags, const ImporterPimpl &pimpl) const;
+
+    // ----------------------------------------------------------------------------
+    /** @brief Loads an entry.
+     *  @param key Key returned by MakeKey()
+     *  @param pImp Importer to load the entry for, the files the entry depends on are
+     *    read with its IO system
+     *  @return The scene, nullptr if there is no such entry, a file it depends on has
+     *    changed or it could not be read. */
+    aiScene *Load(const std::string &key, Importer *pImp);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Stores a scene, then evicts entries until the cache fits its size limit.
+     *  @param key Key returned by MakeKey()
+     *  @param scene Post-processed scene to store
+     *  @param dependencies Tracker which wrapped the IO system during the import
+     *  @return true if the scene was stored. */
+    bool Store(const std::string &key, const aiScene *scene, const DependencyTracker &dependencies);
+
+private:
+    struct Entry {
+        size_t size; ///< Size of the entry and its dependency file, in bytes
+        size_t lastUse; ///< Value of mTick at the last use
+    };
+
+    std::string GetFilePath(const std::string &name) const;
+    std::string GetEntryPath(const std::string &key) const;
+    std::string GetDependencyPath(const std::string &key) const;
+    bool CheckDependencies(const std::string &key, IOSystem *io) const;
+    void ReadIndex();
+    void WriteIndex();
+    void Evict();
+
+private:
+    std::string mDirectory;
+    size_t mMaxSize;
+    IOSystem *mIOSystem;
+    std::map<std::string, Entry> mEntries;
+    std::set<std::string> mUsed; ///< Entries used since the index was written
+    size_t mTotalSize;
+    size_t mTick;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_IMPORTCACHE_H_INC
@@ -68,8 +68,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/ImportCache.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/BaseImporter.h>
+#include <assimp/MemoryTracker.hpp>
 #include <assimp/GenericProperty.h>
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/Profiler.h>
@@ -78,10 +81,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <exception>
 #include <set>
 #include <memory>
 #include <cctype>
+#include <typeinfo>
+#ifdef __GNUC__
+#   include <cxxabi.h>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -183,9 +192,10 @@ Importer::~Importer() {
         delete pimpl->mPostProcessingSteps[a];
     }
 
-    // Delete the assigned IO and progress handler
+    // Delete the assigned IO and progress handler and the memory tracker
     delete pimpl->mIOHandler;
     delete pimpl->mProgressHandler;
+    delete pimpl->mMemoryTracker;
 
     // Kill imported scene. Destructor's should do that recursively
     delete pimpl->mScene;
@@ -193,6 +203,9 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Delete the import cache, its entries stay on disk
+    delete pimpl->mCache;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -363,6 +376,25 @@ bool Importer::IsDefaultProgressHandler() const {
     return pimpl->mIsDefaultProgressHandler;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Supplies a custom memory tracker
+void Importer::SetMemoryTracker(MemoryTracker *pTracker) {
+    ai_assert(nullptr != pimpl);
+
+    if (pimpl->mMemoryTracker != pTracker) {
+        delete pimpl->mMemoryTracker;
+        pimpl->mMemoryTracker = pTracker;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the currently set memory tracker
+MemoryTracker *Importer::GetMemoryTracker() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mMemoryTracker;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Validate post process step flags
 bool _ValidateFlags(unsigned int pFlags) {
@@ -576,6 +608,213 @@ void WriteLogOpening(const std::string& file) {
     ASSIMP_LOG_DEBUG(stream.str());
 }
 
+// ------------------------------------------------------------------------------------------------
+// Adds the name of the importer to the metadata of the scene, unless the importer did so
+static void AddSourceFormatMetaData(aiScene *scene, const std::string &ext) {
+    if (!scene->mMetaData || !scene->mMetaData->HasKey(AI_METADATA_SOURCE_FORMAT)) {
+        if (!scene->mMetaData) {
+            scene->mMetaData = new aiMetadata;
+        }
+        scene->mMetaData->Add(AI_METADATA_SOURCE_FORMAT, aiString(ext));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the thread limit for ParallelFor set by AI_CONFIG_GLOB_MULTITHREADING, 0 if none
+static unsigned int GetThreadLimit(const Importer *pImp) {
+    const int threads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+    return threads < 0 ? 0u : static_cast<unsigned int>(std::max(threads, 1));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Creates, replaces or drops the import cache to match the current properties
+static void SetupImportCache(Importer *pImp) {
+    ImporterPimpl *pimpl = pImp->Pimpl();
+    const std::string directory = pImp->GetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, "");
+    if (directory.empty()) {
+        delete pimpl->mCache;
+        pimpl->mCache = nullptr;
+        return;
+    }
+
+    const size_t maxSize = static_cast<size_t>(std::max(0, pImp->GetPropertyInteger(AI_CONFIG_IMPORT_CACHE_MAX_SIZE, AI_IMPORT_CACHE_DEFAULT_MAX_SIZE))) * 1024;
+    if (nullptr == pimpl->mCache || pimpl->mCache->GetDirectory() != directory) {
+        delete pimpl->mCache;
+        pimpl->mCache = new ImportCache(directory, maxSize);
+    } else {
+        pimpl->mCache->SetMaxSize(maxSize);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the import cache key of the file, empty if the cache is disabled
+static std::string GetImportCacheKey(Importer *pImp, const std::string &pFile, unsigned int pFlags) {
+    ImporterPimpl *pimpl = pImp->Pimpl();
+    if (nullptr == pimpl->mCache) {
+        return std::string();
+    }
+    return pimpl->mCache->MakeKey(pimpl->mIOHandler, pFile, pFlags, *pimpl);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compacts or expands the storage of the scene as requested, once it is not going to be modified
+// anymore. Index buffers are opt-in, callers which did not ask for them may still reallocate or
+// delete the indices of single faces, so buffers from any source are given up for them.
+static void UpdateSceneStorage(Importer *pImp, aiScene *scene) {
+    if (nullptr == scene) {
+        return;
+    }
+    const bool contiguous = pImp->GetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, false);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        if (contiguous) {
+            scene->mMeshes[i]->CompactIndices();
+        } else {
+            scene->mMeshes[i]->ExpandIndices();
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Installs a DependencyTracker as the IO handler of the importer while it is alive, so the
+// importer and the post-processing steps open their files through it. Does nothing without one.
+class DependencyScope {
+public:
+    DependencyScope(ImporterPimpl *pimpl, DependencyTracker *tracker) :
+            mPimpl(pimpl),
+            mTracker(tracker) {
+        if (nullptr != mTracker) {
+            mPimpl->mIOHandler = mTracker;
+        }
+    }
+
+    ~DependencyScope() {
+        if (nullptr != mTracker) {
+            mPimpl->mIOHandler = mTracker->GetWrapped();
+        }
+    }
+
+private:
+    ImporterPimpl *mPimpl;
+    DependencyTracker *mTracker;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Reports the allocations of one phase, its peak of live memory and the size of the scene after
+// it to the memory tracker of the importer, if there is one
+class MemoryPhase {
+public:
+    MemoryPhase(const Importer *pImp, const std::string &name, unsigned int step = 0) :
+            mImporter(pImp),
+            mTracker(pImp->GetMemoryTracker()),
+            mName(name),
+            mStep(step),
+            mCounters() {
+        if (nullptr != mTracker) {
+            mTracker->GetAllocationCounters(mCounters);
+            mTracker->ResetPeak();
+        }
+    }
+
+    ~MemoryPhase() {
+        End();
+    }
+
+    void End() {
+        if (nullptr == mTracker) {
+            return;
+        }
+
+        aiMemoryPhaseInfo info;
+        info.name.Set(mName);
+        info.step = mStep;
+        MemoryTracker::Counters counters = {};
+        mTracker->GetAllocationCounters(counters);
+        info.allocations = counters.allocations - mCounters.allocations;
+        info.allocatedBytes = counters.allocatedBytes - mCounters.allocatedBytes;
+        info.deallocations = counters.deallocations - mCounters.deallocations;
+        info.freedBytes = counters.freedBytes - mCounters.freedBytes;
+        info.peakBytes = counters.peakBytes;
+        mImporter->GetMemoryRequirements(info.scene);
+        mTracker->OnPhase(info);
+        mTracker = nullptr;
+    }
+
+private:
+    const Importer *mImporter;
+    MemoryTracker *mTracker;
+    std::string mName;
+    unsigned int mStep;
+    MemoryTracker::Counters mCounters;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Returns the aiPostProcessSteps flag which activates a post-processing step. IsActive() also
+// configures some steps, so it is called with the full set of flags again at the end.
+static unsigned int GetActivatingStep(BaseProcess *process, unsigned int pFlags) {
+    unsigned int step = 0;
+    for (unsigned int flag = 1; flag != 0 && step == 0; flag <<= 1) {
+        if ((pFlags & flag) && process->IsActive(flag)) {
+            step = flag;
+        }
+    }
+    process->IsActive(pFlags);
+    return step;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Class name of a post-processing step, without the namespace
+static std::string GetProcessName(const BaseProcess *process) {
+    std::string name = typeid(*process).name();
+#ifdef __GNUC__
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (0 == status && nullptr != demangled) {
+        name = demangled;
+    }
+    ::free(demangled);
+#endif
+    // MSVC reports "class Assimp::Name"
+    const std::string::size_type pos = name.find_last_of(": ");
+    return std::string::npos == pos ? name : name.substr(pos + 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether a post-processing step is enabled by a property instead of a flag
+static bool IsAnyStepRequested(const Importer *pImp, const std::vector<BaseProcess *> &steps) {
+    for (const BaseProcess *process : steps) {
+        if (process->IsRequested(pImp)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Gives each face its own index array again if a step can't work on index buffers. Most steps
+// which run late only read the faces, so the buffers allocated by the importers are kept.
+static void PrepareSceneStorage(aiScene *scene, const BaseProcess *process) {
+    if (process->SupportsIndexBuffer()) {
+        return;
+    }
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        scene->mMeshes[i]->ExpandIndices();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Importer::GetImportCacheHits() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mCacheHits;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Importer::GetImportCacheMisses() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mCacheMisses;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
@@ -613,10 +852,21 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         }
 
         std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+        SetupImportCache(this);
         if (profiler) {
             profiler->BeginRegion("total");
         }
 
+        if (nullptr == pimpl->mMemoryTracker && GetPropertyBool(AI_CONFIG_GLOB_TRACK_MEMORY, false)) {
+            pimpl->mMemoryTracker = new MemoryTracker();
+        }
+        if (nullptr != pimpl->mMemoryTracker) {
+            pimpl->mMemoryTracker->OnBeginImport();
+        }
+        MemoryTracker::Scope trackerScope(pimpl->mMemoryTracker);
+        ParallelLimitScope limitScope(GetThreadLimit(this));
+        MemoryPhase detectPhase(this, "detect");
+
         // Find an worker class which can handle the file
         BaseImporter* imp = nullptr;
         SetPropertyInteger("importerIndex", -1);
@@ -650,6 +900,35 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             }
         }
 
+        detectPhase.End();
+
+        // Dispatch the reading to the worker class for this format
+        const aiImporterDesc *desc( imp->GetInfo() );
+        std::string ext( "unknown" );
+        if ( nullptr != desc ) {
+            ext = desc->mName;
+        }
+
+        // Look for the post-processed scene in the import cache
+        const std::string cacheKey = GetImportCacheKey(this, pFile, pFlags);
+        if (!cacheKey.empty()) {
+            MemoryPhase cachePhase(this, "cache");
+            pimpl->mScene = pimpl->mCache->Load(cacheKey, this);
+            SetPropertyString("sourceFilePath", pFile);
+            if (pimpl->mScene) {
+                ++pimpl->mCacheHits;
+                ASSIMP_LOG_INFO("Found the file in the import cache, skipping import and post-processing");
+                ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+                AddSourceFormatMetaData(pimpl->mScene, ext);
+                UpdateSceneStorage(this, pimpl->mScene);
+                if (profiler) {
+                    profiler->EndRegion("total");
+                }
+                return pimpl->mScene;
+            }
+            ++pimpl->mCacheMisses;
+        }
+
         // Get file size for progress handler
         IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
         uint32_t fileSize = 0;
@@ -659,21 +938,21 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             pimpl->mIOHandler->Close( fileIO );
         }
 
-        // Dispatch the reading to the worker class for this format
-        const aiImporterDesc *desc( imp->GetInfo() );
-        std::string ext( "unknown" );
-        if ( nullptr != desc ) {
-            ext = desc->mName;
-        }
         ASSIMP_LOG_INFO("Found a matching importer for this file format: " + ext + "." );
         pimpl->mProgressHandler->UpdateFileRead( 0, fileSize );
 
+        // record the other files the import reads, a cache entry is only valid while they are unchanged
+        std::unique_ptr<DependencyTracker> dependencies(cacheKey.empty() ? nullptr : new DependencyTracker(pFile, pimpl->mIOHandler));
+        DependencyScope dependencyScope(pimpl, dependencies.get());
+
         if (profiler) {
             profiler->BeginRegion("import");
         }
 
+        MemoryPhase parsePhase(this, "parse");
         pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
+        parsePhase.End();
 
         if (profiler) {
             profiler->EndRegion("import");
@@ -683,17 +962,13 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
         // If successful, apply all active post processing steps to the imported data
         if( pimpl->mScene)  {
-            if (!pimpl->mScene->mMetaData || !pimpl->mScene->mMetaData->HasKey(AI_METADATA_SOURCE_FORMAT)) {
-                if (!pimpl->mScene->mMetaData) {
-                    pimpl->mScene->mMetaData = new aiMetadata;
-                }
-                pimpl->mScene->mMetaData->Add(AI_METADATA_SOURCE_FORMAT, aiString(ext));
-            }
+            AddSourceFormatMetaData(pimpl->mScene, ext);
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure) {
                 ValidateDSProcess ds;
+                MemoryPhase validatePhase(this, pimpl->mMemoryTracker ? GetProcessName(&ds) : std::string(), aiProcess_ValidateDataStructure);
                 ds.ExecuteOnScene (this);
                 if (!pimpl->mScene) {
                     return nullptr;
@@ -706,8 +981,10 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
                 profiler->BeginRegion("preprocess");
             }
 
+            MemoryPhase convertPhase(this, "convert");
             ScenePreprocessor pre(pimpl->mScene);
             pre.ProcessScene();
+            convertPhase.End();
 
             if (profiler) {
                 profiler->EndRegion("preprocess");
@@ -715,6 +992,11 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+            // the storage of the scene is final already, ApplyPostProcessing() compacts it
+            if (pimpl->mScene && !cacheKey.empty()) {
+                pimpl->mCache->Store(cacheKey, pimpl->mScene, *dependencies);
+            }
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -760,9 +1042,13 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     if (!pimpl->mScene) {
         return nullptr;
     }
+    MemoryTracker::Scope trackerScope(pimpl->mMemoryTracker);
+    ParallelLimitScope limitScope(GetThreadLimit(this));
 
-    // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    // If no flags are given and no step is enabled by a property, return the current
+    // scene with no further action
+    if (!pFlags && !IsAnyStepRequested(this, pimpl->mPostProcessingSteps)) {
+        UpdateSceneStorage(this, pimpl->mScene);
         return pimpl->mScene;
     }
 
@@ -775,6 +1061,7 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     // list of post-processing steps, so we need to call it manually.
     if (pFlags & aiProcess_ValidateDataStructure) {
         ValidateDSProcess ds;
+        MemoryPhase validatePhase(this, pimpl->mMemoryTracker ? GetProcessName(&ds) : std::string(), aiProcess_ValidateDataStructure);
         ds.ExecuteOnScene (this);
         if (!pimpl->mScene) {
             return nullptr;
@@ -799,12 +1086,16 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
-        if( process->IsActive( pFlags)) {
+        if( process->IsActive( pFlags) || process->IsRequested(this)) {
             if (profiler) {
                 profiler->BeginRegion("postprocess");
             }
 
+            const unsigned int step = pimpl->mMemoryTracker ? GetActivatingStep(process, pFlags) : 0;
+            MemoryPhase phase(this, pimpl->mMemoryTracker ? GetProcessName(process) : std::string(), step);
+            PrepareSceneStorage(pimpl->mScene, process);
             process->ExecuteOnScene ( this );
+            phase.End();
 
             if (profiler) {
                 profiler->EndRegion("postprocess");
@@ -842,6 +1133,7 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
 
     // clear any data allocated by post-process steps
     pimpl->mPPShared->Clean();
+    UpdateSceneStorage(this, pimpl->mScene);
     ASSIMP_LOG_INFO("Leaving post processing pipeline");
 
     ASSIMP_END_EXCEPTION_REGION(const aiScene*);
@@ -859,6 +1151,8 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     if ( nullptr == pimpl->mScene ) {
         return nullptr;
     }
+    MemoryTracker::Scope trackerScope(pimpl->mMemoryTracker);
+    ParallelLimitScope limitScope(GetThreadLimit(this));
 
     // If no flags are given, return the current scene with no further action
     if (nullptr == rootProcess) {
@@ -899,7 +1193,10 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
         profiler->BeginRegion( "postprocess" );
     }
 
+    MemoryPhase phase(this, pimpl->mMemoryTracker ? GetProcessName(rootProcess) : std::string());
+    PrepareSceneStorage(pimpl->mScene, rootProcess);
     rootProcess->ExecuteOnScene( this );
+    phase.End();
 
     if ( profiler ) {
         profiler->EndRegion( "postprocess" );
@@ -918,6 +1215,7 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
 
     // clear any data allocated by post-process steps
     pimpl->mPPShared->Clean();
+    UpdateSceneStorage(this, pimpl->mScene);
     ASSIMP_LOG_INFO( "Leaving customized post processing pipeline" );
 
     ASSIMP_END_EXCEPTION_REGION( const aiScene* );
@@ -1171,6 +1469,11 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const {
             }
         }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
+        if (mScene->mMeshes[i]->HasMeshlets()) {
+            in.meshes += sizeof(aiMeshlet) * mScene->mMeshes[i]->mNumMeshlets;
+            in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumMeshletVertices;
+            in.meshes += mScene->mMeshes[i]->mNumMeshletIndices;
+        }
     }
     in.total += in.meshes;
 
@@ -54,10 +54,12 @@ struct aiScene;
 
 namespace Assimp    {
     class ProgressHandler;
+    class MemoryTracker;
     class IOSystem;
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ImportCache;
 
 
 //! @cond never
@@ -88,6 +90,9 @@ public:
     ProgressHandler* mProgressHandler;
     bool mIsDefaultProgressHandler;
 
+    /** Memory tracker, nullptr if tracking is disabled. */
+    MemoryTracker* mMemoryTracker;
+
     /** Format-specific importer worker objects - one for each format we can read.*/
     std::vector< BaseImporter* > mImporter;
 
@@ -123,6 +128,13 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Import cache, nullptr if AI_CONFIG_IMPORT_CACHE_DIRECTORY is not set */
+    ImportCache* mCache;
+
+    /** Number of imports served from the cache, and of imports which were not */
+    unsigned int mCacheHits;
+    unsigned int mCacheMisses;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -133,6 +145,7 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mIsDefaultHandler( false ),
         mProgressHandler( nullptr ),
         mIsDefaultProgressHandler( false ),
+        mMemoryTracker( nullptr ),
         mImporter(),
         mPostProcessingSteps(),
         mScene( nullptr ),
@@ -143,7 +156,10 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mStringProperties(),
         mMatrixProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mCache( nullptr ),
+        mCacheHits( 0 ),
+        mCacheMisses( 0 ) {
     // empty
 }
 //! @endcond
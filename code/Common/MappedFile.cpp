@@ -0,0 +1,120 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MappedFile.cpp
+ *  @brief Implementation of the file mapping.
+ */
+#include <assimp/MappedFile.h>
+
+#include <assimp/DefaultIOStream.h>
+#include <assimp/IOStream.hpp>
+
+#ifdef _WIN32
+#   include <io.h>
+#   include <windows.h>
+#else
+#   include <sys/mman.h>
+#endif
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+MappedFile::MappedFile(IOStream *stream, bool copyOnWrite) :
+        mData(nullptr),
+        mSize(0),
+        mCopyOnWrite(copyOnWrite)
+#ifdef _WIN32
+        , mHandle(nullptr)
+#endif
+{
+    // only plain files can be mapped, everything else goes through the stream
+    const DefaultIOStream *file = dynamic_cast<const DefaultIOStream *>(stream);
+    if (nullptr == file || nullptr == file->mFile) {
+        return;
+    }
+
+    const size_t size = file->FileSize();
+    if (0 == size) {
+        return;
+    }
+
+#ifdef _WIN32
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file->mFile)));
+    if (INVALID_HANDLE_VALUE == handle) {
+        return;
+    }
+    HANDLE mapping = ::CreateFileMappingA(handle, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping) {
+        return;
+    }
+    void *data = ::MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, size);
+    if (nullptr == data) {
+        ::CloseHandle(mapping);
+        return;
+    }
+    mHandle = mapping;
+#else
+    void *data = copyOnWrite ?
+            ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file->mFile), 0) :
+            ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(file->mFile), 0);
+    if (MAP_FAILED == data) {
+        return;
+    }
+#endif
+    mData = static_cast<const uint8_t *>(data);
+    mSize = size;
+}
+
+// ------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile() {
+    if (nullptr == mData) {
+        return;
+    }
+#ifdef _WIN32
+    ::UnmapViewOfFile(mData);
+    ::CloseHandle(static_cast<HANDLE>(mHandle));
+#else
+    ::munmap(const_cast<uint8_t *>(mData), mSize);
+#endif
+}
+
+} // end of namespace Assimp
@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  MemoryTracker.cpp
+ *  @brief Implementation of the MemoryTracker class
+ */
+#include <assimp/MemoryTracker.hpp>
+
+#include <algorithm>
+
+namespace Assimp {
+
+// The tracker which receives the allocations of the calling thread
+static thread_local MemoryTracker *s_currentTracker = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::Scope::Scope(MemoryTracker *tracker) :
+        mPrevious(s_currentTracker) {
+    s_currentTracker = tracker;
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::Scope::~Scope() {
+    s_currentTracker = mPrevious;
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::MemoryTracker() :
+        mPhases(),
+        mPeakSceneSize(),
+        mPeakBytes(0),
+        mAllocations(0),
+        mAllocatedBytes(0),
+        mDeallocations(0),
+        mFreedBytes(0),
+        mLiveBytes(0),
+        mPeakLiveBytes(0),
+        mPeakBase(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::~MemoryTracker() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker *MemoryTracker::GetCurrent() {
+    return s_currentTracker;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::CountAllocation(size_t size) {
+    MemoryTracker *tracker = s_currentTracker;
+    if (nullptr == tracker) {
+        return;
+    }
+
+    tracker->mAllocations.fetch_add(1, std::memory_order_relaxed);
+    tracker->mAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const long long live = tracker->mLiveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) +
+                           static_cast<long long>(size);
+    long long peak = tracker->mPeakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !tracker->mPeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        // peak was reloaded, try again
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::CountDeallocation(size_t size) {
+    MemoryTracker *tracker = s_currentTracker;
+    if (nullptr == tracker) {
+        return;
+    }
+
+    tracker->mDeallocations.fetch_add(1, std::memory_order_relaxed);
+    tracker->mFreedBytes.fetch_add(size, std::memory_order_relaxed);
+    tracker->mLiveBytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::GetAllocationCounters(Counters &counters) const {
+    counters.allocations = mAllocations.load(std::memory_order_relaxed);
+    counters.allocatedBytes = mAllocatedBytes.load(std::memory_order_relaxed);
+    counters.deallocations = mDeallocations.load(std::memory_order_relaxed);
+    counters.freedBytes = mFreedBytes.load(std::memory_order_relaxed);
+    const long long peak = mPeakLiveBytes.load(std::memory_order_relaxed) - mPeakBase.load(std::memory_order_relaxed);
+    counters.peakBytes = peak > 0 ? static_cast<size_t>(peak) : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::ResetPeak() {
+    const long long live = mLiveBytes.load(std::memory_order_relaxed);
+    mPeakBase.store(live, std::memory_order_relaxed);
+    mPeakLiveBytes.store(live, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::OnBeginImport() {
+    mPhases.clear();
+    mPeakSceneSize = aiMemoryInfo();
+    mPeakBytes = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::OnPhase(const aiMemoryPhaseInfo &phase) {
+    mPhases.push_back(phase);
+    if (phase.scene.total > mPeakSceneSize.total) {
+        mPeakSceneSize = phase.scene;
+    }
+    mPeakBytes = std::max(mPeakBytes, phase.peakBytes);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int MemoryTracker::GetNumPhases() const {
+    return static_cast<unsigned int>(mPhases.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMemoryPhaseInfo *MemoryTracker::GetPhase(unsigned int index) const {
+    return index < mPhases.size() ? &mPhases[index] : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMemoryInfo &MemoryTracker::GetPeakSceneSize() const {
+    return mPeakSceneSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryTracker::GetPeakBytes() const {
+    return mPeakBytes;
+}
+
+} // namespace Assimp
@@ -0,0 +1,197 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ParallelFor.cpp
+ *  @brief Thread pool and thread limit behind ParallelFor
+ */
+#include "ParallelFor.h"
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+#   include <condition_variable>
+#   include <deque>
+#   include <system_error>
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace Assimp {
+
+// The thread limit of the calling thread, 0 if there is none
+static thread_local unsigned int s_parallelLimit = 0;
+
+// ------------------------------------------------------------------------------------------------
+ParallelLimitScope::ParallelLimitScope(unsigned int maxThreads) :
+        mPrevious(s_parallelLimit) {
+    s_parallelLimit = maxThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+ParallelLimitScope::~ParallelLimitScope() {
+    s_parallelLimit = mPrevious;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ParallelLimitScope::GetCurrent() {
+    return s_parallelLimit;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GetParallelWorkerCount() {
+#ifdef ASSIMP_BUILD_NO_PARALLEL
+    return 1;
+#else
+    unsigned int count = std::thread::hardware_concurrency();
+    if (0 != s_parallelLimit) {
+        count = std::min(count, s_parallelLimit);
+    }
+    return count > 0 ? count : 1;
+#endif
+}
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+
+namespace {
+
+// A loop handed to the pool
+struct ParallelTask {
+    void (*run)(void *);
+    void *context;
+    size_t helpers; // pool threads which may still join
+    size_t active;  // pool threads running it
+};
+
+// ------------------------------------------------------------------------------------------------
+// Threads are started on demand, up to one less than the number of hardware threads, and
+// wait for tasks afterwards. Tasks are served in the order they were handed in.
+class ParallelPool {
+public:
+    void Run(void (*run)(void *), void *context, size_t numHelpers) {
+        ParallelTask task = { run, context, 0, 0 };
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            StartThreads(numHelpers);
+            task.helpers = std::min(numHelpers, mThreads.size());
+            if (0 != task.helpers) {
+                mTasks.push_back(&task);
+                queued = true;
+            }
+        }
+        if (queued) {
+            mWake.notify_all();
+        }
+
+        run(context);
+
+        // all blocks are taken once the calling thread returns, so threads which did not
+        // join yet are not waited for
+        std::unique_lock<std::mutex> lock(mMutex);
+        std::deque<ParallelTask *>::iterator it = std::find(mTasks.begin(), mTasks.end(), &task);
+        if (it != mTasks.end()) {
+            mTasks.erase(it);
+        }
+        mDone.wait(lock, [&task]() { return 0 == task.active; });
+    }
+
+private:
+    void StartThreads(size_t count) {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        count = std::min<size_t>(count, hardware > 1 ? hardware - 1 : 0);
+        while (mThreads.size() < count) {
+            try {
+                mThreads.emplace_back(&ParallelPool::WorkerLoop, this);
+            } catch (const std::system_error &) {
+                // out of threads, continue with the ones we have
+                return;
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (;;) {
+            mWake.wait(lock, [this]() { return !mTasks.empty(); });
+            ParallelTask *task = mTasks.front();
+            if (0 == --task->helpers) {
+                mTasks.pop_front();
+            }
+            ++task->active;
+
+            lock.unlock();
+            task->run(task->context);
+            lock.lock();
+
+            if (0 == --task->active) {
+                mDone.notify_all();
+            }
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    std::deque<ParallelTask *> mTasks;
+    std::vector<std::thread> mThreads;
+};
+
+} // namespace
+
+#endif // ASSIMP_BUILD_NO_PARALLEL
+
+// ------------------------------------------------------------------------------------------------
+void RunParallel(void (*run)(void *), void *context, size_t numHelpers) {
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+    if (0 != numHelpers) {
+        // never destroyed, joining threads while the process or the library shuts down
+        // may deadlock, and idle threads hold no resources worth releasing
+        static ParallelPool *pool = new ParallelPool();
+        pool->Run(run, context, numHelpers);
+        return;
+    }
+#else
+    (void)numHelpers;
+#endif
+    run(context);
+}
+
+} // end of namespace Assimp
@@ -0,0 +1,185 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Minimal helper to distribute independent loop iterations over threads.
+ */
+#pragma once
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/MemoryTracker.hpp>
+
+#include <algorithm>
+#include <stddef.h>
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+#   include <atomic>
+#   include <exception>
+#   include <mutex>
+#endif
+
+namespace Assimp {
+
+/// Estimated work below which #ParallelFor runs a loop serially, in elementary steps such
+/// as vertices, faces or keys. Waking up worker threads costs more than such loops take.
+static const size_t ParallelMinWork = 16384;
+
+// --------------------------------------------------------------------------------------------
+/** @brief Limits the number of threads #ParallelFor uses on the calling thread until the
+ *  scope ends, then restores the previous limit.
+ *
+ *  The importer opens a scope with the value of #AI_CONFIG_GLOB_MULTITHREADING for each
+ *  import and post-processing run. Worker threads take over the limit of the thread which
+ *  started the loop. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API ParallelLimitScope {
+public:
+    /// @param maxThreads Maximum number of threads including the calling one, 0 for no limit.
+    explicit ParallelLimitScope(unsigned int maxThreads);
+    ~ParallelLimitScope();
+
+    /// Returns the limit of the calling thread, 0 if there is none.
+    static unsigned int GetCurrent();
+
+private:
+    ParallelLimitScope(const ParallelLimitScope &) = delete;
+    ParallelLimitScope &operator=(const ParallelLimitScope &) = delete;
+
+    unsigned int mPrevious;
+};
+
+// --------------------------------------------------------------------------------------------
+/** @brief Returns the number of threads used by #ParallelFor on the calling thread, at
+ *  least 1: the number of hardware threads, capped by the current #ParallelLimitScope. */
+// --------------------------------------------------------------------------------------------
+ASSIMP_API unsigned int GetParallelWorkerCount();
+
+// --------------------------------------------------------------------------------------------
+/** @brief Calls run(context) on the calling thread and on up to numHelpers threads of a
+ *  pool shared by the whole process. Returns once all of them have returned. Pool threads
+ *  only join while the calling thread is still running, so run must not rely on them.
+ *  run must not throw. */
+// --------------------------------------------------------------------------------------------
+ASSIMP_API void RunParallel(void (*run)(void *), void *context, size_t numHelpers);
+
+// --------------------------------------------------------------------------------------------
+/** @brief Calls func(i) for each i in [begin, end), distributed over worker threads.
+ *
+ *  The calling thread takes part in the work, the other threads come from a pool which is
+ *  shared by all loops, so concurrent imports do not multiply the number of threads.
+ *  Iterations are handed out in blocks of @c grain, so @c func must not depend on the order
+ *  of execution. @c work estimates the cost of the whole loop in elementary steps; loops
+ *  below #ParallelMinWork and loops with a single block run serially. If @c func throws,
+ *  the remaining blocks are skipped and the first exception is rethrown in the calling
+ *  thread once all workers have finished. Builds with ASSIMP_BUILD_NO_PARALLEL run the
+ *  loop serially.
+ *
+ *  @c func may log. #DefaultLogger and its built-in streams can be written by several
+ *  threads at once, but the order of the messages then depends on the scheduling, and
+ *  loggers or streams set up by the application need not be thread-safe. Loops whose
+ *  messages matter collect them and log them in the calling thread afterwards. The
+ *  logger must not be replaced and no streams attached or detached while a loop runs. */
+// --------------------------------------------------------------------------------------------
+template <typename Func>
+void ParallelFor(size_t begin, size_t end, const Func &func, size_t grain = 1, size_t work = ParallelMinWork) {
+    if (end <= begin) {
+        return;
+    }
+
+    grain = std::max<size_t>(grain, 1);
+    const size_t numBlocks = (end - begin + grain - 1) / grain;
+    const size_t numThreads = work < ParallelMinWork ? 1 : std::min<size_t>(GetParallelWorkerCount(), numBlocks);
+    if (numThreads <= 1) {
+        for (size_t i = begin; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+#ifndef ASSIMP_BUILD_NO_PARALLEL
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    // allocations of the workers count for the importer which started the loop, nested
+    // loops keep its thread limit
+    MemoryTracker *const tracker = MemoryTracker::GetCurrent();
+    const unsigned int limit = ParallelLimitScope::GetCurrent();
+    auto worker = [&]() {
+        MemoryTracker::Scope trackerScope(tracker);
+        ParallelLimitScope limitScope(limit);
+        for (;;) {
+            const size_t block = next.fetch_add(1);
+            if (block >= numBlocks) {
+                return;
+            }
+
+            const size_t first = begin + block * grain;
+            const size_t last = std::min(end, first + grain);
+            try {
+                for (size_t i = first; i < last; ++i) {
+                    func(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = numBlocks;
+                return;
+            }
+        }
+    };
+
+    typedef decltype(worker) Worker;
+    RunParallel([](void *context) { (*static_cast<Worker *>(context))(); }, &worker, numThreads - 1);
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+
+} // end of namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
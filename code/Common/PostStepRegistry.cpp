@@ -137,6 +137,15 @@ corresponding preprocessor flag to selectively disable steps.
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
 #   include "PostProcessing/GenBoundingBoxesProcess.h"
 #endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS)
+#   include "PostProcessing/OptimizeAnimationsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENLODS_PROCESS)
+#   include "PostProcessing/GenLODsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+#   include "PostProcessing/GenMeshletsProcess.h"
+#endif
 
 
 
@@ -150,7 +159,7 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
     // of sequence it is executed. Steps that are added here are not
     // validated - as RegisterPPStep() does - all dependencies must be given.
     // ----------------------------------------------------------------------------
-    out.reserve(31);
+    out.reserve(34);
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
     out.push_back( new MakeLeftHandedProcess());
 #endif
@@ -254,9 +263,18 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS)
+    out.push_back( new OptimizeAnimationsProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENLODS_PROCESS)
+    out.push_back( new GenLODsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+    out.push_back( new GenMeshletsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
     out.push_back(new GenBoundingBoxesProcess);
 #endif
@@ -1039,6 +1039,22 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
     // now - copy the root node of the scene (deep copy, too)
     Copy(&dest->mRootNode, src->mRootNode);
 
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+    // bones still reference the nodes of the source scene, redirect them to the copied nodes
+    for (unsigned int i = 0; i < dest->mNumMeshes; ++i) {
+        aiMesh *mesh = dest->mMeshes[i];
+        for (unsigned int j = 0; j < mesh->mNumBones; ++j) {
+            aiBone *bone = mesh->mBones[j];
+            if (nullptr != bone->mArmature) {
+                bone->mArmature = dest->mRootNode ? dest->mRootNode->FindNode(bone->mArmature->mName) : nullptr;
+            }
+            if (nullptr != bone->mNode) {
+                bone->mNode = dest->mRootNode ? dest->mRootNode->FindNode(bone->mNode->mName) : nullptr;
+            }
+        }
+    }
+#endif
+
     // and keep the flags ...
     dest->mFlags = src->mFlags;
 
@@ -1085,8 +1101,18 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
         GetArrayCopy(f.mIndices, f.mNumIndices);
     }
 
+    // the faces got their own indices, copies never share an index buffer. Callers such as
+    // the Exporter run post-processing steps on them, which reallocate face indices
+    dest->mIndices = nullptr;
+    dest->mNumIndices = 0;
+
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
+
+    // and of the meshlets
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    GetArrayCopy(dest->mMeshletVertices, dest->mNumMeshletVertices);
+    GetArrayCopy(dest->mMeshletIndices, dest->mNumMeshletIndices);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,655 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file TextStreamWriter.cpp
+ *  @brief Implementation of the buffered text writer.
+ */
+#include "TextStreamWriter.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/ai_assert.h>
+#include <assimp/fast_atof.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Assimp {
+
+namespace {
+
+// Number of significant digits which always survive a decimal round-trip (digits10), and
+// the number which is always enough to read the value back (max_digits10)
+template <typename Real>
+struct RealDigits;
+
+template <>
+struct RealDigits<float> {
+    static const int Short = 6;
+    static const int Max = 9;
+};
+
+template <>
+struct RealDigits<double> {
+    static const int Short = 15;
+    static const int Max = 17;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Rounds a finite, positive value to 'precision' significant decimal digits. Returns the
+// number of digits without trailing zeros, the decimal exponent of the first digit is
+// stored in 'exponent'. The decimal separator printf emits depends on the current locale,
+// so anything but digits in front of the exponent is skipped.
+int ExtractDigits(double value, int precision, char *digits, int &exponent) {
+    char tmp[64];
+    ::snprintf(tmp, sizeof(tmp), "%.*e", precision - 1, value);
+
+    int count = 0;
+    const char *c = tmp;
+    for (; *c != 'e' && *c != '\0'; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            digits[count++] = *c;
+        }
+    }
+
+    exponent = 0;
+    if (*c == 'e') {
+        ++c;
+        const bool negative = (*c == '-');
+        if (negative || *c == '+') {
+            ++c;
+        }
+        for (; *c >= '0' && *c <= '9'; ++c) {
+            exponent = exponent * 10 + (*c - '0');
+        }
+        if (negative) {
+            exponent = -exponent;
+        }
+    }
+
+    while (count > 1 && digits[count - 1] == '0') {
+        --count;
+    }
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether the digits read back to exactly the same value, using the same parser
+// the importers use.
+template <typename Real>
+bool RoundTrips(const char *digits, int count, int exponent, Real value) {
+    char tmp[64];
+    ::memcpy(tmp, digits, count);
+    ::snprintf(tmp + count, sizeof(tmp) - count, "e%d", exponent - count + 1);
+
+    Real parsed = 0;
+    fast_atoreal_move<Real>(tmp, parsed, false);
+    return parsed == value;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Adds one unit in the last of 'precision' significant digits and strips trailing zeros again.
+int IncrementDigits(char *digits, int count, int precision, int &exponent) {
+    for (; count < precision; ++count) {
+        digits[count] = '0';
+    }
+    int i = precision - 1;
+    for (; i >= 0 && digits[i] == '9'; --i) {
+        digits[i] = '0';
+    }
+    if (i < 0) {
+        digits[0] = '1';
+        ++exponent;
+    } else {
+        ++digits[i];
+    }
+    while (count > 1 && digits[count - 1] == '0') {
+        --count;
+    }
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finds the fewest significant digits which read back to value, used where Grisu3 gives up.
+// Every decimal with up to digits10 digits survives the round-trip, so if the value rounded
+// to digits10 digits reads back, stripping the trailing zeros already yields the shortest
+// form. Otherwise each longer precision is tried in turn. The correctly rounded digits are
+// the closest candidate, except for powers of two whose gap to the next lower value is only
+// half as wide: there the next decimal above may read back while the closest one below does
+// not.
+template <typename Real>
+int ShortestDigits(Real value, char *digits, int &exponent) {
+    int count = ExtractDigits(value, RealDigits<Real>::Short, digits, exponent);
+    if (RoundTrips(digits, count, exponent, value)) {
+        return count;
+    }
+
+    int e2 = 0;
+    const bool powerOfTwo = std::frexp(value, &e2) == 0.5;
+    for (int precision = RealDigits<Real>::Short + 1; precision < RealDigits<Real>::Max; ++precision) {
+        count = ExtractDigits(value, precision, digits, exponent);
+        if (RoundTrips(digits, count, exponent, value)) {
+            return count;
+        }
+        if (powerOfTwo) {
+            char up[32];
+            int upExponent = exponent;
+            ::memcpy(up, digits, count);
+            const int upCount = IncrementDigits(up, count, precision, upExponent);
+            if (RoundTrips(up, upCount, upExponent, value)) {
+                ::memcpy(digits, up, upCount);
+                exponent = upExponent;
+                return upCount;
+            }
+        }
+    }
+    return ExtractDigits(value, RealDigits<Real>::Max, digits, exponent);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Grisu3, see Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+// Integers", PLDI 2010. It finds the shortest digits with 64 bit integer arithmetic only, but
+// gives up for less than 1% of all values, for which ShortestDigits() is used instead.
+
+// Unpacked floating-point value f * 2^e
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+// Layout of the IEEE 754 types
+template <typename Real>
+struct RealBits;
+
+template <>
+struct RealBits<float> {
+    typedef uint32_t Bits;
+    static const int SignificandSize = 23;
+    static const int ExponentBias = 127 + SignificandSize;
+};
+
+template <>
+struct RealBits<double> {
+    typedef uint64_t Bits;
+    static const int SignificandSize = 52;
+    static const int ExponentBias = 1023 + SignificandSize;
+};
+
+// Normalized powers of ten 10^k for k = -348, -340, ..., 340, rounded to 64 bits
+struct CachedPower {
+    uint64_t f;
+    int16_t e;
+    int16_t k;
+};
+
+const CachedPower CachedPowers[] = {
+    { 0xfa8fd5a0081c0288ull, -1220, -348 },
+    { 0xbaaee17fa23ebf76ull, -1193, -340 },
+    { 0x8b16fb203055ac76ull, -1166, -332 },
+    { 0xcf42894a5dce35eaull, -1140, -324 },
+    { 0x9a6bb0aa55653b2dull, -1113, -316 },
+    { 0xe61acf033d1a45dfull, -1087, -308 },
+    { 0xab70fe17c79ac6caull, -1060, -300 },
+    { 0xff77b1fcbebcdc4full, -1034, -292 },
+    { 0xbe5691ef416bd60cull, -1007, -284 },
+    { 0x8dd01fad907ffc3cull, -980, -276 },
+    { 0xd3515c2831559a83ull, -954, -268 },
+    { 0x9d71ac8fada6c9b5ull, -927, -260 },
+    { 0xea9c227723ee8bcbull, -901, -252 },
+    { 0xaecc49914078536dull, -874, -244 },
+    { 0x823c12795db6ce57ull, -847, -236 },
+    { 0xc21094364dfb5637ull, -821, -228 },
+    { 0x9096ea6f3848984full, -794, -220 },
+    { 0xd77485cb25823ac7ull, -768, -212 },
+    { 0xa086cfcd97bf97f4ull, -741, -204 },
+    { 0xef340a98172aace5ull, -715, -196 },
+    { 0xb23867fb2a35b28eull, -688, -188 },
+    { 0x84c8d4dfd2c63f3bull, -661, -180 },
+    { 0xc5dd44271ad3cdbaull, -635, -172 },
+    { 0x936b9fcebb25c996ull, -608, -164 },
+    { 0xdbac6c247d62a584ull, -582, -156 },
+    { 0xa3ab66580d5fdaf6ull, -555, -148 },
+    { 0xf3e2f893dec3f126ull, -529, -140 },
+    { 0xb5b5ada8aaff80b8ull, -502, -132 },
+    { 0x87625f056c7c4a8bull, -475, -124 },
+    { 0xc9bcff6034c13053ull, -449, -116 },
+    { 0x964e858c91ba2655ull, -422, -108 },
+    { 0xdff9772470297ebdull, -396, -100 },
+    { 0xa6dfbd9fb8e5b88full, -369, -92 },
+    { 0xf8a95fcf88747d94ull, -343, -84 },
+    { 0xb94470938fa89bcfull, -316, -76 },
+    { 0x8a08f0f8bf0f156bull, -289, -68 },
+    { 0xcdb02555653131b6ull, -263, -60 },
+    { 0x993fe2c6d07b7facull, -236, -52 },
+    { 0xe45c10c42a2b3b06ull, -210, -44 },
+    { 0xaa242499697392d3ull, -183, -36 },
+    { 0xfd87b5f28300ca0eull, -157, -28 },
+    { 0xbce5086492111aebull, -130, -20 },
+    { 0x8cbccc096f5088ccull, -103, -12 },
+    { 0xd1b71758e219652cull, -77, -4 },
+    { 0x9c40000000000000ull, -50, 4 },
+    { 0xe8d4a51000000000ull, -24, 12 },
+    { 0xad78ebc5ac620000ull, 3, 20 },
+    { 0x813f3978f8940984ull, 30, 28 },
+    { 0xc097ce7bc90715b3ull, 56, 36 },
+    { 0x8f7e32ce7bea5c70ull, 83, 44 },
+    { 0xd5d238a4abe98068ull, 109, 52 },
+    { 0x9f4f2726179a2245ull, 136, 60 },
+    { 0xed63a231d4c4fb27ull, 162, 68 },
+    { 0xb0de65388cc8ada8ull, 189, 76 },
+    { 0x83c7088e1aab65dbull, 216, 84 },
+    { 0xc45d1df942711d9aull, 242, 92 },
+    { 0x924d692ca61be758ull, 269, 100 },
+    { 0xda01ee641a708deaull, 295, 108 },
+    { 0xa26da3999aef774aull, 322, 116 },
+    { 0xf209787bb47d6b85ull, 348, 124 },
+    { 0xb454e4a179dd1877ull, 375, 132 },
+    { 0x865b86925b9bc5c2ull, 402, 140 },
+    { 0xc83553c5c8965d3dull, 428, 148 },
+    { 0x952ab45cfa97a0b3ull, 455, 156 },
+    { 0xde469fbd99a05fe3ull, 481, 164 },
+    { 0xa59bc234db398c25ull, 508, 172 },
+    { 0xf6c69a72a3989f5cull, 534, 180 },
+    { 0xb7dcbf5354e9beceull, 561, 188 },
+    { 0x88fcf317f22241e2ull, 588, 196 },
+    { 0xcc20ce9bd35c78a5ull, 614, 204 },
+    { 0x98165af37b2153dfull, 641, 212 },
+    { 0xe2a0b5dc971f303aull, 667, 220 },
+    { 0xa8d9d1535ce3b396ull, 694, 228 },
+    { 0xfb9b7cd9a4a7443cull, 720, 236 },
+    { 0xbb764c4ca7a44410ull, 747, 244 },
+    { 0x8bab8eefb6409c1aull, 774, 252 },
+    { 0xd01fef10a657842cull, 800, 260 },
+    { 0x9b10a4e5e9913129ull, 827, 268 },
+    { 0xe7109bfba19c0c9dull, 853, 276 },
+    { 0xac2820d9623bf429ull, 880, 284 },
+    { 0x80444b5e7aa7cf85ull, 907, 292 },
+    { 0xbf21e44003acdd2dull, 933, 300 },
+    { 0x8e679c2f5e44ff8full, 960, 308 },
+    { 0xd433179d9c8cb841ull, 986, 316 },
+    { 0x9e19db92b4e31ba9ull, 1013, 324 },
+    { 0xeb96bf6ebadf77d9ull, 1039, 332 },
+    { 0xaf87023b9bf0ee6bull, 1066, 340 },
+};
+
+const int CachedPowersOffset = 348; // -k of the first entry
+const int CachedPowersStep = 8;
+
+// Range of binary exponents the scaled value has to fall into, so that DigitGen() can split
+// it into a 32 bit integral and a fractional part
+const int MinTargetExponent = -60;
+const int MaxTargetExponent = -32;
+
+// ------------------------------------------------------------------------------------------------
+inline DiyFp Normalize(DiyFp v) {
+    while (!(v.f & (1ull << 63))) {
+        v.f <<= 1;
+        --v.e;
+    }
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Upper 64 bits of the 128 bit product, rounded
+inline DiyFp Multiply(DiyFp x, DiyFp y) {
+    const uint64_t M32 = 0xFFFFFFFFu;
+    const uint64_t a = x.f >> 32, b = x.f & M32;
+    const uint64_t c = y.f >> 32, d = y.f & M32;
+    const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1u << 31;
+    DiyFp r;
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the last digit towards w while that keeps it inside the rounding interval and brings
+// it closer to w. Fails if the result is not provably the closest shortest representation.
+bool RoundWeed(char *digits, int count, uint64_t distanceTooHighW, uint64_t unsafeInterval,
+        uint64_t rest, uint64_t tenKappa, uint64_t unit) {
+    const uint64_t smallDistance = distanceTooHighW - unit;
+    const uint64_t bigDistance = distanceTooHighW + unit;
+    while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+            (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+        --digits[count - 1];
+        rest += tenKappa;
+    }
+    if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+            (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance)) {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Generates the digits of the scaled value w, as few as needed to stay between low and high.
+// The exponent of the last digit is stored in 'kappa'.
+bool DigitGen(DiyFp low, DiyFp w, DiyFp high, char *digits, int &count, int &kappa) {
+    uint64_t unit = 1;
+    const DiyFp tooLow = { low.f - unit, low.e };
+    const DiyFp tooHigh = { high.f + unit, high.e };
+    uint64_t unsafeInterval = tooHigh.f - tooLow.f;
+    const int shift = -w.e;
+    const uint64_t one = 1ull << shift;
+    uint32_t integrals = static_cast<uint32_t>(tooHigh.f >> shift);
+    uint64_t fractionals = tooHigh.f & (one - 1);
+
+    uint32_t divisor = 0;
+    kappa = 0;
+    if (integrals) {
+        divisor = 1;
+        kappa = 1;
+        while (kappa < 10 && static_cast<uint64_t>(divisor) * 10 <= integrals) {
+            divisor *= 10;
+            ++kappa;
+        }
+    }
+
+    count = 0;
+    while (kappa > 0) {
+        digits[count++] = static_cast<char>('0' + integrals / divisor);
+        integrals %= divisor;
+        --kappa;
+        const uint64_t rest = (static_cast<uint64_t>(integrals) << shift) + fractionals;
+        if (rest < unsafeInterval) {
+            return RoundWeed(digits, count, tooHigh.f - w.f, unsafeInterval, rest,
+                    static_cast<uint64_t>(divisor) << shift, unit);
+        }
+        divisor /= 10;
+    }
+
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval *= 10;
+        digits[count++] = static_cast<char>('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        --kappa;
+        if (fractionals < unsafeInterval) {
+            return RoundWeed(digits, count, (tooHigh.f - w.f) * unit, unsafeInterval, fractionals, one, unit);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Shortest digits of a finite, positive value with Grisu3. Returns 0 if it cannot guarantee
+// the result, the decimal exponent of the first digit is stored in 'exponent'.
+template <typename Real>
+int GrisuDigits(Real value, char *digits, int &exponent) {
+    typedef RealBits<Real> Layout;
+    typename Layout::Bits bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+
+    const typename Layout::Bits hiddenBit = static_cast<typename Layout::Bits>(1) << Layout::SignificandSize;
+    const int biasedExponent = static_cast<int>(bits >> Layout::SignificandSize);
+    DiyFp v;
+    v.f = bits & (hiddenBit - 1);
+    if (biasedExponent) {
+        v.f |= hiddenBit;
+        v.e = biasedExponent - Layout::ExponentBias;
+    } else {
+        v.e = 1 - Layout::ExponentBias;
+    }
+
+    // the gap to the next lower value is only half as wide for powers of two
+    const DiyFp plus = Normalize(DiyFp{ (v.f << 1) + 1, v.e - 1 });
+    DiyFp minus = (v.f == hiddenBit && biasedExponent > 1) ? DiyFp{ (v.f << 2) - 1, v.e - 2 } : DiyFp{ (v.f << 1) - 1, v.e - 1 };
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    const DiyFp w = Normalize(v);
+
+    // pick a power of ten which moves the exponent of w into the target range
+    const int minExponent = MinTargetExponent - (w.e + 64);
+    const int k = static_cast<int>(std::ceil((minExponent + 63) * 0.30102999566398114));
+    const CachedPower &power = CachedPowers[(CachedPowersOffset + k - 1) / CachedPowersStep + 1];
+    ai_assert(power.e >= minExponent && power.e <= MaxTargetExponent - (w.e + 64));
+    const DiyFp tenMk = { power.f, power.e };
+
+    int count = 0, kappa = 0;
+    if (!DigitGen(Multiply(minus, tenMk), Multiply(w, tenMk), Multiply(plus, tenMk), digits, count, kappa)) {
+        return 0;
+    }
+    exponent = kappa - power.k + count - 1;
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Real>
+size_t FormatRealImpl(Real value, char *out) {
+    char *o = out;
+    if (std::isnan(value)) {
+        ::memcpy(o, "nan", 4);
+        return 3;
+    }
+    if (std::signbit(value)) {
+        *o++ = '-';
+        value = -value;
+    }
+    if (std::isinf(value)) {
+        ::memcpy(o, "inf", 4);
+        return (o - out) + 3;
+    }
+    if (value == 0) {
+        *o++ = '0';
+        *o = '\0';
+        return o - out;
+    }
+
+    char digits[32];
+    int exponent = 0;
+    int count = GrisuDigits(value, digits, exponent);
+    if (0 == count) {
+        count = ShortestDigits(value, digits, exponent);
+    }
+
+    if (exponent < -4 || exponent >= RealDigits<Real>::Max) {
+        *o++ = digits[0];
+        if (count > 1) {
+            *o++ = '.';
+            ::memcpy(o, digits + 1, count - 1);
+            o += count - 1;
+        }
+        *o++ = 'e';
+        *o++ = exponent < 0 ? '-' : '+';
+        const int e = std::abs(exponent);
+        if (e >= 100) {
+            *o++ = static_cast<char>('0' + e / 100);
+        }
+        *o++ = static_cast<char>('0' + (e / 10) % 10);
+        *o++ = static_cast<char>('0' + e % 10);
+    } else if (exponent >= 0) {
+        const int intDigits = exponent + 1;
+        for (int i = 0; i < intDigits; ++i) {
+            *o++ = i < count ? digits[i] : '0';
+        }
+        if (count > intDigits) {
+            *o++ = '.';
+            ::memcpy(o, digits + intDigits, count - intDigits);
+            o += count - intDigits;
+        }
+    } else {
+        *o++ = '0';
+        *o++ = '.';
+        for (int i = -1; i > exponent; --i) {
+            *o++ = '0';
+        }
+        ::memcpy(o, digits, count);
+        o += count;
+    }
+
+    *o = '\0';
+    return o - out;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter::TextStreamWriter(IOStream *stream, size_t bufferSize) :
+        mStream(stream),
+        mBuffer(std::max<size_t>(bufferSize, 1)),
+        mUsed(0),
+        mGood(nullptr != stream) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter::~TextStreamWriter() {
+    Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+void TextStreamWriter::Write(const void *data, size_t length) {
+    if (length > mBuffer.size() - mUsed) {
+        Flush();
+
+        // too large to be worth buffering, hand it over directly
+        if (length >= mBuffer.size()) {
+            if (mGood && mStream->Write(data, length, 1) != 1) {
+                mGood = false;
+            }
+            return;
+        }
+    }
+    ::memcpy(&mBuffer[mUsed], data, length);
+    mUsed += length;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TextStreamWriter::Flush() {
+    if (mUsed > 0 && mGood && mStream->Write(mBuffer.data(), mUsed, 1) != 1) {
+        mGood = false;
+    }
+    mUsed = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TextStreamWriter::WriteUnsigned(unsigned long long value, bool negative) {
+    char tmp[24];
+    char *c = tmp + sizeof(tmp);
+    do {
+        *--c = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (negative) {
+        *--c = '-';
+    }
+    Write(c, tmp + sizeof(tmp) - c);
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(const char *str) {
+    Write(str, ::strlen(str));
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(const std::string &str) {
+    Write(str.data(), str.length());
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(int value) {
+    return *this << static_cast<long long>(value);
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(unsigned int value) {
+    WriteUnsigned(value, false);
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(long value) {
+    return *this << static_cast<long long>(value);
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(unsigned long value) {
+    WriteUnsigned(value, false);
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(long long value) {
+    // negate in unsigned arithmetic, -LLONG_MIN does not fit into a long long
+    const unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    WriteUnsigned(magnitude, value < 0);
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(unsigned long long value) {
+    WriteUnsigned(value, false);
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(float value) {
+    char tmp[MaxRealLength];
+    Write(tmp, FormatReal(value, tmp));
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+TextStreamWriter &TextStreamWriter::operator<<(double value) {
+    char tmp[MaxRealLength];
+    Write(tmp, FormatReal(value, tmp));
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t TextStreamWriter::FormatReal(float value, char *out) {
+    return FormatRealImpl(value, out);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t TextStreamWriter::FormatReal(double value, char *out) {
+    return FormatRealImpl(value, out);
+}
+
+} // end of namespace Assimp
@@ -0,0 +1,153 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file TextStreamWriter.h
+ *  @brief Buffered, locale-independent text output for the exporters.
+ */
+#pragma once
+#ifndef AI_TEXTSTREAMWRITER_H_INC
+#define AI_TEXTSTREAMWRITER_H_INC
+
+#include <assimp/defs.h>
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+class IOStream;
+
+// --------------------------------------------------------------------------------------------
+/** @brief Writes text (and raw bytes) to an IOStream through a fixed-size buffer.
+ *
+ *  Replaces the std::ostringstream the exporters used to build their whole output in.
+ *  The buffer is handed to the stream whenever it fills up, so memory use does not
+ *  grow with the size of the exported file. Numbers are always formatted as in the
+ *  C locale. Floating-point values are written with as few digits as are needed to
+ *  read the very same value back, in the style of printf's %g.
+ *
+ *  Write errors are sticky: once the stream refused data, all further output is
+ *  dropped and IsGood() returns false. Callers should Flush() at the end and check
+ *  IsGood() then. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API TextStreamWriter {
+public:
+    /// Default size of the output buffer in bytes.
+    static const size_t DefaultBufferSize = 64 * 1024;
+
+    /// Maximum number of characters FormatReal() writes, including the terminating zero.
+    static const size_t MaxRealLength = 32;
+
+    // ----------------------------------------------------------------------------
+    /** @brief Constructs a writer on top of a stream.
+     *  @param stream Stream to write to, not owned. Must outlive the writer.
+     *  @param bufferSize Size of the output buffer in bytes. */
+    explicit TextStreamWriter(IOStream *stream, size_t bufferSize = DefaultBufferSize);
+
+    /// Destructor, flushes all pending output.
+    ~TextStreamWriter();
+
+    // ----------------------------------------------------------------------------
+    /** @brief Appends raw bytes. */
+    void Write(const void *data, size_t length);
+
+    /// Appends a single character.
+    void Put(char c) {
+        if (mUsed == mBuffer.size()) {
+            Flush();
+        }
+        mBuffer[mUsed++] = c;
+    }
+
+    /// Hands all buffered output to the stream.
+    void Flush();
+
+    /// Returns false once a write to the stream has failed.
+    bool IsGood() const {
+        return mGood;
+    }
+
+    TextStreamWriter &operator<<(const char *str);
+    TextStreamWriter &operator<<(const std::string &str);
+    TextStreamWriter &operator<<(char c) {
+        Put(c);
+        return *this;
+    }
+    TextStreamWriter &operator<<(int value);
+    TextStreamWriter &operator<<(unsigned int value);
+    TextStreamWriter &operator<<(long value);
+    TextStreamWriter &operator<<(unsigned long value);
+    TextStreamWriter &operator<<(long long value);
+    TextStreamWriter &operator<<(unsigned long long value);
+    TextStreamWriter &operator<<(float value);
+    TextStreamWriter &operator<<(double value);
+
+    // ----------------------------------------------------------------------------
+    /** @brief Formats a real with the shortest representation that reads back to it.
+     *
+     *  The digits are generated with Grisu3 in integer arithmetic. For the few values
+     *  Grisu3 cannot decide, they are found by rounding to increasing precisions.
+     *  Fixed notation is used for decimal exponents in [-4, max_digits10), scientific
+     *  notation otherwise. NaN and infinity are written as "nan", "inf" and "-inf".
+     *  @param value Value to format.
+     *  @param out Receives the zero-terminated text, at least MaxRealLength chars.
+     *  @return Number of characters written, not counting the terminating zero. */
+    static size_t FormatReal(float value, char *out);
+    static size_t FormatReal(double value, char *out);
+
+private:
+    TextStreamWriter(const TextStreamWriter &) = delete;
+    TextStreamWriter &operator=(const TextStreamWriter &) = delete;
+
+    void WriteUnsigned(unsigned long long value, bool negative);
+
+private:
+    IOStream *mStream;
+    std::vector<char> mBuffer;
+    size_t mUsed;
+    bool mGood;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_TEXTSTREAMWRITER_H_INC
@@ -2,7 +2,11 @@
 #define INCLUDED_ASSBIN_CHUNKS_H
 
 #define ASSBIN_VERSION_MAJOR 1
-#define ASSBIN_VERSION_MINOR 0
+#define ASSBIN_VERSION_MINOR 1
+
+// version of the flat (memory-mappable) layout, see section 4 below
+#define ASSBIN_FLAT_VERSION_MAJOR 2
+#define ASSBIN_FLAT_VERSION_MINOR 2
 
 /**
 @page assfile .ASS File formats
@@ -81,15 +85,19 @@ integer     Assimp compile flags
 short       0 for normal files, 1 for shortened dumps for regression tests
                 these should have the file extension assbin.regress
 
-short       1 if the data after the header is compressed with the DEFLATE algorithm,
+short       Compression of the data after the header:
             0 for uncompressed files.
-                   For compressed files, the first integer after the header is
-                   always the uncompressed data size
+            1 if the data is compressed with the DEFLATE algorithm as a whole (legacy).
+                   The first integer after the header is always the uncompressed
+                   data size
+            2 if the data is stored as a container of independently compressed
+                   blocks, see BlockCompression.h. The codec is stored in the
+                   container header.
 
 byte[256]   Zero-terminated source file name, UTF-8
 byte[128]   Zero-terminated command line parameters passed to assimp_cmd, UTF-8
 
-byte[64]    Reserved for future use
+byte[64]    Reserved for future use (for the flat layout, see 4.)
 ---> Total length: 512 bytes
 
 -------------------------------------------------------------------------------
@@ -126,6 +134,9 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
    - The root node holding the scene structure is naturally stored in
      a ASSBIN_CHUNK_AINODE subchunk following 1.) and 2.) (which is
      empty for aiScene).
+   - Since version 1.1, mName and mMetaData follow the POD members. The
+     metadata is stored as an integer number of entries, followed by the
+     entries in the same format as for aiNode.
 
 [[aiMesh]]
 
@@ -145,6 +156,15 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
    - The array member block of aiMesh is prefixed with an integer that specifies
      the kinds of vertex components actually present in the mesh. This is a
      bitwise combination of the ASSBIN_MESH_HAS_xxx constants.
+   - Since version 1.1, the faces are followed by
+       string mName
+       vec3 mAABB.mMin, mAABB.mMax
+       integer mNumMeshlets
+       [only if mNumMeshlets is not 0]
+       integer mNumMeshletVertices, mNumMeshletIndices
+       aiMeshlet mMeshlets[mNumMeshlets]
+       integer mMeshletVertices[mNumMeshletVertices]
+       byte mMeshletIndices[mNumMeshletIndices]
 
 [[aiFace]]
 
@@ -154,22 +174,92 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 [[aiNode]]
 
    - mParent is omitted
+   - metadata values of type AI_AIMETADATA are stored as an integer number
+     of entries followed by the entries, since version 1.1. Older files
+     store nothing for them.
 
 [[aiLight]]
 
    - mAttenuationXXX not written if aiLight::mType == aiLightSource_DIRECTIONAL
    - mAngleXXX not written if aiLight::mType != aiLightSource_SPOT
+   - mPosition, mDirection, mUp and mSize are appended since version 1.1
+
+[[aiCamera]]
+
+   - mOrthographicWidth is appended since version 1.1
+
+[[aiTexture]]
+
+   - mFilename follows achFormatHint since version 1.1
 
 [[aiMaterial]]
 
    - mNumAllocated is omitted, for obvious reasons :-)
 
+-------------------------------------------------------------------------------
+4. Flat layout (version 2.2):
+-------------------------------------------------------------------------------
+
+The flat layout is meant for caches of pre-processed scenes which are loaded
+many times. It holds everything added in version 1.1. It is never compressed
+or shortened. The chunk structure is the same as above, but all large arrays
+are moved out of the chunks into a data section at the end of the file, so
+they can be mapped into memory and copied into the scene in one go:
+
+----------------------
+| Header (512 bytes) |
+----------------------
+| Chunks             |
+----------------------
+| Padding            |
+----------------------
+| Data section       |   starts at a multiple of ASSBIN_FLAT_ALIGNMENT
+----------------------
+
+The reserved bytes of the header hold:
+
+int64       Offset of the data section from the start of the file
+int64       Size of the data section, in bytes
+integer     ASSBIN_FLAT_BYTE_ORDER_MARK, written in the writer's byte order
+integer     sizeof(ai_real) of the writer
+byte[40]    Reserved for future use
+
+In the chunks, each of the following arrays is replaced by an int64 offset
+relative to the start of the data section. Each offset is a multiple of
+ASSBIN_FLAT_ALIGNMENT, arrays are stored in the in-memory representation of
+the writer (native byte order, ai_real, including struct padding):
+
+   - aiMesh::mVertices, mNormals, mTangents, mBitangents, mColors[n],
+     mTextureCoords[n]
+   - aiMesh::mMeshlets, mMeshletVertices, mMeshletIndices
+   - aiBone::mWeights
+   - aiNodeAnim::mPositionKeys, mRotationKeys, mScalingKeys
+   - aiTexture::pcData (mWidth bytes for compressed textures, else
+     mWidth * mHeight texels)
+
+Faces are stored as:
+
+integer     Number of indices per face, 0 if the mesh has faces of different sizes
+integer     Total number of indices
+int64       Offset of the index buffer (integer[total])
+int64       Offset of the per-face index counts (integer[mNumFaces]), only present
+            if the number of indices per face is 0
+
 
  @endverbatim*/
 
 
 #define ASSBIN_HEADER_LENGTH 512
 
+// values of the compression field in the header
+#define ASSBIN_COMPRESSION_NONE 0
+#define ASSBIN_COMPRESSION_DEFLATE 1
+#define ASSBIN_COMPRESSION_BLOCKS 2
+
+// alignment of the data section and of each array in the flat layout
+#define ASSBIN_FLAT_ALIGNMENT 64
+#define ASSBIN_FLAT_BYTE_ORDER_MARK 0x01020304
+
 // these are the magic chunk identifiers for the binary ASS file format
 #define ASSBIN_CHUNK_AICAMERA                   0x1234
 #define ASSBIN_CHUNK_AILIGHT                    0x1235
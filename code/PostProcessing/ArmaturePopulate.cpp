@@ -62,6 +62,12 @@ bool ArmaturePopulate::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_PopulateArmatureData) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool ArmaturePopulate::SupportsIndexBuffer() const {
+    return true;
+}
+
 void ArmaturePopulate::SetupProperties(const Importer *) {
     // do nothing
 }
@@ -72,6 +72,12 @@ bool CalcTangentsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_CalcTangentSpace) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool CalcTangentsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void CalcTangentsProcess::SetupProperties(const Importer *pImp) {
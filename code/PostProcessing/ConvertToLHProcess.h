@@ -82,6 +82,7 @@ public:
 
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
@@ -133,6 +134,7 @@ public:
 
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
@@ -158,6 +160,7 @@ public:
 
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
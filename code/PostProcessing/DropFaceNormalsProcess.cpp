@@ -74,6 +74,12 @@ bool DropFaceNormalsProcess::IsActive( unsigned int pFlags) const {
     return  (pFlags & aiProcess_DropNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool DropFaceNormalsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void DropFaceNormalsProcess::Execute( aiScene* pScene) {
@@ -41,15 +41,79 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "EmbedTexturesProcess.h"
+#include "Common/ParallelFor.h"
+#include <assimp/Hash.h>
 #include <assimp/ParsingUtils.h>
 #include "ProcessHelper.h"
 
+#include <climits>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#   pragma warning(push)
+#   pragma warning(disable : 4100 4505)
+#elif defined(__GNUC__) || defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wunused-function"
+#   pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+// Private copy of the decoder, without the failure strings it would share between threads
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_NO_FAILURE_STRINGS
+#include <contrib/stb_image/stb_image.h>
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#elif defined(__GNUC__) || defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
 
 using namespace Assimp;
 
+namespace {
+
+// A texture reference of a material to an external file
+struct TextureReference {
+    aiMaterial *material;
+    aiTextureType type;
+    unsigned int index;
+    size_t file;
+};
+
+// Halves both dimensions of the image with a box filter, the last row and column
+// are repeated for odd sizes.
+void HalveImage(std::unique_ptr<aiTexel[]> &texels, unsigned int &width, unsigned int &height) {
+    const unsigned int newWidth = std::max(width / 2, 1u);
+    const unsigned int newHeight = std::max(height / 2, 1u);
+    std::unique_ptr<aiTexel[]> result(new aiTexel[newWidth * newHeight]);
+    for (unsigned int y = 0; y < newHeight; ++y) {
+        const aiTexel *row0 = &texels[std::min(2 * y, height - 1) * width];
+        const aiTexel *row1 = &texels[std::min(2 * y + 1, height - 1) * width];
+        for (unsigned int x = 0; x < newWidth; ++x) {
+            const unsigned int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            aiTexel &out = result[y * newWidth + x];
+            out.b = static_cast<unsigned char>((row0[x0].b + row0[x1].b + row1[x0].b + row1[x1].b + 2) / 4);
+            out.g = static_cast<unsigned char>((row0[x0].g + row0[x1].g + row1[x0].g + row1[x1].g + 2) / 4);
+            out.r = static_cast<unsigned char>((row0[x0].r + row0[x1].r + row1[x0].r + row1[x1].r + 2) / 4);
+            out.a = static_cast<unsigned char>((row0[x0].a + row0[x1].a + row1[x0].a + row1[x1].a + 2) / 4);
+        }
+    }
+    texels = std::move(result);
+    width = newWidth;
+    height = newHeight;
+}
+
+} // namespace
+
 EmbedTexturesProcess::EmbedTexturesProcess()
-: BaseProcess() {
+: BaseProcess()
+, mRootPath()
+, mDecode(false)
+, mMaxSize(0) {
 }
 
 EmbedTexturesProcess::~EmbedTexturesProcess() {
@@ -59,9 +123,17 @@ bool EmbedTexturesProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_EmbedTextures) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool EmbedTexturesProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 void EmbedTexturesProcess::SetupProperties(const Importer* pImp) {
     mRootPath = pImp->GetPropertyString("sourceFilePath");
     mRootPath = mRootPath.substr(0, mRootPath.find_last_of("\\/") + 1u);
+    mDecode = pImp->GetPropertyInteger(AI_CONFIG_PP_ET_DECODE, 0) != 0;
+    mMaxSize = static_cast<unsigned int>(std::max(pImp->GetPropertyInteger(AI_CONFIG_PP_ET_MAX_SIZE, 0), 0));
 }
 
 void EmbedTexturesProcess::Execute(aiScene* pScene) {
@@ -69,8 +141,10 @@ void EmbedTexturesProcess::Execute(aiScene* pScene) {
 
     aiString path;
 
-    uint32_t embeddedTexturesCount = 0u;
-
+    // Collect the references to external files, each distinct path is read once
+    std::vector<TextureReference> references;
+    std::vector<std::string> paths;
+    std::unordered_map<std::string, size_t> pathIndices;
     for (auto matId = 0u; matId < pScene->mNumMaterials; ++matId) {
         auto material = pScene->mMaterials[matId];
 
@@ -82,29 +156,117 @@ void EmbedTexturesProcess::Execute(aiScene* pScene) {
                 material->GetTexture(tt, texId, &path);
                 if (path.data[0] == '*') continue; // Already embedded
 
-                // Indeed embed
-                if (addTexture(pScene, path.data)) {
-                    auto embeddedTextureId = pScene->mNumTextures - 1u;
-                    ::ai_snprintf(path.data, 1024, "*%u", embeddedTextureId);
-                    material->AddProperty(&path, AI_MATKEY_TEXTURE(tt, texId));
-                    embeddedTexturesCount++;
+                auto inserted = pathIndices.insert(std::make_pair(std::string(path.C_Str()), paths.size()));
+                if (inserted.second) {
+                    paths.push_back(inserted.first->first);
                 }
+                references.push_back({ material, tt, texId, inserted.first->second });
+            }
+        }
+    }
+
+    // Read and hash all files concurrently, the messages are logged afterwards
+    std::vector<std::string> imagePaths(paths.size());
+    std::vector<std::unique_ptr<aiTexel[]>> contents(paths.size());
+    std::vector<size_t> sizes(paths.size(), 0), hashes(paths.size(), 0);
+    std::vector<char> found(paths.size(), 0);
+    ParallelFor(0, paths.size(), [&](size_t i) {
+        found[i] = readTexture(paths[i], imagePaths[i], contents[i], sizes[i]);
+        if (found[i] && sizes[i] != 0) {
+            hashes[i] = SuperFastHash(reinterpret_cast<const char*>(contents[i].get()), static_cast<uint32_t>(sizes[i]));
+        }
+    });
+
+    // Add the files to the scene, identical images are embedded only once
+    std::vector<unsigned int> textureIds(paths.size(), UINT_MAX);
+    std::vector<aiTexture*> newTextures;
+    std::vector<size_t> newTextureFiles;
+    std::unordered_multimap<size_t, unsigned int> contentHashes;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (imagePaths[i] != paths[i]) {
+            ASSIMP_LOG_WARN_F("EmbedTexturesProcess: Cannot find image: ", paths[i], ". Will try to find it in root folder.");
+        }
+        if (!found[i]) {
+            ASSIMP_LOG_ERROR_F("EmbedTexturesProcess: Unable to embed texture: ", paths[i], ".");
+            continue;
+        }
+
+        const size_t hash = hashes[i];
+        auto range = contentHashes.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const aiTexture *other = newTextures[it->second];
+            if (other->mWidth == sizes[i] && ::memcmp(other->pcData, contents[i].get(), sizes[i]) == 0) {
+                textureIds[i] = pScene->mNumTextures + it->second;
+                break;
             }
         }
+        if (textureIds[i] != UINT_MAX) {
+            ASSIMP_LOG_VERBOSE_DEBUG_F("EmbedTexturesProcess: ", imagePaths[i], " is identical to ", imagePaths[newTextureFiles[textureIds[i] - pScene->mNumTextures]], ".");
+            continue;
+        }
+
+        auto pTexture = new aiTexture;
+        pTexture->mHeight = 0; // Means that this is still compressed
+        pTexture->mWidth = static_cast<uint32_t>(sizes[i]);
+        pTexture->pcData = contents[i].release();
+
+        auto extension = paths[i].substr(paths[i].find_last_of('.') + 1u);
+        extension = ai_tolower(extension);
+        if (extension == "jpeg") {
+            extension = "jpg";
+        }
+
+        size_t len = extension.size();
+        if (len > HINTMAXTEXTURELEN -1 ) {
+            len = HINTMAXTEXTURELEN - 1;
+        }
+        ::strncpy(pTexture->achFormatHint, extension.c_str(), len);
+
+        textureIds[i] = pScene->mNumTextures + static_cast<unsigned int>(newTextures.size());
+        contentHashes.insert(std::make_pair(hash, static_cast<unsigned int>(newTextures.size())));
+        newTextures.push_back(pTexture);
+        newTextureFiles.push_back(i);
+    }
+
+    // Enlarging the textures table
+    if (!newTextures.empty()) {
+        auto oldTextures = pScene->mTextures;
+        pScene->mTextures = new aiTexture*[pScene->mNumTextures + newTextures.size()];
+        if (oldTextures != nullptr) {
+            ::memmove(pScene->mTextures, oldTextures, sizeof(aiTexture*) * pScene->mNumTextures);
+        }
+        ::memmove(pScene->mTextures + pScene->mNumTextures, newTextures.data(), sizeof(aiTexture*) * newTextures.size());
+        pScene->mNumTextures += static_cast<unsigned int>(newTextures.size());
+        delete [] oldTextures;
+    }
+
+    // Indeed embed
+    uint32_t embeddedTexturesCount = 0u;
+    for (const TextureReference &reference : references) {
+        const unsigned int embeddedTextureId = textureIds[reference.file];
+        if (embeddedTextureId == UINT_MAX) continue;
+
+        path.length = static_cast<ai_uint32>(::ai_snprintf(path.data, MAXLEN, "*%u", embeddedTextureId));
+        reference.material->AddProperty(&path, AI_MATKEY_TEXTURE(reference.type, reference.index));
+        embeddedTexturesCount++;
     }
 
     ASSIMP_LOG_INFO_F("EmbedTexturesProcess finished. Embedded ", embeddedTexturesCount, " textures." );
+
+    if (mDecode) {
+        const unsigned int decodedTexturesCount = decodeTextures(pScene);
+        ASSIMP_LOG_INFO_F("EmbedTexturesProcess decoded ", decodedTexturesCount, " textures.");
+    }
 }
 
-bool EmbedTexturesProcess::addTexture(aiScene* pScene, std::string path) const {
+bool EmbedTexturesProcess::readTexture(const std::string &path, std::string &imagePath,
+        std::unique_ptr<aiTexel[]> &content, size_t &size) const {
     std::streampos imageSize = 0;
-    std::string    imagePath = path;
+    imagePath = path;
 
     // Test path directly
     std::ifstream file(imagePath, std::ios::binary | std::ios::ate);
     if ((imageSize = file.tellg()) == std::streampos(-1)) {
-        ASSIMP_LOG_WARN_F("EmbedTexturesProcess: Cannot find image: ", imagePath, ". Will try to find it in root folder.");
-
         // Test path in root path
         imagePath = mRootPath + path;
         file.open(imagePath, std::ios::binary | std::ios::ate);
@@ -113,41 +275,70 @@ bool EmbedTexturesProcess::addTexture(aiScene* pScene, std::string path) const {
             imagePath = mRootPath + path.substr(path.find_last_of("\\/") + 1u);
             file.open(imagePath, std::ios::binary | std::ios::ate);
             if ((imageSize = file.tellg()) == std::streampos(-1)) {
-                ASSIMP_LOG_ERROR_F("EmbedTexturesProcess: Unable to embed texture: ", path, ".");
                 return false;
             }
         }
     }
 
-    aiTexel* imageContent = new aiTexel[ 1ul + static_cast<unsigned long>( imageSize ) / sizeof(aiTexel)];
+    size = static_cast<size_t>(imageSize);
+    content.reset(new aiTexel[1 + size / sizeof(aiTexel)]);
     file.seekg(0, std::ios::beg);
-    file.read(reinterpret_cast<char*>(imageContent), imageSize);
+    file.read(reinterpret_cast<char*>(content.get()), imageSize);
+    return true;
+}
 
-    // Enlarging the textures table
-    unsigned int textureId = pScene->mNumTextures++;
-    auto oldTextures = pScene->mTextures;
-    pScene->mTextures = new aiTexture*[pScene->mNumTextures];
-    ::memmove(pScene->mTextures, oldTextures, sizeof(aiTexture*) * (pScene->mNumTextures - 1u));
-    delete [] oldTextures;
-    
-    // Add the new texture
-    auto pTexture = new aiTexture;
-    pTexture->mHeight = 0; // Means that this is still compressed
-    pTexture->mWidth = static_cast<uint32_t>(imageSize);
-    pTexture->pcData = imageContent;
-
-    auto extension = path.substr(path.find_last_of('.') + 1u);
-    extension = ai_tolower(extension);
-    if (extension == "jpeg") {
-        extension = "jpg";
-    }
+unsigned int EmbedTexturesProcess::decodeTextures(aiScene* pScene) const {
+    // Decode concurrently into separate buffers, the textures are only replaced afterwards
+    std::vector<std::unique_ptr<aiTexel[]>> texels(pScene->mNumTextures);
+    std::vector<unsigned int> widths(pScene->mNumTextures, 0), heights(pScene->mNumTextures, 0);
+    ParallelFor(0, pScene->mNumTextures, [&](size_t i) {
+        const aiTexture *texture = pScene->mTextures[i];
+        if (texture->mHeight != 0 || texture->pcData == nullptr || texture->mWidth > INT_MAX) {
+            return;
+        }
 
-    size_t len = extension.size();
-    if (len > HINTMAXTEXTURELEN -1 ) {
-        len = HINTMAXTEXTURELEN - 1;
-    }
-    ::strncpy(pTexture->achFormatHint, extension.c_str(), len);
-    pScene->mTextures[textureId] = pTexture;
+        int width = 0, height = 0, channels = 0;
+        stbi_uc *rgba = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(texture->pcData),
+                static_cast<int>(texture->mWidth), &width, &height, &channels, 4);
+        if (rgba == nullptr) {
+            return;
+        }
 
-    return true;
+        const size_t numTexels = static_cast<size_t>(width) * static_cast<size_t>(height);
+        texels[i].reset(new aiTexel[numTexels]);
+        for (size_t t = 0; t < numTexels; ++t) {
+            aiTexel &texel = texels[i][t];
+            texel.r = rgba[4 * t + 0];
+            texel.g = rgba[4 * t + 1];
+            texel.b = rgba[4 * t + 2];
+            texel.a = rgba[4 * t + 3];
+        }
+        stbi_image_free(rgba);
+
+        widths[i] = static_cast<unsigned int>(width);
+        heights[i] = static_cast<unsigned int>(height);
+        while (mMaxSize != 0 && (widths[i] > mMaxSize || heights[i] > mMaxSize)) {
+            HalveImage(texels[i], widths[i], heights[i]);
+        }
+    });
+
+    unsigned int decodedTexturesCount = 0u;
+    for (unsigned int i = 0; i < pScene->mNumTextures; ++i) {
+        aiTexture *texture = pScene->mTextures[i];
+        if (texels[i] == nullptr) {
+            if (texture->mHeight == 0) {
+                ASSIMP_LOG_WARN_F("EmbedTexturesProcess: Unable to decode texture *", i, ", format hint: ", texture->achFormatHint, ".");
+            }
+            continue;
+        }
+
+        delete [] texture->pcData;
+        texture->pcData = texels[i].release();
+        texture->mWidth = widths[i];
+        texture->mHeight = heights[i];
+        ::memset(texture->achFormatHint, 0, sizeof(texture->achFormatHint));
+        ::memcpy(texture->achFormatHint, "argb8888", 8);
+        decodedTexturesCount++;
+    }
+    return decodedTexturesCount;
 }
@@ -44,9 +44,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 
+#include <memory>
 #include <string>
 
 struct aiNode;
+struct aiTexel;
 
 namespace Assimp {
 
@@ -56,6 +58,10 @@ namespace Assimp {
  *  (due, for instance, to an absolute path generated on another system),
  *  it will check if a file with the same name exists at the root folder
  *  of the imported model. And if so, it uses that.
+ *
+ *  All files are read concurrently and identical images are embedded once.
+ *  With #AI_CONFIG_PP_ET_DECODE set, the compressed textures of the scene
+ *  are decoded concurrently as well.
  */
 class ASSIMP_API EmbedTexturesProcess : public BaseProcess {
 public:
@@ -67,6 +73,7 @@ public:
 
     /// Overwritten, @see BaseProcess
     virtual bool IsActive(unsigned int pFlags) const;
+    virtual bool SupportsIndexBuffer() const;
 
     /// Overwritten, @see BaseProcess
     virtual void SetupProperties(const Importer* pImp);
@@ -75,11 +82,18 @@ public:
     virtual void Execute(aiScene* pScene);
 
 private:
-    // Resolve the path and add the file content to the scene as a texture.
-    bool addTexture(aiScene* pScene, std::string path) const;
+    // Resolve the path and read the file content into a texel buffer as aiTexture stores
+    // compressed data, stores the path it was found at and the file size.
+    bool readTexture(const std::string &path, std::string &imagePath,
+            std::unique_ptr<aiTexel[]> &content, size_t &size) const;
+
+    // Decode all compressed textures of the scene, returns the number of decoded ones.
+    unsigned int decodeTextures(aiScene* pScene) const;
 
 private:
     std::string mRootPath;
+    bool mDecode;
+    unsigned int mMaxSize;
 };
 
 } // namespace Assimp
@@ -72,6 +72,12 @@ bool FindInstancesProcess::IsActive( unsigned int pFlags) const
     return 0 != (pFlags & aiProcess_FindInstances) && 0 == (pFlags & aiProcess_PreTransformVertices);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Faces are never modified, only whole meshes are deleted
+bool FindInstancesProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup properties for the step
 void FindInstancesProcess::SetupProperties(const Importer* pImp)
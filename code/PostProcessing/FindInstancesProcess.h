@@ -118,6 +118,7 @@ public:
     // -------------------------------------------------------------------
     // Check whether step is active in given flags combination
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     // Execute step on a given scene
@@ -72,6 +72,12 @@ bool FindInvalidDataProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FindInvalidData);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Faces are never modified, only whole meshes are deleted
+bool FindInvalidDataProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup import configuration
 void FindInvalidDataProcess::SetupProperties(const Importer *pImp) {
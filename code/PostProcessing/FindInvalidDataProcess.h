@@ -70,6 +70,7 @@ public:
     // -------------------------------------------------------------------
     //
     bool IsActive(unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     // Setup import settings
@@ -78,6 +78,12 @@ bool FixInfacingNormalsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_FixInfacingNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Indices are changed in place, faces keep their size
+bool FixInfacingNormalsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FixInfacingNormalsProcess::Execute( aiScene* pScene)
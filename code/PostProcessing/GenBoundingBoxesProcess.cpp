@@ -61,6 +61,12 @@ bool GenBoundingBoxesProcess::IsActive(unsigned int pFlags) const {
     return 0 != ( pFlags & aiProcess_GenBoundingBoxes );
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool GenBoundingBoxesProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 void checkMesh(aiMesh* mesh, aiVector3D& min, aiVector3D& max) {
     ai_assert(nullptr != mesh);
 
@@ -65,6 +65,7 @@ public:
     ~GenBoundingBoxesProcess();
     /// Will return true, if aiProcess_GenBoundingBoxes is defined.
     bool IsActive(unsigned int pFlags) const override;
+    bool SupportsIndexBuffer() const override;
     /// The execution callback.
     void Execute(aiScene* pScene) override;
 };
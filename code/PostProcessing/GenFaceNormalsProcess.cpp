@@ -74,6 +74,12 @@ bool GenFaceNormalsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_GenNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool GenFaceNormalsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenFaceNormalsProcess::Execute(aiScene *pScene) {
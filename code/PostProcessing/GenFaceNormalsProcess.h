@@ -68,6 +68,7 @@ public:
     * @return true if the process is present in this flag fields, false if not.
     */
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
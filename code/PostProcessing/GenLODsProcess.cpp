@@ -0,0 +1,687 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenLODsProcess.cpp
+ *  @brief Implementation of the GenLODsProcess post processing step
+ */
+#include "GenLODsProcess.h"
+#include "Common/ParallelFor.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/commonMetaData.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <locale>
+#include <sstream>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Sum of squared distances to a set of planes, a symmetric 4x4 matrix stored as upper triangle
+struct Quadric {
+    double m[10];
+
+    Quadric() {
+        std::fill(m, m + 10, 0.0);
+    }
+
+    void AddPlane(double a, double b, double c, double d, double weight) {
+        m[0] += weight * a * a;
+        m[1] += weight * a * b;
+        m[2] += weight * a * c;
+        m[3] += weight * a * d;
+        m[4] += weight * b * b;
+        m[5] += weight * b * c;
+        m[6] += weight * b * d;
+        m[7] += weight * c * c;
+        m[8] += weight * c * d;
+        m[9] += weight * d * d;
+    }
+
+    Quadric &operator+=(const Quadric &other) {
+        for (unsigned int i = 0; i < 10; ++i) {
+            m[i] += other.m[i];
+        }
+        return *this;
+    }
+
+    double Evaluate(const aiVector3D &p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x +
+               m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y +
+               m[7] * z * z + 2.0 * m[8] * z +
+               m[9];
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Moves vertex mFrom onto its neighbour mTo
+struct Collapse {
+    double mCost;
+    unsigned int mFrom;
+    unsigned int mTo;
+
+    bool operator<(const Collapse &other) const {
+        return mCost < other.mCost;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+T *CopyVertices(const T *source, const std::vector<unsigned int> &vertices) {
+    if (nullptr == source) {
+        return nullptr;
+    }
+    T *out = new T[vertices.size()];
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        out[i] = source[vertices[i]];
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+bool IsEqualAt(const T *values, unsigned int a, unsigned int b) {
+    return nullptr == values || values[a] == values[b];
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether two vertices have the same attributes besides their position
+bool HaveEqualAttributes(const aiMesh *mesh, unsigned int a, unsigned int b) {
+    if (!IsEqualAt(mesh->mNormals, a, b) || !IsEqualAt(mesh->mTangents, a, b) || !IsEqualAt(mesh->mBitangents, a, b)) {
+        return false;
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        if (!IsEqualAt(mesh->mColors[c], a, b)) {
+            return false;
+        }
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        if (!IsEqualAt(mesh->mTextureCoords[c], a, b)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsTriangleMesh(const aiMesh *mesh) {
+    if ((mesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) != aiPrimitiveType_TRIANGLE || 0 == mesh->mNumFaces) {
+        return false;
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        if (3 != mesh->mFaces[i].mNumIndices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Edge collapse simplification of a triangle mesh. Collapses are done in passes: each pass
+// computes the cheapest collapse of every vertex and applies them in the order of their cost,
+// skipping those close to a collapse done before in the same pass.
+class MeshSimplifier {
+public:
+    explicit MeshSimplifier(const aiMesh *mesh);
+
+    void Simplify(unsigned int targetFaces);
+
+    unsigned int GetNumFaces() const {
+        return static_cast<unsigned int>(mIndices.size() / 3);
+    }
+
+    aiMesh *CreateMesh(const std::string &name) const;
+
+private:
+    bool RunPass(unsigned int targetFaces);
+    bool CollectNeighbours(const VertexTriangleAdjacency &adjacency, unsigned int vertex,
+            std::vector<unsigned int> &neighbours) const;
+    bool KeepsOrientation(const VertexTriangleAdjacency &adjacency, unsigned int from, unsigned int to) const;
+    void RemoveDegenerates();
+
+    const aiMesh *mMesh;
+    std::vector<unsigned int> mIndices;
+    std::vector<Quadric> mQuadrics;
+    std::vector<bool> mLocked;
+};
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiMesh *mesh) :
+        mMesh(mesh),
+        mIndices(mesh->mNumFaces * 3),
+        mQuadrics(mesh->mNumVertices),
+        mLocked(mesh->mNumVertices, false) {
+    const aiVector3D *positions = mesh->mVertices;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const unsigned int *face = mesh->mFaces[i].mIndices;
+        std::copy(face, face + 3, &mIndices[i * 3]);
+
+        // planes are weighted by the area of their triangle
+        const aiVector3D &p0 = positions[face[0]];
+        const aiVector3D e1 = positions[face[1]] - p0, e2 = positions[face[2]] - p0;
+        double nx = double(e1.y) * e2.z - double(e1.z) * e2.y;
+        double ny = double(e1.z) * e2.x - double(e1.x) * e2.z;
+        double nz = double(e1.x) * e2.y - double(e1.y) * e2.x;
+        const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (0.0 == length) {
+            continue;
+        }
+        nx /= length;
+        ny /= length;
+        nz /= length;
+        const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+        for (unsigned int c = 0; c < 3; ++c) {
+            mQuadrics[face[c]].AddPlane(nx, ny, nz, d, length * 0.5);
+        }
+    }
+
+    // vertices sharing a position but not their other attributes lie on a seam, e.g. of the
+    // texture coordinates, they must stay. Plain duplicates are left to the border check.
+    std::vector<unsigned int> order(mesh->mNumVertices);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [positions](unsigned int a, unsigned int b) {
+        const aiVector3D &pa = positions[a], &pb = positions[b];
+        if (pa.x != pb.x) {
+            return pa.x < pb.x;
+        }
+        if (pa.y != pb.y) {
+            return pa.y < pb.y;
+        }
+        return pa.z < pb.z;
+    });
+    for (size_t first = 0; first < order.size();) {
+        size_t last = first + 1;
+        bool seam = false;
+        while (last < order.size() && positions[order[last]] == positions[order[first]]) {
+            seam = seam || !HaveEqualAttributes(mesh, order[first], order[last]);
+            ++last;
+        }
+        for (size_t i = first; seam && i < last; ++i) {
+            mLocked[order[i]] = true;
+        }
+        first = last;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::Simplify(unsigned int targetFaces) {
+    for (;;) {
+        RemoveDegenerates();
+        if (GetNumFaces() <= targetFaces || !RunPass(targetFaces)) {
+            return;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::RemoveDegenerates() {
+    size_t out = 0;
+    for (size_t i = 0; i < mIndices.size(); i += 3) {
+        const unsigned int a = mIndices[i], b = mIndices[i + 1], c = mIndices[i + 2];
+        if (a != b && b != c && a != c) {
+            mIndices[out++] = a;
+            mIndices[out++] = b;
+            mIndices[out++] = c;
+        }
+    }
+    mIndices.resize(out);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the distinct neighbours of a vertex and whether its neighbourhood is a closed disk,
+// i.e. each edge to a neighbour is shared by exactly two triangles
+bool MeshSimplifier::CollectNeighbours(const VertexTriangleAdjacency &adjacency, unsigned int vertex,
+        std::vector<unsigned int> &neighbours) const {
+    neighbours.clear();
+    const unsigned int *triangles = adjacency.GetAdjacentTriangles(vertex);
+    const unsigned int numTriangles = adjacency.mLiveTriangles[vertex];
+    for (unsigned int i = 0; i < numTriangles; ++i) {
+        const unsigned int *face = &mIndices[triangles[i] * 3];
+        for (unsigned int c = 0; c < 3; ++c) {
+            if (face[c] != vertex) {
+                neighbours.push_back(face[c]);
+            }
+        }
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+
+    bool closed = true;
+    size_t out = 0;
+    for (size_t i = 0; i < neighbours.size();) {
+        size_t run = i + 1;
+        while (run < neighbours.size() && neighbours[run] == neighbours[i]) {
+            ++run;
+        }
+        closed = closed && (run - i == 2);
+        neighbours[out++] = neighbours[i];
+        i = run;
+    }
+    neighbours.resize(out);
+    return closed && !neighbours.empty();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks that no triangle around from flips when from is moved onto to
+bool MeshSimplifier::KeepsOrientation(const VertexTriangleAdjacency &adjacency, unsigned int from, unsigned int to) const {
+    const aiVector3D *positions = mMesh->mVertices;
+    const unsigned int *triangles = adjacency.GetAdjacentTriangles(from);
+    const unsigned int numTriangles = adjacency.mLiveTriangles[from];
+    for (unsigned int i = 0; i < numTriangles; ++i) {
+        const unsigned int *face = &mIndices[triangles[i] * 3];
+        if (face[0] == to || face[1] == to || face[2] == to) {
+            continue;
+        }
+
+        aiVector3D before[3], after[3];
+        for (unsigned int c = 0; c < 3; ++c) {
+            before[c] = positions[face[c]];
+            after[c] = positions[face[c] == from ? to : face[c]];
+        }
+        const aiVector3D normalBefore = (before[1] - before[0]) ^ (before[2] - before[0]);
+        const aiVector3D normalAfter = (after[1] - after[0]) ^ (after[2] - after[0]);
+        if (normalBefore * normalAfter <= ai_real(0.0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::RunPass(unsigned int targetFaces) {
+    const unsigned int numVertices = mMesh->mNumVertices;
+    const unsigned int numFaces = GetNumFaces();
+
+    // the adjacency only copies the indices, so the faces can point into our buffer
+    aiFace *faces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        faces[i].mNumIndices = 3;
+        faces[i].mIndices = &mIndices[i * 3];
+    }
+    VertexTriangleAdjacency adjacency(faces, numFaces, numVertices, true);
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        faces[i].mIndices = nullptr;
+    }
+    delete[] faces;
+
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> neighbours;
+    for (unsigned int vertex = 0; vertex < numVertices; ++vertex) {
+        if (mLocked[vertex] || !CollectNeighbours(adjacency, vertex, neighbours)) {
+            continue;
+        }
+
+        Collapse best = { 0.0, vertex, vertex };
+        for (unsigned int neighbour : neighbours) {
+            Quadric quadric = mQuadrics[vertex];
+            quadric += mQuadrics[neighbour];
+            const double cost = quadric.Evaluate(mMesh->mVertices[neighbour]);
+            if (best.mTo == vertex || cost < best.mCost) {
+                best.mCost = cost;
+                best.mTo = neighbour;
+            }
+        }
+        collapses.push_back(best);
+    }
+    std::sort(collapses.begin(), collapses.end());
+
+    // each collapse removes two triangles, only the cheaper half of the candidates is used
+    const size_t maxCollapses = std::max<size_t>(1, (numFaces - targetFaces + 1) / 2);
+    const size_t numCandidates = std::max<size_t>(1, collapses.size() / 2);
+    std::vector<bool> touched(numVertices, false);
+    std::vector<unsigned int> targetNeighbours;
+    size_t numCollapses = 0;
+    for (size_t i = 0; i < numCandidates && i < collapses.size() && numCollapses < maxCollapses; ++i) {
+        const unsigned int from = collapses[i].mFrom, to = collapses[i].mTo;
+        if (touched[from] || touched[to]) {
+            continue;
+        }
+
+        // the edge may only be shared by two triangles whose third vertices are the only common
+        // neighbours of its ends, otherwise the collapse changes the topology
+        CollectNeighbours(adjacency, from, neighbours);
+        CollectNeighbours(adjacency, to, targetNeighbours);
+        size_t common = 0;
+        for (unsigned int neighbour : neighbours) {
+            common += std::binary_search(targetNeighbours.begin(), targetNeighbours.end(), neighbour) ? 1 : 0;
+        }
+        if (2 != common || !KeepsOrientation(adjacency, from, to)) {
+            continue;
+        }
+
+        const unsigned int *triangles = adjacency.GetAdjacentTriangles(from);
+        for (unsigned int t = 0; t < adjacency.mLiveTriangles[from]; ++t) {
+            unsigned int *face = &mIndices[triangles[t] * 3];
+            for (unsigned int c = 0; c < 3; ++c) {
+                if (face[c] == from) {
+                    face[c] = to;
+                }
+            }
+        }
+        mQuadrics[to] += mQuadrics[from];
+
+        touched[from] = true;
+        touched[to] = true;
+        for (unsigned int neighbour : neighbours) {
+            touched[neighbour] = true;
+        }
+        ++numCollapses;
+    }
+    return numCollapses > 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiMesh *MeshSimplifier::CreateMesh(const std::string &name) const {
+    // vertices in the order of their first use
+    std::vector<unsigned int> remap(mMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> vertices;
+    for (unsigned int index : mIndices) {
+        if (UINT_MAX == remap[index]) {
+            remap[index] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(index);
+        }
+    }
+
+    aiMesh *out = new aiMesh();
+    out->mName.Set(name);
+    out->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    out->mMaterialIndex = mMesh->mMaterialIndex;
+    out->mMethod = mMesh->mMethod;
+    out->mAABB = mMesh->mAABB;
+    out->mNumVertices = static_cast<unsigned int>(vertices.size());
+    out->mVertices = CopyVertices(mMesh->mVertices, vertices);
+    out->mNormals = CopyVertices(mMesh->mNormals, vertices);
+    out->mTangents = CopyVertices(mMesh->mTangents, vertices);
+    out->mBitangents = CopyVertices(mMesh->mBitangents, vertices);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        out->mColors[c] = CopyVertices(mMesh->mColors[c], vertices);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        out->mTextureCoords[c] = CopyVertices(mMesh->mTextureCoords[c], vertices);
+        out->mNumUVComponents[c] = mMesh->mNumUVComponents[c];
+    }
+
+    out->mNumFaces = GetNumFaces();
+    out->mFaces = new aiFace[out->mNumFaces];
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        out->mFaces[i].mNumIndices = 3;
+    }
+    // the levels use an index buffer if the input mesh does
+    out->AllocateFaceIndices(mMesh->HasIndexBuffer());
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        aiFace &face = out->mFaces[i];
+        for (unsigned int c = 0; c < 3; ++c) {
+            face.mIndices[c] = remap[mIndices[i * 3 + c]];
+        }
+    }
+
+    // bones are kept even if they lose all their weights, so the levels share one palette
+    if (mMesh->mNumBones) {
+        out->mNumBones = mMesh->mNumBones;
+        out->mBones = new aiBone *[out->mNumBones];
+        for (unsigned int i = 0; i < mMesh->mNumBones; ++i) {
+            const aiBone *source = mMesh->mBones[i];
+            aiBone *bone = out->mBones[i] = new aiBone();
+            bone->mName = source->mName;
+            bone->mOffsetMatrix = source->mOffsetMatrix;
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+            bone->mArmature = source->mArmature;
+            bone->mNode = source->mNode;
+#endif
+
+            std::vector<aiVertexWeight> weights;
+            for (unsigned int w = 0; w < source->mNumWeights; ++w) {
+                const aiVertexWeight &weight = source->mWeights[w];
+                if (UINT_MAX != remap[weight.mVertexId]) {
+                    weights.push_back(aiVertexWeight(remap[weight.mVertexId], weight.mWeight));
+                }
+            }
+            if (!weights.empty()) {
+                bone->mNumWeights = static_cast<unsigned int>(weights.size());
+                bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+                std::copy(weights.begin(), weights.end(), bone->mWeights);
+            }
+        }
+    }
+
+    if (mMesh->mNumAnimMeshes) {
+        out->mNumAnimMeshes = mMesh->mNumAnimMeshes;
+        out->mAnimMeshes = new aiAnimMesh *[out->mNumAnimMeshes];
+        for (unsigned int i = 0; i < mMesh->mNumAnimMeshes; ++i) {
+            const aiAnimMesh *source = mMesh->mAnimMeshes[i];
+            aiAnimMesh *animMesh = out->mAnimMeshes[i] = new aiAnimMesh();
+            animMesh->mName = source->mName;
+            animMesh->mWeight = source->mWeight;
+            animMesh->mNumVertices = out->mNumVertices;
+            animMesh->mVertices = CopyVertices(source->mVertices, vertices);
+            animMesh->mNormals = CopyVertices(source->mNormals, vertices);
+            animMesh->mTangents = CopyVertices(source->mTangents, vertices);
+            animMesh->mBitangents = CopyVertices(source->mBitangents, vertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                animMesh->mColors[c] = CopyVertices(source->mColors[c], vertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                animMesh->mTextureCoords[c] = CopyVertices(source->mTextureCoords[c], vertices);
+            }
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collects the nodes which reference meshes
+void CollectMeshNodes(aiNode *node, std::vector<aiNode *> &nodes) {
+    if (node->mNumMeshes) {
+        nodes.push_back(node);
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectMeshNodes(node->mChildren[i], nodes);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Gives each node with meshes one child per level of detail, which references the simplified
+// versions of its meshes
+void AddLevelNodes(aiScene *scene, unsigned int numMeshes, unsigned int numLevels) {
+    std::vector<aiNode *> nodes;
+    if (nullptr != scene->mRootNode) {
+        CollectMeshNodes(scene->mRootNode, nodes);
+    }
+
+    std::vector<aiNode *> children(numLevels);
+    for (aiNode *node : nodes) {
+        for (unsigned int level = 1; level <= numLevels; ++level) {
+            aiNode *child = children[level - 1] = new aiNode(std::string(node->mName.C_Str()) + "_LOD" + std::to_string(level));
+            child->mNumMeshes = node->mNumMeshes;
+            child->mMeshes = new unsigned int[child->mNumMeshes];
+            for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+                child->mMeshes[i] = node->mMeshes[i] + level * numMeshes;
+            }
+            child->mMetaData = new aiMetadata();
+            child->mMetaData->Add(AI_METADATA_LOD_LEVEL, static_cast<int32_t>(level));
+        }
+        node->addChildren(numLevels, children.data());
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenLODsProcess::GenLODsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenLODsProcess::~GenLODsProcess() {
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The input meshes are only read, the levels of detail are new meshes
+bool GenLODsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::IsRequested(const Importer *pImp) const {
+    return pImp->GetPropertyBool(AI_CONFIG_PP_LOD_ENABLE, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::RequireVerboseFormat() const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::SetupProperties(const Importer *pImp) {
+    mRatios.clear();
+
+    std::istringstream stream(pImp->GetPropertyString(AI_CONFIG_PP_LOD_RATIOS, AI_LOD_DEFAULT_RATIOS));
+    stream.imbue(std::locale::classic());
+    float ratio = 0.0f;
+    while (stream >> ratio) {
+        if (ratio > 0.0f && ratio < 1.0f) {
+            mRatios.push_back(ratio);
+        } else {
+            ASSIMP_LOG_WARN_F("GenLODsProcess: Ignoring ratio ", ratio, ", ratios must lie between 0 and 1");
+        }
+    }
+    if (!stream.eof()) {
+        ASSIMP_LOG_WARN("GenLODsProcess: Failed to parse " AI_CONFIG_PP_LOD_RATIOS);
+    }
+    std::sort(mRatios.begin(), mRatios.end(), [](float a, float b) { return a > b; });
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::Execute(aiScene *pScene) {
+    ASSIMP_LOG_DEBUG("GenLODsProcess begin");
+
+    int32_t existingLevels = 0;
+    if (pScene->mMetaData && pScene->mMetaData->Get(AI_METADATA_LOD_LEVELS, existingLevels)) {
+        ASSIMP_LOG_WARN("GenLODsProcess: The scene has levels of detail already, skipping");
+        return;
+    }
+    if (mRatios.empty() || 0 == pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("GenLODsProcess finished. There was nothing to be done.");
+        return;
+    }
+
+    const unsigned int numMeshes = pScene->mNumMeshes;
+    const unsigned int numLevels = static_cast<unsigned int>(mRatios.size());
+    std::vector<std::vector<aiMesh *>> levels(numMeshes);
+    size_t work = 0;
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        work += pScene->mMeshes[i]->mNumFaces;
+    }
+    ParallelFor(0, numMeshes, [&](size_t i) {
+        ProcessMesh(pScene->mMeshes[i], levels[i]);
+    }, 1, work);
+
+    aiMesh **meshes = new aiMesh *[numMeshes * (numLevels + 1)];
+    std::copy(pScene->mMeshes, pScene->mMeshes + numMeshes, meshes);
+    for (unsigned int level = 0; level < numLevels; ++level) {
+        for (unsigned int i = 0; i < numMeshes; ++i) {
+            meshes[(level + 1) * numMeshes + i] = levels[i][level];
+        }
+    }
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = meshes;
+    pScene->mNumMeshes = numMeshes * (numLevels + 1);
+
+    if (nullptr == pScene->mMetaData) {
+        pScene->mMetaData = new aiMetadata();
+    }
+    pScene->mMetaData->Add(AI_METADATA_LOD_LEVELS, static_cast<int32_t>(numLevels));
+    pScene->mMetaData->Add(AI_METADATA_LOD_MESH_COUNT, static_cast<int32_t>(numMeshes));
+    AddLevelNodes(pScene, numMeshes, numLevels);
+
+    if (!DefaultLogger::isNullLogger()) {
+        for (unsigned int level = 0; level <= numLevels; ++level) {
+            size_t numFaces = 0;
+            for (unsigned int i = 0; i < numMeshes; ++i) {
+                numFaces += meshes[level * numMeshes + i]->mNumFaces;
+            }
+            ASSIMP_LOG_INFO_F("GenLODsProcess: Level ", level, " has ", numFaces, " faces");
+        }
+    }
+    ASSIMP_LOG_DEBUG("GenLODsProcess finished");
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::ProcessMesh(const aiMesh *pMesh, std::vector<aiMesh *> &pLevels) const {
+    pLevels.clear();
+    pLevels.reserve(mRatios.size());
+
+    if (!IsTriangleMesh(pMesh)) {
+        for (size_t level = 1; level <= mRatios.size(); ++level) {
+            aiMesh *copy = nullptr;
+            SceneCombiner::Copy(&copy, pMesh);
+            copy->mName.Set(std::string(pMesh->mName.C_Str()) + "_LOD" + std::to_string(level));
+            pLevels.push_back(copy);
+        }
+        return;
+    }
+
+    MeshSimplifier simplifier(pMesh);
+    for (size_t level = 1; level <= mRatios.size(); ++level) {
+        const unsigned int target = static_cast<unsigned int>(mRatios[level - 1] * pMesh->mNumFaces);
+        simplifier.Simplify(std::max(target, 1u));
+        pLevels.push_back(simplifier.CreateMesh(std::string(pMesh->mName.C_Str()) + "_LOD" + std::to_string(level)));
+    }
+}
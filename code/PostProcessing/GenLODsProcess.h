@@ -0,0 +1,115 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenLODsProcess.h
+ *  @brief Declares a post processing step to generate simplified levels of detail.
+ */
+#ifndef AI_GENLODSPROCESS_H_INC
+#define AI_GENLODSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** This post processing step simplifies triangle meshes by collapsing edges
+ *  in the order of their quadric error. Each collapse moves a vertex onto
+ *  one of its neighbours, so all vertex attributes are kept as they are.
+ *  Vertices on open borders and vertices sharing their position with other
+ *  vertices with different attributes (seams of normals or texture
+ *  coordinates) are never moved. The levels are appended to aiScene::mMeshes,
+ *  see #AI_METADATA_LOD_LEVELS, and referenced by new child nodes, see
+ *  #AI_METADATA_LOD_LEVEL.
+ *  The step is not part of #aiPostProcessSteps, it is enabled by
+ *  #AI_CONFIG_PP_LOD_ENABLE.
+ */
+class ASSIMP_API GenLODsProcess : public BaseProcess {
+public:
+    GenLODsProcess();
+    ~GenLODsProcess();
+
+    // -------------------------------------------------------------------
+    /** Returns false, the step has no #aiPostProcessSteps flag. */
+    bool IsActive(unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
+
+    // -------------------------------------------------------------------
+    /** Returns whether #AI_CONFIG_PP_LOD_ENABLE is set. */
+    bool IsRequested(const Importer *pImp) const;
+
+    // -------------------------------------------------------------------
+    /** The step works on indexed meshes. */
+    bool RequireVerboseFormat() const;
+
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer *pImp);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on the given imported data.
+    * @param pScene The imported data to work at.
+    */
+    void Execute(aiScene *pScene);
+
+    // -------------------------------------------------------------------
+    /** Generates the levels of detail of a single mesh.
+    * @param pMesh The mesh to simplify.
+    * @param pLevels Receives one new mesh per entry of mRatios. Meshes
+    *   which are not made of triangles are copied.
+    */
+    void ProcessMesh(const aiMesh *pMesh, std::vector<aiMesh *> &pLevels) const;
+
+    /** Triangle ratios of the levels, see #AI_CONFIG_PP_LOD_RATIOS. */
+    std::vector<float> mRatios;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENLODSPROCESS_H_INC
@@ -0,0 +1,318 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.cpp
+ *  @brief Implementation of the GenMeshletsProcess post processing step
+ */
+#include "GenMeshletsProcess.h"
+#include "Common/ParallelFor.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+bool IsTriangleMesh(const aiMesh *mesh) {
+    if ((mesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) != aiPrimitiveType_TRIANGLE || 0 == mesh->mNumFaces) {
+        return false;
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        if (3 != mesh->mFaces[i].mNumIndices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes the bounding sphere and the normal cone of a finished meshlet
+void ComputeBounds(const aiMesh *mesh, const unsigned int *vertices, const unsigned char *indices, aiMeshlet &meshlet) {
+    aiVector3D min = mesh->mVertices[vertices[0]], max = min;
+    for (unsigned int i = 1; i < meshlet.mVertexCount; ++i) {
+        const aiVector3D &v = mesh->mVertices[vertices[i]];
+        min = aiVector3D(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+        max = aiVector3D(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+    }
+    meshlet.mCenter = (min + max) * static_cast<ai_real>(0.5);
+    meshlet.mRadius = 0;
+    for (unsigned int i = 0; i < meshlet.mVertexCount; ++i) {
+        meshlet.mRadius = std::max(meshlet.mRadius, (mesh->mVertices[vertices[i]] - meshlet.mCenter).Length());
+    }
+
+    // the cone axis is the area weighted average of the face normals
+    aiVector3D axis;
+    for (unsigned int i = 0; i < meshlet.mTriangleCount * 3; i += 3) {
+        const aiVector3D &p0 = mesh->mVertices[vertices[indices[i]]];
+        axis += (mesh->mVertices[vertices[indices[i + 1]]] - p0) ^ (mesh->mVertices[vertices[indices[i + 2]]] - p0);
+    }
+    meshlet.mConeApex = meshlet.mCenter;
+    meshlet.mConeCutoff = 1;
+    const ai_real length = axis.Length();
+    if (length <= 0) {
+        return;
+    }
+    meshlet.mConeAxis = axis / length;
+
+    // the cone must contain all normals, too wide cones never cull anything
+    ai_real minDot = 1;
+    for (unsigned int i = 0; i < meshlet.mTriangleCount * 3; i += 3) {
+        const aiVector3D &p0 = mesh->mVertices[vertices[indices[i]]];
+        aiVector3D normal = (mesh->mVertices[vertices[indices[i + 1]]] - p0) ^ (mesh->mVertices[vertices[indices[i + 2]]] - p0);
+        const ai_real normalLength = normal.Length();
+        if (normalLength > 0) {
+            minDot = std::min(minDot, (normal / normalLength) * meshlet.mConeAxis);
+        }
+    }
+    if (minDot <= static_cast<ai_real>(0.1)) {
+        return;
+    }
+
+    // move the apex back along the axis until it lies behind all faces
+    ai_real maxT = 0;
+    for (unsigned int i = 0; i < meshlet.mTriangleCount * 3; i += 3) {
+        const aiVector3D &p0 = mesh->mVertices[vertices[indices[i]]];
+        aiVector3D normal = (mesh->mVertices[vertices[indices[i + 1]]] - p0) ^ (mesh->mVertices[vertices[indices[i + 2]]] - p0);
+        const ai_real normalLength = normal.Length();
+        if (normalLength > 0) {
+            normal /= normalLength;
+            maxT = std::max(maxT, ((meshlet.mCenter - p0) * normal) / (meshlet.mConeAxis * normal));
+        }
+    }
+    meshlet.mConeApex = meshlet.mCenter - meshlet.mConeAxis * maxT;
+    meshlet.mConeCutoff = std::sqrt(1 - minDot * minDot);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenMeshletsProcess::GenMeshletsProcess() :
+        mMaxVertices(AI_ML_DEFAULT_MAX_VERTICES),
+        mMaxTriangles(AI_ML_DEFAULT_MAX_TRIANGLES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenMeshletsProcess::~GenMeshletsProcess() {
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool GenMeshletsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsRequested(const Importer *pImp) const {
+    return pImp->GetPropertyBool(AI_CONFIG_PP_ML_ENABLE, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetupProperties(const Importer *pImp) {
+    const int maxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_VERTICES, AI_ML_DEFAULT_MAX_VERTICES);
+    const int maxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_TRIANGLES, AI_ML_DEFAULT_MAX_TRIANGLES);
+    mMaxVertices = static_cast<unsigned int>(std::min(std::max(maxVertices, 3), 256));
+    mMaxTriangles = static_cast<unsigned int>(std::max(maxTriangles, 1));
+    if (static_cast<int>(mMaxVertices) != maxVertices || static_cast<int>(mMaxTriangles) != maxTriangles) {
+        ASSIMP_LOG_WARN_F("GenMeshletsProcess: Clamping the meshlet limits to ", mMaxVertices, " vertices and ",
+                mMaxTriangles, " triangles");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::Execute(aiScene *pScene) {
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess begin");
+
+    std::vector<char> processed(pScene->mNumMeshes, 0);
+    size_t work = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        work += pScene->mMeshes[i]->mNumFaces;
+    }
+    ParallelFor(0, pScene->mNumMeshes, [&](size_t i) {
+        processed[i] = ProcessMesh(pScene->mMeshes[i]);
+    }, 1, work);
+
+    if (!DefaultLogger::isNullLogger()) {
+        size_t numMeshlets = 0, numVertices = 0, numTriangles = 0;
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            const aiMesh *mesh = pScene->mMeshes[i];
+            if (!processed[i]) {
+                ASSIMP_LOG_WARN_F("GenMeshletsProcess: Mesh ", i, " is not made of triangles, skipping");
+                continue;
+            }
+            numMeshlets += mesh->mNumMeshlets;
+            numVertices += mesh->mNumMeshletVertices;
+            numTriangles += mesh->mNumFaces;
+        }
+        if (numMeshlets) {
+            ASSIMP_LOG_INFO_F("GenMeshletsProcess: Generated ", numMeshlets, " meshlets with on average ",
+                    static_cast<float>(numVertices) / numMeshlets, " vertices and ",
+                    static_cast<float>(numTriangles) / numMeshlets, " triangles");
+        }
+    }
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess finished");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::ProcessMesh(aiMesh *pMesh) const {
+    delete[] pMesh->mMeshlets;
+    delete[] pMesh->mMeshletVertices;
+    delete[] pMesh->mMeshletIndices;
+    pMesh->mMeshlets = nullptr;
+    pMesh->mMeshletVertices = nullptr;
+    pMesh->mMeshletIndices = nullptr;
+    pMesh->mNumMeshlets = pMesh->mNumMeshletVertices = pMesh->mNumMeshletIndices = 0;
+
+    if (!IsTriangleMesh(pMesh)) {
+        return false;
+    }
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, pMesh->mNumVertices, true);
+    unsigned int *const live = adj.mLiveTriangles;
+
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned char> indices;
+    meshlets.reserve(numFaces / mMaxTriangles + 1);
+    vertices.reserve(pMesh->mNumVertices + pMesh->mNumVertices / 2);
+    indices.reserve(numFaces * 3);
+
+    // index of each vertex within the current meshlet, UINT_MAX if it is not part of it
+    std::vector<unsigned int> local(pMesh->mNumVertices, UINT_MAX);
+    std::vector<char> emitted(numFaces, 0);
+    unsigned int nextSeed = 0;
+
+    aiMeshlet meshlet;
+    auto countNew = [&](unsigned int face) {
+        const unsigned int *idx = pMesh->mFaces[face].mIndices;
+        return (local[idx[0]] == UINT_MAX) + (local[idx[1]] == UINT_MAX) + (local[idx[2]] == UINT_MAX);
+    };
+    auto flush = [&]() {
+        ComputeBounds(pMesh, &vertices[meshlet.mVertexOffset], &indices[meshlet.mIndexOffset], meshlet);
+        for (unsigned int i = 0; i < meshlet.mVertexCount; ++i) {
+            local[vertices[meshlet.mVertexOffset + i]] = UINT_MAX;
+        }
+        meshlets.push_back(meshlet);
+        meshlet = aiMeshlet();
+        meshlet.mVertexOffset = static_cast<unsigned int>(vertices.size());
+        meshlet.mIndexOffset = static_cast<unsigned int>(indices.size());
+    };
+
+    for (unsigned int emittedFaces = 0; emittedFaces < numFaces; ++emittedFaces) {
+        // prefer the face next to the meshlet which adds the fewest new vertices
+        unsigned int best = UINT_MAX, bestNew = 4;
+        for (unsigned int i = 0; i < meshlet.mVertexCount && bestNew; ++i) {
+            const unsigned int vertex = vertices[meshlet.mVertexOffset + i];
+            if (!live[vertex]) {
+                continue;
+            }
+            const unsigned int *begin = adj.GetAdjacentTriangles(vertex);
+            const unsigned int *end = begin + (adj.mOffsetTable[vertex + 1] - adj.mOffsetTable[vertex]);
+            for (const unsigned int *face = begin; face != end; ++face) {
+                if (emitted[*face]) {
+                    continue;
+                }
+                const unsigned int numNew = countNew(*face);
+                if (numNew < bestNew || (numNew == bestNew && *face < best)) {
+                    best = *face;
+                    bestNew = numNew;
+                }
+            }
+        }
+
+        // otherwise continue with the next face in order, which is close after ImproveCacheLocality
+        if (UINT_MAX == best) {
+            while (emitted[nextSeed]) {
+                ++nextSeed;
+            }
+            best = nextSeed;
+            bestNew = countNew(best);
+        }
+
+        if (meshlet.mVertexCount + bestNew > mMaxVertices || meshlet.mTriangleCount == mMaxTriangles) {
+            flush();
+        }
+
+        const unsigned int *idx = pMesh->mFaces[best].mIndices;
+        for (unsigned int a = 0; a < 3; ++a) {
+            unsigned int &l = local[idx[a]];
+            if (UINT_MAX == l) {
+                l = meshlet.mVertexCount++;
+                vertices.push_back(idx[a]);
+            }
+            indices.push_back(static_cast<unsigned char>(l));
+            --live[idx[a]];
+        }
+        ++meshlet.mTriangleCount;
+        emitted[best] = 1;
+    }
+    flush();
+
+    pMesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pMesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pMesh->mMeshlets);
+    pMesh->mNumMeshletVertices = static_cast<unsigned int>(vertices.size());
+    pMesh->mMeshletVertices = new unsigned int[vertices.size()];
+    std::copy(vertices.begin(), vertices.end(), pMesh->mMeshletVertices);
+    pMesh->mNumMeshletIndices = static_cast<unsigned int>(indices.size());
+    pMesh->mMeshletIndices = new unsigned char[indices.size()];
+    std::copy(indices.begin(), indices.end(), pMesh->mMeshletIndices);
+    return true;
+}
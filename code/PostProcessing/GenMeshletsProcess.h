@@ -0,0 +1,108 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.h
+ *  @brief Declares a post processing step to partition meshes into meshlets.
+ */
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** This post processing step partitions the faces of triangle meshes into
+ *  meshlets, see aiMesh::mMeshlets. Meshlets are grown greedily from a seed
+ *  face, adding the adjacent face which introduces the fewest new vertices
+ *  until one of the limits is reached. Each meshlet gets a bounding sphere
+ *  and a normal cone for culling.
+ *  The step is not part of #aiPostProcessSteps, it is enabled by
+ *  #AI_CONFIG_PP_ML_ENABLE.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess {
+public:
+    GenMeshletsProcess();
+    ~GenMeshletsProcess();
+
+    // -------------------------------------------------------------------
+    /** Returns false, the step has no #aiPostProcessSteps flag. */
+    bool IsActive(unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
+
+    // -------------------------------------------------------------------
+    /** Returns whether #AI_CONFIG_PP_ML_ENABLE is set. */
+    bool IsRequested(const Importer *pImp) const;
+
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer *pImp);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on the given imported data.
+    * @param pScene The imported data to work at.
+    */
+    void Execute(aiScene *pScene);
+
+    // -------------------------------------------------------------------
+    /** Generates the meshlets of a single mesh, replacing existing ones.
+    * @param pMesh The mesh to process.
+    * @return false if the mesh is not made of triangles and was skipped.
+    */
+    bool ProcessMesh(aiMesh *pMesh) const;
+
+    /** Maximum number of vertices per meshlet, see #AI_CONFIG_PP_ML_MAX_VERTICES. */
+    unsigned int mMaxVertices;
+
+    /** Maximum number of triangles per meshlet, see #AI_CONFIG_PP_ML_MAX_TRIANGLES. */
+    unsigned int mMaxTriangles;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
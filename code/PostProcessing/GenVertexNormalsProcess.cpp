@@ -74,6 +74,12 @@ bool GenVertexNormalsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_GenSmoothNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool GenVertexNormalsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::SetupProperties(const Importer *pImp) {
@@ -71,6 +71,7 @@ public:
     *   false if not.
     */
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
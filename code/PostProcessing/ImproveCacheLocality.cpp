@@ -45,7 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * <br>
  * The algorithm is roughly basing on this paper:
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw reduction isn't implemented yet ...
+ * Overdraw reduction follows the same paper: the fans are split into clusters which
+ * are sorted by how much they face away from the center of the mesh.
  */
 
 // internal headers
@@ -56,15 +57,104 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
 #include <stdio.h>
 #include <stack>
 
 using namespace Assimp;
 
+namespace {
+
+// Cache line size and number of cache lines used for the vertex fetch statistics
+const unsigned int FetchLineSize = 64;
+const unsigned int FetchCacheLines = 64;
+
+// ------------------------------------------------------------------------------------------------
+// Counts the misses of a FIFO vertex cache of the given depth
+unsigned int CountCacheMisses(const unsigned int* piIndices, size_t iNumIndices,
+        unsigned int iNumVertices, unsigned int iCacheDepth) {
+    std::vector<unsigned int> stamps(iNumVertices, 0);
+    unsigned int stamp = iCacheDepth + 1;
+    unsigned int misses = 0;
+    for (size_t i = 0; i < iNumIndices; ++i) {
+        if (stamp - stamps[piIndices[i]] > iCacheDepth) {
+            stamps[piIndices[i]] = stamp++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Size of a vertex if all its components are stored interleaved as floats
+unsigned int GetVertexSize(const aiMesh* pMesh) {
+    unsigned int size = sizeof(aiVector3D);
+    size += pMesh->HasNormals() ? sizeof(aiVector3D) : 0;
+    size += pMesh->HasTangentsAndBitangents() ? 2 * sizeof(aiVector3D) : 0;
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        size += pMesh->HasVertexColors(i) ? sizeof(aiColor4D) : 0;
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        size += pMesh->HasTextureCoords(i) ? pMesh->mNumUVComponents[i] * sizeof(ai_real) : 0;
+    }
+    return size;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts the bytes read from a vertex buffer through a small FIFO cache of memory lines
+size_t CountFetchedBytes(const unsigned int* piIndices, size_t iNumIndices,
+        unsigned int iNumVertices, unsigned int iVertexSize) {
+    const size_t numLines = (static_cast<size_t>(iNumVertices) * iVertexSize + FetchLineSize - 1) / FetchLineSize;
+    std::vector<unsigned int> stamps(numLines, 0);
+    unsigned int stamp = FetchCacheLines + 1;
+    size_t bytes = 0;
+    for (size_t i = 0; i < iNumIndices; ++i) {
+        const size_t first = static_cast<size_t>(piIndices[i]) * iVertexSize;
+        for (size_t line = first / FetchLineSize; line <= (first + iVertexSize - 1) / FetchLineSize; ++line) {
+            if (stamp - stamps[line] > FetchCacheLines) {
+                stamps[line] = stamp++;
+                bytes += FetchLineSize;
+            }
+        }
+    }
+    return bytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the indices of a triangle mesh to a single buffer
+std::vector<unsigned int> GetIndices(const aiMesh* pMesh) {
+    std::vector<unsigned int> indices;
+    indices.reserve(pMesh->mNumFaces * 3);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        indices.insert(indices.end(), pMesh->mFaces[i].mIndices, pMesh->mFaces[i].mIndices + 3);
+    }
+    return indices;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the element order[i] of a per-vertex array to position i
+template <typename T>
+void ReorderVertices(T*& pData, const std::vector<unsigned int>& order) {
+    if (nullptr == pData) {
+        return;
+    }
+    T* out = new T[order.size()];
+    for (size_t i = 0; i < order.size(); ++i) {
+        out[i] = pData[order[i]];
+    }
+    delete[] pData;
+    pData = out;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
-: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
+: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE)
+, mConfigOverdrawThreshold(0.f)
+, mConfigVertexFetch(false) {
     // empty
 }
 
@@ -80,11 +170,21 @@ bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
     return (pFlags & aiProcess_ImproveCacheLocality) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Indices are changed in place, faces keep their size
+bool ImproveCacheLocalityProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration
 void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+
+    // values below 1 disable the overdraw and vertex fetch optimizations
+    mConfigOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,0.f);
+    mConfigVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -97,6 +197,7 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
+    mStatistics = Statistics();
     float out = 0.f;
     unsigned int numf = 0, numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
@@ -111,6 +212,15 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
         if (numf > 0) {
             ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
         }
+        const Statistics& st = mStatistics;
+        if (st.mNumFaces > 0 && st.mBytesUsed > 0) {
+            ASSIMP_LOG_INFO_F("ACMR in: ", (float)st.mCacheMissesIn / st.mNumFaces,
+                " out: ", (float)st.mCacheMissesOut / st.mNumFaces,
+                " | ATVR in: ", (float)st.mCacheMissesIn / st.mNumVertices,
+                " out: ", (float)st.mCacheMissesOut / st.mNumVertices,
+                " | vertex overfetch in: ", (float)st.mBytesFetchedIn / st.mBytesUsed,
+                " out: ", (float)st.mBytesFetchedOut / st.mBytesUsed);
+        }
         ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
 }
@@ -138,38 +248,16 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
 
     ai_real fACMR = 3.f;
     const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
+    const unsigned int iVertexSize = GetVertexSize(pMesh);
 
-    // Input ACMR is for logging purposes only
+    // Input ACMR and vertex fetch statistics are for logging purposes only
+    unsigned int iCacheMissesIn = 0;
+    size_t iBytesFetchedIn = 0;
     if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[mConfigCacheDepth];
-        memset(piFIFOStack,0xff,mConfigCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + mConfigCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
-            }
-        }
-        delete[] piFIFOStack;
-        fACMR = (ai_real) iCacheMisses / pMesh->mNumFaces;
+        const std::vector<unsigned int> indices = GetIndices(pMesh);
+        iCacheMissesIn = CountCacheMisses(indices.data(), indices.size(), pMesh->mNumVertices, mConfigCacheDepth);
+        iBytesFetchedIn = CountFetchedBytes(indices.data(), indices.size(), pMesh->mNumVertices, iVertexSize);
+        fACMR = (ai_real) iCacheMissesIn / pMesh->mNumFaces;
         if (3.0 == fACMR)   {
             char szBuff[128]; // should be sufficiently large in every case
 
@@ -219,6 +307,9 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
     unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
     unsigned int iCacheMisses = 0;
 
+    // first face of each cluster of fans, for the overdraw optimization
+    std::vector<unsigned int> aiClusters(1, 0u);
+
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
 
@@ -325,6 +416,9 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
         }
         // did we reach a dead end?
         if (-1 == ivdx) {
+            // the next fan starts a new cluster
+            aiClusters.push_back(static_cast<unsigned int>((piCSIter - piIBOutput) / 3));
+
             // need to get a non-local vertex for which we have a good chance that it is still
             // in the cache ...
             while (!sDeadEndVStack.empty()) {
@@ -349,6 +443,13 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
             }
         }
     }
+    if (mConfigOverdrawThreshold >= 1.f) {
+        OptimizeOverdraw(pMesh, piIBOutput, aiClusters, (ai_real) iCacheMisses / pMesh->mNumFaces);
+        if (!DefaultLogger::isNullLogger()) {
+            iCacheMisses = CountCacheMisses(piIBOutput, iIdxCnt, pMesh->mNumVertices, mConfigCacheDepth);
+        }
+    }
+
     ai_real fACMR2 = 0.0f;
     if (!DefaultLogger::isNullLogger()) {
         fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
@@ -375,5 +476,179 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
     delete[] piIBOutput;
     delete[] piCandidates;
 
+    if (mConfigVertexFetch) {
+        OptimizeVertexFetch(pMesh);
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        const std::vector<unsigned int> indices = GetIndices(pMesh);
+        std::vector<bool> abUsed(pMesh->mNumVertices, false);
+        unsigned int iNumUsed = 0;
+        for (unsigned int index : indices) {
+            if (!abUsed[index]) {
+                abUsed[index] = true;
+                ++iNumUsed;
+            }
+        }
+
+        mStatistics.mNumFaces += pMesh->mNumFaces;
+        mStatistics.mNumVertices += iNumUsed;
+        mStatistics.mCacheMissesIn += iCacheMissesIn;
+        mStatistics.mCacheMissesOut += iCacheMisses;
+        mStatistics.mBytesFetchedIn += iBytesFetchedIn;
+        mStatistics.mBytesFetchedOut += CountFetchedBytes(indices.data(), indices.size(), pMesh->mNumVertices, iVertexSize);
+        mStatistics.mBytesUsed += static_cast<size_t>(iNumUsed) * iVertexSize;
+    }
+
     return fACMR2;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Splits the clusters further where the cache can be flushed cheaply and sorts them so that
+// clusters facing away from the center of the mesh are drawn first
+void ImproveCacheLocalityProcess::OptimizeOverdraw(const aiMesh* pMesh, unsigned int* pIndices,
+        std::vector<unsigned int>& pClusters, ai_real fACMR) const {
+    const unsigned int iNumFaces = pMesh->mNumFaces;
+    pClusters.push_back(iNumFaces);
+    pClusters.erase(std::unique(pClusters.begin(), pClusters.end()), pClusters.end());
+
+    // a new cluster may start wherever the ACMR of the current one is low enough
+    const ai_real fThreshold = mConfigOverdrawThreshold * fACMR;
+    std::vector<unsigned int> aiStamps(pMesh->mNumVertices, 0);
+    unsigned int iStamp = 0;
+    std::vector<unsigned int> aiStarts;
+    for (size_t c = 0; c + 1 < pClusters.size(); ++c) {
+        unsigned int iStart = pClusters[c];
+        const unsigned int iEnd = pClusters[c + 1];
+        aiStarts.push_back(iStart);
+        iStamp += mConfigCacheDepth + 1;
+        unsigned int iMisses = 0;
+        for (unsigned int f = iStart; f < iEnd; ++f) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                const unsigned int idx = pIndices[f * 3 + i];
+                if (iStamp - aiStamps[idx] > mConfigCacheDepth) {
+                    aiStamps[idx] = iStamp++;
+                    ++iMisses;
+                }
+            }
+            if (f + 1 < iEnd && iMisses <= fThreshold * (f + 1 - iStart)) {
+                iStart = f + 1;
+                aiStarts.push_back(iStart);
+                iStamp += mConfigCacheDepth + 1;
+                iMisses = 0;
+            }
+        }
+    }
+    aiStarts.push_back(iNumFaces);
+
+    // sort key: distance of the cluster from the center along its normal
+    const aiVector3D* pcVertices = pMesh->mVertices;
+    aiVector3D vMeshCenter;
+    ai_real fMeshArea = 0.f;
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        const aiVector3D& a = pcVertices[pIndices[f * 3]];
+        const aiVector3D& b = pcVertices[pIndices[f * 3 + 1]];
+        const aiVector3D& c = pcVertices[pIndices[f * 3 + 2]];
+        const ai_real fArea = ((b - a) ^ (c - a)).Length();
+        vMeshCenter += (a + b + c) * (fArea / 3.f);
+        fMeshArea += fArea;
+    }
+    if (fMeshArea > 0.f) {
+        vMeshCenter /= fMeshArea;
+    }
+
+    std::vector<std::pair<ai_real, unsigned int> > aiOrder(aiStarts.size() - 1);
+    for (size_t c = 0; c + 1 < aiStarts.size(); ++c) {
+        aiVector3D vCenter, vNormal;
+        ai_real fArea = 0.f;
+        for (unsigned int f = aiStarts[c]; f < aiStarts[c + 1]; ++f) {
+            const aiVector3D& a = pcVertices[pIndices[f * 3]];
+            const aiVector3D& b = pcVertices[pIndices[f * 3 + 1]];
+            const aiVector3D& c2 = pcVertices[pIndices[f * 3 + 2]];
+            const aiVector3D vFaceNormal = (b - a) ^ (c2 - a);
+            const ai_real fFaceArea = vFaceNormal.Length();
+            vCenter += (a + b + c2) * (fFaceArea / 3.f);
+            vNormal += vFaceNormal;
+            fArea += fFaceArea;
+        }
+        if (fArea > 0.f) {
+            vCenter /= fArea;
+        }
+        const ai_real fLength = vNormal.Length();
+        if (fLength > 0.f) {
+            vNormal /= fLength;
+        }
+        aiOrder[c] = std::make_pair(-((vCenter - vMeshCenter) * vNormal), static_cast<unsigned int>(c));
+    }
+    std::stable_sort(aiOrder.begin(), aiOrder.end(),
+        [](const std::pair<ai_real, unsigned int>& a, const std::pair<ai_real, unsigned int>& b) {
+            return a.first < b.first;
+        });
+
+    std::vector<unsigned int> aiSorted;
+    aiSorted.reserve(iNumFaces * 3);
+    for (const std::pair<ai_real, unsigned int>& entry : aiOrder) {
+        aiSorted.insert(aiSorted.end(), pIndices + aiStarts[entry.second] * 3, pIndices + aiStarts[entry.second + 1] * 3);
+    }
+    std::copy(aiSorted.begin(), aiSorted.end(), pIndices);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the vertices in the order of their first use, unused ones are moved to the end
+void ImproveCacheLocalityProcess::OptimizeVertexFetch(aiMesh* pMesh) const {
+    std::vector<unsigned int> aiRemap(pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> aiOrder;
+    aiOrder.reserve(pMesh->mNumVertices);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            if (UINT_MAX == aiRemap[face.mIndices[i]]) {
+                aiRemap[face.mIndices[i]] = static_cast<unsigned int>(aiOrder.size());
+                aiOrder.push_back(face.mIndices[i]);
+            }
+        }
+    }
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        if (UINT_MAX == aiRemap[v]) {
+            aiRemap[v] = static_cast<unsigned int>(aiOrder.size());
+            aiOrder.push_back(v);
+        }
+    }
+
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        aiFace& face = pMesh->mFaces[f];
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            face.mIndices[i] = aiRemap[face.mIndices[i]];
+        }
+    }
+
+    ReorderVertices(pMesh->mVertices, aiOrder);
+    ReorderVertices(pMesh->mNormals, aiOrder);
+    ReorderVertices(pMesh->mTangents, aiOrder);
+    ReorderVertices(pMesh->mBitangents, aiOrder);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        ReorderVertices(pMesh->mColors[i], aiOrder);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        ReorderVertices(pMesh->mTextureCoords[i], aiOrder);
+    }
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        aiBone* pcBone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < pcBone->mNumWeights; ++w) {
+            pcBone->mWeights[w].mVertexId = aiRemap[pcBone->mWeights[w].mVertexId];
+        }
+    }
+    for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh* pcAnim = pMesh->mAnimMeshes[a];
+        ReorderVertices(pcAnim->mVertices, aiOrder);
+        ReorderVertices(pcAnim->mNormals, aiOrder);
+        ReorderVertices(pcAnim->mTangents, aiOrder);
+        ReorderVertices(pcAnim->mBitangents, aiOrder);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            ReorderVertices(pcAnim->mColors[i], aiOrder);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            ReorderVertices(pcAnim->mTextureCoords[i], aiOrder);
+        }
+    }
+}
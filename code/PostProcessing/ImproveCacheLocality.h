@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
+#include <vector>
+
 struct aiMesh;
 
 namespace Assimp
@@ -58,10 +60,13 @@ namespace Assimp
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
+ *  Optionally, clusters of faces are sorted to reduce overdraw
+ *  (#AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD) and the vertices are reordered
+ *  for fetch locality (#AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH).
  *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -73,6 +78,7 @@ public:
     // -------------------------------------------------------------------
     // Check whether the pp step is active
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     // Executes the pp step on a given scene
@@ -90,10 +96,45 @@ protected:
      */
     ai_real ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
 
+    // -------------------------------------------------------------------
+    /** Sorts clusters of faces to reduce overdraw
+     * @param pMesh The mesh the indices belong to
+     * @param pIndices Triangle list in the order of the cache optimization
+     * @param pClusters First face of every cluster of the cache optimization
+     * @param fACMR ACMR of pIndices
+     */
+    void OptimizeOverdraw( const aiMesh* pMesh, unsigned int* pIndices,
+        std::vector<unsigned int>& pClusters, ai_real fACMR) const;
+
+    // -------------------------------------------------------------------
+    /** Reorders the vertices of a mesh in the order of their first use
+     * @param pMesh The mesh to process.
+     */
+    void OptimizeVertexFetch( aiMesh* pMesh) const;
+
 private:
+    //! Cache statistics of the processed meshes, gathered if logging is enabled
+    struct Statistics {
+        unsigned int mNumFaces = 0;
+        unsigned int mNumVertices = 0;
+        unsigned int mCacheMissesIn = 0;
+        unsigned int mCacheMissesOut = 0;
+        size_t mBytesFetchedIn = 0;
+        size_t mBytesFetchedOut = 0;
+        size_t mBytesUsed = 0;
+    };
+
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: ACMR threshold for overdraw optimization
+    ai_real mConfigOverdrawThreshold;
+
+    //! Configuration parameter: reorder vertices for fetch locality
+    bool mConfigVertexFetch;
+
+    Statistics mStatistics;
 };
 
 } // end of namespace Assimp
@@ -74,6 +74,12 @@ bool LimitBoneWeightsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_LimitBoneWeights) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool LimitBoneWeightsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void LimitBoneWeightsProcess::Execute( aiScene* pScene)
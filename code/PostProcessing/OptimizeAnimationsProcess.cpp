@@ -0,0 +1,243 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file OptimizeAnimationsProcess.cpp
+ *  @brief Implementation of the OptimizeAnimationsProcess post processing step
+ */
+#include "OptimizeAnimationsProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+ai_real GetFactor(double start, double end, double time) {
+    return end > start ? static_cast<ai_real>((time - start) / (end - start)) : ai_real(0.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D Interpolate(const aiVectorKey &first, const aiVectorKey &second, double time) {
+    return first.mValue + (second.mValue - first.mValue) * GetFactor(first.mTime, second.mTime, time);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiQuaternion Interpolate(const aiQuatKey &first, const aiQuatKey &second, double time) {
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, first.mValue, second.mValue, GetFactor(first.mTime, second.mTime, time));
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_real GetError(const aiVector3D &a, const aiVector3D &b) {
+    return (a - b).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle of the rotation from a to b, atan2 stays precise for small angles unlike acos
+ai_real GetError(const aiQuaternion &a, const aiQuaternion &b) {
+    aiQuaternion inverse = a;
+    inverse.Conjugate();
+    const aiQuaternion delta = inverse * b;
+    const ai_real sine = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+    return ai_real(2.0) * std::atan2(sine, std::fabs(delta.w));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether all keys between first and last are interpolated from these two within tolerance
+template <typename KeyType>
+bool IsRedundant(const KeyType *keys, unsigned int first, unsigned int last, ai_real tolerance) {
+    for (unsigned int i = first + 1; i < last; ++i) {
+        if (GetError(Interpolate(keys[first], keys[last], keys[i].mTime), keys[i].mValue) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Longest run of keys which is replaced by an interpolation. Each candidate range is checked key
+// by key, so this bounds the work per key instead of letting long smooth channels go quadratic.
+const unsigned int MaxInterpolatedKeys = 64;
+
+// ------------------------------------------------------------------------------------------------
+// Greedily extends the interpolated range from the last key kept until a key in between does
+// not fit anymore or the range gets too long, then keeps the key before the one that failed.
+template <typename KeyType>
+void ReduceKeys(KeyType *&keys, unsigned int &numKeys, ai_real tolerance) {
+    if (numKeys < 2) {
+        return;
+    }
+
+    // constant channels are common, they are reduced to a single key in one pass
+    unsigned int numEqual = 1;
+    while (numEqual < numKeys && GetError(keys[0].mValue, keys[numEqual].mValue) <= tolerance) {
+        ++numEqual;
+    }
+    if (numEqual == numKeys) {
+        const KeyType first = keys[0];
+        delete[] keys;
+        numKeys = 1;
+        keys = new KeyType[1];
+        keys[0] = first;
+        return;
+    }
+
+    std::vector<KeyType> kept;
+    kept.push_back(keys[0]);
+    unsigned int anchor = 0;
+    for (unsigned int end = 2; end < numKeys; ++end) {
+        if (end - anchor > MaxInterpolatedKeys || !IsRedundant(keys, anchor, end, tolerance)) {
+            anchor = end - 1;
+            kept.push_back(keys[anchor]);
+        }
+    }
+    kept.push_back(keys[numKeys - 1]);
+
+    if (kept.size() < numKeys) {
+        delete[] keys;
+        numKeys = static_cast<unsigned int>(kept.size());
+        keys = new KeyType[numKeys];
+        std::copy(kept.begin(), kept.end(), keys);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t CountKeys(const aiNodeAnim *channel) {
+    return static_cast<size_t>(channel->mNumPositionKeys) + channel->mNumRotationKeys + channel->mNumScalingKeys;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+OptimizeAnimationsProcess::OptimizeAnimationsProcess() :
+        mPositionTolerance(AI_OA_DEFAULT_POSITION_TOLERANCE),
+        mRotationTolerance(AI_OA_DEFAULT_ROTATION_TOLERANCE),
+        mScalingTolerance(AI_OA_DEFAULT_SCALING_TOLERANCE),
+        mNumKeysIn(0),
+        mNumKeysOut(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+OptimizeAnimationsProcess::~OptimizeAnimationsProcess() {
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+bool OptimizeAnimationsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool OptimizeAnimationsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool OptimizeAnimationsProcess::IsRequested(const Importer *pImp) const {
+    return pImp->GetPropertyBool(AI_CONFIG_PP_OA_ENABLE, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::SetupProperties(const Importer *pImp) {
+    mPositionTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_OA_POSITION_TOLERANCE, AI_OA_DEFAULT_POSITION_TOLERANCE);
+    mRotationTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_OA_ROTATION_TOLERANCE, AI_OA_DEFAULT_ROTATION_TOLERANCE);
+    mScalingTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_OA_SCALING_TOLERANCE, AI_OA_DEFAULT_SCALING_TOLERANCE);
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::Execute(aiScene *pScene) {
+    ASSIMP_LOG_DEBUG("OptimizeAnimationsProcess begin");
+
+    std::vector<aiNodeAnim *> channels;
+    for (unsigned int i = 0; i < pScene->mNumAnimations; ++i) {
+        const aiAnimation *anim = pScene->mAnimations[i];
+        channels.insert(channels.end(), anim->mChannels, anim->mChannels + anim->mNumChannels);
+    }
+
+    mNumKeysIn = 0;
+    for (const aiNodeAnim *channel : channels) {
+        mNumKeysIn += CountKeys(channel);
+    }
+
+    ParallelFor(0, channels.size(), [&](size_t i) {
+        ProcessChannel(channels[i]);
+    }, 1, mNumKeysIn);
+
+    mNumKeysOut = 0;
+    for (const aiNodeAnim *channel : channels) {
+        mNumKeysOut += CountKeys(channel);
+    }
+
+    if (mNumKeysIn != mNumKeysOut) {
+        ASSIMP_LOG_INFO_F("OptimizeAnimationsProcess finished. Reduced ", mNumKeysIn, " animation keys to ",
+                mNumKeysOut, ", compression ratio ", GetCompressionRatio());
+    } else {
+        ASSIMP_LOG_DEBUG("OptimizeAnimationsProcess finished. There was nothing to be done.");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::ProcessChannel(aiNodeAnim *pChannel) const {
+    ReduceKeys(pChannel->mPositionKeys, pChannel->mNumPositionKeys, mPositionTolerance);
+    ReduceKeys(pChannel->mRotationKeys, pChannel->mNumRotationKeys, mRotationTolerance);
+    ReduceKeys(pChannel->mScalingKeys, pChannel->mNumScalingKeys, mScalingTolerance);
+}
+
+// ------------------------------------------------------------------------------------------------
+float OptimizeAnimationsProcess::GetCompressionRatio() const {
+    if (0 == mNumKeysOut) {
+        return 1.0f;
+    }
+    return static_cast<float>(mNumKeysIn) / static_cast<float>(mNumKeysOut);
+}
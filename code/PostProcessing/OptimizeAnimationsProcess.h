@@ -0,0 +1,114 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file OptimizeAnimationsProcess.h
+ *  @brief Declares a post processing step to remove redundant animation keys.
+ */
+#ifndef AI_OPTIMIZEANIMATIONSPROCESS_H_INC
+#define AI_OPTIMIZEANIMATIONSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+struct aiNodeAnim;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** This post processing step removes keys of node animation channels which
+ *  can be interpolated from the keys before and after them. Positions and
+ *  scalings are interpolated linearly, rotations spherically, the error of
+ *  every removed key is at most the configured tolerance. The step is not
+ *  part of #aiPostProcessSteps, it is enabled by #AI_CONFIG_PP_OA_ENABLE.
+ */
+class ASSIMP_API OptimizeAnimationsProcess : public BaseProcess {
+public:
+    OptimizeAnimationsProcess();
+    ~OptimizeAnimationsProcess();
+
+    // -------------------------------------------------------------------
+    /** Returns false, the step has no #aiPostProcessSteps flag. */
+    bool IsActive(unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
+
+    // -------------------------------------------------------------------
+    /** Returns whether #AI_CONFIG_PP_OA_ENABLE is set. */
+    bool IsRequested(const Importer *pImp) const;
+
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer *pImp);
+
+    // -------------------------------------------------------------------
+    /** Executes the post processing step on the given imported data.
+    * @param pScene The imported data to work at.
+    */
+    void Execute(aiScene *pScene);
+
+    // -------------------------------------------------------------------
+    /** Removes the redundant keys of a single channel.
+    * @param pChannel The channel to process.
+    */
+    void ProcessChannel(aiNodeAnim *pChannel) const;
+
+    // -------------------------------------------------------------------
+    /** Returns the number of keys before divided by the number of keys
+    * after the last call of Execute(), 1 if there were no keys.
+    */
+    float GetCompressionRatio() const;
+
+    /** Tolerances of the removed keys, see AI_CONFIG_PP_OA_XXX_TOLERANCE. */
+    ai_real mPositionTolerance;
+    ai_real mRotationTolerance;
+    ai_real mScalingTolerance;
+
+private:
+    size_t mNumKeysIn;
+    size_t mNumKeysOut;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_OPTIMIZEANIMATIONSPROCESS_H_INC
@@ -90,6 +90,12 @@ bool OptimizeGraphProcess::IsActive(unsigned int pFlags) const {
 	return (0 != (pFlags & aiProcess_OptimizeGraph));
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool OptimizeGraphProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup properties for the post-processing step
 void OptimizeGraphProcess::SetupProperties(const Importer *pImp) {
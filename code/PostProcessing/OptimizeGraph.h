@@ -76,6 +76,7 @@ public:
 
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const override;
+    bool SupportsIndexBuffer() const override;
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene) override;
@@ -50,14 +50,93 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ParsingUtils.h>
 #include "ProcessHelper.h"
 #include "Material/MaterialSystem.h"
+#include <assimp/Hash.h>
+#include <assimp/fast_atof.h>
 #include <stdio.h>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Size of the data of an embedded texture, in bytes
+static size_t GetTextureDataSize(const aiTexture* tex)
+{
+    return tex->mHeight == 0 ? tex->mWidth : size_t(tex->mWidth) * tex->mHeight * sizeof(aiTexel);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute a hash over the format and the data of an embedded texture
+static uint32_t ComputeTextureHash(const aiTexture* tex)
+{
+    uint32_t hash = SuperFastHash((const char*)&tex->mWidth, sizeof(tex->mWidth));
+    hash = SuperFastHash((const char*)&tex->mHeight, sizeof(tex->mHeight), hash);
+    hash = SuperFastHash(tex->achFormatHint, HINTMAXTEXTURELEN, hash);
+
+    const size_t size = GetTextureDataSize(tex);
+    if (size && tex->pcData) {
+        hash = SuperFastHash((const char*)tex->pcData, (uint32_t)size, hash);
+    }
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether two embedded textures have the same format and data
+static bool IsSameTexture(const aiTexture* a, const aiTexture* b)
+{
+    if (a->mWidth != b->mWidth || a->mHeight != b->mHeight ||
+            ::memcmp(a->achFormatHint, b->achFormatHint, HINTMAXTEXTURELEN)) {
+        return false;
+    }
+    const size_t size = GetTextureDataSize(a);
+    return !size || a->pcData == b->pcData ||
+            (a->pcData && b->pcData && !::memcmp(a->pcData, b->pcData, size));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Bring a texture path into a canonical form: forward slashes, no empty or '.' segments
+// and no 'dir/..' pairs. Leading slashes are kept as they are.
+static std::string NormalizeTexturePath(const char* path)
+{
+    std::string in(path);
+    std::replace(in.begin(), in.end(), '\\', '/');
+
+    const size_t begin = in.find_first_not_of('/');
+    std::string out = in.substr(0, std::min(begin, in.length()));
+    std::vector<std::string> segments;
+    for (size_t pos = begin; pos < in.length(); ) {
+        size_t end = in.find('/', pos);
+        if (end == std::string::npos) {
+            end = in.length();
+        }
+        const std::string segment = in.substr(pos, end - pos);
+        if (segment == "..") {
+            if (!segments.empty() && segments.back() != "..") {
+                segments.pop_back();
+            } else {
+                segments.push_back(segment);
+            }
+        } else if (!segment.empty() && segment != ".") {
+            segments.push_back(segment);
+        }
+        pos = end + 1;
+    }
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (i) {
+            out += '/';
+        }
+        out += segments[i];
+    }
+    return out;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 RemoveRedundantMatsProcess::RemoveRedundantMatsProcess()
-: mConfigFixedMaterials() {
+: mConfigFixedMaterials()
+, mConfigTextures(false) {
     // nothing to do here
 }
 
@@ -75,12 +154,118 @@ bool RemoveRedundantMatsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_RemoveRedundantMaterials) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool RemoveRedundantMatsProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup import properties
 void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp)
 {
     // Get value of AI_CONFIG_PP_RRM_EXCLUDE_LIST
     mConfigFixedMaterials = pImp->GetPropertyString(AI_CONFIG_PP_RRM_EXCLUDE_LIST,"");
+
+    // Get value of AI_CONFIG_PP_RRM_TEXTURES
+    mConfigTextures = pImp->GetPropertyBool(AI_CONFIG_PP_RRM_TEXTURES,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collapses identical embedded textures and equivalent texture paths.
+unsigned int RemoveRedundantMatsProcess::RemoveRedundantTextures( aiScene* pScene)
+{
+    // Find out which embedded textures are identical, keep the first of them
+    std::vector<unsigned int> aiMappingTable(pScene->mNumTextures);
+    std::vector<bool> abRemoved(pScene->mNumTextures,false);
+    std::unordered_multimap<uint32_t,unsigned int> hashes;
+    unsigned int iNewNum = 0;
+    for (unsigned int i = 0; i < pScene->mNumTextures;++i)
+    {
+        const aiTexture* tex = pScene->mTextures[i];
+        const uint32_t me = ComputeTextureHash(tex);
+        auto range = hashes.equal_range(me);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (IsSameTexture(pScene->mTextures[it->second],tex)) {
+                aiMappingTable[i] = aiMappingTable[it->second];
+                abRemoved[i] = true;
+                break;
+            }
+        }
+        if (!abRemoved[i]) {
+            hashes.insert(std::make_pair(me,i));
+            aiMappingTable[i] = iNewNum++;
+        }
+    }
+
+    // Embedded textures may also be referenced by their file name. The first texture
+    // with a matching short name is the one that is used, see aiScene::GetEmbeddedTexture.
+    std::map<std::string,unsigned int> filenames;
+    for (unsigned int i = 0; i < pScene->mNumTextures;++i) {
+        if (pScene->mTextures[i]->mFilename.length) {
+            filenames.insert(std::make_pair(std::string(aiScene::GetShortFilename(pScene->mTextures[i]->mFilename.C_Str())),i));
+        }
+    }
+
+    // Rewrite the texture references of all materials
+    std::map<std::string,std::string> paths;
+    for (unsigned int i = 0; i < pScene->mNumMaterials;++i)
+    {
+        aiMaterial* mat = pScene->mMaterials[i];
+        int dummy;
+        const bool fixed = AI_SUCCESS == mat->Get("~RRM.UniqueMaterial",0,0,dummy);
+
+        for (unsigned int p = 0; p < mat->mNumProperties;++p)
+        {
+            const aiMaterialProperty* prop = mat->mProperties[p];
+            aiString path;
+            if (::strcmp(prop->mKey.data,_AI_MATKEY_TEXTURE_BASE) || prop->mType != aiPTI_String ||
+                    AI_SUCCESS != mat->Get(_AI_MATKEY_TEXTURE_BASE,prop->mSemantic,prop->mIndex,path)) {
+                continue;
+            }
+
+            aiString newPath = path;
+            if (path.data[0] == '*') {
+                const unsigned int index = strtoul10(path.data + 1);
+                if (index < pScene->mNumTextures) {
+                    newPath.length = ::ai_snprintf(newPath.data,MAXLEN,"*%u",aiMappingTable[index]);
+                }
+            } else {
+                auto it = filenames.find(aiScene::GetShortFilename(path.data));
+                if (it != filenames.end()) {
+                    if (abRemoved[it->second]) {
+                        newPath.length = ::ai_snprintf(newPath.data,MAXLEN,"*%u",aiMappingTable[it->second]);
+                    }
+                } else if (!fixed) {
+                    // refer to equivalent external files with a single spelling
+                    auto known = paths.insert(std::make_pair(NormalizeTexturePath(path.data),std::string(path.data)));
+                    newPath.Set(known.first->second);
+                }
+            }
+
+            if (newPath != path) {
+                mat->AddProperty(&newPath,_AI_MATKEY_TEXTURE_BASE,prop->mSemantic,prop->mIndex);
+            }
+        }
+    }
+
+    // Rebuild the texture list
+    if (iNewNum != pScene->mNumTextures) {
+        aiTexture** ppcTextures = new aiTexture*[iNewNum];
+        for (unsigned int i = 0; i < pScene->mNumTextures;++i) {
+            if (abRemoved[i]) {
+                delete pScene->mTextures[i];
+            } else {
+                ppcTextures[aiMappingTable[i]] = pScene->mTextures[i];
+            }
+        }
+        delete[] pScene->mTextures;
+        pScene->mTextures = ppcTextures;
+    }
+
+    const unsigned int removed = pScene->mNumTextures - iNewNum;
+    pScene->mNumTextures = iNewNum;
+    return removed;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -89,7 +274,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("RemoveRedundantMatsProcess begin");
 
-    unsigned int redundantRemoved = 0, unreferencedRemoved = 0;
+    unsigned int redundantRemoved = 0, unreferencedRemoved = 0, texturesRemoved = 0;
     if (pScene->mNumMaterials)
     {
         // Find out which materials are referenced by meshes
@@ -128,6 +313,12 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
             }
         }
 
+        // Collapse redundant textures first, materials that only differed
+        // in the way they refer to them are identical afterwards.
+        if (mConfigTextures) {
+            texturesRemoved = RemoveRedundantTextures(pScene);
+        }
+
         // TODO: re-implement this algorithm to work in-place
         unsigned int *aiMappingTable = new unsigned int[pScene->mNumMaterials];
         for ( unsigned int i=0; i<pScene->mNumMaterials; i++ ) {
@@ -209,13 +400,13 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
         delete[] aiHashes;
         delete[] aiMappingTable;
     }
-    if (redundantRemoved == 0 && unreferencedRemoved == 0)
+    if (redundantRemoved == 0 && unreferencedRemoved == 0 && texturesRemoved == 0)
     {
         ASSIMP_LOG_DEBUG("RemoveRedundantMatsProcess finished ");
     }
     else
     {
         ASSIMP_LOG_INFO_F("RemoveRedundantMatsProcess finished. Removed ", redundantRemoved, " redundant and ", 
-            unreferencedRemoved, " unused materials.");
+            unreferencedRemoved, " unused materials, ", texturesRemoved, " redundant textures.");
     }
 }
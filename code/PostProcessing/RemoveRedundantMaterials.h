@@ -55,7 +55,8 @@ namespace Assimp    {
 
 // ---------------------------------------------------------------------------
 /** RemoveRedundantMatsProcess: Post-processing step to remove redundant
- *  materials from the imported scene.
+ *  materials from the imported scene. Optionally, redundant textures are
+ *  removed first, see #AI_CONFIG_PP_RRM_TEXTURES.
  */
 class ASSIMP_API RemoveRedundantMatsProcess : public BaseProcess {
 public:
@@ -68,6 +69,7 @@ public:
     // -------------------------------------------------------------------
     // Check whether step is active
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     // Execute step on a given scene
@@ -93,9 +95,25 @@ public:
         return mConfigFixedMaterials;
     }
 
+    // -------------------------------------------------------------------
+    /** @brief Enable or disable the removal of redundant textures
+     *  @param enable See #AI_CONFIG_PP_RRM_TEXTURES
+     */
+    void SetRemoveRedundantTextures(bool enable) {
+        mConfigTextures = enable;
+    }
+
 private:
+    // -------------------------------------------------------------------
+    // Collapse identical embedded textures and equivalent texture paths,
+    // returns the number of removed textures
+    unsigned int RemoveRedundantTextures(aiScene* pScene);
+
     //! Configuration option: list of all fixed materials
     std::string mConfigFixedMaterials;
+
+    //! Configuration option: remove redundant textures as well
+    bool mConfigTextures;
 };
 
 } // end of namespace Assimp
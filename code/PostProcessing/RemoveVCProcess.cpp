@@ -66,6 +66,12 @@ bool RemoveVCProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_RemoveComponent) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Faces are never modified, only whole meshes are deleted
+bool RemoveVCProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Small helper function to delete all elements in a T** aray using delete
 template <typename T>
@@ -76,6 +76,7 @@ public:
 
     /// Overwritten, @see BaseProcess
     virtual bool IsActive( unsigned int pFlags ) const;
+    virtual bool SupportsIndexBuffer() const;
 
     /// Overwritten, @see BaseProcess
     virtual void SetupProperties( const Importer* pImp );
@@ -76,6 +76,12 @@ bool TextureTransformStep::IsActive( unsigned int pFlags) const
     return  (pFlags & aiProcess_TransformUVCoords) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The step does not touch the faces
+bool TextureTransformStep::SupportsIndexBuffer() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup properties
 void TextureTransformStep::SetupProperties(const Importer* pImp)
@@ -204,6 +204,7 @@ public:
 
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
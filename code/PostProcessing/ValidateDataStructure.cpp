@@ -49,19 +49,41 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "ValidateDataStructure.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/fast_atof.h>
+#include <exception>
 #include <memory>
+#include <string>
 
 // CRT headers
 #include <stdarg.h>
 
 using namespace Assimp;
 
+namespace {
+
+// Warnings of the mesh which is validated by the current thread. They are logged afterwards in
+// mesh order, log streams of the application may not be thread-safe.
+thread_local std::vector<std::string> *gWarnings = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+// Returns the largest index, written as a plain reduction so the compiler can vectorize it
+unsigned int GetMaxIndex(const unsigned int *indices, size_t count) {
+    unsigned int result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result = indices[i] > result ? indices[i] : result;
+    }
+    return result;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess() :
-        mScene() {}
+        mScene(),
+        mLightMode(false) {}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -72,6 +94,17 @@ ValidateDSProcess::~ValidateDSProcess() {}
 bool ValidateDSProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool ValidateDSProcess::SupportsIndexBuffer() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::SetupProperties(const Importer *pImp) {
+    mLightMode = pImp->GetPropertyBool(AI_CONFIG_PP_VDS_LIGHT_MODE, false);
+}
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) {
     ai_assert(nullptr != msg);
@@ -99,6 +132,10 @@ void ValidateDSProcess::ReportWarning(const char *msg, ...) {
     ai_assert(iLen > 0);
 
     va_end(args);
+    if (gWarnings) {
+        gWarnings->push_back("Validation warning: " + std::string(szBuffer, iLen));
+        return;
+    }
     ASSIMP_LOG_WARN("Validation warning: " + std::string(szBuffer, iLen));
 }
 
@@ -165,6 +202,9 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T **array, unsigned int
         const char *secondName) {
     // validate all entries
     DoValidationEx(array, size, firstName, secondName);
+    if (mLightMode) {
+        return;
+    }
 
     for (unsigned int i = 0; i < size; ++i) {
         int res = HasNameMatch(array[i]->mName, mScene->mRootNode);
@@ -187,11 +227,12 @@ void ValidateDSProcess::Execute(aiScene *pScene) {
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess begin");
 
     // validate the node graph of the scene
+    mNodeMeshes.assign(pScene->mNumMeshes, false);
     Validate(pScene->mRootNode);
 
     // validate all meshes
     if (pScene->mNumMeshes) {
-        DoValidation(pScene->mMeshes, pScene->mNumMeshes, "mMeshes", "mNumMeshes");
+        ValidateMeshes();
     } else if (!(mScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)) {
         ReportError("aiScene::mNumMeshes is 0. At least one mesh must be there");
     } else if (pScene->mMeshes) {
@@ -278,6 +319,156 @@ void ValidateDSProcess::Validate(const aiCamera *pCamera) {
         ReportWarning("%f is not a valid value for aiCamera::mHorizontalFOV", pCamera->mHorizontalFOV);
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateMeshes() {
+    if (!mScene->mMeshes) {
+        ReportError("aiScene::mMeshes is nullptr (aiScene::mNumMeshes is %i)", mScene->mNumMeshes);
+    }
+    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
+        if (!mScene->mMeshes[i]) {
+            ReportError("aiScene::mMeshes[%i] is nullptr (aiScene::mNumMeshes is %i)", i, mScene->mNumMeshes);
+        }
+    }
+
+    // meshes are independent of each other, their warnings and errors are reported afterwards
+    // in mesh order, as if they had been validated one after the other
+    std::vector<std::vector<std::string>> warnings(mScene->mNumMeshes);
+    std::vector<std::exception_ptr> errors(mScene->mNumMeshes);
+    size_t work = 0;
+    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
+        work += mScene->mMeshes[i]->mNumVertices + mScene->mMeshes[i]->mNumFaces;
+    }
+    ParallelFor(0, mScene->mNumMeshes, [&](size_t i) {
+        struct WarningScope {
+            explicit WarningScope(std::vector<std::string> *sink) { gWarnings = sink; }
+            ~WarningScope() { gWarnings = nullptr; }
+        } scope(&warnings[i]);
+
+        try {
+            if (mLightMode) {
+                ValidateStructure(mScene->mMeshes[i]);
+            } else {
+                Validate(mScene->mMeshes[i]);
+            }
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }, 1, work);
+
+    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
+        for (const std::string &warning : warnings[i]) {
+            ASSIMP_LOG_WARN(warning);
+        }
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateStructure(const aiMesh *pMesh) {
+    if (mScene->mNumMaterials && pMesh->mMaterialIndex >= mScene->mNumMaterials) {
+        ReportError("aiMesh::mMaterialIndex is invalid (value: %i maximum: %i)",
+                pMesh->mMaterialIndex, mScene->mNumMaterials - 1);
+    }
+    if (!pMesh->mNumVertices || (!pMesh->mVertices && !mScene->mFlags)) {
+        ReportError("The mesh %s contains no vertices", pMesh->mName.C_Str());
+    }
+    if (pMesh->mNumVertices > AI_MAX_VERTICES) {
+        ReportError("Mesh has too many vertices: %u, but the limit is %u", pMesh->mNumVertices, AI_MAX_VERTICES);
+    }
+    if (pMesh->mNumFaces > AI_MAX_FACES) {
+        ReportError("Mesh has too many faces: %u, but the limit is %u", pMesh->mNumFaces, AI_MAX_FACES);
+    }
+    if ((pMesh->mTangents != nullptr) != (pMesh->mBitangents != nullptr)) {
+        ReportError("If there are tangents, bitangent vectors must be present as well");
+    }
+    if (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags)) {
+        ReportError("Mesh %s contains no faces", pMesh->mName.C_Str());
+    }
+
+    // check the faces first and all indices at once afterwards
+    unsigned int maxIndex = 0;
+    const unsigned int *cursor = pMesh->mIndices;
+    for (unsigned int i = 0; pMesh->mFaces && i < pMesh->mNumFaces; ++i) {
+        const aiFace &face = pMesh->mFaces[i];
+        if (!face.mNumIndices || face.mNumIndices > AI_MAX_FACE_INDICES) {
+            ReportError("aiMesh::mFaces[%i].mNumIndices is invalid (%u)", i, face.mNumIndices);
+        }
+        if (!face.mIndices) {
+            ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
+        }
+        if (cursor) {
+            if (face.mIndices != cursor) {
+                ReportError("aiMesh::mFaces[%i]::mIndices does not point into aiMesh::mIndices", i);
+            }
+            cursor += face.mNumIndices;
+        } else {
+            maxIndex = std::max(maxIndex, GetMaxIndex(face.mIndices, face.mNumIndices));
+        }
+    }
+    if (cursor && pMesh->mFaces) {
+        if (cursor != pMesh->mIndices + pMesh->mNumIndices) {
+            ReportError("aiMesh::mNumIndices does not match the number of face indices");
+        }
+        maxIndex = GetMaxIndex(pMesh->mIndices, pMesh->mNumIndices);
+    }
+    if (pMesh->mNumFaces && maxIndex >= pMesh->mNumVertices) {
+        ReportError("aiMesh %s references vertex %u, which is out of range", pMesh->mName.C_Str(), maxIndex);
+    }
+
+    ValidateMeshlets(pMesh);
+
+    if (pMesh->mNumBones) {
+        if (!pMesh->mBones) {
+            ReportError("aiMesh::mBones is nullptr (aiMesh::mNumBones is %i)", pMesh->mNumBones);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+            const aiBone *bone = pMesh->mBones[i];
+            if (!bone) {
+                ReportError("aiMesh::mBones[%i] is nullptr (aiMesh::mNumBones is %i)", i, pMesh->mNumBones);
+            }
+            if (bone->mNumWeights && !bone->mWeights) {
+                ReportError("aiMesh::mBones[%i]::mWeights is nullptr", i);
+            }
+            for (unsigned int a = 0; a < bone->mNumWeights; ++a) {
+                if (bone->mWeights[a].mVertexId >= pMesh->mNumVertices) {
+                    ReportError("aiBone::mWeights[%i].mVertexId is out of range", a);
+                }
+            }
+        }
+    } else if (pMesh->mBones) {
+        ReportError("aiMesh::mBones is non-null although there are no bones");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateMeshlets(const aiMesh *pMesh) {
+    if (!pMesh->mNumMeshlets) {
+        return;
+    }
+    if (!pMesh->mMeshlets || !pMesh->mMeshletVertices || !pMesh->mMeshletIndices) {
+        ReportError("aiMesh::mNumMeshlets is %u but the meshlet buffers are incomplete", pMesh->mNumMeshlets);
+    }
+    for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+        const aiMeshlet &meshlet = pMesh->mMeshlets[i];
+        if (meshlet.mVertexOffset + meshlet.mVertexCount > pMesh->mNumMeshletVertices ||
+                meshlet.mIndexOffset + meshlet.mTriangleCount * 3 > pMesh->mNumMeshletIndices) {
+            ReportError("aiMesh::mMeshlets[%u] is out of range", i);
+        }
+        for (unsigned int a = 0; a < meshlet.mVertexCount; ++a) {
+            if (pMesh->mMeshletVertices[meshlet.mVertexOffset + a] >= pMesh->mNumVertices) {
+                ReportError("aiMesh::mMeshlets[%u] references vertex %u, which is out of range", i, a);
+            }
+        }
+        for (unsigned int a = 0; a < meshlet.mTriangleCount * 3; ++a) {
+            if (pMesh->mMeshletIndices[meshlet.mIndexOffset + a] >= meshlet.mVertexCount) {
+                ReportError("aiMesh::mMeshlets[%u] has index %u out of range", i, a);
+            }
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate(const aiMesh *pMesh) {
     // validate the material index of the mesh
@@ -380,6 +571,24 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
         }
     }
 
+    // the faces of a mesh with an index buffer must point into it in order
+    if (pMesh->HasIndexBuffer()) {
+        const unsigned int *cursor = pMesh->mIndices;
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            const aiFace &face = pMesh->mFaces[i];
+            if (face.mIndices != cursor) {
+                ReportError("aiMesh::mFaces[%i]::mIndices does not point into aiMesh::mIndices", i);
+            }
+            cursor += face.mNumIndices;
+        }
+        if (cursor != pMesh->mIndices + pMesh->mNumIndices) {
+            ReportError("aiMesh::mNumIndices does not match the number of face indices");
+        }
+    }
+
+    // the meshlets must stay within their buffers
+    ValidateMeshlets(pMesh);
+
     // check whether there are vertices that aren't referenced by a face
     bool b = false;
     for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
@@ -663,6 +872,9 @@ void ValidateDSProcess::Validate(const aiMaterial *pMaterial) {
         }
         // TODO: check whether there is a key with an unknown name ...
     }
+    if (mLightMode) {
+        return;
+    }
 
     // make some more specific tests
     ai_real fTemp;
@@ -749,6 +961,14 @@ void ValidateDSProcess::Validate(const aiTexture *pTexture) {
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate(const aiAnimation *pAnimation,
         const aiNodeAnim *pNodeAnim) {
+    if (mLightMode) {
+        if ((pNodeAnim->mNumPositionKeys && !pNodeAnim->mPositionKeys) ||
+                (pNodeAnim->mNumRotationKeys && !pNodeAnim->mRotationKeys) ||
+                (pNodeAnim->mNumScalingKeys && !pNodeAnim->mScalingKeys)) {
+            ReportError("aiNodeAnim::mXXXKeys is nullptr although there are keys");
+        }
+        return;
+    }
     Validate(&pNodeAnim->mNodeName);
 
     if (!pNodeAnim->mNumPositionKeys && !pNodeAnim->mScalingKeys && !pNodeAnim->mNumRotationKeys) {
@@ -841,6 +1061,13 @@ void ValidateDSProcess::Validate(const aiAnimation *pAnimation,
 
 void ValidateDSProcess::Validate(const aiAnimation *pAnimation,
         const aiMeshMorphAnim *pMeshMorphAnim) {
+    if (mLightMode) {
+        if (pMeshMorphAnim->mNumKeys && !pMeshMorphAnim->mKeys) {
+            ReportError("aiMeshMorphAnim::mKeys is nullptr (aiMeshMorphAnim::mNumKeys is %i)",
+                    pMeshMorphAnim->mNumKeys);
+        }
+        return;
+    }
     Validate(&pMeshMorphAnim->mName);
 
     if (!pMeshMorphAnim->mNumKeys) {
@@ -896,18 +1123,20 @@ void ValidateDSProcess::Validate(const aiNode *pNode) {
             ReportError("aiNode::mMeshes is nullptr for node %s (aiNode::mNumMeshes is %i)",
                     nodeName, pNode->mNumMeshes);
         }
-        std::vector<bool> abHadMesh;
-        abHadMesh.resize(mScene->mNumMeshes, false);
+        // mNodeMeshes is shared by all nodes and cleared again after each node
         for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
             if (pNode->mMeshes[i] >= mScene->mNumMeshes) {
                 ReportError("aiNode::mMeshes[%i] is out of range for node %s (maximum is %i)",
                         pNode->mMeshes[i], nodeName, mScene->mNumMeshes - 1);
             }
-            if (abHadMesh[pNode->mMeshes[i]]) {
+            if (mNodeMeshes[pNode->mMeshes[i]]) {
                 ReportError("aiNode::mMeshes[%i] is already referenced by this node %s (value: %i)",
                         i, nodeName, pNode->mMeshes[i]);
             }
-            abHadMesh[pNode->mMeshes[i]] = true;
+            mNodeMeshes[pNode->mMeshes[i]] = true;
+        }
+        for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+            mNodeMeshes[pNode->mMeshes[i]] = false;
         }
     }
     if (pNode->mNumChildren) {
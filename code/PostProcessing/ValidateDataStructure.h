@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 
+#include <vector>
+
 struct aiBone;
 struct aiMesh;
 struct aiAnimation;
@@ -67,9 +69,11 @@ namespace Assimp    {
 
 // --------------------------------------------------------------------------------------
 /** Validates the whole ASSIMP scene data structure for correctness.
- *  ImportErrorException is thrown of the scene is corrupt.*/
+ *  ImportErrorException is thrown of the scene is corrupt.
+ *  Meshes are validated in parallel. See #AI_CONFIG_PP_VDS_LIGHT_MODE for a
+ *  faster mode which only checks what is needed to access the scene safely.*/
 // --------------------------------------------------------------------------------------
-class ValidateDSProcess : public BaseProcess
+class ASSIMP_API ValidateDSProcess : public BaseProcess
 {
 public:
 
@@ -79,10 +83,21 @@ public:
 public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
+    bool SupportsIndexBuffer() const;
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer* pImp);
 
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** Enables or disables light mode, see #AI_CONFIG_PP_VDS_LIGHT_MODE.
+     *  SetupProperties() overrides this setting.*/
+    void SetLightMode(bool light) {
+        mLightMode = light;
+    }
+
 protected:
 
     // -------------------------------------------------------------------
@@ -99,11 +114,25 @@ protected:
     void ReportWarning(const char* msg,...);
 
 
+    // -------------------------------------------------------------------
+    /** Validates all meshes of the scene, in parallel.*/
+    void ValidateMeshes();
+
     // -------------------------------------------------------------------
     /** Validates a mesh
      * @param pMesh Input mesh*/
     void Validate( const aiMesh* pMesh);
 
+    // -------------------------------------------------------------------
+    /** Validates the counts, pointers and indices of a mesh only
+     * @param pMesh Input mesh*/
+    void ValidateStructure( const aiMesh* pMesh);
+
+    // -------------------------------------------------------------------
+    /** Validates the meshlets of a mesh
+     * @param pMesh Input mesh*/
+    void ValidateMeshlets( const aiMesh* pMesh);
+
     // -------------------------------------------------------------------
     /** Validates a bone
      * @param pMesh Input mesh
@@ -187,6 +216,12 @@ private:
         const char* firstName, const char* secondName);
 
     aiScene* mScene;
+
+    // only check counts, pointers and indices
+    bool mLightMode;
+
+    // meshes referenced by the node which is being validated
+    std::vector<bool> mNodeMeshes;
 };
 
 
@@ -0,0 +1,142 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AnimationSampler.hpp
+ *  @brief Class 'AnimationSampler', evaluates the node channels of an aiAnimation.
+ */
+#pragma once
+#ifndef AI_ANIMATIONSAMPLER_H_INC
+#define AI_ANIMATIONSAMPLER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/anim.h>
+#include <assimp/matrix4x4.h>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------
+/** @brief Transformation of one animated node at a point in time. */
+struct ChannelPose {
+    aiVector3D mPosition;
+    aiQuaternion mRotation;
+    aiVector3D mScaling;
+
+    ChannelPose() :
+            mPosition(),
+            mRotation(),
+            mScaling(1, 1, 1) {}
+};
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Samples all node channels of an aiAnimation.
+ *
+ *  The keys are copied into a structure-of-arrays layout on construction.
+ *  The key pair around a time is found by binary search. Each track also
+ *  remembers the key used by the previous call, so playing the animation
+ *  forward (or resampling it at increasing times) finds the keys in
+ *  constant time. Positions and scalings are interpolated linearly, and
+ *  rotations by the same slerp as aiQuaternion::Interpolate, batched over
+ *  all channels.
+ *
+ *  Times outside of the keys of a track follow the mPreState and mPostState
+ *  of its channel. aiAnimBehaviour_DEFAULT behaves like CONSTANT, since the
+ *  sampler does not know the node transformations.
+ *
+ *  The animation is not referenced after construction. The sampler is not
+ *  thread-safe, use one sampler per thread. */
+class ASSIMP_API AnimationSampler
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /** @brief Copies the node channels of an animation.
+     *  @param anim The animation, must not be nullptr. */
+    explicit AnimationSampler(const aiAnimation *anim);
+
+    ~AnimationSampler();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of sampled channels, the same as
+     *  aiAnimation::mNumChannels. */
+    unsigned int GetNumChannels() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Samples all channels.
+     *  @param time Time in ticks.
+     *  @param poses Receives one pose per channel, in the order of
+     *    aiAnimation::mChannels. */
+    void Sample(double time, ChannelPose *poses);
+
+    // -------------------------------------------------------------------
+    /** @brief Samples all channels as node transformation matrices.
+     *  @param time Time in ticks.
+     *  @param transforms Receives one matrix per channel. */
+    void Sample(double time, aiMatrix4x4 *transforms);
+
+    // -------------------------------------------------------------------
+    /** @brief Samples several frames at once.
+     *  @param startTime Time of the first frame in ticks.
+     *  @param timeStep Time between two frames in ticks.
+     *  @param numFrames Number of frames to sample.
+     *  @param poses Receives numFrames * GetNumChannels() poses, frame by
+     *    frame. */
+    void SampleFrames(double startTime, double timeStep, unsigned int numFrames, ChannelPose *poses);
+
+    // -------------------------------------------------------------------
+    /** @brief Forgets the keys remembered from the previous calls. */
+    void ResetCursors();
+
+private:
+    AnimationSampler(const AnimationSampler &) = delete;
+    AnimationSampler &operator=(const AnimationSampler &) = delete;
+
+    struct Impl;
+    Impl *mImpl;
+}; // !class AnimationSampler
+
+} // Namespace Assimp
+
+#endif // AI_ANIMATIONSAMPLER_H_INC
@@ -0,0 +1,108 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AsyncLogStream.hpp
+ *  @brief Log stream which hands messages to a background thread.
+ */
+#pragma once
+#ifndef INCLUDED_AI_ASYNCLOGSTREAM_H
+#define INCLUDED_AI_ASYNCLOGSTREAM_H
+
+#include <assimp/LogStream.hpp>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Log stream which writes messages to another stream on a
+ *  background thread.
+ *
+ *  #write() copies the message to a fixed-size ring buffer without taking a lock
+ *  or allocating memory, so threads which log at the same time neither wait for
+ *  each other nor for the output. Messages are dropped if the buffer is full, use
+ *  #getNumDropped() to check for this. Messages longer than MAX_LOG_MESSAGE_LENGTH
+ *  are truncated.
+ *
+ *  If assimp was built without ASSIMP_BUILD_PARALLEL, messages are written to
+ *  the target stream right away. */
+class ASSIMP_API AsyncLogStream : public LogStream {
+public:
+    /** Default number of messages the buffer can hold. */
+    static const unsigned int DefaultCapacity = 1024;
+
+    // -------------------------------------------------------------------
+    /** @brief Constructor, starts the background thread.
+     *  @param target Stream to write the messages to. The async stream
+     *    takes ownership of it.
+     *  @param capacity Number of messages the buffer can hold, rounded
+     *    up to a power of two. */
+    explicit AsyncLogStream(LogStream *target, unsigned int capacity = DefaultCapacity);
+
+    // -------------------------------------------------------------------
+    /** @brief Destructor, writes all pending messages and stops the
+     *  background thread. */
+    ~AsyncLogStream();
+
+    // -------------------------------------------------------------------
+    /** @brief Queues a message, safe to call from several threads at once. */
+    void write(const char *message) override;
+
+    // -------------------------------------------------------------------
+    /** @brief Waits until all messages queued so far have been written. */
+    void flush();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of messages dropped because the buffer
+     *  was full. */
+    unsigned int getNumDropped() const;
+
+private:
+    AsyncLogStream(const AsyncLogStream &) = delete;
+    AsyncLogStream &operator=(const AsyncLogStream &) = delete;
+
+    struct Impl;
+    Impl *mImpl;
+};
+
+// ------------------------------------------------------------------------------------
+} // Namespace Assimp
+
+#endif // INCLUDED_AI_ASYNCLOGSTREAM_H
@@ -64,6 +64,7 @@ namespace Assimp {
 //!         used with no restrictions.
 class ASSIMP_API DefaultIOStream : public IOStream {
     friend class DefaultIOSystem;
+    friend class MappedFile;
 #if __ANDROID__
 # if __ANDROID_API__ > 9
 #  if defined(AI_CONFIG_ANDROID_JNI_ASSIMP_MANAGER_SUPPORT)
@@ -114,6 +114,11 @@ public:
      *  something else than just rejecting all log messages. */
     static bool isNullLogger();
 
+    // ----------------------------------------------------------------------
+    /** @brief  Return whether the given logger is the #NullLogger
+     *  @param logger A logger returned by get() */
+    static bool isNullLogger(const Logger *logger);
+
     // ----------------------------------------------------------------------
     /** @brief  Kills the current singleton logger and replaces it with a
      *  #NullLogger instance. */
@@ -177,10 +182,6 @@ private:
 
     //! Attached streams
     StreamArray m_StreamArray;
-
-    bool noRepeatMsg;
-    char lastMsg[MAX_LOG_MESSAGE_LENGTH * 2];
-    size_t lastLen;
 };
 // ------------------------------------------------------------------------------------
 
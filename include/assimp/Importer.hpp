@@ -68,6 +68,7 @@ class Importer;
 class IOStream;
 class IOSystem;
 class ProgressHandler;
+class MemoryTracker;
 
 // =======================================================================
 // Plugin development
@@ -363,6 +364,20 @@ public:
      */
     bool IsDefaultProgressHandler() const;
 
+    // -------------------------------------------------------------------
+    /** Supplies a memory tracker to the importer. The tracker records
+     *  the allocations and the scene size of each import phase and
+     *  post-processing step, see #MemoryTracker.
+     *  @param pTracker Tracker to install, the importer takes ownership.
+     *    Pass nullptr to disable tracking. #AI_CONFIG_GLOB_TRACK_MEMORY
+     *    installs a default tracker when the next file is read. */
+    void SetMemoryTracker(MemoryTracker *pTracker);
+
+    // -------------------------------------------------------------------
+    /** Retrieves the memory tracker that is currently set.
+     * @return The tracker, nullptr if memory tracking is disabled. */
+    MemoryTracker *GetMemoryTracker() const;
+
     // -------------------------------------------------------------------
     /** @brief Check whether a given set of post-processing flags
      *  is supported.
@@ -533,6 +548,22 @@ public:
      *   It will work as well for static linkage with Assimp.*/
     aiScene *GetOrphanedScene();
 
+    // -------------------------------------------------------------------
+    /** Returns how many calls to ReadFile() were served from the import
+     *  cache since the Importer was created.
+     *
+     * @return Number of cache hits, always 0 if the cache is disabled.
+     * @see AI_CONFIG_IMPORT_CACHE_DIRECTORY */
+    unsigned int GetImportCacheHits() const;
+
+    // -------------------------------------------------------------------
+    /** Returns how many calls to ReadFile() could not be served from the
+     *  import cache since the Importer was created.
+     *
+     * @return Number of cache misses, always 0 if the cache is disabled.
+     * @see AI_CONFIG_IMPORT_CACHE_DIRECTORY */
+    unsigned int GetImportCacheMisses() const;
+
     // -------------------------------------------------------------------
     /** Returns whether a given file extension is supported by ASSIMP.
      *
@@ -137,6 +137,16 @@ public:
     /** @brief Get the current log severity*/
     LogSeverity getLogSeverity() const;
 
+    // ----------------------------------------------------------------------
+    /** @brief Returns whether debug messages are logged with the current
+     *  log severity. Used to skip formatting messages which are dropped anyway. */
+    bool isDebugEnabled() const;
+
+    // ----------------------------------------------------------------------
+    /** @brief Returns whether verbose debug messages are logged with the
+     *  current log severity. */
+    bool isVerboseDebugEnabled() const;
+
     // ----------------------------------------------------------------------
     /** @brief  Attach a new log-stream
      *
@@ -266,6 +276,18 @@ Logger::LogSeverity Logger::getLogSeverity() const {
     return m_Severity;
 }
 
+// ----------------------------------------------------------------------------------
+inline
+bool Logger::isDebugEnabled() const {
+    return m_Severity >= DEBUGGING;
+}
+
+// ----------------------------------------------------------------------------------
+inline
+bool Logger::isVerboseDebugEnabled() const {
+    return m_Severity >= VERBOSE;
+}
+
 // ----------------------------------------------------------------------------------
 inline
 void Logger::debug(const std::string &message) {
@@ -298,34 +320,46 @@ void Logger::info(const std::string &message) {
 } // Namespace Assimp
 
 // ------------------------------------------------------------------------------------------------
+// The arguments of the logging macros are only evaluated if the message is going to be logged,
+// so messages aren't formatted if there is no logger or if their severity is disabled. The
+// logger is fetched once, @c enabled and @c call refer to it as ai_logger_.
+// The macros are expressions, some importers log inside a conditional expression.
+#define ASSIMP_LOG_IF_ENABLED_(enabled, call) \
+	([&]() { \
+		Assimp::Logger *const ai_logger_ = Assimp::DefaultLogger::get(); \
+		if (enabled) { \
+			ai_logger_->call; \
+		} \
+	}())
+
 #define ASSIMP_LOG_WARN_F(string, ...) \
-	Assimp::DefaultLogger::get()->warn((Assimp::Formatter::format(string), __VA_ARGS__))
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), warn((Assimp::Formatter::format(string), __VA_ARGS__)))
 
 #define ASSIMP_LOG_ERROR_F(string, ...) \
-	Assimp::DefaultLogger::get()->error((Assimp::Formatter::format(string), __VA_ARGS__))
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), error((Assimp::Formatter::format(string), __VA_ARGS__)))
 
 #define ASSIMP_LOG_DEBUG_F(string, ...) \
-	Assimp::DefaultLogger::get()->debug((Assimp::Formatter::format(string), __VA_ARGS__))
+	ASSIMP_LOG_IF_ENABLED_(ai_logger_->isDebugEnabled(), debug((Assimp::Formatter::format(string), __VA_ARGS__)))
 
 #define ASSIMP_LOG_VERBOSE_DEBUG_F(string, ...) \
-	Assimp::DefaultLogger::get()->verboseDebug((Assimp::Formatter::format(string), __VA_ARGS__))
+	ASSIMP_LOG_IF_ENABLED_(ai_logger_->isVerboseDebugEnabled(), verboseDebug((Assimp::Formatter::format(string), __VA_ARGS__)))
 
 #define ASSIMP_LOG_INFO_F(string, ...) \
-	Assimp::DefaultLogger::get()->info((Assimp::Formatter::format(string), __VA_ARGS__))
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), info((Assimp::Formatter::format(string), __VA_ARGS__)))
 
 #define ASSIMP_LOG_WARN(string) \
-	Assimp::DefaultLogger::get()->warn(string)
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), warn(string))
 
 #define ASSIMP_LOG_ERROR(string) \
-	Assimp::DefaultLogger::get()->error(string)
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), error(string))
 
 #define ASSIMP_LOG_DEBUG(string) \
-	Assimp::DefaultLogger::get()->debug(string)
+	ASSIMP_LOG_IF_ENABLED_(ai_logger_->isDebugEnabled(), debug(string))
 
 #define ASSIMP_LOG_VERBOSE_DEBUG(string) \
-	Assimp::DefaultLogger::get()->verboseDebug(string)
+	ASSIMP_LOG_IF_ENABLED_(ai_logger_->isVerboseDebugEnabled(), verboseDebug(string))
 
 #define ASSIMP_LOG_INFO(string) \
-	Assimp::DefaultLogger::get()->info(string)
+	ASSIMP_LOG_IF_ENABLED_(!Assimp::DefaultLogger::isNullLogger(ai_logger_), info(string))
 
 #endif // !! INCLUDED_AI_LOGGER_H
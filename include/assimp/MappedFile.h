@@ -0,0 +1,115 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MappedFile.h
+ *  @brief Memory mapping of files opened through the default IO system.
+ */
+#pragma once
+#ifndef AI_MAPPEDFILE_H_INC
+#define AI_MAPPEDFILE_H_INC
+
+#include <assimp/defs.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Assimp {
+
+class IOStream;
+
+// --------------------------------------------------------------------------------------------
+/** @brief Maps the file behind an IOStream into memory.
+ *
+ *  The mapping is read-only by default. A private mapping can be requested instead, its
+ *  pages are copied on the first write and changes never reach the file. Mapping is
+ *  only possible for streams opened by #DefaultIOSystem, all other streams (custom IO
+ *  systems, archives, memory streams) are left alone and IsValid() returns false.
+ *  Callers must always provide a fallback which reads through the stream. The stream
+ *  must stay open as long as the mapping is in use. */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API MappedFile {
+public:
+    // ----------------------------------------------------------------------------
+    /** @brief Tries to map the whole file behind a stream.
+     *  @param stream Stream to map, the stream position is not changed.
+     *  @param copyOnWrite Map the file privately so that it may be written to. */
+    explicit MappedFile(IOStream *stream, bool copyOnWrite = false);
+
+    /// Destructor, unmaps the file.
+    ~MappedFile();
+
+    /// Returns whether the file has been mapped successfully.
+    bool IsValid() const {
+        return nullptr != mData;
+    }
+
+    /// Returns the first byte of the mapped file (page aligned) or nullptr.
+    const uint8_t *GetData() const {
+        return mData;
+    }
+
+    /// Returns the first byte of a private mapping, nullptr for read-only mappings.
+    uint8_t *GetWritableData() const {
+        return mCopyOnWrite ? const_cast<uint8_t *>(mData) : nullptr;
+    }
+
+    /// Returns the size of the mapped file in bytes.
+    size_t GetSize() const {
+        return mSize;
+    }
+
+private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+    bool mCopyOnWrite;
+#ifdef _WIN32
+    void *mHandle;
+#endif
+};
+
+} // end of namespace Assimp
+
+#endif // AI_MAPPEDFILE_H_INC
@@ -0,0 +1,191 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MemoryTracker.hpp
+ *  @brief Class 'MemoryTracker', records the memory statistics of an import.
+ */
+#pragma once
+#ifndef AI_MEMORYTRACKER_H_INC
+#define AI_MEMORYTRACKER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+#include <atomic>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Records the allocations and the scene size of each import phase
+ *  and post-processing step of an #Importer.
+ *
+ *  Install a tracker with #Importer::SetMemoryTracker() or enable the default one
+ *  with #AI_CONFIG_GLOB_TRACK_MEMORY. The importer reports the phases "detect",
+ *  "cache" (import cache lookups), "parse" (the format importer), "convert"
+ *  (the scene preprocessor) and one phase per executed post-processing step,
+ *  named after the class of the step.
+ *
+ *  Assimp allocates with plain new, so it cannot count allocations by itself.
+ *  Applications call #CountAllocation() and #CountDeallocation() from their
+ *  allocation hooks, e.g. a replaced global operator new and delete. They are
+ *  credited to the tracker of the importer running on the calling thread, see
+ *  #Scope, so imports on other threads don't disturb each other. Override
+ *  #GetAllocationCounters() to read the counters of a custom allocator instead.
+ *  Without either, only the scene sizes are recorded.
+ *
+ *  The scene size is measured at the end of each phase. Temporary data which a
+ *  phase frees before it ends only shows up in aiMemoryPhaseInfo::peakBytes. */
+class ASSIMP_API MemoryTracker
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /** @brief Allocation counters of a tracker, all counting from its creation */
+    struct Counters {
+        size_t allocations;     ///< Number of allocations
+        size_t allocatedBytes;  ///< Bytes allocated
+        size_t deallocations;   ///< Number of deallocations
+        size_t freedBytes;      ///< Bytes freed
+        size_t peakBytes;       ///< Highest amount of live bytes above the level at the last #ResetPeak()
+    };
+
+    // -------------------------------------------------------------------
+    /** @brief Makes a tracker receive the allocations of the calling thread
+     *  until the scope ends, then restores the previous one.
+     *
+     *  The importer opens a scope for each import and post-processing
+     *  run. Worker threads of the library take over the tracker of the
+     *  thread which started them. */
+    class ASSIMP_API Scope {
+    public:
+        explicit Scope(MemoryTracker *tracker);
+        ~Scope();
+
+    private:
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        MemoryTracker *mPrevious;
+    };
+
+    /// @brief  Default constructor
+    MemoryTracker();
+
+    /// @brief  Virtual destructor.
+    virtual ~MemoryTracker();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the tracker of the calling thread, nullptr if none. */
+    static MemoryTracker *GetCurrent();
+
+    // -------------------------------------------------------------------
+    /** @brief Adds an allocation to the tracker of the calling thread.
+     *  Thread-safe, may be called from operator new. */
+    static void CountAllocation(size_t size);
+
+    // -------------------------------------------------------------------
+    /** @brief Adds a deallocation to the tracker of the calling thread.
+     *  Thread-safe, may be called from operator delete. Memory may be freed
+     *  by a different tracker than the one which allocated it, e.g. if the
+     *  application deletes a scene, so freed bytes can exceed the allocated
+     *  ones. */
+    static void CountDeallocation(size_t size);
+
+    // -------------------------------------------------------------------
+    /** @brief Reads the current allocation counters.
+     *
+     *  The importer takes the difference of the counters before and after
+     *  each phase. */
+    virtual void GetAllocationCounters(Counters &counters) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Starts a new peak measurement at the current amount of live
+     *  bytes. Called at the start of each phase. */
+    virtual void ResetPeak();
+
+    // -------------------------------------------------------------------
+    /** @brief Called when #Importer::ReadFile() starts, discards the phases
+     *  of the previous import. */
+    virtual void OnBeginImport();
+
+    // -------------------------------------------------------------------
+    /** @brief Called at the end of each phase, records it. */
+    virtual void OnPhase(const aiMemoryPhaseInfo &phase);
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of recorded phases. */
+    unsigned int GetNumPhases() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns a recorded phase, nullptr if the index is out of range. */
+    const aiMemoryPhaseInfo *GetPhase(unsigned int index) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the largest scene size after any recorded phase. */
+    const aiMemoryInfo &GetPeakSceneSize() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the largest peak of live bytes of any recorded phase. */
+    size_t GetPeakBytes() const;
+
+private:
+    std::vector<aiMemoryPhaseInfo> mPhases;
+    aiMemoryInfo mPeakSceneSize;
+    size_t mPeakBytes;
+
+    std::atomic<size_t> mAllocations;
+    std::atomic<size_t> mAllocatedBytes;
+    std::atomic<size_t> mDeallocations;
+    std::atomic<size_t> mFreedBytes;
+    std::atomic<long long> mLiveBytes;
+    std::atomic<long long> mPeakLiveBytes;
+    std::atomic<long long> mPeakBase;
+}; // !class MemoryTracker
+
+} // Namespace Assimp
+
+#endif // AI_MEMORYTRACKER_H_INC
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Defines.h>
 #include <assimp/Exceptional.h>
 #include <assimp/IOStream.hpp>
+#include <assimp/MappedFile.h>
 
 #include <memory>
 
@@ -67,6 +68,10 @@ namespace Assimp {
  *  compile-time, which should usually be true (#BaseImporter::ConvertToUTF8 implements
  *  runtime endianness conversions for text files).
  *
+ *  Larger files opened through #DefaultIOSystem are not copied into memory, the reader
+ *  works on a private mapping of the file instead. Writing to the buffer returned by
+ *  GetPtr() is fine either way, changes never reach the file.
+ *
  *  XXX switch from unsigned int for size types to size_t? or ptrdiff_t?*/
 // --------------------------------------------------------------------------------------------
 template <bool SwapEndianess = false, bool RuntimeSwitch = false>
@@ -112,7 +117,9 @@ public:
 
     // ---------------------------------------------------------------------
     ~StreamReader() {
-        delete[] mBuffer;
+        if (!mMapping) {
+            delete[] mBuffer;
+        }
     }
 
     // deprecated, use overloaded operator>> instead
@@ -305,11 +312,27 @@ private:
             throw DeadlyImportError("StreamReader: Unable to open file");
         }
 
-        const size_t filesize = mStream->FileSize() - mStream->Tell();
+        const size_t offset = mStream->Tell();
+        const size_t filesize = mStream->FileSize() - offset;
         if (0 == filesize) {
             throw DeadlyImportError("StreamReader: File is empty or EOF is already reached");
         }
 
+        // alias larger files instead of copying them, for small ones a plain read is cheaper
+        const size_t MinMappedSize = 64 * 1024;
+        if (filesize >= MinMappedSize) {
+            mMapping.reset(new MappedFile(mStream.get(), true));
+            if (mMapping->IsValid() && mMapping->GetSize() == offset + filesize) {
+                mCurrent = mBuffer = reinterpret_cast<int8_t *>(mMapping->GetWritableData()) + offset;
+                mEnd = mLimit = mBuffer + filesize;
+
+                // leave the stream where reading the file would have left it
+                mStream->Seek(0, aiOrigin_END);
+                return;
+            }
+            mMapping.reset();
+        }
+
         mCurrent = mBuffer = new int8_t[filesize];
         const size_t read = mStream->Read(mCurrent, 1, filesize);
         // (read < s) can only happen if the stream was opened in text mode, in which case FileSize() is not reliable
@@ -319,6 +342,7 @@ private:
 
 private:
     std::shared_ptr<IOStream> mStream;
+    std::unique_ptr<MappedFile> mMapping;
     int8_t *mBuffer;
     int8_t *mCurrent;
     int8_t *mEnd;
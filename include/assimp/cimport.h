@@ -373,6 +373,29 @@ ASSIMP_API void aiGetMemoryRequirements(
         const C_STRUCT aiScene *pIn,
         C_STRUCT aiMemoryInfo *in);
 
+// --------------------------------------------------------------------------------
+/** Get the number of import phases and post-processing steps for which memory
+ * statistics were recorded. Recording is enabled by the #AI_CONFIG_GLOB_TRACK_MEMORY
+ * import property.
+ * @param pIn Input asset.
+ * @return Number of recorded phases, 0 if memory tracking was not enabled.
+ */
+ASSIMP_API unsigned int aiGetMemoryPhaseCount(
+        const C_STRUCT aiScene *pIn);
+
+// --------------------------------------------------------------------------------
+/** Get the memory statistics of one import phase or post-processing step,
+ * in the order they were executed.
+ * @param pIn Input asset.
+ * @param index Index of the phase, must be less than #aiGetMemoryPhaseCount().
+ * @param info Data structure to be filled.
+ * @return aiReturn_SUCCESS if the phase exists.
+ */
+ASSIMP_API C_ENUM aiReturn aiGetMemoryPhaseInfo(
+        const C_STRUCT aiScene *pIn,
+        unsigned int index,
+        C_STRUCT aiMemoryPhaseInfo *info);
+
 // --------------------------------------------------------------------------------
 /** Create an empty property store. Property stores are used to collect import
  *  settings.
@@ -64,4 +64,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /// Not all formats add this metadata.
 #define AI_METADATA_SOURCE_COPYRIGHT "SourceAsset_Copyright"
 
+/// Scene metadata holding the number of levels of detail generated by the GenLODs step
+/// (#AI_CONFIG_PP_LOD_ENABLE) as int32. Level k (starting at 1) of mesh i is stored in
+/// aiScene::mMeshes[i + k * n], n being the value of #AI_METADATA_LOD_MESH_COUNT.
+#define AI_METADATA_LOD_LEVELS "LOD_Levels"
+
+/// Scene metadata holding the number of meshes in each level of detail as int32.
+#define AI_METADATA_LOD_MESH_COUNT "LOD_MeshCount"
+
+/// Node metadata holding the level of detail of the meshes of the node as int32. The
+/// GenLODs step adds one such child per level to each node with meshes. Applications
+/// show either the meshes of the node or those of one of these children.
+#define AI_METADATA_LOD_LEVEL "LOD_Level"
+
 #endif
@@ -21,8 +21,13 @@
 #   pragma GCC system_header
 #endif
 
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
 #include <stdint.h>
 #include <assimp/defs.h>
 
@@ -256,18 +261,243 @@ int64_t strtol10_64(const char* in, const char** out = 0, unsigned int* max_inou
 }
 
 // Number of relevant decimals for floating-point parsing.
+// Kept for compatibility, fast_atoreal_move is no longer limited by it.
 #define AI_FAST_ATOF_RELAVANT_DECIMALS 15
 
 // ------------------------------------------------------------------------------------
-//! Provides a fast function for converting a string into a float,
-//! about 6 times faster than atof in win32.
-// If you find any bugs, please send them to me, niko (at) irrlicht3d.org.
+// Helpers for fast_atoreal_move
 // ------------------------------------------------------------------------------------
-template<typename Real, typename ExceptionType = DeadlyImportError>
+
+// Powers of ten which are exactly representable as double / float
+const double fast_atoreal_pow10_double[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const float fast_atoreal_pow10_float[11] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+#if LDBL_MANT_DIG == 64 && (defined(__i386__) || defined(__x86_64__))
+const long double fast_atoreal_pow10_long_double[28] = {
+    1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L,
+    1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L,
+    1e26L, 1e27L
+};
+#endif
+
+// ------------------------------------------------------------------------------------
+// Returns whether all eight bytes of a little-endian block are decimal digits
 inline
-const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true) {
-    Real f = 0;
+bool fast_atoreal_is_eight_digits(uint64_t block) {
+    return ((block & 0xF0F0F0F0F0F0F0F0ull) |
+            (((block + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// ------------------------------------------------------------------------------------
+// Converts eight decimal digits of a little-endian block in three multiplications
+inline
+uint32_t fast_atoreal_parse_eight_digits(uint64_t block) {
+    block = (block & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+    block = (block & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+    return static_cast<uint32_t>((block & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32);
+}
+
+// ------------------------------------------------------------------------------------
+// Accumulates a run of digits into a decimal mantissa of at most 19 digits. Digits
+// behind that only adjust the exponent and set truncated if they are not zero.
+// If end is given, blocks of eight digits before end are converted at once.
+inline
+const char* fast_atoreal_digits(const char* c, const char* end, bool fraction,
+        uint64_t& mantissa, unsigned int& digits, int64_t& exponent, bool& truncated) {
+    for ( ;; ) {
+#ifndef AI_BUILD_BIG_ENDIAN
+        if (end && 0 != mantissa && digits + 8 <= 19 && end - c >= 8) {
+            uint64_t block;
+            ::memcpy(&block, c, sizeof(block));
+            if (fast_atoreal_is_eight_digits(block)) {
+                mantissa = mantissa * 100000000 + fast_atoreal_parse_eight_digits(block);
+                digits += 8;
+                if (fraction) {
+                    exponent -= 8;
+                }
+                c += 8;
+                continue;
+            }
+        }
+#endif
+        if ( *c < '0' || *c > '9' ) {
+            break;
+        }
 
+        const unsigned int d = static_cast<unsigned int>(*c - '0');
+        if (0 == mantissa && 0 == d) {
+            // leading zero
+            if (fraction) {
+                --exponent;
+            }
+        } else if (digits < 19) {
+            mantissa = mantissa * 10 + d;
+            ++digits;
+            if (fraction) {
+                --exponent;
+            }
+        } else {
+            if (!fraction) {
+                ++exponent;
+            }
+            truncated |= (0 != d);
+        }
+        ++c;
+    }
+    return c;
+}
+
+// ------------------------------------------------------------------------------------
+// Correctly rounded conversion of a decimal string without decimal point, used if
+// the fast path does not apply. No decimal point means no locale dependency.
+template<typename Real>
+inline
+Real fast_atoreal_slow(const char* s) {
+    return static_cast<Real>(std::strtod(s, nullptr));
+}
+
+template<>
+inline
+float fast_atoreal_slow<float>(const char* s) {
+    return std::strtof(s, nullptr);
+}
+
+// ------------------------------------------------------------------------------------
+// Writes the digits of [intBegin, intEnd) and [fracBegin, fracEnd) followed by 'e' and
+// exponent to buf and converts them with fast_atoreal_slow. Numbers which do not fit
+// into the stack buffer are assembled on the heap.
+template<typename Real>
+inline
+Real fast_atoreal_slow(const char* intBegin, const char* intEnd,
+        const char* fracBegin, const char* fracEnd, int64_t exponent) {
+    char buf[128];
+    const size_t intLen = static_cast<size_t>(intEnd - intBegin);
+    const size_t fracLen = static_cast<size_t>(fracEnd - fracBegin);
+
+    // 'e', sign, at most 20 exponent digits and the terminator
+    if (intLen + fracLen + 23 > sizeof(buf)) {
+        std::string s(intBegin, intEnd);
+        s.append(fracBegin, fracEnd);
+        s += 'e';
+        s += std::to_string(exponent);
+        return fast_atoreal_slow<Real>(s.c_str());
+    }
+
+    char* out = buf;
+    ::memcpy(out, intBegin, intLen);
+    out += intLen;
+    ::memcpy(out, fracBegin, fracLen);
+    out += fracLen;
+    *out++ = 'e';
+
+    uint64_t e = static_cast<uint64_t>(exponent);
+    if (exponent < 0) {
+        *out++ = '-';
+        e = 0 - e;
+    }
+    char digits[20];
+    unsigned int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + e % 10);
+        e /= 10;
+    } while (e);
+    while (n) {
+        *out++ = digits[--n];
+    }
+    *out = '\0';
+    return fast_atoreal_slow<Real>(buf);
+}
+
+// ------------------------------------------------------------------------------------
+// Computes mantissa * 10^exponent. Returns false if the result cannot be computed
+// exactly rounded from double / float arithmetic (Clinger's fast path).
+template<typename Real>
+inline
+bool fast_atoreal_compose(uint64_t mantissa, int64_t exponent, Real& out) {
+    if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+#if LDBL_MANT_DIG == 64 && (defined(__i386__) || defined(__x86_64__))
+        // With x87 extended precision every 64 bit mantissa and 10^27 are exact, so
+        // the result is correctly rounded to 64 bits. Rounding that to double is only
+        // wrong if it lies exactly halfway between two doubles.
+        if (exponent < -27 || exponent > 27) {
+            return false;
+        }
+        long double ld = static_cast<long double>(mantissa);
+        if (exponent < 0) {
+            ld /= fast_atoreal_pow10_long_double[-exponent];
+        } else {
+            ld *= fast_atoreal_pow10_long_double[exponent];
+        }
+        uint64_t bits;
+        ::memcpy(&bits, &ld, sizeof(bits));
+        if ((bits & 0x7FFull) == 0x400ull) {
+            return false;
+        }
+        out = static_cast<Real>(static_cast<double>(ld));
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    double d = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        d /= fast_atoreal_pow10_double[-exponent];
+    } else {
+        d *= fast_atoreal_pow10_double[exponent];
+    }
+    out = static_cast<Real>(d);
+    return true;
+}
+
+template<>
+inline
+bool fast_atoreal_compose<float>(uint64_t mantissa, int64_t exponent, float& out) {
+    if (mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+        float f = static_cast<float>(mantissa);
+        if (exponent < 0) {
+            f /= fast_atoreal_pow10_float[-exponent];
+        } else {
+            f *= fast_atoreal_pow10_float[exponent];
+        }
+        out = f;
+        return true;
+    }
+
+    double d;
+    if (!fast_atoreal_compose<double>(mantissa, exponent, d)) {
+        return false;
+    }
+
+    // d is correctly rounded, rounding it to float again is only wrong if d lies
+    // exactly halfway between two floats. The result is always a normal float here.
+    uint64_t bits;
+    ::memcpy(&bits, &d, sizeof(bits));
+    if ((bits & 0x1FFFFFFFull) == 0x10000000ull) {
+        return false;
+    }
+    out = static_cast<float>(d);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------
+//! Provides a fast function for converting a string into a float.
+//! Results are correctly rounded: most numbers are assembled from an exact decimal
+//! mantissa and exponent in a single floating-point operation (in x87 extended
+//! precision for mantissas above 2^53 where available), numbers with more than 19
+//! significant digits or large exponents fall back to strtod without heap allocation.
+//! If end is not nullptr, digits before end are converted in blocks of eight. The
+//! string must still be terminated by a character which is not part of a number.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+const char* fast_atoreal_move(const char* c, const char* end, Real& out, bool check_comma = true) {
     bool inv = (*c == '-');
     if (inv || *c == '+') {
         ++c;
@@ -299,26 +529,22 @@ const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
                                     "or decimal point followed by digit.");
     }
 
-    if (*c != '.' && (! check_comma || c[0] != ',')) {
-        f = static_cast<Real>( strtoul10_64<ExceptionType> ( c, &c) );
-    }
+    uint64_t mantissa = 0;
+    unsigned int digits = 0;
+    int64_t exponent = 0;
+    bool truncated = false;
+
+    const char* intBegin = c;
+    c = fast_atoreal_digits(c, end, false, mantissa, digits, exponent, truncated);
+    const char* intEnd = c;
 
+    const char* fracBegin = c;
+    const char* fracEnd = c;
     if ((*c == '.' || (check_comma && c[0] == ',')) && c[1] >= '0' && c[1] <= '9') {
         ++c;
-
-        // NOTE: The original implementation is highly inaccurate here. The precision of a single
-        // IEEE 754 float is not high enough, everything behind the 6th digit tends to be more
-        // inaccurate than it would need to be. Casting to double seems to solve the problem.
-        // strtol_64 is used to prevent integer overflow.
-
-        // Another fix: this tends to become 0 for long numbers if we don't limit the maximum
-        // number of digits to be read. AI_FAST_ATOF_RELAVANT_DECIMALS can be a value between
-        // 1 and 15.
-        unsigned int diff = AI_FAST_ATOF_RELAVANT_DECIMALS;
-        double pl = static_cast<double>( strtoul10_64<ExceptionType> ( c, &c, &diff ));
-
-        pl *= fast_atof_table[diff];
-        f += static_cast<Real>( pl );
+        fracBegin = c;
+        c = fast_atoreal_digits(c, end, true, mantissa, digits, exponent, truncated);
+        fracEnd = c;
     }
     // For backwards compatibility: eat trailing dots, but not trailing commas.
     else if (*c == '.') {
@@ -327,6 +553,7 @@ const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
 
     // A major 'E' must be allowed. Necessary for proper reading of some DXF files.
     // Thanks to Zhao Lei to point out that this if() must be outside the if (*c == '.' ..)
+    int64_t exp10 = 0;
     if (*c == 'e' || *c == 'E') {
         ++c;
         const bool einv = (*c=='-');
@@ -334,14 +561,17 @@ const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
             ++c;
         }
 
-        // The reason float constants are used here is that we've seen cases where compilers
-        // would perform such casts on compile-time constants at runtime, which would be
-        // bad considering how frequently fast_atoreal_move<float> is called in Assimp.
-        Real exp = static_cast<Real>( strtoul10_64<ExceptionType>(c, &c) );
+        // clamp, anything beyond over- or underflows anyway
+        exp10 = static_cast<int64_t>(std::min<uint64_t>(strtoul10_64<ExceptionType>(c, &c), 100000));
         if (einv) {
-            exp = -exp;
+            exp10 = -exp10;
         }
-        f *= std::pow(static_cast<Real>(10.0), exp);
+    }
+
+    Real f = 0;
+    if (0 != mantissa && (truncated || !fast_atoreal_compose<Real>(mantissa, exponent + exp10, f))) {
+        f = fast_atoreal_slow<Real>(intBegin, intEnd, fracBegin, fracEnd,
+                exp10 - static_cast<int64_t>(fracEnd - fracBegin));
     }
 
     if (inv) {
@@ -351,6 +581,40 @@ const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
     return c;
 }
 
+// ------------------------------------------------------------------------------------
+// Same for zero-terminated strings without known end
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true) {
+    return fast_atoreal_move<Real, ExceptionType>(c, nullptr, out, check_comma);
+}
+
+// ------------------------------------------------------------------------------------
+// Parses up to n reals separated by spaces or tabs. Parsing stops early at a line end
+// or at end. Returns the position behind the last parsed value and stores the number
+// of parsed values in numParsed if given.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+const char* fast_atoreal_move_n(const char* c, const char* end, Real* out, unsigned int n,
+        unsigned int* numParsed = nullptr, bool check_comma = true) {
+    unsigned int i = 0;
+    for (; i < n; ++i) {
+        while (*c == ' ' || *c == '\t') {
+            ++c;
+        }
+        if ((end && c >= end) || *c == '\0' || *c == '\r' || *c == '\n' || *c == '\f') {
+            break;
+        }
+        c = fast_atoreal_move<Real, ExceptionType>(c, end, out[i], check_comma);
+    }
+
+    if (numParsed) {
+        *numParsed = i;
+    }
+    return c;
+}
+
 // ------------------------------------------------------------------------------------
 // The same but more human.
 template<typename ExceptionType = DeadlyImportError>
@@ -139,6 +139,7 @@ struct aiFace {
     unsigned int mNumIndices;
 
     //! Pointer to the indices array. Size of the array is given in numIndices.
+    //! Points into aiMesh::mIndices if the mesh stores all indices in one buffer.
     unsigned int *mIndices;
 
 #ifdef __cplusplus
@@ -301,6 +302,10 @@ struct aiBone {
     aiBone() AI_NO_EXCEPT
             : mName(),
               mNumWeights(0),
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+              mArmature(nullptr),
+              mNode(nullptr),
+#endif
               mWeights(nullptr),
               mOffsetMatrix() {
         // empty
@@ -310,6 +315,10 @@ struct aiBone {
     aiBone(const aiBone &other) :
             mName(other.mName),
             mNumWeights(other.mNumWeights),
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+            mArmature(other.mArmature),
+            mNode(other.mNode),
+#endif
             mWeights(nullptr),
             mOffsetMatrix(other.mOffsetMatrix) {
         if (other.mWeights && other.mNumWeights) {
@@ -327,6 +336,10 @@ struct aiBone {
         mName = other.mName;
         mNumWeights = other.mNumWeights;
         mOffsetMatrix = other.mOffsetMatrix;
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+        mArmature = other.mArmature;
+        mNode = other.mNode;
+#endif
 
         if (other.mWeights && other.mNumWeights) {
             if (mWeights) {
@@ -571,6 +584,67 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A small cluster of connected triangles of a mesh.
+ *
+ *  Meshlets are the unit of work of mesh shader pipelines. Their vertices
+ *  are given by mVertexCount entries of aiMesh::mMeshletVertices starting at
+ *  mVertexOffset, each of them an index into the vertex arrays of the mesh.
+ *  Their triangles are given by 3 * mTriangleCount entries of
+ *  aiMesh::mMeshletIndices starting at mIndexOffset, each of them an index
+ *  into the vertices of the meshlet.
+ *
+ *  The bounding sphere and the normal cone allow culling whole meshlets.
+ *  All triangles of a meshlet face away from a camera at position p if
+ *  dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff.
+ */
+struct aiMeshlet {
+    //! Offset of the first vertex in aiMesh::mMeshletVertices
+    unsigned int mVertexOffset;
+
+    //! Number of vertices of the meshlet
+    unsigned int mVertexCount;
+
+    //! Offset of the first index in aiMesh::mMeshletIndices
+    unsigned int mIndexOffset;
+
+    //! Number of triangles of the meshlet
+    unsigned int mTriangleCount;
+
+    //! Center of the bounding sphere
+    C_STRUCT aiVector3D mCenter;
+
+    //! Radius of the bounding sphere
+    ai_real mRadius;
+
+    //! Apex of the normal cone
+    C_STRUCT aiVector3D mConeApex;
+
+    //! Axis of the normal cone, normalized
+    C_STRUCT aiVector3D mConeAxis;
+
+    //! Cosine of the culling angle, 1 if the meshlet can't be culled
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    //! Default constructor
+    aiMeshlet() AI_NO_EXCEPT
+            : mVertexOffset(0),
+              mVertexCount(0),
+              mIndexOffset(0),
+              mTriangleCount(0),
+              mCenter(),
+              mRadius(0),
+              mConeApex(),
+              mConeAxis(),
+              mConeCutoff(1) {
+        // empty
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -741,6 +815,46 @@ struct aiMesh {
      */
     C_STRUCT aiAABB mAABB;
 
+    /** Contiguous storage of the indices of all faces, in face order.
+     * This is nullptr unless the indices were compacted, see
+     * #AI_CONFIG_IMPORT_CONTIGUOUS_INDICES. If set, the mIndices of
+     * each face point into this buffer and are not owned by the face,
+     * the offset of a face in the buffer is given by the difference of
+     * both pointers. For triangulated meshes, this is a ready-to-use
+     * index buffer with 3 * mNumFaces entries.
+     */
+    unsigned int *mIndices;
+
+    /** The number of indices in mIndices.
+     */
+    unsigned int mNumIndices;
+
+    /** The meshlets of the mesh, see #AI_CONFIG_PP_ML_ENABLE.
+     * This is nullptr unless meshlets were generated.
+     */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /** The number of meshlets in mMeshlets.
+     */
+    unsigned int mNumMeshlets;
+
+    /** The vertices of all meshlets, as indices into the vertex arrays.
+     */
+    unsigned int *mMeshletVertices;
+
+    /** The number of indices in mMeshletVertices.
+     */
+    unsigned int mNumMeshletVertices;
+
+    /** The triangles of all meshlets, three indices per triangle. Each
+     * index refers to the vertices of its meshlet in mMeshletVertices.
+     */
+    unsigned char *mMeshletIndices;
+
+    /** The number of indices in mMeshletIndices.
+     */
+    unsigned int mNumMeshletIndices;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -762,7 +876,15 @@ struct aiMesh {
               mNumAnimMeshes(0),
               mAnimMeshes(nullptr),
               mMethod(0),
-              mAABB() {
+              mAABB(),
+              mIndices(nullptr),
+              mNumIndices(0),
+              mMeshlets(nullptr),
+              mNumMeshlets(0),
+              mMeshletVertices(nullptr),
+              mNumMeshletVertices(0),
+              mMeshletIndices(nullptr),
+              mNumMeshletIndices(0) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -803,7 +925,18 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
+        // faces don't own their indices if they are stored in the index buffer
+        if (mIndices && mFaces) {
+            for (unsigned int a = 0; a < mNumFaces; a++) {
+                mFaces[a].mIndices = nullptr;
+            }
+        }
         delete[] mFaces;
+        delete[] mIndices;
+
+        delete[] mMeshlets;
+        delete[] mMeshletVertices;
+        delete[] mMeshletIndices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -867,6 +1000,95 @@ struct aiMesh {
         return mBones != nullptr && mNumBones > 0;
     }
 
+    //! Check whether the indices of all faces are stored in mIndices
+    bool HasIndexBuffer() const {
+        return mIndices != nullptr;
+    }
+
+    //! Check whether meshlets were generated for the mesh
+    bool HasMeshlets() const {
+        return mMeshlets != nullptr && mNumMeshlets > 0;
+    }
+
+    //! Moves the indices of all faces to a single buffer, mIndices.
+    //! The faces point into the buffer, so they can be read as before,
+    //! but their indices must not be reallocated or deleted anymore.
+    void CompactIndices() {
+        if (mIndices || !mFaces) {
+            return;
+        }
+
+        unsigned int numIndices = 0;
+        for (unsigned int a = 0; a < mNumFaces; a++) {
+            numIndices += mFaces[a].mNumIndices;
+        }
+
+        mIndices = new unsigned int[numIndices];
+        mNumIndices = numIndices;
+        unsigned int *cursor = mIndices;
+        for (unsigned int a = 0; a < mNumFaces; a++) {
+            aiFace &face = mFaces[a];
+            if (face.mNumIndices) {
+                ::memcpy(cursor, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+            }
+            delete[] face.mIndices;
+            face.mIndices = face.mNumIndices ? cursor : nullptr;
+            cursor += face.mNumIndices;
+        }
+    }
+
+    //! Gives each face its own index array again and releases mIndices.
+    //! This is required before faces can be modified the usual way.
+    void ExpandIndices() {
+        if (!mIndices) {
+            return;
+        }
+
+        for (unsigned int a = 0; a < mNumFaces; a++) {
+            aiFace &face = mFaces[a];
+            if (face.mNumIndices) {
+                unsigned int *indices = new unsigned int[face.mNumIndices];
+                ::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+                face.mIndices = indices;
+            }
+        }
+        delete[] mIndices;
+        mIndices = nullptr;
+        mNumIndices = 0;
+    }
+
+    //! Allocates the index arrays of all faces, mNumIndices must be set
+    //! for each face already. If contiguous is true, all indices go to
+    //! one buffer, as if CompactIndices() had been called afterwards.
+    void AllocateFaceIndices(bool contiguous) {
+        if (!mFaces) {
+            return;
+        }
+
+        if (!contiguous) {
+            for (unsigned int a = 0; a < mNumFaces; a++) {
+                aiFace &face = mFaces[a];
+                face.mIndices = face.mNumIndices ? new unsigned int[face.mNumIndices] : nullptr;
+            }
+            return;
+        }
+
+        unsigned int numIndices = 0;
+        for (unsigned int a = 0; a < mNumFaces; a++) {
+            numIndices += mFaces[a].mNumIndices;
+        }
+
+        delete[] mIndices;
+        mIndices = new unsigned int[numIndices];
+        mNumIndices = numIndices;
+        unsigned int *cursor = mIndices;
+        for (unsigned int a = 0; a < mNumFaces; a++) {
+            aiFace &face = mFaces[a];
+            face.mIndices = face.mNumIndices ? cursor : nullptr;
+            cursor += face.mNumIndices;
+        }
+    }
+
 #endif // __cplusplus
 };
 
@@ -308,6 +308,9 @@ enum aiPostProcessSteps
      * content pipeline (probably using *magic* material names), don't
      * specify this flag. Alternatively take a look at the
      * <tt>#AI_CONFIG_PP_RRM_EXCLUDE_LIST</tt> importer property.
+     *
+     * Set <tt>#AI_CONFIG_PP_RRM_TEXTURES</tt> to remove duplicate embedded
+     * textures and to unify equivalent texture paths as well.
      */
     aiProcess_RemoveRedundantMaterials = 0x1000,
 
@@ -577,6 +580,10 @@ enum aiPostProcessSteps
      *  (due, for instance, to an absolute path generated on another system),
      *  it will check if a file with the same name exists at the root folder
      *  of the imported model. And if so, it uses that.
+     *
+     *  Identical images are embedded once. Use #AI_CONFIG_PP_ET_DECODE and
+     *  #AI_CONFIG_PP_ET_MAX_SIZE to decode and downscale all compressed
+     *  textures of the scene.
      */
     aiProcess_EmbedTextures  = 0x10000000,
         
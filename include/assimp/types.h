@@ -523,6 +523,56 @@ struct aiMemoryInfo {
     unsigned int total;
 }; // !struct aiMemoryInfo
 
+// ----------------------------------------------------------------------------------
+/** Stores the allocations of one import phase or post-processing step and the
+ *  size of the scene after it.
+ *  @see Assimp::MemoryTracker
+ *  @see aiGetMemoryPhaseInfo()
+*/
+struct aiMemoryPhaseInfo {
+#ifdef __cplusplus
+
+    /** Default constructor */
+    aiMemoryPhaseInfo() AI_NO_EXCEPT
+            : name(),
+              step(0),
+              allocations(0),
+              allocatedBytes(0),
+              deallocations(0),
+              freedBytes(0),
+              peakBytes(0),
+              scene() {}
+
+#endif
+
+    /** "detect", "cache", "parse", "convert" or the class name of the
+     *  post-processing step, e.g. "JoinVerticesProcess" */
+    C_STRUCT aiString name;
+
+    /** The #aiPostProcessSteps flag which activated the step, 0 for the
+     *  import phases and customized post-processing */
+    unsigned int step;
+
+    /** Number of allocations during the phase */
+    size_t allocations;
+
+    /** Bytes allocated during the phase */
+    size_t allocatedBytes;
+
+    /** Number of deallocations during the phase */
+    size_t deallocations;
+
+    /** Bytes freed during the phase, including memory allocated before it */
+    size_t freedBytes;
+
+    /** Highest amount of live memory during the phase, in bytes above the
+     *  amount at its start. Includes temporary data freed before its end. */
+    size_t peakBytes;
+
+    /** Storage of the scene after the phase */
+    C_STRUCT aiMemoryInfo scene;
+}; // !struct aiMemoryPhaseInfo
+
 #ifdef __cplusplus
 }
 #endif //!  __cplusplus
@@ -0,0 +1,255 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Bench.cpp
+ *  @brief Allocation counting, memory statistics and JSON output for assimp_bench
+ */
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> gNumAllocations(0);
+std::atomic<uint64_t> gAllocatedBytes(0);
+
+// ------------------------------------------------------------------------------------------------
+void *CountedAlloc(size_t size) {
+    gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Replacements of the global allocation functions, used to count allocations
+void *operator new(size_t size) {
+    for (;;) {
+        void *p = CountedAlloc(size);
+        if (nullptr != p) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (nullptr == handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return CountedAlloc(size);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+namespace Assimp {
+namespace Bench {
+
+// ------------------------------------------------------------------------------------------------
+uint64_t GetNumAllocations() {
+    return gNumAllocations.load(std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t GetAllocatedBytes() {
+    return gAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t GetPeakRss() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize) / 1024;
+#else
+    struct rusage usage;
+    if (0 != getrusage(RUSAGE_SELF, &usage)) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    // reported in bytes on macOS, in kB everywhere else
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void ResetPeakRss() {
+#if defined(__linux__)
+    // writing 5 to clear_refs resets the peak RSS (ru_maxrss is not affected before Linux 4.0)
+    FILE *file = ::fopen("/proc/self/clear_refs", "w");
+    if (nullptr != file) {
+        ::fputs("5", file);
+        ::fclose(file);
+    }
+#endif
+}
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+void WriteString(std::ostream &out, const std::string &str) {
+    out << '"';
+    for (const char c : str) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                ::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+                out << buffer;
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteResult(std::ostream &out, const Result &result) {
+    out << "    {\"name\": ";
+    WriteString(out, result.mName);
+    out << ", \"input\": ";
+    WriteString(out, result.mInput);
+    out << ", \"status\": " << (result.mSuccess ? "\"ok\"" : "\"failed\"");
+    if (result.mSuccess) {
+        const double seconds = result.mBestMs / 1000.0;
+        out << ", \"iterations\": " << result.mIterations
+            << ", \"best_ms\": " << result.mBestMs
+            << ", \"mean_ms\": " << result.mMeanMs
+            << ", \"bytes\": " << result.mBytes
+            << ", \"vertices\": " << result.mVertices
+            << ", \"faces\": " << result.mFaces;
+        if (seconds > 0.0) {
+            out << ", \"mb_per_s\": " << result.mBytes / (1024.0 * 1024.0) / seconds
+                << ", \"vertices_per_s\": " << result.mVertices / seconds;
+        }
+        out << ", \"allocations\": " << result.mAllocations
+            << ", \"allocated_bytes\": " << result.mAllocatedBytes
+            << ", \"peak_rss_kb\": " << result.mPeakRss;
+    }
+    out << "}";
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void WriteJson(std::ostream &out, const RunInfo &info, const std::vector<ResultGroup> &groups) {
+    out << "{\n  \"info\": {";
+    for (size_t i = 0; i < info.size(); ++i) {
+        out << (i ? ",\n    " : "\n    ");
+        WriteString(out, info[i].mKey);
+        out << ": ";
+        if (info[i].mNumeric) {
+            out << info[i].mValue;
+        } else {
+            WriteString(out, info[i].mValue);
+        }
+    }
+    out << "\n  }";
+
+    for (const ResultGroup &group : groups) {
+        out << ",\n  ";
+        WriteString(out, group.mName);
+        out << ": [";
+        for (size_t i = 0; i < group.mResults.size(); ++i) {
+            out << (i ? ",\n" : "\n");
+            WriteResult(out, group.mResults[i]);
+        }
+        out << (group.mResults.empty() ? "]" : "\n  ]");
+    }
+    out << "\n}\n";
+}
+
+} // namespace Bench
+} // namespace Assimp
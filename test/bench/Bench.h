@@ -0,0 +1,157 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Bench.h
+ *  @brief Measurement helpers shared by the assimp_bench benchmarks
+ */
+#pragma once
+#ifndef AI_BENCH_BENCH_H_INC
+#define AI_BENCH_BENCH_H_INC
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+namespace Bench {
+
+// ------------------------------------------------------------------------------------------------
+/** Number of operator new calls and requested bytes since program start.
+ *
+ *  The bench replaces the global allocation functions to count them. Platforms which resolve
+ *  operator new per module (Windows DLLs) only see the allocations of the bench itself unless
+ *  assimp is linked statically. */
+uint64_t GetNumAllocations();
+uint64_t GetAllocatedBytes();
+
+/** Peak resident set size of the process, in kB. */
+uint64_t GetPeakRss();
+
+/** Resets the peak resident set size where the platform supports it (Linux), so the next
+ *  GetPeakRss() call reports the peak of a single benchmark. */
+void ResetPeakRss();
+
+// ------------------------------------------------------------------------------------------------
+/** Result of a single benchmark. */
+struct Result {
+    std::string mName;          ///< Importer, exporter or step name
+    std::string mInput;         ///< File name or description of the generated input
+    bool mSuccess = false;
+    uint64_t mBytes = 0;        ///< Bytes read or written per iteration, 0 if not applicable
+    uint64_t mVertices = 0;     ///< Vertices processed per iteration
+    uint64_t mFaces = 0;        ///< Faces processed per iteration
+    unsigned int mIterations = 0;
+    double mBestMs = 0.0;
+    double mMeanMs = 0.0;
+    uint64_t mAllocations = 0;  ///< Allocations of the last iteration
+    uint64_t mAllocatedBytes = 0;
+    uint64_t mPeakRss = 0;      ///< kB
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Times `iterations` runs of body. setup runs before each iteration and is not measured.
+ *  Both return false on failure, which marks the result as failed. */
+template <typename Setup, typename Body>
+bool Measure(unsigned int iterations, Result &result, Setup setup, Body body) {
+    typedef std::chrono::steady_clock Clock;
+
+    result.mSuccess = false;
+    result.mIterations = 0;
+    result.mBestMs = std::numeric_limits<double>::max();
+    result.mMeanMs = 0.0;
+
+    ResetPeakRss();
+    double total = 0.0;
+    for (unsigned int i = 0; i < iterations; ++i) {
+        if (!setup()) {
+            return false;
+        }
+
+        const uint64_t allocations = GetNumAllocations();
+        const uint64_t bytes = GetAllocatedBytes();
+        const Clock::time_point start = Clock::now();
+        const bool ok = body();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (!ok) {
+            return false;
+        }
+
+        result.mAllocations = GetNumAllocations() - allocations;
+        result.mAllocatedBytes = GetAllocatedBytes() - bytes;
+        result.mBestMs = ms < result.mBestMs ? ms : result.mBestMs;
+        total += ms;
+        ++result.mIterations;
+    }
+    result.mMeanMs = result.mIterations ? total / result.mIterations : 0.0;
+    result.mPeakRss = GetPeakRss();
+    result.mSuccess = result.mIterations > 0;
+    return result.mSuccess;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** A group of results, written as one JSON array. */
+struct ResultGroup {
+    std::string mName;
+    std::vector<Result> mResults;
+};
+
+/** A key/value pair describing the run. */
+struct RunInfoEntry {
+    std::string mKey;
+    std::string mValue;
+    bool mNumeric;  ///< Written without quotes
+};
+
+typedef std::vector<RunInfoEntry> RunInfo;
+
+/** Writes the run info and all result groups as a single JSON document. Throughput fields are
+ *  derived from the best iteration. */
+void WriteJson(std::ostream &out, const RunInfo &info, const std::vector<ResultGroup> &groups);
+
+} // namespace Bench
+} // namespace Assimp
+
+#endif // AI_BENCH_BENCH_H_INC
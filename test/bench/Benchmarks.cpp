@@ -0,0 +1,465 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Benchmarks.cpp
+ *  @brief Importer, exporter and post-processing benchmarks of assimp_bench
+ */
+#include "Benchmarks.h"
+
+#include "Common/TextStreamWriter.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/importerdesc.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Post-processing steps and the steps their input is prepared with. Steps which expect
+ *  unindexed (verbose) vertices run on the raw import. */
+struct StepInfo {
+    const char *mName;
+    unsigned int mFlags;
+    unsigned int mInputFlags;
+};
+
+const StepInfo Steps[] = {
+    { "CalcTangentSpace", aiProcess_CalcTangentSpace, aiProcess_JoinIdenticalVertices },
+    { "JoinIdenticalVertices", aiProcess_JoinIdenticalVertices, 0 },
+    { "MakeLeftHanded", aiProcess_MakeLeftHanded, aiProcess_JoinIdenticalVertices },
+    { "Triangulate", aiProcess_Triangulate, aiProcess_JoinIdenticalVertices },
+    { "RemoveComponent", aiProcess_RemoveComponent, aiProcess_JoinIdenticalVertices },
+    { "GenNormals", aiProcess_GenNormals | aiProcess_DropNormals, 0 },
+    { "GenSmoothNormals", aiProcess_GenSmoothNormals | aiProcess_DropNormals, 0 },
+    { "SplitLargeMeshes", aiProcess_SplitLargeMeshes, aiProcess_JoinIdenticalVertices },
+    { "PreTransformVertices", aiProcess_PreTransformVertices, aiProcess_JoinIdenticalVertices },
+    { "LimitBoneWeights", aiProcess_LimitBoneWeights, aiProcess_JoinIdenticalVertices },
+    { "ValidateDataStructure", aiProcess_ValidateDataStructure, aiProcess_JoinIdenticalVertices },
+    { "ImproveCacheLocality", aiProcess_ImproveCacheLocality, aiProcess_JoinIdenticalVertices },
+    { "RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials, aiProcess_JoinIdenticalVertices },
+    { "FixInfacingNormals", aiProcess_FixInfacingNormals, aiProcess_JoinIdenticalVertices },
+    { "PopulateArmatureData", aiProcess_PopulateArmatureData, aiProcess_JoinIdenticalVertices },
+    { "SortByPType", aiProcess_SortByPType, aiProcess_JoinIdenticalVertices },
+    { "FindDegenerates", aiProcess_FindDegenerates, aiProcess_JoinIdenticalVertices },
+    { "FindInvalidData", aiProcess_FindInvalidData, aiProcess_JoinIdenticalVertices },
+    { "GenUVCoords", aiProcess_GenUVCoords, 0 },
+    { "TransformUVCoords", aiProcess_TransformUVCoords, aiProcess_JoinIdenticalVertices },
+    { "FindInstances", aiProcess_FindInstances, aiProcess_JoinIdenticalVertices },
+    { "OptimizeMeshes", aiProcess_OptimizeMeshes, aiProcess_JoinIdenticalVertices },
+    { "OptimizeGraph", aiProcess_OptimizeGraph, aiProcess_JoinIdenticalVertices },
+    { "FlipUVs", aiProcess_FlipUVs, aiProcess_JoinIdenticalVertices },
+    { "FlipWindingOrder", aiProcess_FlipWindingOrder, aiProcess_JoinIdenticalVertices },
+    { "SplitByBoneCount", aiProcess_SplitByBoneCount, aiProcess_JoinIdenticalVertices },
+    { "Debone", aiProcess_Debone, aiProcess_JoinIdenticalVertices },
+    { "GlobalScale", aiProcess_GlobalScale, aiProcess_JoinIdenticalVertices },
+    { "EmbedTextures", aiProcess_EmbedTextures, aiProcess_JoinIdenticalVertices },
+    { "GenBoundingBoxes", aiProcess_GenBoundingBoxes, aiProcess_JoinIdenticalVertices },
+};
+
+// ------------------------------------------------------------------------------------------------
+// Files to ignore (with reason)
+//
+// LWO/LWO2/UglyVertexColors.lwo, M3D/cube_usemtl.m3d - crash the importer when the scene is
+// released.
+// ------------------------------------------------------------------------------------------------
+const char *FilesToIgnore[] = {
+    "LWO/LWO2/UglyVertexColors.lwo",
+    "M3D/cube_usemtl.m3d"
+};
+
+// ------------------------------------------------------------------------------------------------
+bool IsExcluded(const Options &options, const std::string &file) {
+    for (const std::string &exclude : options.mExcludes) {
+        if (std::string::npos != file.find(exclude)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Matches(const Options &options, const std::string &name, const std::string &input) {
+    return options.mFilter.empty() ||
+           std::string::npos != name.find(options.mFilter) ||
+           std::string::npos != input.find(options.mFilter);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CountGeometry(const aiScene *scene, Result &result) {
+    result.mVertices = 0;
+    result.mFaces = 0;
+    if (nullptr == scene) {
+        return;
+    }
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        result.mVertices += scene->mMeshes[i]->mNumVertices;
+        result.mFaces += scene->mMeshes[i]->mNumFaces;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Report(const char *group, const Result &result) {
+    if (result.mSuccess) {
+        ::fprintf(stderr, "%-12s %-40s %-48s %10.3f ms\n", group, result.mName.c_str(), result.mInput.c_str(), result.mBestMs);
+    } else {
+        ::fprintf(stderr, "%-12s %-40s %-48s     failed\n", group, result.mName.c_str(), result.mInput.c_str());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ListFiles(const std::string &dir, const std::string &prefix, std::vector<std::string> &files) {
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE handle = ::FindFirstFileA((dir + "\\*").c_str(), &data);
+    if (INVALID_HANDLE_VALUE == handle) {
+        return;
+    }
+    do {
+        const std::string name = data.cFileName;
+        if (name.empty() || name[0] == '.') {
+            continue;
+        }
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            ListFiles(dir + "\\" + name, prefix + name + "/", files);
+        } else {
+            files.push_back(prefix + name);
+        }
+    } while (::FindNextFileA(handle, &data));
+    ::FindClose(handle);
+#else
+    DIR *handle = ::opendir(dir.c_str());
+    if (nullptr == handle) {
+        return;
+    }
+    while (const dirent *entry = ::readdir(handle)) {
+        const std::string name = entry->d_name;
+        if (name.empty() || name[0] == '.') {
+            continue;
+        }
+        struct stat info;
+        const std::string path = dir + "/" + name;
+        if (0 != ::stat(path.c_str(), &info)) {
+            continue;
+        }
+        if (S_ISDIR(info.st_mode)) {
+            ListFiles(path, prefix + name + "/", files);
+        } else if (S_ISREG(info.st_mode)) {
+            files.push_back(prefix + name);
+        }
+    }
+    ::closedir(handle);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t GetFileSize(const std::string &path) {
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    return file ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BenchmarkMemoryImport(const Options &options, const std::string &data, const std::string &format,
+        const std::string &input, std::vector<Result> &results) {
+    Importer importer;
+    const aiImporterDesc *desc = importer.GetImporterInfo(importer.GetImporterIndex(format.c_str()));
+    Result result;
+    result.mName = nullptr != desc ? desc->mName : format;
+    result.mInput = input;
+    if (!Matches(options, result.mName, result.mInput)) {
+        return;
+    }
+
+    result.mBytes = data.size();
+    Measure(options.mIterations, result,
+            [&importer]() {
+                importer.FreeScene();
+                return true;
+            },
+            [&importer, &data, &format]() {
+                return nullptr != importer.ReadFileFromMemory(data.data(), data.size(), 0, format.c_str());
+            });
+    CountGeometry(importer.GetScene(), result);
+    Report("importer", result);
+    results.push_back(result);
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+// ------------------------------------------------------------------------------------------------
+/** Counts and drops everything written to it, so only the formatting is timed. */
+class NullIOStream : public IOStream {
+public:
+    size_t Read(void *, size_t, size_t) override { return 0; }
+    size_t Write(const void *, size_t size, size_t count) override {
+        mSize += size * count;
+        return count;
+    }
+    aiReturn Seek(size_t, aiOrigin) override { return aiReturn_FAILURE; }
+    size_t Tell() const override { return mSize; }
+    size_t FileSize() const override { return mSize; }
+    void Flush() override {}
+
+    size_t mSize = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Writes the positions, normals and texture coordinates of the scene as text, once with the
+ *  TextStreamWriter the text exporters use and once with a std::ostringstream at
+ *  ASSIMP_AI_REAL_TEXT_PRECISION, as the exporters did before. */
+void BenchmarkRealFormatting(const Options &options, const aiScene *scene, std::vector<Result> &results) {
+    std::vector<ai_real> reals;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            reals.insert(reals.end(), { mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z });
+            if (mesh->HasNormals()) {
+                reals.insert(reals.end(), { mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z });
+            }
+            if (mesh->HasTextureCoords(0)) {
+                reals.insert(reals.end(), { mesh->mTextureCoords[0][v].x, mesh->mTextureCoords[0][v].y });
+            }
+        }
+    }
+
+    Result writerResult;
+    writerResult.mName = "TextStreamWriter";
+    writerResult.mInput = "generated.reals";
+    if (Matches(options, writerResult.mName, writerResult.mInput)) {
+        NullIOStream stream;
+        Measure(options.mIterations, writerResult,
+                [&stream]() {
+                    stream.mSize = 0;
+                    return true;
+                },
+                [&stream, &reals]() {
+                    TextStreamWriter writer(&stream);
+                    for (ai_real value : reals) {
+                        writer << value << '\n';
+                    }
+                    writer.Flush();
+                    return writer.IsGood();
+                });
+        CountGeometry(scene, writerResult);
+        writerResult.mBytes = stream.mSize;
+        Report("exporter", writerResult);
+        results.push_back(writerResult);
+    }
+
+    Result streamResult;
+    streamResult.mName = "std::ostringstream";
+    streamResult.mInput = "generated.reals";
+    if (Matches(options, streamResult.mName, streamResult.mInput)) {
+        size_t size = 0;
+        Measure(options.mIterations, streamResult,
+                []() {
+                    return true;
+                },
+                [&size, &reals]() {
+                    std::ostringstream out;
+                    out.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
+                    for (ai_real value : reals) {
+                        out << value << '\n';
+                    }
+                    size = out.str().size();
+                    return true;
+                });
+        CountGeometry(scene, streamResult);
+        streamResult.mBytes = size;
+        Report("exporter", streamResult);
+        results.push_back(streamResult);
+    }
+}
+#endif // ASSIMP_BUILD_NO_EXPORT
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+std::vector<std::string> GetDefaultExcludes() {
+    return std::vector<std::string>(std::begin(FilesToIgnore), std::end(FilesToIgnore));
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunImporterBenchmarks(const Options &options, const std::string &generated, std::vector<Result> &results) {
+    BenchmarkMemoryImport(options, generated, "obj", "generated.obj", results);
+    if (options.mModelsDir.empty()) {
+        return;
+    }
+
+    std::vector<std::string> files;
+    ListFiles(options.mModelsDir, std::string(), files);
+    std::sort(files.begin(), files.end());
+
+    const Importer registry;
+    for (const std::string &file : files) {
+        const std::string::size_type dot = file.find_last_of('.');
+        if (std::string::npos == dot || !registry.IsExtensionSupported(file.substr(dot)) || IsExcluded(options, file)) {
+            continue;
+        }
+
+        Result result;
+        const aiImporterDesc *desc = registry.GetImporterInfo(registry.GetImporterIndex(file.substr(dot).c_str()));
+        result.mName = nullptr != desc ? desc->mName : file.substr(dot + 1);
+        result.mInput = file;
+        if (!Matches(options, result.mName, result.mInput)) {
+            continue;
+        }
+
+        // a fresh importer per file keeps state left behind by one loader out of the next run
+        Importer importer;
+        const std::string path = options.mModelsDir + "/" + file;
+        result.mBytes = GetFileSize(path);
+        Measure(options.mIterations, result,
+                [&importer]() {
+                    importer.FreeScene();
+                    return true;
+                },
+                [&importer, &path]() {
+                    return nullptr != importer.ReadFile(path, 0);
+                });
+        CountGeometry(importer.GetScene(), result);
+        Report("importer", result);
+        results.push_back(result);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunExporterBenchmarks(const Options &options, const std::string &generated,
+        std::vector<Result> &results, std::vector<Result> &importerResults) {
+#ifndef ASSIMP_BUILD_NO_EXPORT
+    Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(generated.data(), generated.size(),
+            aiProcess_JoinIdenticalVertices, "obj");
+    if (nullptr == scene) {
+        return;
+    }
+
+    Exporter exporter;
+    for (size_t i = 0; i < exporter.GetExportFormatCount(); ++i) {
+        const aiExportFormatDesc *desc = exporter.GetExportFormatDescription(i);
+        Result result;
+        result.mName = desc->id;
+        result.mInput = "generated";
+        if (!Matches(options, result.mName, result.mInput)) {
+            continue;
+        }
+
+        const std::string id = desc->id;
+        Measure(options.mIterations, result,
+                [&exporter]() {
+                    exporter.FreeBlob();
+                    return true;
+                },
+                [&exporter, scene, &id]() {
+                    return nullptr != exporter.ExportToBlob(scene, id);
+                });
+        CountGeometry(scene, result);
+        const aiExportDataBlob *blob = exporter.GetBlob();
+        for (const aiExportDataBlob *it = blob; nullptr != it; it = it->next) {
+            result.mBytes += it->size;
+        }
+        Report("exporter", result);
+        results.push_back(result);
+
+        // read the main file back, formats which need the secondary blobs will simply fail
+        const std::string format = desc->fileExtension;
+        if (result.mSuccess && nullptr != blob && importer.IsExtensionSupported("." + format)) {
+            const std::string data(static_cast<const char *>(blob->data), blob->size);
+            BenchmarkMemoryImport(options, data, format, "generated." + id, importerResults);
+        }
+    }
+
+    BenchmarkRealFormatting(options, scene, results);
+#else
+    (void)options;
+    (void)generated;
+    (void)results;
+    (void)importerResults;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunPostProcessBenchmarks(const Options &options, const std::string &generated, std::vector<Result> &results) {
+    for (const StepInfo &step : Steps) {
+        Result result;
+        result.mName = step.mName;
+        result.mInput = "generated";
+        if (!Matches(options, result.mName, result.mInput)) {
+            continue;
+        }
+
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, aiComponent_NORMALS);
+        Measure(options.mIterations, result,
+                [&importer, &generated, &step, &result]() {
+                    CountGeometry(importer.ReadFileFromMemory(generated.data(), generated.size(), step.mInputFlags, "obj"), result);
+                    return nullptr != importer.GetScene();
+                },
+                [&importer, &step]() {
+                    return nullptr != importer.ApplyPostProcessing(step.mFlags);
+                });
+        Report("postprocess", result);
+        results.push_back(result);
+    }
+}
+
+} // namespace Bench
+} // namespace Assimp
@@ -0,0 +1,87 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Benchmarks.h
+ *  @brief Importer, exporter and post-processing benchmarks of assimp_bench
+ */
+#pragma once
+#ifndef AI_BENCH_BENCHMARKS_H_INC
+#define AI_BENCH_BENCHMARKS_H_INC
+
+#include "Bench.h"
+
+namespace Assimp {
+namespace Bench {
+
+// ------------------------------------------------------------------------------------------------
+/** Settings shared by all benchmarks. */
+struct Options {
+    unsigned int mGridSize = 128;   ///< Quads per row of each generated mesh
+    unsigned int mNumMeshes = 4;    ///< Meshes in the generated scene
+    unsigned int mIterations = 3;
+    std::string mModelsDir;         ///< Directory scanned for importer inputs, empty to skip
+    std::string mFilter;            ///< Only run benchmarks whose name or input contains this
+    std::vector<std::string> mExcludes; ///< Skip model files whose path contains one of these
+};
+
+/** Model files which are excluded by default, see Benchmarks.cpp for the reasons. */
+std::vector<std::string> GetDefaultExcludes();
+
+/** Times the OBJ import of the generated scene and the import of every supported file in the
+ *  models directory. */
+void RunImporterBenchmarks(const Options &options, const std::string &generated, std::vector<Result> &results);
+
+/** Times every exporter on the generated scene and the import of each exported blob, if an
+ *  importer for the format exists. The latter are appended to importerResults. Also times
+ *  the number formatting of the text exporters against std::ostringstream. */
+void RunExporterBenchmarks(const Options &options, const std::string &generated,
+        std::vector<Result> &results, std::vector<Result> &importerResults);
+
+/** Times each post-processing step in isolation on a freshly imported copy of the generated
+ *  scene. */
+void RunPostProcessBenchmarks(const Options &options, const std::string &generated, std::vector<Result> &results);
+
+} // namespace Bench
+} // namespace Assimp
+
+#endif // AI_BENCH_BENCHMARKS_H_INC
@@ -0,0 +1,199 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Main.cpp
+ *  @brief Entry point of assimp_bench
+ *
+ *  assimp_bench times importers, exporters and post-processing steps in isolation and writes
+ *  the results as JSON, so runs of two releases can be diffed to catch regressions.
+ */
+#include "Benchmarks.h"
+#include "SceneGenerator.h"
+
+#include <assimp/version.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace Assimp::Bench;
+
+namespace {
+
+const char *Usage =
+        "assimp_bench [options]\n"
+        "\n"
+        "Times importers, exporters and post-processing steps and prints the results as JSON.\n"
+        "\n"
+        "  --size <n>        quads per row of each generated mesh (default 128)\n"
+        "  --meshes <n>      meshes in the generated scene (default 4)\n"
+        "  --iterations <n>  timed runs per benchmark, the best one is reported (default 3)\n"
+        "  --models <dir>    directory scanned for importer inputs\n"
+        "  --no-models       only use the generated scene\n"
+        "  --filter <text>   only run benchmarks whose name or input contains text\n"
+        "  --exclude <text>  skip model files whose path contains text\n"
+        "  --include-all     also run the model files excluded by default\n"
+        "  --skip <group>    skip a group: importers, exporters or postprocess\n"
+        "  --output <file>   write the JSON to file instead of stdout\n";
+
+// ------------------------------------------------------------------------------------------------
+bool ParseUnsigned(const char *text, unsigned int &value) {
+    char *end = nullptr;
+    const unsigned long parsed = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || parsed == 0) {
+        return false;
+    }
+    value = static_cast<unsigned int>(parsed);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ToString(unsigned int value) {
+    char buffer[16];
+    ::snprintf(buffer, sizeof(buffer), "%u", value);
+    return buffer;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+    Options options;
+#ifdef ASSIMP_TEST_MODELS_DIR
+    options.mModelsDir = ASSIMP_TEST_MODELS_DIR;
+#endif
+    options.mExcludes = GetDefaultExcludes();
+    std::string output;
+    bool runImporters = true, runExporters = true, runPostProcess = true;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (0 == ::strcmp(arg, "--no-models")) {
+            options.mModelsDir.clear();
+            continue;
+        } else if (0 == ::strcmp(arg, "--include-all")) {
+            options.mExcludes.clear();
+            continue;
+        } else if (0 == ::strcmp(arg, "--help") || 0 == ::strcmp(arg, "-h")) {
+            ::printf("%s", Usage);
+            return 0;
+        } else if (nullptr == value) {
+            ok = false;
+        } else if (0 == ::strcmp(arg, "--size")) {
+            ok = ParseUnsigned(value, options.mGridSize);
+        } else if (0 == ::strcmp(arg, "--meshes")) {
+            ok = ParseUnsigned(value, options.mNumMeshes);
+        } else if (0 == ::strcmp(arg, "--iterations")) {
+            ok = ParseUnsigned(value, options.mIterations);
+        } else if (0 == ::strcmp(arg, "--models")) {
+            options.mModelsDir = value;
+        } else if (0 == ::strcmp(arg, "--filter")) {
+            options.mFilter = value;
+        } else if (0 == ::strcmp(arg, "--exclude")) {
+            options.mExcludes.push_back(value);
+        } else if (0 == ::strcmp(arg, "--output")) {
+            output = value;
+        } else if (0 == ::strcmp(arg, "--skip")) {
+            runImporters = runImporters && 0 != ::strcmp(value, "importers");
+            runExporters = runExporters && 0 != ::strcmp(value, "exporters");
+            runPostProcess = runPostProcess && 0 != ::strcmp(value, "postprocess");
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            ::fprintf(stderr, "assimp_bench: invalid argument %s\n\n%s", arg, Usage);
+            return 1;
+        }
+        ++i;
+    }
+
+    const std::string generated = GenerateObj(options.mGridSize, options.mNumMeshes);
+
+    std::vector<ResultGroup> groups(3);
+    groups[0].mName = "importers";
+    groups[1].mName = "exporters";
+    groups[2].mName = "postprocess";
+    if (runImporters) {
+        RunImporterBenchmarks(options, generated, groups[0].mResults);
+    }
+    if (runExporters) {
+        RunExporterBenchmarks(options, generated, groups[1].mResults, groups[0].mResults);
+    }
+    if (runPostProcess) {
+        RunPostProcessBenchmarks(options, generated, groups[2].mResults);
+    }
+
+    char version[64];
+    ::snprintf(version, sizeof(version), "%u.%u.%u", aiGetVersionMajor(), aiGetVersionMinor(), aiGetVersionPatch());
+    char revision[16];
+    ::snprintf(revision, sizeof(revision), "%x", aiGetVersionRevision());
+    const RunInfo info = {
+        { "version", version, false },
+        { "revision", revision, false },
+        { "branch", aiGetBranchName(), false },
+        { "compile_flags", ToString(aiGetCompileFlags()), true },
+        { "grid_size", ToString(options.mGridSize), true },
+        { "meshes", ToString(options.mNumMeshes), true },
+        { "iterations", ToString(options.mIterations), true },
+        { "generated_bytes", ToString(static_cast<unsigned int>(generated.size())), true },
+        { "models_dir", options.mModelsDir, false },
+        { "filter", options.mFilter, false }
+    };
+
+    if (output.empty()) {
+        WriteJson(std::cout, info, groups);
+        return 0;
+    }
+
+    std::ofstream file(output.c_str());
+    if (!file) {
+        ::fprintf(stderr, "assimp_bench: cannot open %s\n", output.c_str());
+        return 1;
+    }
+    WriteJson(file, info, groups);
+    return file ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  SceneGenerator.cpp
+ *  @brief Procedural test scenes for assimp_bench
+ */
+#include "SceneGenerator.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <typename... Args>
+void Append(std::string &out, const char *format, Args... args) {
+    char buffer[128];
+    const int length = ::snprintf(buffer, sizeof(buffer), format, args...);
+    if (length > 0) {
+        out.append(buffer, static_cast<size_t>(length));
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+std::string GenerateObj(unsigned int gridSize, unsigned int numMeshes) {
+    const unsigned int rowLength = gridSize + 1;
+    const unsigned int numVertices = rowLength * rowLength;
+
+    std::string out;
+    out.reserve(static_cast<size_t>(numMeshes) * numVertices * 96);
+    out += "# generated by assimp_bench\n";
+
+    unsigned int base = 1;
+    for (unsigned int m = 0; m < numMeshes; ++m) {
+        Append(out, "o mesh_%u\n", m);
+
+        const float offset = static_cast<float>(m) * 1.5f;
+        for (unsigned int y = 0; y < rowLength; ++y) {
+            for (unsigned int x = 0; x < rowLength; ++x) {
+                const float u = static_cast<float>(x) / gridSize;
+                const float v = static_cast<float>(y) / gridSize;
+                const float height = 0.1f * std::sin(u * 12.0f + offset) * std::cos(v * 12.0f);
+                Append(out, "v %.6f %.6f %.6f\n", u + offset, height, v);
+            }
+        }
+        for (unsigned int y = 0; y < rowLength; ++y) {
+            for (unsigned int x = 0; x < rowLength; ++x) {
+                const float u = static_cast<float>(x) / gridSize;
+                const float v = static_cast<float>(y) / gridSize;
+                // normal of the height field, d/du and d/dv of the displacement above
+                const float du = 1.2f * std::cos(u * 12.0f + offset) * std::cos(v * 12.0f);
+                const float dv = -1.2f * std::sin(u * 12.0f + offset) * std::sin(v * 12.0f);
+                const float length = std::sqrt(du * du + 1.0f + dv * dv);
+                Append(out, "vn %.6f %.6f %.6f\n", -du / length, 1.0f / length, -dv / length);
+            }
+        }
+        for (unsigned int y = 0; y < rowLength; ++y) {
+            for (unsigned int x = 0; x < rowLength; ++x) {
+                Append(out, "vt %.6f %.6f\n", static_cast<float>(x) / gridSize, static_cast<float>(y) / gridSize);
+            }
+        }
+        for (unsigned int y = 0; y < gridSize; ++y) {
+            for (unsigned int x = 0; x < gridSize; ++x) {
+                const unsigned int i0 = base + y * rowLength + x;
+                const unsigned int i1 = i0 + 1;
+                const unsigned int i2 = i0 + rowLength;
+                const unsigned int i3 = i2 + 1;
+                Append(out, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", i0, i0, i0, i2, i2, i2, i1, i1, i1);
+                Append(out, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", i1, i1, i1, i2, i2, i2, i3, i3, i3);
+            }
+        }
+        base += numVertices;
+    }
+    return out;
+}
+
+} // namespace Bench
+} // namespace Assimp
@@ -0,0 +1,214 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/AnimationSampler.hpp>
+#include <assimp/anim.h>
+
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Two channels: the first with three keys per track, the second with a single key each
+aiAnimation *CreateAnimation(aiAnimBehaviour preState, aiAnimBehaviour postState) {
+    aiAnimation *anim = new aiAnimation;
+    anim->mDuration = 2.0;
+    anim->mNumChannels = 2;
+    anim->mChannels = new aiNodeAnim *[2];
+
+    aiNodeAnim *moving = new aiNodeAnim;
+    moving->mNodeName.Set("moving");
+    moving->mPreState = preState;
+    moving->mPostState = postState;
+    moving->mNumPositionKeys = 3;
+    moving->mPositionKeys = new aiVectorKey[3];
+    moving->mPositionKeys[0] = aiVectorKey(0.0, aiVector3D(0, 0, 0));
+    moving->mPositionKeys[1] = aiVectorKey(1.0, aiVector3D(2, 0, 0));
+    moving->mPositionKeys[2] = aiVectorKey(2.0, aiVector3D(2, 4, 0));
+    moving->mNumRotationKeys = 3;
+    moving->mRotationKeys = new aiQuatKey[3];
+    moving->mRotationKeys[0] = aiQuatKey(0.0, aiQuaternion());
+    moving->mRotationKeys[1] = aiQuatKey(1.0, aiQuaternion(aiVector3D(0, 1, 0), 1.5f));
+    moving->mRotationKeys[2] = aiQuatKey(2.0, aiQuaternion(aiVector3D(1, 0, 0), 1.0f));
+    moving->mNumScalingKeys = 2;
+    moving->mScalingKeys = new aiVectorKey[2];
+    moving->mScalingKeys[0] = aiVectorKey(0.0, aiVector3D(1, 1, 1));
+    moving->mScalingKeys[1] = aiVectorKey(2.0, aiVector3D(3, 1, 1));
+    anim->mChannels[0] = moving;
+
+    aiNodeAnim *still = new aiNodeAnim;
+    still->mNodeName.Set("still");
+    still->mNumPositionKeys = 1;
+    still->mPositionKeys = new aiVectorKey[1];
+    still->mPositionKeys[0] = aiVectorKey(0.5, aiVector3D(1, 2, 3));
+    still->mNumRotationKeys = 1;
+    still->mRotationKeys = new aiQuatKey[1];
+    still->mRotationKeys[0] = aiQuatKey(0.5, aiQuaternion(aiVector3D(0, 0, 1), 0.5f));
+    anim->mChannels[1] = still;
+    return anim;
+}
+
+aiQuaternion Slerp(const aiQuaternion &a, const aiQuaternion &b, ai_real factor) {
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, a, b, factor);
+    return out;
+}
+
+void ExpectNear(const aiVector3D &expected, const aiVector3D &actual) {
+    EXPECT_NEAR(expected.x, actual.x, 1e-5);
+    EXPECT_NEAR(expected.y, actual.y, 1e-5);
+    EXPECT_NEAR(expected.z, actual.z, 1e-5);
+}
+
+void ExpectNear(const aiQuaternion &expected, const aiQuaternion &actual) {
+    EXPECT_NEAR(expected.w, actual.w, 1e-5);
+    EXPECT_NEAR(expected.x, actual.x, 1e-5);
+    EXPECT_NEAR(expected.y, actual.y, 1e-5);
+    EXPECT_NEAR(expected.z, actual.z, 1e-5);
+}
+
+} // namespace
+
+class utAnimationSampler : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utAnimationSampler, interpolatesLikeTheReference) {
+    std::unique_ptr<aiAnimation> anim(CreateAnimation(aiAnimBehaviour_DEFAULT, aiAnimBehaviour_DEFAULT));
+    const aiNodeAnim *moving = anim->mChannels[0];
+    AnimationSampler sampler(anim.get());
+    EXPECT_EQ(2u, sampler.GetNumChannels());
+
+    ChannelPose poses[2];
+    sampler.Sample(0.25, poses);
+    ExpectNear(aiVector3D(0.5, 0, 0), poses[0].mPosition);
+    ExpectNear(aiVector3D(1.25, 1, 1), poses[0].mScaling);
+    ExpectNear(Slerp(moving->mRotationKeys[0].mValue, moving->mRotationKeys[1].mValue, 0.25f), poses[0].mRotation);
+
+    sampler.Sample(1.5, poses);
+    ExpectNear(aiVector3D(2, 2, 0), poses[0].mPosition);
+    ExpectNear(Slerp(moving->mRotationKeys[1].mValue, moving->mRotationKeys[2].mValue, 0.5f), poses[0].mRotation);
+
+    // a channel with single keys is constant, missing tracks keep the identity
+    ExpectNear(aiVector3D(1, 2, 3), poses[1].mPosition);
+    ExpectNear(anim->mChannels[1]->mRotationKeys[0].mValue, poses[1].mRotation);
+    ExpectNear(aiVector3D(1, 1, 1), poses[1].mScaling);
+}
+
+TEST_F(utAnimationSampler, cursorsFollowJumpsInTime) {
+    std::unique_ptr<aiAnimation> anim(CreateAnimation(aiAnimBehaviour_DEFAULT, aiAnimBehaviour_DEFAULT));
+    AnimationSampler sampler(anim.get());
+
+    ChannelPose poses[2];
+    sampler.Sample(1.75, poses);
+    ExpectNear(aiVector3D(2, 3, 0), poses[0].mPosition);
+    sampler.Sample(0.5, poses);
+    ExpectNear(aiVector3D(1, 0, 0), poses[0].mPosition);
+    sampler.Sample(1.0, poses);
+    ExpectNear(aiVector3D(2, 0, 0), poses[0].mPosition);
+    sampler.ResetCursors();
+    sampler.Sample(1.25, poses);
+    ExpectNear(aiVector3D(2, 1, 0), poses[0].mPosition);
+}
+
+TEST_F(utAnimationSampler, appliesPreAndPostStates) {
+    std::unique_ptr<aiAnimation> constant(CreateAnimation(aiAnimBehaviour_CONSTANT, aiAnimBehaviour_DEFAULT));
+    AnimationSampler constantSampler(constant.get());
+    ChannelPose poses[2];
+    constantSampler.Sample(-1.0, poses);
+    ExpectNear(aiVector3D(0, 0, 0), poses[0].mPosition);
+    constantSampler.Sample(5.0, poses);
+    ExpectNear(aiVector3D(2, 4, 0), poses[0].mPosition);
+    ExpectNear(constant->mChannels[0]->mRotationKeys[2].mValue, poses[0].mRotation);
+
+    std::unique_ptr<aiAnimation> repeat(CreateAnimation(aiAnimBehaviour_REPEAT, aiAnimBehaviour_REPEAT));
+    AnimationSampler repeatSampler(repeat.get());
+    repeatSampler.Sample(2.5, poses);
+    ExpectNear(aiVector3D(1, 0, 0), poses[0].mPosition);
+    repeatSampler.Sample(-0.5, poses);
+    ExpectNear(aiVector3D(2, 2, 0), poses[0].mPosition);
+
+    std::unique_ptr<aiAnimation> linear(CreateAnimation(aiAnimBehaviour_LINEAR, aiAnimBehaviour_LINEAR));
+    AnimationSampler linearSampler(linear.get());
+    linearSampler.Sample(3.0, poses);
+    ExpectNear(aiVector3D(2, 8, 0), poses[0].mPosition);
+    ExpectNear(aiVector3D(4, 1, 1), poses[0].mScaling);
+    ExpectNear(linear->mChannels[0]->mRotationKeys[2].mValue, poses[0].mRotation);
+    linearSampler.Sample(-1.0, poses);
+    ExpectNear(aiVector3D(-2, 0, 0), poses[0].mPosition);
+}
+
+TEST_F(utAnimationSampler, sampleFramesMatchesSingleSamples) {
+    std::unique_ptr<aiAnimation> anim(CreateAnimation(aiAnimBehaviour_DEFAULT, aiAnimBehaviour_DEFAULT));
+    AnimationSampler frames(anim.get());
+    AnimationSampler single(anim.get());
+
+    const unsigned int numFrames = 9;
+    std::vector<ChannelPose> poses(numFrames * 2);
+    frames.SampleFrames(0.0, 0.25, numFrames, poses.data());
+    for (unsigned int frame = 0; frame < numFrames; ++frame) {
+        ChannelPose expected[2];
+        single.Sample(frame * 0.25, expected);
+        for (unsigned int i = 0; i < 2; ++i) {
+            ExpectNear(expected[i].mPosition, poses[frame * 2 + i].mPosition);
+            ExpectNear(expected[i].mRotation, poses[frame * 2 + i].mRotation);
+            ExpectNear(expected[i].mScaling, poses[frame * 2 + i].mScaling);
+        }
+    }
+}
+
+TEST_F(utAnimationSampler, composesTransformationMatrices) {
+    std::unique_ptr<aiAnimation> anim(CreateAnimation(aiAnimBehaviour_DEFAULT, aiAnimBehaviour_DEFAULT));
+    AnimationSampler sampler(anim.get());
+
+    ChannelPose poses[2];
+    aiMatrix4x4 transforms[2];
+    sampler.Sample(0.75, poses);
+    sampler.Sample(0.75, transforms);
+    for (unsigned int i = 0; i < 2; ++i) {
+        const aiMatrix4x4 expected(poses[i].mScaling, poses[i].mRotation, poses[i].mPosition);
+        EXPECT_TRUE(expected.Equal(transforms[i], 1e-5f));
+    }
+}
@@ -0,0 +1,133 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "UTLogStream.h"
+
+#include <assimp/AsyncLogStream.hpp>
+#include <assimp/DefaultLogger.hpp>
+
+#include <thread>
+
+using namespace Assimp;
+
+class utAsyncLogStream : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mSeverity = DefaultLogger::get()->getLogSeverity();
+    }
+
+    void TearDown() override {
+        DefaultLogger::get()->setLogSeverity(mSeverity);
+    }
+
+    Logger::LogSeverity mSeverity = Logger::NORMAL;
+};
+
+TEST_F(utAsyncLogStream, writeTest) {
+    UTLogStream *target = new UTLogStream();
+    AsyncLogStream stream(target);
+    stream.write("first\n");
+    stream.write("second\n");
+    stream.flush();
+
+    ASSERT_EQ(2u, target->m_messages.size());
+    EXPECT_EQ("first\n", target->m_messages[0]);
+    EXPECT_EQ("second\n", target->m_messages[1]);
+    EXPECT_EQ(0u, stream.getNumDropped());
+}
+
+TEST_F(utAsyncLogStream, threadsTest) {
+    static const unsigned int NumThreads = 4;
+    static const unsigned int NumMessages = 100;
+
+    UTLogStream *target = new UTLogStream();
+    AsyncLogStream stream(target, NumThreads * NumMessages);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&stream]() {
+            for (unsigned int m = 0; m < NumMessages; ++m) {
+                stream.write("message\n");
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    stream.flush();
+
+    // the buffer is large enough for all messages, none are dropped
+    EXPECT_EQ(0u, stream.getNumDropped());
+    EXPECT_EQ(NumThreads * NumMessages, target->m_messages.size());
+}
+
+TEST_F(utAsyncLogStream, defaultLoggerTest) {
+    UTLogStream *target = new UTLogStream();
+    AsyncLogStream stream(target);
+    DefaultLogger::get()->attachStream(&stream, Logger::Info | Logger::Warn);
+    ASSIMP_LOG_INFO("async info");
+    ASSIMP_LOG_WARN_F("async warn ", 1);
+    DefaultLogger::get()->detachStream(&stream);
+    stream.flush();
+
+    ASSERT_EQ(2u, target->m_messages.size());
+    EXPECT_NE(std::string::npos, target->m_messages[0].find("async info"));
+    EXPECT_NE(std::string::npos, target->m_messages[1].find("async warn 1"));
+}
+
+static int CountCall(int &calls) {
+    return ++calls;
+}
+
+TEST_F(utAsyncLogStream, lazyFormattingTest) {
+    int calls = 0;
+
+    // debug messages are only formatted with the matching severity
+    DefaultLogger::get()->setLogSeverity(Logger::NORMAL);
+    ASSIMP_LOG_DEBUG_F("value ", CountCall(calls));
+    ASSIMP_LOG_VERBOSE_DEBUG_F("value ", CountCall(calls));
+    ASSIMP_LOG_WARN_F("value ", CountCall(calls));
+    EXPECT_EQ(1, calls);
+
+    DefaultLogger::get()->setLogSeverity(Logger::VERBOSE);
+    ASSIMP_LOG_DEBUG_F("value ", CountCall(calls));
+    ASSIMP_LOG_VERBOSE_DEBUG_F("value ", CountCall(calls));
+    EXPECT_EQ(3, calls);
+}
@@ -0,0 +1,236 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/BlockCompression.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/IOSystem.hpp>
+#include <assimp/MemoryIOWrapper.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Assimp;
+
+// a growable in-memory stream to write containers to, optionally seekable
+class VectorIOStream : public IOStream {
+public:
+    explicit VectorIOStream(bool seekable = false) :
+            mPos(0), mSeekable(seekable) {}
+
+    size_t Read(void *, size_t, size_t) override { return 0; }
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        const unsigned char *in = static_cast<const unsigned char *>(pvBuffer);
+        const size_t size = pSize * pCount;
+        mData.resize(std::max(mData.size(), mPos + size));
+        std::copy(in, in + size, mData.begin() + mPos);
+        mPos += size;
+        return pCount;
+    }
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
+        if (!mSeekable || pOrigin != aiOrigin_SET || pOffset > mData.size()) {
+            return aiReturn_FAILURE;
+        }
+        mPos = pOffset;
+        return aiReturn_SUCCESS;
+    }
+    size_t Tell() const override { return mPos; }
+    size_t FileSize() const override { return mData.size(); }
+    void Flush() override {}
+
+    std::vector<uint8_t> mData;
+    size_t mPos;
+    bool mSeekable;
+};
+
+class utBlockCompression : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // compressible, but not trivially
+        mData.resize(100000);
+        for (size_t i = 0; i < mData.size(); ++i) {
+            mData[i] = static_cast<unsigned char>((i * 7) ^ (i >> 5));
+        }
+    }
+
+    std::vector<unsigned char> mData;
+};
+
+TEST_F(utBlockCompression, roundTripTest) {
+    VectorIOStream out;
+    WriteCompressedBlocks(&out, mData.data(), mData.size(), BlockCodec_Deflate, 4096);
+    EXPECT_LT(out.FileSize(), mData.size());
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream stream(&in);
+    EXPECT_EQ(mData.size(), stream.FileSize());
+
+    std::vector<unsigned char> result(mData.size());
+    EXPECT_EQ(1u, stream.Read(result.data(), result.size(), 1));
+    EXPECT_EQ(mData, result);
+
+    unsigned char c = 0;
+    EXPECT_EQ(0u, stream.Read(&c, 1, 1));
+}
+
+TEST_F(utBlockCompression, streamedWriteTest) {
+    VectorIOStream reference;
+    WriteCompressedBlocks(&reference, mData.data(), mData.size(), BlockCodec_Deflate, 1000);
+
+    // uneven writes across block and batch boundaries give the same container
+    VectorIOStream out;
+    BlockCompressIOStream stream(&out, BlockCodec_Deflate, mData.size(), 1000);
+    for (size_t pos = 0, step = 1; pos < mData.size(); pos += step, step = step * 3 % 4999 + 1) {
+        stream.Write(&mData[pos], 1, std::min(step, mData.size() - pos));
+    }
+    EXPECT_EQ(mData.size(), stream.Tell());
+    stream.Finish();
+    EXPECT_EQ(reference.mData, out.mData);
+
+    // more or less data than announced is an error
+    VectorIOStream tooMuch;
+    BlockCompressIOStream small(&tooMuch, BlockCodec_Deflate, 10);
+    EXPECT_THROW(small.Write(mData.data(), 1, 11), DeadlyExportError);
+    small.Write(mData.data(), 1, 5);
+    EXPECT_THROW(small.Finish(), DeadlyExportError);
+}
+
+TEST_F(utBlockCompression, patchTest) {
+    // the size is not known up front and data is replaced after its block was compressed
+    VectorIOStream out(true);
+    BlockCompressIOStream stream(&out, BlockCodec_Deflate, BlockCompressIOStream::UnknownSize, 1000);
+    for (size_t pos = 0, step = 1; pos < mData.size(); pos += step, step = step * 3 % 4999 + 1) {
+        stream.Write(&mData[pos], 1, std::min(step, mData.size() - pos));
+    }
+
+    std::vector<unsigned char> expected = mData;
+    const unsigned char patch[6] = { 1, 2, 3, 4, 5, 6 };
+    const size_t offsets[] = { 10, 999, 1000 - 3, mData.size() - 6, 10 };
+    for (size_t offset : offsets) {
+        ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(offset, aiOrigin_SET));
+        stream.Write(patch, 1, sizeof(patch));
+        std::copy(patch, patch + sizeof(patch), expected.begin() + offset);
+    }
+    EXPECT_EQ(aiReturn_FAILURE, stream.Seek(mData.size() + 1, aiOrigin_SET));
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(0, aiOrigin_END));
+    EXPECT_EQ(mData.size(), stream.Tell());
+    stream.Finish();
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream result(&in);
+    ASSERT_EQ(expected.size(), result.FileSize());
+    std::vector<unsigned char> data(expected.size());
+    ASSERT_EQ(aiReturn_SUCCESS, result.Seek(50000, aiOrigin_SET));
+    EXPECT_EQ(1u, result.Read(data.data() + 50000, data.size() - 50000, 1));
+    ASSERT_EQ(aiReturn_SUCCESS, result.Seek(0, aiOrigin_SET));
+    EXPECT_EQ(1u, result.Read(data.data(), 50000, 1));
+    EXPECT_EQ(expected, data);
+
+    // without the size, the header has to be completed by seeking back
+    VectorIOStream unseekable;
+    BlockCompressIOStream unknown(&unseekable, BlockCodec_Deflate);
+    unknown.Write(mData.data(), 1, 10);
+    EXPECT_THROW(unknown.Finish(), DeadlyExportError);
+}
+
+TEST_F(utBlockCompression, seekTest) {
+    VectorIOStream out;
+    WriteCompressedBlocks(&out, mData.data(), mData.size(), BlockCodec_Deflate, 1000);
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream stream(&in);
+
+    // reads across block boundaries, backwards and forwards
+    unsigned char buffer[1500];
+    const size_t offsets[] = { 98000, 500, 40999, 0, 100000 - sizeof(buffer), 2000 };
+    for (size_t offset : offsets) {
+        ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(offset, aiOrigin_SET));
+        ASSERT_EQ(1u, stream.Read(buffer, sizeof(buffer), 1));
+        EXPECT_EQ(0, ::memcmp(buffer, &mData[offset], sizeof(buffer)));
+        EXPECT_EQ(offset + sizeof(buffer), stream.Tell());
+    }
+    EXPECT_EQ(aiReturn_FAILURE, stream.Seek(mData.size() + 1, aiOrigin_SET));
+}
+
+TEST_F(utBlockCompression, emptyTest) {
+    VectorIOStream out;
+    WriteCompressedBlocks(&out, nullptr, 0, BlockCodec_Deflate);
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream stream(&in);
+    EXPECT_EQ(0u, stream.FileSize());
+    unsigned char c = 0;
+    EXPECT_EQ(0u, stream.Read(&c, 1, 1));
+}
+
+TEST_F(utBlockCompression, corruptDataTest) {
+    VectorIOStream out;
+    WriteCompressedBlocks(&out, mData.data(), mData.size(), BlockCodec_Deflate, 4096);
+    out.mData.resize(out.mData.size() / 2);
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream stream(&in);
+    std::vector<unsigned char> result(mData.size());
+    EXPECT_THROW(stream.Read(result.data(), result.size(), 1), DeadlyImportError);
+}
+
+TEST_F(utBlockCompression, corruptBlockSizeTest) {
+    // a huge compressed size must be rejected before anything is allocated for it
+    VectorIOStream out;
+    WriteCompressedBlocks(&out, mData.data(), mData.size(), BlockCodec_Deflate, 4096);
+    const uint32_t packed = 0x7fffffff;
+    ::memcpy(&out.mData[24 + sizeof(uint32_t)], &packed, sizeof(packed));
+
+    MemoryIOStream in(out.mData.data(), out.mData.size());
+    BlockDecompressIOStream stream(&in);
+    unsigned char c = 0;
+    EXPECT_THROW(stream.Read(&c, 1, 1), DeadlyImportError);
+}
+
+TEST_F(utBlockCompression, codecSupportTest) {
+    EXPECT_TRUE(IsBlockCodecSupported(BlockCodec_Deflate));
+#ifdef ASSIMP_BUILD_ZSTD
+    EXPECT_TRUE(IsBlockCodecSupported(BlockCodec_ZStd));
+#else
+    EXPECT_FALSE(IsBlockCodecSupported(BlockCodec_ZStd));
+#endif
+}
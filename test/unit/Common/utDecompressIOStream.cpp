@@ -0,0 +1,169 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/DecompressIOStream.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/MemoryIOWrapper.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utDecompressIOStream : public ::testing::Test {
+protected:
+    std::shared_ptr<IOStream> openCompressed() {
+        return std::shared_ptr<IOStream>(mIOSystem.Open(ASSIMP_TEST_MODELS_DIR "/BLEND/TorusLightsCams_250_compressed.blend", "rb"));
+    }
+
+    DefaultIOSystem mIOSystem;
+};
+
+TEST_F(utDecompressIOStream, detectFormatTest) {
+    std::shared_ptr<IOStream> source = openCompressed();
+    ASSERT_NE(nullptr, source);
+
+    unsigned char magic[4] = { 0 };
+    ASSERT_EQ(1u, source->Read(magic, 4, 1));
+    EXPECT_EQ(DecompressIOStream::Format_GZip, DecompressIOStream::DetectFormat(magic, 4));
+
+    const unsigned char zstd[4] = { 0x28, 0xb5, 0x2f, 0xfd };
+    EXPECT_EQ(DecompressIOStream::Format_ZStd, DecompressIOStream::DetectFormat(zstd, 4));
+
+    const char blender[] = "BLENDER";
+    EXPECT_EQ(DecompressIOStream::Format_Unknown, DecompressIOStream::DetectFormat(blender, 7));
+    EXPECT_EQ(DecompressIOStream::Format_Unknown, DecompressIOStream::DetectFormat(zstd, 2));
+}
+
+TEST_F(utDecompressIOStream, readAllTest) {
+    std::shared_ptr<IOStream> source = openCompressed();
+    ASSERT_NE(nullptr, source);
+
+    DecompressIOStream stream(source, DecompressIOStream::Format_GZip);
+    EXPECT_EQ(568880u, stream.FileSize());
+
+    std::vector<char> data(stream.FileSize());
+    EXPECT_EQ(1u, stream.Read(data.data(), data.size(), 1));
+    EXPECT_EQ(data.size(), stream.Tell());
+    EXPECT_EQ(0, ::strncmp(data.data(), "BLENDER", 7));
+
+    // nothing left to read
+    char c = 0;
+    EXPECT_EQ(0u, stream.Read(&c, 1, 1));
+}
+
+TEST_F(utDecompressIOStream, seekTest) {
+    std::vector<char> reference;
+    {
+        DecompressIOStream stream(openCompressed(), DecompressIOStream::Format_GZip);
+        reference.resize(stream.FileSize());
+        ASSERT_EQ(1u, stream.Read(reference.data(), reference.size(), 1));
+    }
+
+    // use the smallest possible checkpoint distance to make sure restarting works
+    DecompressIOStream stream(openCompressed(), DecompressIOStream::Format_GZip, 1);
+    char buffer[256];
+    const size_t offsets[] = { 500000, 100, 300000, 300128, 65536, 0, 568880 - 256, 200000 };
+    for (size_t offset : offsets) {
+        ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(offset, aiOrigin_SET));
+        EXPECT_EQ(offset, stream.Tell());
+        ASSERT_EQ(1u, stream.Read(buffer, sizeof(buffer), 1));
+        EXPECT_EQ(0, ::memcmp(buffer, &reference[offset], sizeof(buffer)));
+    }
+    EXPECT_LT(0u, stream.GetNumCheckpoints());
+
+    EXPECT_EQ(aiReturn_SUCCESS, stream.Seek(256, aiOrigin_END));
+    EXPECT_EQ(reference.size() - 256, stream.Tell());
+    EXPECT_EQ(aiReturn_FAILURE, stream.Seek(reference.size() + 1, aiOrigin_SET));
+}
+
+TEST_F(utDecompressIOStream, zlibScanTest) {
+    // a zlib stream has no trailer with the size, so it is decoded once up front to find it
+    static const uint8_t compressed[] = {
+        0x78, 0xda, 0x73, 0xf2, 0x71, 0xf5, 0x73, 0x71, 0x0d, 0xd2, 0x2d, 0x33,
+        0x32, 0xb7, 0x1c, 0x06, 0x04, 0x00, 0x8c, 0x55, 0x34, 0xc5
+    };
+    std::shared_ptr<IOStream> source = std::make_shared<MemoryIOStream>(compressed, sizeof(compressed));
+    DecompressIOStream stream(source, DecompressIOStream::Format_GZip);
+    ASSERT_EQ(7u + 40u * 5u, stream.FileSize());
+
+    char buffer[8] = { 0 };
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(202, aiOrigin_SET));
+    ASSERT_EQ(1u, stream.Read(buffer, 5, 1));
+    EXPECT_EQ(0, ::strncmp(buffer, "-v279", 5));
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(0, aiOrigin_SET));
+    ASSERT_EQ(1u, stream.Read(buffer, 7, 1));
+    EXPECT_EQ(0, ::strncmp(buffer, "BLENDER", 7));
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(0, aiOrigin_END));
+    EXPECT_EQ(0u, stream.Read(buffer, 1, 1));
+}
+
+#ifdef ASSIMP_BUILD_ZSTD
+
+TEST_F(utDecompressIOStream, zstdFramesTest) {
+    // two frames with content sizes (112 and 200 bytes), the size and the checkpoints
+    // come from the frame headers
+    static const uint8_t compressed[] = {
+        0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x70, 0xa5, 0x00, 0x00, 0x70, 0x42, 0x4c, 0x45, 0x4e, 0x44, 0x45,
+        0x52, 0x2d, 0x76, 0x32, 0x37, 0x39, 0x61, 0x61, 0x01, 0x00, 0x3f, 0x01, 0x25, 0x96, 0x0d, 0x3e,
+        0x04, 0x28, 0xb5, 0x2f, 0xfd, 0x24, 0xc8, 0x8d, 0x00, 0x00, 0x50, 0x30, 0x31, 0x32, 0x33, 0x34,
+        0x35, 0x36, 0x37, 0x38, 0x39, 0x01, 0x00, 0xbb, 0x52, 0x05, 0x09, 0x7e, 0x4c, 0x55, 0xc1
+    };
+    std::shared_ptr<IOStream> source = std::make_shared<MemoryIOStream>(compressed, sizeof(compressed));
+    DecompressIOStream stream(source, DecompressIOStream::Format_ZStd);
+    ASSERT_EQ(312u, stream.FileSize());
+    EXPECT_EQ(2u, stream.GetNumCheckpoints());
+
+    char buffer[8] = { 0 };
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(112 + 13, aiOrigin_SET));
+    ASSERT_EQ(1u, stream.Read(buffer, 4, 1));
+    EXPECT_EQ(0, ::strncmp(buffer, "3456", 4));
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(0, aiOrigin_SET));
+    ASSERT_EQ(1u, stream.Read(buffer, 7, 1));
+    EXPECT_EQ(0, ::strncmp(buffer, "BLENDER", 7));
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(8, aiOrigin_END));
+    ASSERT_EQ(1u, stream.Read(buffer, 8, 1));
+    EXPECT_EQ(0, ::strncmp(buffer, "23456789", 8));
+}
+
+#endif // ASSIMP_BUILD_ZSTD
@@ -0,0 +1,229 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "SceneDiffer.h"
+
+#include "Common/ScenePrivate.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+static const char *CacheDirectory = "import_cache_test";
+static const char *ModelFile = ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj";
+
+class utImportCache : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // start with an empty cache, the entries are unknown without the index
+        DefaultIOSystem io;
+        io.DeleteFile(std::string(CacheDirectory) + io.getOsSeparator() + "index.txt");
+    }
+};
+
+TEST_F(utImportCache, disabledByDefaultTest) {
+    Importer importer;
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_ValidateDataStructure));
+    EXPECT_EQ(0u, importer.GetImportCacheHits());
+    EXPECT_EQ(0u, importer.GetImportCacheMisses());
+}
+
+TEST_F(utImportCache, hitMissTest) {
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+
+    const aiScene *scene = importer.ReadFile(ModelFile, aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(0u, importer.GetImportCacheHits());
+    EXPECT_EQ(1u, importer.GetImportCacheMisses());
+    const unsigned int numMeshes = scene->mNumMeshes;
+    const unsigned int numVertices = scene->mMeshes[0]->mNumVertices;
+    const unsigned int numFaces = scene->mMeshes[0]->mNumFaces;
+
+    // same file and flags, served from the cache
+    scene = importer.ReadFile(ModelFile, aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, importer.GetImportCacheHits());
+    EXPECT_EQ(1u, importer.GetImportCacheMisses());
+    ASSERT_EQ(numMeshes, scene->mNumMeshes);
+    EXPECT_EQ(numVertices, scene->mMeshes[0]->mNumVertices);
+    EXPECT_EQ(numFaces, scene->mMeshes[0]->mNumFaces);
+    EXPECT_NE(0u, ScenePriv(scene)->mPPStepsApplied & aiProcess_Triangulate);
+
+    // different post-processing is a different entry
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_Triangulate | aiProcess_GenNormals));
+    EXPECT_EQ(2u, importer.GetImportCacheMisses());
+
+    // so are different properties
+    importer.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_Triangulate));
+    EXPECT_EQ(3u, importer.GetImportCacheMisses());
+
+    // the cache is shared through the directory
+    Importer other;
+    other.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+    ASSERT_NE(nullptr, other.ReadFile(ModelFile, aiProcess_Triangulate));
+    EXPECT_EQ(1u, other.GetImportCacheHits());
+    EXPECT_EQ(0u, other.GetImportCacheMisses());
+}
+
+TEST_F(utImportCache, indexBufferOptInTest) {
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_Triangulate));
+
+    // cache entries hold an index buffer, hits only keep it if the caller asked for it
+    aiScene *scene = const_cast<aiScene *>(importer.ReadFile(ModelFile, aiProcess_Triangulate));
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, importer.GetImportCacheHits());
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        aiMesh *mesh = scene->mMeshes[i];
+        EXPECT_FALSE(mesh->HasIndexBuffer());
+        ASSERT_LT(1u, mesh->mNumFaces);
+        mesh->mFaces[1] = mesh->mFaces[0];
+    }
+
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    scene = const_cast<aiScene *>(importer.ReadFile(ModelFile, aiProcess_Triangulate));
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(2u, importer.GetImportCacheHits());
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_TRUE(scene->mMeshes[i]->HasIndexBuffer());
+    }
+}
+
+TEST_F(utImportCache, sizeLimitTest) {
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_CACHE_MAX_SIZE, 1);
+
+    // the scene is larger than 1 kB, so it is evicted right away
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_Triangulate));
+    ASSERT_NE(nullptr, importer.ReadFile(ModelFile, aiProcess_Triangulate));
+    EXPECT_EQ(0u, importer.GetImportCacheHits());
+    EXPECT_EQ(2u, importer.GetImportCacheMisses());
+}
+
+TEST_F(utImportCache, hitEqualsMissTest) {
+    // bounding boxes, meshlets and the FBX scene metadata must survive the cache
+    static const char *files[] = {
+        ModelFile,
+        ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx"
+    };
+    for (const char *file : files) {
+        Importer importer;
+        importer.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+        importer.SetPropertyBool(AI_CONFIG_PP_ML_ENABLE, true);
+        const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenBoundingBoxes;
+
+        const aiScene *miss = importer.ReadFile(file, flags);
+        ASSERT_NE(nullptr, miss);
+        EXPECT_EQ(1u, importer.GetImportCacheMisses());
+        ASSERT_TRUE(miss->mMeshes[0]->HasMeshlets());
+        aiScene *expected = nullptr;
+        SceneCombiner::CopyScene(&expected, miss);
+
+        const aiScene *hit = importer.ReadFile(file, flags);
+        ASSERT_NE(nullptr, hit);
+        EXPECT_EQ(1u, importer.GetImportCacheHits());
+
+        SceneDiffer differ;
+        EXPECT_TRUE(differ.isEqual(expected, hit)) << file;
+        differ.showReport();
+        delete expected;
+    }
+}
+
+static void WriteTextFile(const char *file, const std::string &text) {
+    DefaultIOSystem io;
+    IOStream *stream = io.Open(file, "wb");
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(1u, stream->Write(text.data(), text.size(), 1));
+    io.Close(stream);
+}
+
+TEST_F(utImportCache, dependencyChangeTest) {
+    static const char *objFile = "import_cache_dependency.obj";
+    static const char *mtlFile = "import_cache_dependency.mtl";
+    WriteTextFile(objFile, "mtllib import_cache_dependency.mtl\n"
+                           "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                           "usemtl color\nf 1 2 3\n");
+    WriteTextFile(mtlFile, "newmtl color\nKd 1 0 0\n");
+
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, CacheDirectory);
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    EXPECT_EQ(1u, importer.GetImportCacheHits());
+    EXPECT_EQ(1u, importer.GetImportCacheMisses());
+
+    // the main file is unchanged, the material library is not
+    WriteTextFile(mtlFile, "newmtl color\nKd 0 1 0\n");
+    const aiScene *scene = importer.ReadFile(objFile, 0);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, importer.GetImportCacheHits());
+    EXPECT_EQ(2u, importer.GetImportCacheMisses());
+    aiColor3D diffuse;
+    ASSERT_EQ(aiReturn_SUCCESS, scene->mMaterials[scene->mMeshes[0]->mMaterialIndex]->Get(AI_MATKEY_COLOR_DIFFUSE, diffuse));
+    EXPECT_EQ(aiColor3D(0, 1, 0), diffuse);
+
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    EXPECT_EQ(2u, importer.GetImportCacheHits());
+
+    // a file which was missing during the import counts as well
+    DefaultIOSystem io;
+    io.DeleteFile(mtlFile);
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    EXPECT_EQ(3u, importer.GetImportCacheMisses());
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    EXPECT_EQ(3u, importer.GetImportCacheHits());
+    WriteTextFile(mtlFile, "newmtl color\nKd 0 0 1\n");
+    ASSERT_NE(nullptr, importer.ReadFile(objFile, 0));
+    EXPECT_EQ(4u, importer.GetImportCacheMisses());
+
+    io.DeleteFile(objFile);
+    io.DeleteFile(mtlFile);
+}
@@ -0,0 +1,213 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/MemoryTracker.hpp>
+#include <assimp/cimport.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <string>
+#include <thread>
+
+using namespace Assimp;
+
+class utMemoryTracker : public ::testing::Test {
+    // empty
+};
+
+namespace {
+
+// Counts every read of the allocation counters as one allocation of 16 bytes
+class CountingTracker : public MemoryTracker {
+public:
+    CountingTracker() :
+            mReads(0) {}
+
+    void GetAllocationCounters(Counters &counters) const override {
+        ++mReads;
+        counters.allocations = mReads;
+        counters.allocatedBytes = mReads * 16;
+        counters.deallocations = 0;
+        counters.freedBytes = 0;
+        counters.peakBytes = 0;
+    }
+
+    mutable size_t mReads;
+};
+
+std::string PhaseName(const MemoryTracker *tracker, unsigned int index) {
+    return tracker->GetPhase(index)->name.C_Str();
+}
+
+} // namespace
+
+TEST_F(utMemoryTracker, disabledByDefaultTest) {
+    Importer importer;
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0));
+    EXPECT_EQ(nullptr, importer.GetMemoryTracker());
+}
+
+TEST_F(utMemoryTracker, importPhasesTest) {
+    Importer importer;
+    CountingTracker *tracker = new CountingTracker;
+    importer.SetMemoryTracker(tracker);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj",
+            aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals));
+
+    // the spatial sort is computed before and destroyed after the steps which share it
+    ASSERT_EQ(8u, tracker->GetNumPhases());
+    EXPECT_EQ("detect", PhaseName(tracker, 0));
+    EXPECT_EQ("parse", PhaseName(tracker, 1));
+    EXPECT_EQ("ValidateDSProcess", PhaseName(tracker, 2));
+    EXPECT_EQ("convert", PhaseName(tracker, 3));
+    EXPECT_EQ("ComputeSpatialSortProcess", PhaseName(tracker, 4));
+    EXPECT_EQ("GenVertexNormalsProcess", PhaseName(tracker, 5));
+    EXPECT_EQ("JoinVerticesProcess", PhaseName(tracker, 6));
+    EXPECT_EQ("DestroySpatialSortProcess", PhaseName(tracker, 7));
+    EXPECT_EQ(0u, tracker->GetPhase(0)->step);
+    EXPECT_EQ(static_cast<unsigned int>(aiProcess_ValidateDataStructure), tracker->GetPhase(2)->step);
+    EXPECT_EQ(static_cast<unsigned int>(aiProcess_GenSmoothNormals), tracker->GetPhase(5)->step);
+    EXPECT_EQ(static_cast<unsigned int>(aiProcess_JoinIdenticalVertices), tracker->GetPhase(6)->step);
+    EXPECT_EQ(nullptr, tracker->GetPhase(8));
+
+    // every phase reads the counters once at its start and once at its end
+    for (unsigned int i = 0; i < tracker->GetNumPhases(); ++i) {
+        EXPECT_EQ(1u, tracker->GetPhase(i)->allocations);
+        EXPECT_EQ(16u, tracker->GetPhase(i)->allocatedBytes);
+    }
+
+    // nothing is imported before the parse phase, joining vertices shrinks the scene
+    aiMemoryInfo final;
+    importer.GetMemoryRequirements(final);
+    EXPECT_EQ(0u, tracker->GetPhase(0)->scene.total);
+    EXPECT_LT(0u, tracker->GetPhase(1)->scene.meshes);
+    EXPECT_EQ(final.total, tracker->GetPhase(7)->scene.total);
+    EXPECT_LT(tracker->GetPhase(6)->scene.meshes, tracker->GetPhase(5)->scene.meshes);
+    EXPECT_EQ(tracker->GetPhase(5)->scene.total, tracker->GetPeakSceneSize().total);
+
+    // the next import starts over
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0));
+    EXPECT_EQ(3u, tracker->GetNumPhases());
+    EXPECT_EQ("convert", PhaseName(tracker, 2));
+}
+
+TEST_F(utMemoryTracker, applyPostProcessingTest) {
+    Importer importer;
+    importer.SetMemoryTracker(new MemoryTracker);
+    ASSERT_NE(nullptr, importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", 0));
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_Triangulate));
+
+    const MemoryTracker *tracker = importer.GetMemoryTracker();
+    ASSERT_EQ(4u, tracker->GetNumPhases());
+    EXPECT_EQ("TriangulateProcess", PhaseName(tracker, 3));
+}
+
+TEST_F(utMemoryTracker, countAllocationTest) {
+    MemoryTracker tracker;
+    MemoryTracker::CountAllocation(100);
+    MemoryTracker::Counters counters = {};
+    tracker.GetAllocationCounters(counters);
+    EXPECT_EQ(0u, counters.allocations);
+
+    {
+        MemoryTracker::Scope scope(&tracker);
+        EXPECT_EQ(&tracker, MemoryTracker::GetCurrent());
+        tracker.ResetPeak();
+        MemoryTracker::CountAllocation(100);
+        MemoryTracker::CountAllocation(50);
+        MemoryTracker::CountDeallocation(100);
+        MemoryTracker::CountAllocation(20);
+    }
+    EXPECT_EQ(nullptr, MemoryTracker::GetCurrent());
+
+    tracker.GetAllocationCounters(counters);
+    EXPECT_EQ(3u, counters.allocations);
+    EXPECT_EQ(170u, counters.allocatedBytes);
+    EXPECT_EQ(1u, counters.deallocations);
+    EXPECT_EQ(100u, counters.freedBytes);
+    EXPECT_EQ(150u, counters.peakBytes);
+
+    // the peak starts over at the live bytes
+    tracker.ResetPeak();
+    tracker.GetAllocationCounters(counters);
+    EXPECT_EQ(0u, counters.peakBytes);
+}
+
+TEST_F(utMemoryTracker, threadScopeTest) {
+    MemoryTracker first, second;
+    MemoryTracker::Scope scope(&first);
+    std::thread thread([&second]() {
+        MemoryTracker::Scope threadScope(&second);
+        MemoryTracker::CountAllocation(8);
+    });
+    thread.join();
+    MemoryTracker::CountAllocation(16);
+
+    // each thread counts for its own tracker
+    MemoryTracker::Counters counters = {};
+    first.GetAllocationCounters(counters);
+    EXPECT_EQ(16u, counters.allocatedBytes);
+    second.GetAllocationCounters(counters);
+    EXPECT_EQ(8u, counters.allocatedBytes);
+}
+
+TEST_F(utMemoryTracker, cApiTest) {
+    aiPropertyStore *props = aiCreatePropertyStore();
+    aiSetImportPropertyInteger(props, AI_CONFIG_GLOB_TRACK_MEMORY, 1);
+    const aiScene *scene = aiImportFileExWithProperties(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj",
+            aiProcess_Triangulate, nullptr, props);
+    aiReleasePropertyStore(props);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(4u, aiGetMemoryPhaseCount(scene));
+    aiMemoryPhaseInfo info;
+    ASSERT_EQ(aiReturn_SUCCESS, aiGetMemoryPhaseInfo(scene, 3, &info));
+    EXPECT_STREQ("TriangulateProcess", info.name.C_Str());
+    EXPECT_EQ(static_cast<unsigned int>(aiProcess_Triangulate), info.step);
+
+    aiMemoryInfo final;
+    aiGetMemoryRequirements(scene, &final);
+    EXPECT_EQ(final.total, info.scene.total);
+    EXPECT_EQ(aiReturn_FAILURE, aiGetMemoryPhaseInfo(scene, 4, &info));
+    aiReleaseImport(scene);
+}
@@ -0,0 +1,208 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utMesh : public ::testing::Test {
+protected:
+    // a triangle, a quad and a line
+    static aiMesh *CreateMesh() {
+        aiMesh *mesh = new aiMesh();
+        mesh->mNumVertices = 4;
+        mesh->mVertices = new aiVector3D[4];
+        mesh->mNumFaces = 3;
+        mesh->mFaces = new aiFace[3];
+        const unsigned int counts[] = { 3, 4, 2 };
+        for (unsigned int i = 0; i < 3; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            face.mNumIndices = counts[i];
+            face.mIndices = new unsigned int[counts[i]];
+            for (unsigned int a = 0; a < counts[i]; ++a) {
+                face.mIndices[a] = (i + a) % 4;
+            }
+        }
+        return mesh;
+    }
+};
+
+TEST_F(utMesh, compactIndicesTest) {
+    aiMesh *mesh = CreateMesh();
+    EXPECT_FALSE(mesh->HasIndexBuffer());
+
+    mesh->CompactIndices();
+    ASSERT_TRUE(mesh->HasIndexBuffer());
+    EXPECT_EQ(9u, mesh->mNumIndices);
+    EXPECT_EQ(mesh->mIndices, mesh->mFaces[0].mIndices);
+    EXPECT_EQ(mesh->mIndices + 3, mesh->mFaces[1].mIndices);
+    EXPECT_EQ(mesh->mIndices + 7, mesh->mFaces[2].mIndices);
+    const unsigned int expected[] = { 0, 1, 2, 1, 2, 3, 0, 2, 3 };
+    EXPECT_EQ(0, ::memcmp(expected, mesh->mIndices, sizeof(expected)));
+
+    // a second call leaves the buffer alone
+    unsigned int *indices = mesh->mIndices;
+    mesh->CompactIndices();
+    EXPECT_EQ(indices, mesh->mIndices);
+    delete mesh;
+}
+
+TEST_F(utMesh, expandIndicesTest) {
+    aiMesh *mesh = CreateMesh();
+    mesh->CompactIndices();
+    mesh->ExpandIndices();
+    EXPECT_FALSE(mesh->HasIndexBuffer());
+    EXPECT_EQ(0u, mesh->mNumIndices);
+
+    // the faces own their indices again
+    ASSERT_EQ(4u, mesh->mFaces[1].mNumIndices);
+    EXPECT_EQ(3u, mesh->mFaces[1].mIndices[2]);
+    delete[] mesh->mFaces[1].mIndices;
+    mesh->mFaces[1].mIndices = new unsigned int[4]();
+    delete mesh;
+}
+
+TEST_F(utMesh, copyMeshTest) {
+    aiMesh *mesh = CreateMesh();
+    mesh->CompactIndices();
+
+    aiMesh *copy = nullptr;
+    SceneCombiner::Copy(&copy, mesh);
+    ASSERT_NE(nullptr, copy);
+
+    // copies get regular faces, their indices may be reallocated
+    EXPECT_FALSE(copy->HasIndexBuffer());
+    EXPECT_EQ(0u, copy->mNumIndices);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const aiFace &face = copy->mFaces[i];
+        ASSERT_EQ(mesh->mFaces[i].mNumIndices, face.mNumIndices);
+        EXPECT_EQ(0, ::memcmp(mesh->mFaces[i].mIndices, face.mIndices, face.mNumIndices * sizeof(unsigned int)));
+    }
+    delete[] copy->mFaces[1].mIndices;
+    copy->mFaces[1].mIndices = new unsigned int[4]();
+    delete mesh;
+    delete copy;
+}
+
+TEST_F(utMesh, allocateFaceIndicesTest) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mNumFaces = 3;
+    mesh->mFaces = new aiFace[3];
+    mesh->mFaces[0].mNumIndices = 3;
+    mesh->mFaces[2].mNumIndices = 4;
+    mesh->AllocateFaceIndices(true);
+    ASSERT_TRUE(mesh->HasIndexBuffer());
+    EXPECT_EQ(7u, mesh->mNumIndices);
+    EXPECT_EQ(mesh->mIndices, mesh->mFaces[0].mIndices);
+    EXPECT_EQ(nullptr, mesh->mFaces[1].mIndices);
+    EXPECT_EQ(mesh->mIndices + 3, mesh->mFaces[2].mIndices);
+    delete mesh;
+
+    mesh = new aiMesh();
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[1];
+    mesh->mFaces[0].mNumIndices = 3;
+    mesh->AllocateFaceIndices(false);
+    EXPECT_FALSE(mesh->HasIndexBuffer());
+    EXPECT_NE(nullptr, mesh->mFaces[0].mIndices);
+    delete mesh;
+}
+
+TEST_F(utMesh, importContiguousIndicesTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        ASSERT_TRUE(mesh->HasIndexBuffer());
+        EXPECT_EQ(mesh->mNumFaces * 3, mesh->mNumIndices);
+    }
+
+    // further post-processing works on regular faces and compacts them again
+    scene = importer.ApplyPostProcessing(aiProcess_GenNormals | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_TRUE(scene->mMeshes[0]->HasIndexBuffer());
+}
+
+TEST_F(utMesh, importDirectContiguousIndicesTest) {
+    // without post-processing, the index buffer comes straight from the importer
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj"
+    };
+    for (const char *file : files) {
+        const aiScene *scene = importer.ReadFile(file, 0);
+        ASSERT_NE(nullptr, scene) << file;
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *mesh = scene->mMeshes[i];
+            ASSERT_TRUE(mesh->HasIndexBuffer()) << file;
+            EXPECT_EQ(mesh->mIndices, mesh->mFaces[0].mIndices) << file;
+        }
+    }
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utMesh, exportContiguousIndicesTest) {
+    // the exporter triangulates a copy of the scene, which must not share the index buffer
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_TRUE(scene->mMeshes[0]->HasIndexBuffer());
+
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "stl");
+    ASSERT_NE(nullptr, blob);
+    EXPECT_LT(0u, blob->size);
+    EXPECT_TRUE(scene->mMeshes[0]->HasIndexBuffer());
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
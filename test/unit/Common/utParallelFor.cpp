@@ -0,0 +1,157 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/ParallelFor.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Records the threads which ran iterations of a loop
+struct ThreadRecorder {
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+
+    void Record() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.insert(std::this_thread::get_id());
+    }
+};
+
+} // namespace
+
+TEST(utParallelFor, visitsEachIndexOnce) {
+    std::vector<std::atomic<int>> visits(100000);
+    for (std::atomic<int> &v : visits) {
+        v = 0;
+    }
+    ParallelFor(0, visits.size(), [&](size_t i) {
+        ++visits[i];
+    }, 64, visits.size());
+
+    for (const std::atomic<int> &v : visits) {
+        EXPECT_EQ(1, v.load());
+    }
+}
+
+TEST(utParallelFor, smallWorkRunsSerially) {
+    ThreadRecorder recorder;
+    ParallelFor(0, 64, [&](size_t) {
+        recorder.Record();
+    }, 1, ParallelMinWork - 1);
+
+    ASSERT_EQ(1u, recorder.ids.size());
+    EXPECT_EQ(std::this_thread::get_id(), *recorder.ids.begin());
+}
+
+TEST(utParallelFor, limitScope) {
+    EXPECT_EQ(0u, ParallelLimitScope::GetCurrent());
+    {
+        ParallelLimitScope scope(1);
+        EXPECT_EQ(1u, ParallelLimitScope::GetCurrent());
+        EXPECT_EQ(1u, GetParallelWorkerCount());
+
+        ThreadRecorder recorder;
+        ParallelFor(0, 1000, [&](size_t) {
+            recorder.Record();
+        });
+        ASSERT_EQ(1u, recorder.ids.size());
+        EXPECT_EQ(std::this_thread::get_id(), *recorder.ids.begin());
+    }
+    EXPECT_EQ(0u, ParallelLimitScope::GetCurrent());
+
+    // nested loops on worker threads keep the limit
+    ParallelLimitScope scope(2);
+    std::atomic<int> wrongLimits(0);
+    ParallelFor(0, 100, [&](size_t) {
+        if (ParallelLimitScope::GetCurrent() != 2) {
+            ++wrongLimits;
+        }
+    });
+    EXPECT_EQ(0, wrongLimits.load());
+}
+
+TEST(utParallelFor, concurrentLoopsShareThePool) {
+    // each caller takes part itself, all other threads come from the shared pool
+    ThreadRecorder recorder;
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; ++c) {
+        callers.emplace_back([&recorder]() {
+            for (int run = 0; run < 10; ++run) {
+                ParallelFor(0, 1000, [&](size_t) {
+                    recorder.Record();
+                });
+            }
+        });
+    }
+    for (std::thread &caller : callers) {
+        caller.join();
+    }
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    EXPECT_LE(recorder.ids.size(), callers.size() + hardware - 1);
+}
+
+TEST(utParallelFor, rethrowsFirstException) {
+    std::atomic<int> calls(0);
+    EXPECT_THROW(ParallelFor(0, 100000, [&](size_t i) {
+        ++calls;
+        if (i == 10) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+
+    // the loop stops early and the pool stays usable
+    EXPECT_LT(calls.load(), 100000);
+    std::atomic<int> sum(0);
+    ParallelFor(0, 100, [&](size_t i) {
+        sum += static_cast<int>(i);
+    });
+    EXPECT_EQ(4950, sum.load());
+}
@@ -0,0 +1,124 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/StreamReader.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utStreamReader : public ::testing::Test {
+protected:
+    static const char *FileName() {
+        return ASSIMP_TEST_MODELS_DIR "/MS3D/jeep1.ms3d";
+    }
+
+    std::vector<uint8_t> readFile() {
+        std::unique_ptr<IOStream> stream(mIOSystem.Open(FileName(), "rb"));
+        EXPECT_NE(nullptr, stream);
+        std::vector<uint8_t> data(stream->FileSize());
+        EXPECT_EQ(data.size(), stream->Read(data.data(), 1, data.size()));
+        return data;
+    }
+
+    DefaultIOSystem mIOSystem;
+};
+
+TEST_F(utStreamReader, mappedFileMatchesContent) {
+    const std::vector<uint8_t> data = readFile();
+    ASSERT_LT(64u * 1024u, data.size());
+
+    StreamReaderLE reader(mIOSystem.Open(FileName(), "rb"));
+    ASSERT_EQ(data.size(), reader.GetRemainingSize());
+    EXPECT_EQ(0, ::memcmp(data.data(), reader.GetPtr(), data.size()));
+
+    uint32_t first = 0;
+    ::memcpy(&first, data.data(), 4);
+    EXPECT_EQ(first, reader.GetU4());
+
+    reader.SetReadLimit(16);
+    reader.IncPtr(12);
+    EXPECT_THROW(reader.GetU4(), DeadlyImportError);
+    reader.SetReadLimit(UINT_MAX);
+    reader.SetCurrentPos(data.size() - 4);
+    EXPECT_NO_THROW(reader.GetU4());
+    EXPECT_THROW(reader.GetU1(), DeadlyImportError);
+}
+
+TEST_F(utStreamReader, startsAtStreamPosition) {
+    const std::vector<uint8_t> data = readFile();
+
+    std::shared_ptr<IOStream> stream(mIOSystem.Open(FileName(), "rb"));
+    ASSERT_EQ(aiReturn_SUCCESS, stream->Seek(100, aiOrigin_SET));
+
+    StreamReaderLE reader(stream);
+    ASSERT_EQ(data.size() - 100, reader.GetRemainingSize());
+    EXPECT_EQ(0, reader.GetCurrentPos());
+    EXPECT_EQ(data[100], reader.GetU1());
+    EXPECT_EQ(stream->FileSize(), stream->Tell());
+}
+
+TEST_F(utStreamReader, writesDoNotReachFile) {
+    const std::vector<uint8_t> data = readFile();
+    {
+        StreamReaderLE reader(mIOSystem.Open(FileName(), "rb"));
+        int8_t *p = reader.GetPtr();
+        for (size_t i = 0; i < data.size(); i += 4096) {
+            p[i] = ~p[i];
+        }
+        EXPECT_EQ(static_cast<int8_t>(~data[0]), reader.GetI1());
+    }
+    EXPECT_EQ(data, readFile());
+}
+
+TEST_F(utStreamReader, readsMemoryStreams) {
+    const uint8_t data[] = { 1, 0, 0, 0, 0, 2 };
+    StreamReaderBE reader(new MemoryIOStream(data, sizeof(data)));
+    EXPECT_EQ(sizeof(data), reader.GetRemainingSize());
+    EXPECT_EQ(0x01000000u, reader.GetU4());
+    EXPECT_EQ(2u, reader.GetU2());
+    EXPECT_EQ(0u, reader.GetRemainingSize());
+}
@@ -0,0 +1,227 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/TextStreamWriter.h"
+
+#include <assimp/IOStream.hpp>
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// Collects everything written into a string, optionally failing all writes.
+class StringIOStream : public IOStream {
+public:
+    explicit StringIOStream(bool fail = false) :
+            mFail(fail), mWrites(0) {}
+
+    size_t Read(void *, size_t, size_t) override { return 0; }
+    size_t Write(const void *buffer, size_t size, size_t count) override {
+        ++mWrites;
+        if (mFail) {
+            return 0;
+        }
+        mData.append(static_cast<const char *>(buffer), size * count);
+        return count;
+    }
+    aiReturn Seek(size_t, aiOrigin) override { return aiReturn_FAILURE; }
+    size_t Tell() const override { return mData.size(); }
+    size_t FileSize() const override { return mData.size(); }
+    void Flush() override {}
+
+    bool mFail;
+    size_t mWrites;
+    std::string mData;
+};
+
+template <typename Real>
+std::string Format(Real value) {
+    char buffer[TextStreamWriter::MaxRealLength];
+    const size_t length = TextStreamWriter::FormatReal(value, buffer);
+    EXPECT_EQ(::strlen(buffer), length);
+    return buffer;
+}
+
+// Number of significant digits in the output of FormatReal, zeros which only pad the
+// integral part do not count
+size_t CountDigits(const std::string &s) {
+    std::string digits;
+    for (char c : s) {
+        if (c == 'e') {
+            break;
+        }
+        if ((c >= '1' && c <= '9') || (c == '0' && !digits.empty())) {
+            digits += c;
+        }
+    }
+    while (!digits.empty() && digits.back() == '0') {
+        digits.pop_back();
+    }
+    return digits.size();
+}
+
+} // namespace
+
+TEST(utTextStreamWriter, formatRealShortest) {
+    EXPECT_EQ("0", Format(0.0f));
+    EXPECT_EQ("-0", Format(-0.0f));
+    EXPECT_EQ("0.1", Format(0.1f));
+    EXPECT_EQ("0.1", Format(0.1));
+    EXPECT_EQ("1.5", Format(1.5f));
+    EXPECT_EQ("-2.25", Format(-2.25f));
+    EXPECT_EQ("100", Format(100.0f));
+    EXPECT_EQ("0.0001", Format(0.0001f));
+    EXPECT_EQ("1e-05", Format(1e-5f));
+    EXPECT_EQ("123456790", Format(123456789.0f));
+    EXPECT_EQ("1e+10", Format(1e10f));
+    EXPECT_EQ("1.23e+300", Format(1.23e300));
+    EXPECT_EQ("0.30000000000000004", Format(0.1 + 0.2));
+    EXPECT_EQ("1.0000001", Format(1.0000001f));
+    EXPECT_EQ("0.7999999999999999", Format(0.1 + 0.7));
+    // a power of two whose closest 16 digit neighbour does not read back
+    EXPECT_EQ("7.120236347223045e-307", Format(std::ldexp(1.0, -1017)));
+    EXPECT_EQ("nan", Format(std::numeric_limits<float>::quiet_NaN()));
+    EXPECT_EQ("inf", Format(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("-inf", Format(-std::numeric_limits<double>::infinity()));
+}
+
+TEST(utTextStreamWriter, formatRealRoundTrips) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> bits32;
+    std::uniform_int_distribution<uint64_t> bits64;
+    for (int i = 0; i < 100000; ++i) {
+        uint32_t b32 = bits32(rng);
+        float f;
+        ::memcpy(&f, &b32, sizeof(f));
+        if (f == f && std::abs(f) != std::numeric_limits<float>::infinity()) {
+            const std::string s = Format(f);
+            EXPECT_EQ(f, std::strtof(s.c_str(), nullptr)) << s;
+        }
+
+        uint64_t b64 = bits64(rng);
+        double d;
+        ::memcpy(&d, &b64, sizeof(d));
+        if (d == d && std::abs(d) != std::numeric_limits<double>::infinity()) {
+            const std::string s = Format(d);
+            EXPECT_EQ(d, std::strtod(s.c_str(), nullptr)) << s;
+        }
+    }
+}
+
+TEST(utTextStreamWriter, formatRealIsShortest) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> bits32;
+    std::uniform_int_distribution<uint64_t> bits64;
+    char shorter[64];
+    for (int i = 0; i < 100000; ++i) {
+        uint32_t b32 = bits32(rng) & 0x7fffffffu;
+        float f;
+        ::memcpy(&f, &b32, sizeof(f));
+        // powers of two may need the decimal above the correctly rounded one, skip them
+        if (f == f && f != std::numeric_limits<float>::infinity() && (b32 & 0x7fffff) != 0) {
+            const size_t digits = CountDigits(Format(f));
+            if (digits > 1) {
+                ::snprintf(shorter, sizeof(shorter), "%.*e", static_cast<int>(digits) - 2, f);
+                EXPECT_NE(f, std::strtof(shorter, nullptr)) << Format(f);
+            }
+        }
+
+        uint64_t b64 = bits64(rng) & 0x7fffffffffffffffull;
+        double d;
+        ::memcpy(&d, &b64, sizeof(d));
+        if (d == d && d != std::numeric_limits<double>::infinity() && (b64 & 0xfffffffffffffull) != 0) {
+            const size_t digits = CountDigits(Format(d));
+            if (digits > 1) {
+                ::snprintf(shorter, sizeof(shorter), "%.*e", static_cast<int>(digits) - 2, d);
+                EXPECT_NE(d, std::strtod(shorter, nullptr)) << Format(d);
+            }
+        }
+    }
+}
+
+TEST(utTextStreamWriter, writesIntegersAndText) {
+    StringIOStream stream;
+    {
+        TextStreamWriter writer(&stream);
+        writer << "v " << 0 << ' ' << INT_MIN << ' ' << UINT_MAX << ' ' << LLONG_MIN << ' ' << ULLONG_MAX
+               << ' ' << std::string("end") << ' ' << 0.5f << '\n';
+        EXPECT_TRUE(stream.mData.empty());
+    }
+    EXPECT_EQ("v 0 -2147483648 4294967295 -9223372036854775808 18446744073709551615 end 0.5\n", stream.mData);
+}
+
+TEST(utTextStreamWriter, flushesInChunks) {
+    StringIOStream stream;
+    std::string expected;
+    TextStreamWriter writer(&stream, 64);
+    for (unsigned int i = 0; i < 1000; ++i) {
+        writer << "line " << i << '\n';
+        expected += "line " + std::to_string(i) + '\n';
+    }
+    const std::string large(200, 'x');
+    writer << large;
+    expected += large;
+
+    writer.Flush();
+    EXPECT_TRUE(writer.IsGood());
+    EXPECT_EQ(expected, stream.mData);
+    EXPECT_GE(stream.mWrites, expected.size() / 64);
+}
+
+TEST(utTextStreamWriter, reportsWriteErrors) {
+    StringIOStream stream(true);
+    TextStreamWriter writer(&stream, 16);
+    writer << "some text which does not fit into the buffer";
+    EXPECT_FALSE(writer.IsGood());
+
+    const size_t writes = stream.mWrites;
+    writer << "more";
+    writer.Flush();
+    EXPECT_EQ(writes, stream.mWrites);
+}
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
 #include <assimp/material.h>
+#include <cstring>
 #include <sstream>
 
 namespace Assimp {
@@ -85,9 +86,16 @@ bool SceneDiffer::isEqual( const aiScene *expected, const aiScene *toCompare ) {
             std::stringstream stream;
             stream << "Meshes are not equal, index : " << i << "\n";
             addDiff( stream.str() );
+            return false;
         }
     }
 
+    // metadata
+    if ( !compareMetadata( expected->mMetaData, toCompare->mMetaData ) ) {
+        addDiff( "Scene metadata is not equal\n" );
+        return false;
+    }
+
     // materials
     /*if ( expected->mNumMaterials != toCompare->mNumMaterials ) {
         std::stringstream stream;
@@ -179,6 +187,19 @@ bool SceneDiffer::compareMesh( aiMesh *expected, aiMesh *toCompare ) {
         std::stringstream stream;
         stream << "Mesh name not equal ( expected: " << expected->mName.C_Str() << ", found : " << toCompare->mName.C_Str() << " )\n";
         addDiff( stream.str() );
+        return false;
+    }
+
+    if ( !expected->mAABB.mMin.Equal( toCompare->mAABB.mMin ) || !expected->mAABB.mMax.Equal( toCompare->mAABB.mMax ) ) {
+        std::stringstream stream;
+        stream << "AABB not equal ( expected: " << dumpVector3( expected->mAABB.mMin ) << " - " << dumpVector3( expected->mAABB.mMax )
+               << ", found: " << dumpVector3( toCompare->mAABB.mMin ) << " - " << dumpVector3( toCompare->mAABB.mMax ) << " )\n";
+        addDiff( stream.str() );
+        return false;
+    }
+
+    if ( !compareMeshlets( expected, toCompare ) ) {
+        return false;
     }
 
     if ( expected->mNumVertices != toCompare->mNumVertices ) {
@@ -332,6 +353,66 @@ bool SceneDiffer::compareMesh( aiMesh *expected, aiMesh *toCompare ) {
     return true;
 }
 
+bool SceneDiffer::compareMeshlets( aiMesh *expected, aiMesh *toCompare ) {
+    if ( expected->mNumMeshlets != toCompare->mNumMeshlets ||
+            expected->mNumMeshletVertices != toCompare->mNumMeshletVertices ||
+            expected->mNumMeshletIndices != toCompare->mNumMeshletIndices ) {
+        std::stringstream stream;
+        stream << "Number of meshlets not equal ( expected: " << expected->mNumMeshlets << ", found: " << toCompare->mNumMeshlets << " )\n";
+        addDiff( stream.str() );
+        return false;
+    }
+
+    for ( unsigned int i = 0; i < expected->mNumMeshlets; i++ ) {
+        const aiMeshlet &exp( expected->mMeshlets[ i ] );
+        const aiMeshlet &toComp( toCompare->mMeshlets[ i ] );
+        if ( exp.mVertexOffset != toComp.mVertexOffset || exp.mVertexCount != toComp.mVertexCount ||
+                exp.mIndexOffset != toComp.mIndexOffset || exp.mTriangleCount != toComp.mTriangleCount ||
+                !exp.mCenter.Equal( toComp.mCenter ) || !exp.mConeAxis.Equal( toComp.mConeAxis ) ) {
+            std::stringstream stream;
+            stream << "Meshlet not equal, index : " << i << "\n";
+            addDiff( stream.str() );
+            return false;
+        }
+    }
+
+    if ( expected->mNumMeshletVertices && 0 != ::memcmp( expected->mMeshletVertices, toCompare->mMeshletVertices, expected->mNumMeshletVertices * sizeof( unsigned int ) ) ) {
+        addDiff( "Meshlet vertices are not equal\n" );
+        return false;
+    }
+    if ( expected->mNumMeshletIndices && 0 != ::memcmp( expected->mMeshletIndices, toCompare->mMeshletIndices, expected->mNumMeshletIndices ) ) {
+        addDiff( "Meshlet indices are not equal\n" );
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneDiffer::compareMetadata( const aiMetadata *expected, const aiMetadata *toCompare ) {
+    // the importer adds entries of its own, so only the expected entries are checked
+    if ( nullptr == expected ) {
+        return true;
+    }
+
+    for ( unsigned int i = 0; i < expected->mNumProperties; i++ ) {
+        const aiMetadataEntry *entry = nullptr;
+        for ( unsigned int j = 0; nullptr != toCompare && j < toCompare->mNumProperties; j++ ) {
+            if ( expected->mKeys[ i ] == toCompare->mKeys[ j ] ) {
+                entry = &toCompare->mValues[ j ];
+                break;
+            }
+        }
+        if ( nullptr == entry || entry->mType != expected->mValues[ i ].mType ) {
+            std::stringstream stream;
+            stream << "Metadata entry missing or of different type: " << expected->mKeys[ i ].C_Str() << "\n";
+            addDiff( stream.str() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool SceneDiffer::compareFace( aiFace *expected, aiFace *toCompare ) {
     if ( nullptr == expected ) {
         return false;
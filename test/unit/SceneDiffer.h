@@ -51,6 +51,7 @@ struct aiScene;
 struct aiMesh;
 struct aiMaterial;
 struct aiFace;
+struct aiMetadata;
 
 namespace Assimp {
 
@@ -65,6 +66,8 @@ public:
 protected:
     void addDiff( const std::string &diff );
     bool compareMesh( aiMesh *expected, aiMesh *toCompare );
+    bool compareMeshlets( aiMesh *expected, aiMesh *toCompare );
+    bool compareMetadata( const aiMetadata *expected, const aiMetadata *toCompare );
     bool compareFace( aiFace *expected, aiFace *toCompare );
     bool compareMaterial( aiMaterial *expected, aiMaterial *toCompare );
 
@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/material.h>
 
+#include <algorithm>
+
 namespace Assimp {
 
 class TestModelFacttory {
@@ -96,6 +98,56 @@ public:
         return scene;
     }
 
+    // A flat triangle mesh of size x size quads per layer with normals and texture
+    // coordinates. The layers face +z and are stacked along z. If seam is not 0, the
+    // vertices of that column are duplicated with their own texture coordinates and
+    // the quads right of it use the copies.
+    static aiMesh *createGridMesh( unsigned int size, unsigned int numLayers = 1, unsigned int seam = 0 ) {
+        const unsigned int row = size + 1 + ( seam ? 1 : 0 );
+        const unsigned int layerVertices = row * ( size + 1 );
+        aiMesh *mesh = new aiMesh;
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = layerVertices * numLayers;
+        mesh->mVertices = new aiVector3D[ mesh->mNumVertices ];
+        mesh->mNormals = new aiVector3D[ mesh->mNumVertices ];
+        mesh->mTextureCoords[ 0 ] = new aiVector3D[ mesh->mNumVertices ];
+        mesh->mNumUVComponents[ 0 ] = 2;
+        for ( unsigned int layer = 0; layer < numLayers; ++layer ) {
+            for ( unsigned int y = 0; y <= size; ++y ) {
+                for ( unsigned int x = 0; x < row; ++x ) {
+                    const unsigned int column = ( seam && x > seam ) ? x - 1 : x;
+                    const unsigned int index = layer * layerVertices + y * row + x;
+                    mesh->mVertices[ index ] = aiVector3D( ai_real( column ), ai_real( y ), ai_real( layer ) );
+                    mesh->mNormals[ index ] = aiVector3D( 0, 0, 1 );
+                    mesh->mTextureCoords[ 0 ][ index ] = aiVector3D( ai_real( x ) / size, ai_real( y ) / size, 0 );
+                }
+            }
+        }
+
+        mesh->mNumFaces = size * size * 2 * numLayers;
+        mesh->mFaces = new aiFace[ mesh->mNumFaces ];
+        unsigned int face = 0;
+        for ( unsigned int layer = 0; layer < numLayers; ++layer ) {
+            const unsigned int base = layer * layerVertices;
+            for ( unsigned int y = 0; y < size; ++y ) {
+                for ( unsigned int x = 0; x < size; ++x ) {
+                    const unsigned int left = ( seam && x >= seam ) ? x + 1 : x;
+                    const unsigned int right = ( seam && x + 1 > seam ) ? x + 2 : x + 1;
+                    const unsigned int corners[ 4 ] = { base + y * row + left, base + y * row + right,
+                        base + ( y + 1 ) * row + right, base + ( y + 1 ) * row + left };
+                    const unsigned int triangles[ 2 ][ 3 ] = { { corners[ 0 ], corners[ 1 ], corners[ 2 ] },
+                        { corners[ 0 ], corners[ 2 ], corners[ 3 ] } };
+                    for ( unsigned int t = 0; t < 2; ++t, ++face ) {
+                        mesh->mFaces[ face ].mNumIndices = 3;
+                        mesh->mFaces[ face ].mIndices = new unsigned int[ 3 ];
+                        std::copy( triangles[ t ], triangles[ t ] + 3, mesh->mFaces[ face ].mIndices );
+                    }
+                }
+            }
+        }
+        return mesh;
+    }
+
     static void releaseDefaultTestModel( aiScene **scene ) {
         delete *scene;
         *scene = nullptr;
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -66,4 +67,151 @@ TEST_F(utAssbinImportExport, import3ExportAssbinDFromFileTest) {
     EXPECT_TRUE(importerTest());
 }
 
+TEST_F(utAssbinImportExport, importContiguousIndicesTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Exporter exporter;
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assbin"));
+
+    Importer contiguousImporter;
+    contiguousImporter.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *contiguousScene = contiguousImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.assbin", 0u);
+    ASSERT_NE(nullptr, contiguousScene);
+
+    ASSERT_EQ(scene->mNumMeshes, contiguousScene->mNumMeshes);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        const aiMesh *contiguousMesh = contiguousScene->mMeshes[m];
+        ASSERT_TRUE(contiguousMesh->HasIndexBuffer());
+        ASSERT_EQ(mesh->mNumFaces, contiguousMesh->mNumFaces);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            ASSERT_EQ(mesh->mFaces[i].mNumIndices, contiguousMesh->mFaces[i].mNumIndices);
+            EXPECT_EQ(0, memcmp(mesh->mFaces[i].mIndices, contiguousMesh->mFaces[i].mIndices, mesh->mFaces[i].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+TEST_F(utAssbinImportExport, exportImportFlatLayoutTest) {
+    // triangles only and mixed face sizes, each with and without an index buffer
+    const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box_longline.obj"
+    };
+    for (const char *file : files) {
+        for (int contiguous = 0; contiguous < 2; ++contiguous) {
+            Importer importer;
+            importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, contiguous != 0);
+            const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+            ASSERT_NE(nullptr, scene) << file;
+
+            ExportProperties properties;
+            properties.SetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_FLAT_LAYOUT, true);
+            Exporter exporter;
+            EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", 0u, &properties));
+
+            Importer flatImporter;
+            const aiScene *flatScene = flatImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", aiProcess_ValidateDataStructure);
+            ASSERT_NE(nullptr, flatScene) << file;
+            ASSERT_EQ(scene->mNumMeshes, flatScene->mNumMeshes);
+            EXPECT_EQ(scene->mNumMaterials, flatScene->mNumMaterials);
+            for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+                const aiMesh *mesh = scene->mMeshes[i], *flatMesh = flatScene->mMeshes[i];
+                ASSERT_EQ(mesh->mNumVertices, flatMesh->mNumVertices);
+                ASSERT_EQ(mesh->mNumFaces, flatMesh->mNumFaces);
+                EXPECT_EQ(0, memcmp(mesh->mVertices, flatMesh->mVertices, mesh->mNumVertices * sizeof(aiVector3D)));
+                for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                    ASSERT_EQ(mesh->mFaces[f].mNumIndices, flatMesh->mFaces[f].mNumIndices);
+                    EXPECT_EQ(0, memcmp(mesh->mFaces[f].mIndices, flatMesh->mFaces[f].mIndices, mesh->mFaces[f].mNumIndices * sizeof(unsigned int)));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(utAssbinImportExport, importFlatLayoutIndexBufferOptInTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_FLAT_LAYOUT, true);
+    Exporter exporter;
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", 0u, &properties));
+
+    // without the property each face owns its indices, as legacy code expects
+    Importer flatImporter;
+    aiScene *flatScene = const_cast<aiScene *>(flatImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", 0u));
+    ASSERT_NE(nullptr, flatScene);
+    for (unsigned int i = 0; i < flatScene->mNumMeshes; ++i) {
+        aiMesh *mesh = flatScene->mMeshes[i];
+        EXPECT_FALSE(mesh->HasIndexBuffer());
+        ASSERT_LT(1u, mesh->mNumFaces);
+        mesh->mFaces[1] = mesh->mFaces[0];
+        EXPECT_EQ(0, memcmp(mesh->mFaces[0].mIndices, mesh->mFaces[1].mIndices, mesh->mFaces[0].mNumIndices * sizeof(unsigned int)));
+    }
+
+    Importer contiguousImporter;
+    contiguousImporter.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *contiguousScene = contiguousImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", 0u);
+    ASSERT_NE(nullptr, contiguousScene);
+    for (unsigned int i = 0; i < contiguousScene->mNumMeshes; ++i) {
+        EXPECT_TRUE(contiguousScene->mMeshes[i]->HasIndexBuffer());
+    }
+}
+
+TEST_F(utAssbinImportExport, exportImportFlatTexturesTest) {
+    // once with the compressed images, once with decoded texels
+    for (int decode = 0; decode < 2; ++decode) {
+        Importer importer;
+        importer.SetPropertyBool(AI_CONFIG_PP_ET_DECODE, decode != 0);
+        importer.SetPropertyInteger(AI_CONFIG_PP_ET_MAX_SIZE, 32);
+        const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_EmbedTextures | aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+        ASSERT_LT(0u, scene->mNumTextures);
+
+        ExportProperties properties;
+        properties.SetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_FLAT_LAYOUT, true);
+        Exporter exporter;
+        EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", 0u, &properties));
+
+        Importer flatImporter;
+        const aiScene *flatScene = flatImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_flat_out.assbin", aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, flatScene);
+        ASSERT_EQ(scene->mNumTextures, flatScene->mNumTextures);
+        for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+            const aiTexture *tex = scene->mTextures[i], *flatTex = flatScene->mTextures[i];
+            ASSERT_EQ(tex->mWidth, flatTex->mWidth);
+            ASSERT_EQ(tex->mHeight, flatTex->mHeight);
+            EXPECT_EQ(decode != 0, tex->mHeight != 0);
+            const size_t size = tex->mHeight ? tex->mWidth * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+            EXPECT_EQ(0, memcmp(tex->pcData, flatTex->pcData, size));
+        }
+    }
+}
+
+TEST_F(utAssbinImportExport, exportImportCompressedTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ExportProperties properties;
+    properties.SetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_COMPRESSION, 1);
+    Exporter exporter;
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "assbin", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_compressed_out.assbin", 0u, &properties));
+
+    Importer compressedImporter;
+    const aiScene *compressedScene = compressedImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_compressed_out.assbin", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, compressedScene);
+    ASSERT_EQ(scene->mNumMeshes, compressedScene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i], *compressedMesh = compressedScene->mMeshes[i];
+        ASSERT_EQ(mesh->mNumVertices, compressedMesh->mNumVertices);
+        ASSERT_EQ(mesh->mNumFaces, compressedMesh->mNumFaces);
+        EXPECT_EQ(0, memcmp(mesh->mVertices, compressedMesh->mVertices, mesh->mNumVertices * sizeof(aiVector3D)));
+    }
+}
+
 #endif // #ifndef ASSIMP_BUILD_NO_EXPORT
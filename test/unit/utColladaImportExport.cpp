@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/ColladaMetaData.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/LogStream.hpp>
 #include <assimp/SceneCombiner.h>
 #include <assimp/commonMetaData.h>
 #include <assimp/postprocess.h>
@@ -342,6 +344,111 @@ TEST_F(utColladaImportExport, exporterUniqueIdsTest) {
     ImportAsNames(outFileNamed, scene);
 }
 
+TEST_F(utColladaImportExport, contiguousIndicesTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/teapots.DAE", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Importer contiguousImporter;
+    contiguousImporter.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+    const aiScene *contiguousScene = contiguousImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/teapots.DAE", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, contiguousScene);
+
+    ASSERT_EQ(scene->mNumMeshes, contiguousScene->mNumMeshes);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        const aiMesh *contiguousMesh = contiguousScene->mMeshes[m];
+        EXPECT_FALSE(mesh->HasIndexBuffer());
+        ASSERT_TRUE(contiguousMesh->HasIndexBuffer());
+        ASSERT_EQ(mesh->mNumFaces, contiguousMesh->mNumFaces);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            ASSERT_EQ(mesh->mFaces[i].mNumIndices, contiguousMesh->mFaces[i].mNumIndices);
+            EXPECT_EQ(0, memcmp(mesh->mFaces[i].mIndices, contiguousMesh->mFaces[i].mIndices, mesh->mFaces[i].mNumIndices * sizeof(unsigned int)));
+        }
+    }
+}
+
+// The second geometry uses a source declared in the first one. Geometries are read in
+// parallel without access to each other's sources, so the second read fails and is repeated
+// serially once the sources of the first one are in the global libraries.
+TEST_F(utColladaImportExport, geometryWithOutsideSourceTest) {
+    struct LogObserver : LogStream {
+        std::vector<std::string> mIndexCountWarnings;
+        void write(const char *message) override {
+            if (std::strstr(message, "Expected different index count")) {
+                mIndexCountWarnings.push_back(message);
+            }
+        }
+    };
+    LogObserver logObserver;
+    DefaultLogger::get()->attachStream(&logObserver, Logger::Warn);
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/shared_source.dae", aiProcess_ValidateDataStructure);
+    DefaultLogger::get()->detachStream(&logObserver, Logger::Warn);
+    ASSERT_NE(nullptr, scene);
+
+    const aiNode *first = scene->mRootNode->FindNode("first-node");
+    const aiNode *second = scene->mRootNode->FindNode("second-node");
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    ASSERT_EQ(2u, first->mNumMeshes);
+    ASSERT_EQ(2u, second->mNumMeshes);
+
+    // the triangle of the second geometry has the vertices of the first in reverse order
+    const aiMesh *firstTriangle = nullptr, *secondTriangle = nullptr;
+    for (unsigned int i = 0; i < 2; ++i) {
+        if (scene->mMeshes[first->mMeshes[i]]->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+            firstTriangle = scene->mMeshes[first->mMeshes[i]];
+        }
+        if (scene->mMeshes[second->mMeshes[i]]->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+            secondTriangle = scene->mMeshes[second->mMeshes[i]];
+        }
+    }
+    ASSERT_NE(nullptr, firstTriangle);
+    ASSERT_NE(nullptr, secondTriangle);
+    ASSERT_EQ(3u, firstTriangle->mNumVertices);
+    ASSERT_EQ(3u, secondTriangle->mNumVertices);
+    EXPECT_EQ(aiVector3D(1, 0, 0), firstTriangle->mVertices[1]);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(firstTriangle->mVertices[i], secondTriangle->mVertices[2 - i]);
+    }
+
+    // the messages of each geometry are logged once, in file order, despite the second read
+    ASSERT_EQ(2u, logObserver.mIndexCountWarnings.size());
+    EXPECT_NE(std::string::npos, logObserver.mIndexCountWarnings[0].find("2 instead of 4"));
+    EXPECT_NE(std::string::npos, logObserver.mIndexCountWarnings[1].find("2 instead of 6"));
+}
+
+// Morph targets are copied from other meshes while the meshes are built, so the geometry of
+// the target must not be deferred.
+TEST_F(utColladaImportExport, morphTargetsAreNotDeferredTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/morph.dae", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    const aiNode *target = scene->mRootNode->FindNode("target-node");
+    const aiNode *base = scene->mRootNode->FindNode("base-node");
+    ASSERT_NE(nullptr, target);
+    ASSERT_NE(nullptr, base);
+    ASSERT_EQ(1u, target->mNumMeshes);
+    ASSERT_EQ(1u, base->mNumMeshes);
+
+    const aiMesh *targetMesh = scene->mMeshes[target->mMeshes[0]];
+    const aiMesh *baseMesh = scene->mMeshes[base->mMeshes[0]];
+    ASSERT_EQ(3u, targetMesh->mNumVertices);
+    EXPECT_EQ(aiVector3D(0, 0, 0), baseMesh->mVertices[0]);
+    ASSERT_EQ(1u, baseMesh->mNumAnimMeshes);
+    const aiAnimMesh *animMesh = baseMesh->mAnimMeshes[0];
+    EXPECT_FLOAT_EQ(0.5f, animMesh->mWeight);
+    ASSERT_EQ(3u, animMesh->mNumVertices);
+    ASSERT_NE(nullptr, animMesh->mVertices);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(targetMesh->mVertices[i], animMesh->mVertices[i]);
+    }
+    EXPECT_EQ(aiVector3D(0, 0, 1), animMesh->mVertices[0]);
+}
+
 class utColladaZaeImportExport : public AbstractImportExportBase {
 public:
     virtual bool importerTest() final {
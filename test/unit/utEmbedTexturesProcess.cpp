@@ -0,0 +1,123 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/EmbedTexturesProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/material.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utEmbedTexturesProcess : public ::testing::Test {
+public:
+    utEmbedTexturesProcess() :
+            Test(), mProcess(nullptr), mScene(nullptr) {
+        // empty
+    }
+
+    void SetUp() override {
+        mProcess = new EmbedTexturesProcess;
+        mScene = new aiScene();
+        mScene->mRootNode = new aiNode();
+        mScene->mNumMaterials = 2;
+        mScene->mMaterials = new aiMaterial *[2];
+        mScene->mMaterials[0] = new aiMaterial();
+        mScene->mMaterials[1] = new aiMaterial();
+    }
+
+    void TearDown() override {
+        delete mProcess;
+        delete mScene;
+    }
+
+    void AddTexture(unsigned int material, aiTextureType type, const char *path) {
+        aiString str(path);
+        mScene->mMaterials[material]->AddProperty(&str, AI_MATKEY_TEXTURE(type, 0));
+    }
+
+    std::string GetTexture(unsigned int material, aiTextureType type) {
+        aiString str;
+        mScene->mMaterials[material]->GetTexture(type, 0, &str);
+        return str.C_Str();
+    }
+
+protected:
+    EmbedTexturesProcess *mProcess;
+    aiScene *mScene;
+};
+
+TEST_F(utEmbedTexturesProcess, embedIdenticalImagesOnceTest) {
+    AddTexture(0, aiTextureType_DIFFUSE, ASSIMP_TEST_MODELS_DIR "/OBJ/SpiderTex.jpg");
+    AddTexture(0, aiTextureType_SPECULAR, ASSIMP_TEST_MODELS_DIR "/OBJ/drkwood2.jpg");
+    AddTexture(1, aiTextureType_DIFFUSE, ASSIMP_TEST_MODELS_DIR "/OBJ/../OBJ/SpiderTex.jpg");
+    AddTexture(1, aiTextureType_SPECULAR, ASSIMP_TEST_MODELS_DIR "/OBJ/missing.jpg");
+    mProcess->Execute(mScene);
+
+    ASSERT_EQ(2u, mScene->mNumTextures);
+    EXPECT_EQ(0u, mScene->mTextures[0]->mHeight);
+    EXPECT_TRUE(mScene->mTextures[0]->CheckFormat("jpg"));
+    EXPECT_EQ("*0", GetTexture(0, aiTextureType_DIFFUSE));
+    EXPECT_EQ("*1", GetTexture(0, aiTextureType_SPECULAR));
+    EXPECT_EQ("*0", GetTexture(1, aiTextureType_DIFFUSE));
+    EXPECT_EQ(ASSIMP_TEST_MODELS_DIR "/OBJ/missing.jpg", GetTexture(1, aiTextureType_SPECULAR));
+}
+
+TEST_F(utEmbedTexturesProcess, decodeAndDownscaleTest) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_ET_DECODE, true);
+    importer.SetPropertyInteger(AI_CONFIG_PP_ET_MAX_SIZE, 64);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_EmbedTextures | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    // five distinct images, the largest one is 768x768
+    ASSERT_EQ(5u, scene->mNumTextures);
+    for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+        const aiTexture *texture = scene->mTextures[i];
+        EXPECT_TRUE(texture->CheckFormat("argb8888"));
+        EXPECT_NE(0u, texture->mHeight);
+        EXPECT_LE(texture->mWidth, 64u);
+        EXPECT_LE(texture->mHeight, 64u);
+        EXPECT_GT(texture->mWidth, 32u);
+    }
+}
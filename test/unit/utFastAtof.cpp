@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/fast_atof.h>
 
+#include <cstdio>
+#include <cstring>
+#include <random>
+
 namespace {
 
 template <typename Real>
@@ -188,3 +192,82 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+TEST_F(FastAtofTest, CorrectlyRounded)
+{
+    // compare against the C library, which rounds correctly
+    const char* cases[] = {
+        "0.1", "0.3", "1.1", "3.14159265358979323846", "2.7182818284590452353602874713527",
+        "123456789.123456789", "9007199254740993", "1.00000005960464477539", "0.000123456789",
+        "1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324", "3.4028234663852886e38",
+        "1.1754943508222875e-38", "16777217", "0.333333333333333333333333333333", "1e22", "1e23",
+        "8.589973e9", "7.038531e-26", "-1.234567e-05", "1.00000017881393432617187499"
+    };
+
+    for (const char* str : cases) {
+        double d = 0.0;
+        Assimp::fast_atoreal_move<double>(str, d);
+        EXPECT_EQ(std::strtod(str, nullptr), d) << str;
+
+        float f = 0.0f;
+        Assimp::fast_atoreal_move<float>(str, f);
+        EXPECT_EQ(std::strtof(str, nullptr), f) << str;
+    }
+}
+
+TEST_F(FastAtofTest, BlockwiseDigits)
+{
+    // long digit runs are converted in blocks of eight if the end is known
+    const std::string str = "1234567890123456.7890123456789 ";
+    double bounded = 0.0;
+    const char* end = Assimp::fast_atoreal_move<double>(str.c_str(), str.c_str() + str.size(), bounded);
+    EXPECT_EQ(str.c_str() + str.size() - 1, end);
+    EXPECT_EQ(std::strtod(str.c_str(), nullptr), bounded);
+
+    double unbounded = 0.0;
+    Assimp::fast_atoreal_move<double>(str.c_str(), unbounded);
+    EXPECT_EQ(bounded, unbounded);
+}
+
+TEST_F(FastAtofTest, LongMantissas)
+{
+    // 17 significant digits exceed 2^53 and take the extended or the slow path
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> mantissas(1.0, 10.0);
+    std::uniform_int_distribution<int> exponents(-40, 40);
+    for (unsigned int i = 0; i < 10000; ++i) {
+        char str[64];
+        std::snprintf(str, sizeof(str), "%.16fe%d", mantissas(rng), exponents(rng));
+
+        double d = 0.0;
+        Assimp::fast_atoreal_move<double>(str, str + std::strlen(str), d);
+        EXPECT_EQ(std::strtod(str, nullptr), d) << str;
+
+        float f = 0.0f;
+        Assimp::fast_atoreal_move<float>(str, str + std::strlen(str), f);
+        EXPECT_EQ(std::strtof(str, nullptr), f) << str;
+    }
+
+    // more digits than fit into the stack buffer of the slow path
+    const std::string str = "0." + std::string(150, '3') + "e-2";
+    double d = 0.0;
+    Assimp::fast_atoreal_move<double>(str.c_str(), d);
+    EXPECT_EQ(std::strtod(str.c_str(), nullptr), d);
+}
+
+TEST_F(FastAtofTest, ParseMultiple)
+{
+    const std::string str = "1.5 -2\t3e2 4\n5";
+    float values[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    unsigned int numParsed = 0;
+    const char* end = Assimp::fast_atoreal_move_n<float>(str.c_str(), str.c_str() + str.size(), values, 5, &numParsed);
+
+    // stops at the line end
+    EXPECT_EQ(4u, numParsed);
+    EXPECT_EQ('\n', *end);
+    EXPECT_EQ(1.5f, values[0]);
+    EXPECT_EQ(-2.0f, values[1]);
+    EXPECT_EQ(300.0f, values[2]);
+    EXPECT_EQ(4.0f, values[3]);
+    EXPECT_EQ(0.0f, values[4]);
+}
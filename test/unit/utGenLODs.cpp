@@ -0,0 +1,183 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/GenLODsProcess.h"
+#include <assimp/commonMetaData.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <memory>
+
+using namespace Assimp;
+
+class utGenLODs : public ::testing::Test {
+protected:
+    static bool HasVertexAt(const aiMesh *mesh, const aiVector3D &position);
+
+    GenLODsProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+bool utGenLODs::HasVertexAt(const aiMesh *mesh, const aiVector3D &position) {
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        if (mesh->mVertices[i] == position) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenLODs, simplifiesToTheRatios) {
+    std::unique_ptr<aiMesh> grid(TestModelFacttory::createGridMesh(20));
+    mProcess.mRatios = { 0.5f, 0.25f };
+
+    std::vector<aiMesh *> levels;
+    mProcess.ProcessMesh(grid.get(), levels);
+    ASSERT_EQ(2u, levels.size());
+    std::unique_ptr<aiMesh> first(levels[0]), second(levels[1]);
+
+    EXPECT_LE(first->mNumFaces, 400u);
+    EXPECT_LT(second->mNumFaces, first->mNumFaces);
+    EXPECT_LT(second->mNumVertices, first->mNumVertices);
+    EXPECT_NE(nullptr, second->mTextureCoords[0]);
+    EXPECT_EQ(2u, second->mNumUVComponents[0]);
+
+    // the grid stays flat, no triangle flips and the border is kept
+    for (unsigned int i = 0; i < second->mNumFaces; ++i) {
+        const unsigned int *face = second->mFaces[i].mIndices;
+        const aiVector3D *v = second->mVertices;
+        const aiVector3D normal = (v[face[1]] - v[face[0]]) ^ (v[face[2]] - v[face[0]]);
+        EXPECT_GT(normal.z, 0.0f);
+    }
+    for (unsigned int i = 0; i <= 20; ++i) {
+        EXPECT_TRUE(HasVertexAt(second.get(), aiVector3D(ai_real(i), 0, 0)));
+        EXPECT_TRUE(HasVertexAt(second.get(), aiVector3D(0, ai_real(i), 0)));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenLODs, keepsSeams) {
+    std::unique_ptr<aiMesh> grid(TestModelFacttory::createGridMesh(20, 1, 10));
+    mProcess.mRatios = { 0.25f };
+
+    std::vector<aiMesh *> levels;
+    mProcess.ProcessMesh(grid.get(), levels);
+    ASSERT_EQ(1u, levels.size());
+    std::unique_ptr<aiMesh> lod(levels[0]);
+    EXPECT_LT(lod->mNumFaces, grid->mNumFaces);
+
+    for (unsigned int y = 0; y <= 20; ++y) {
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < lod->mNumVertices; ++i) {
+            count += lod->mVertices[i] == aiVector3D(10, ai_real(y), 0) ? 1 : 0;
+        }
+        EXPECT_EQ(2u, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenLODs, copiesOtherPrimitives) {
+    aiMesh points;
+    points.mPrimitiveTypes = aiPrimitiveType_POINT;
+    points.mNumVertices = 2;
+    points.mVertices = new aiVector3D[2];
+    points.mNumFaces = 2;
+    points.mFaces = new aiFace[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        points.mFaces[i].mNumIndices = 1;
+        points.mFaces[i].mIndices = new unsigned int[1];
+        points.mFaces[i].mIndices[0] = i;
+    }
+    mProcess.mRatios = { 0.5f };
+
+    std::vector<aiMesh *> levels;
+    mProcess.ProcessMesh(&points, levels);
+    ASSERT_EQ(1u, levels.size());
+    std::unique_ptr<aiMesh> copy(levels[0]);
+    EXPECT_EQ(2u, copy->mNumFaces);
+    EXPECT_STREQ("_LOD1", copy->mName.C_Str());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenLODs, appendsLevelsToTheScene) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_LOD_ENABLE, true);
+    importer.SetPropertyString(AI_CONFIG_PP_LOD_RATIOS, "0.25 0.5");
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_ValidateDataStructure | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, scene);
+
+    int32_t levels = 0, meshCount = 0;
+    ASSERT_TRUE(scene->mMetaData->Get(AI_METADATA_LOD_LEVELS, levels));
+    ASSERT_TRUE(scene->mMetaData->Get(AI_METADATA_LOD_MESH_COUNT, meshCount));
+    EXPECT_EQ(2, levels);
+    EXPECT_EQ(scene->mNumMeshes, static_cast<unsigned int>(meshCount * 3));
+
+    for (int32_t i = 0; i < meshCount; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        const aiMesh *half = scene->mMeshes[i + meshCount];
+        const aiMesh *quarter = scene->mMeshes[i + 2 * meshCount];
+        EXPECT_LE(half->mNumFaces, mesh->mNumFaces);
+        EXPECT_LE(quarter->mNumFaces, half->mNumFaces);
+        EXPECT_EQ(mesh->mMaterialIndex, quarter->mMaterialIndex);
+        EXPECT_EQ(std::string(mesh->mName.C_Str()) + "_LOD2", quarter->mName.C_Str());
+    }
+
+    // the nodes get a child per level which references the simplified meshes
+    const aiNode *node = scene->mRootNode->mNumMeshes ? scene->mRootNode : scene->mRootNode->mChildren[0];
+    ASSERT_LT(0u, node->mNumMeshes);
+    const aiNode *child = node->FindNode((std::string(node->mName.C_Str()) + "_LOD2").c_str());
+    ASSERT_NE(nullptr, child);
+    int32_t level = 0;
+    ASSERT_NE(nullptr, child->mMetaData);
+    ASSERT_TRUE(child->mMetaData->Get(AI_METADATA_LOD_LEVEL, level));
+    EXPECT_EQ(2, level);
+    ASSERT_EQ(node->mNumMeshes, child->mNumMeshes);
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        EXPECT_EQ(node->mMeshes[i] + 2 * meshCount, child->mMeshes[i]);
+    }
+}
@@ -0,0 +1,176 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+using namespace Assimp;
+
+class utGenMeshlets : public ::testing::Test {
+protected:
+    // Checks the limits and that every face is part of exactly one meshlet
+    void CheckMeshlets(const aiMesh *mesh) const;
+
+    GenMeshletsProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void utGenMeshlets::CheckMeshlets(const aiMesh *mesh) const {
+    ASSERT_TRUE(mesh->HasMeshlets());
+
+    std::vector<std::array<unsigned int, 3>> faces, expected;
+    for (unsigned int i = 0; i < mesh->mNumMeshlets; ++i) {
+        const aiMeshlet &meshlet = mesh->mMeshlets[i];
+        EXPECT_LE(meshlet.mVertexCount, mProcess.mMaxVertices);
+        EXPECT_LE(meshlet.mTriangleCount, mProcess.mMaxTriangles);
+        ASSERT_LE(meshlet.mVertexOffset + meshlet.mVertexCount, mesh->mNumMeshletVertices);
+        ASSERT_LE(meshlet.mIndexOffset + meshlet.mTriangleCount * 3, mesh->mNumMeshletIndices);
+
+        for (unsigned int t = 0; t < meshlet.mTriangleCount; ++t) {
+            std::array<unsigned int, 3> face;
+            for (unsigned int a = 0; a < 3; ++a) {
+                const unsigned char index = mesh->mMeshletIndices[meshlet.mIndexOffset + t * 3 + a];
+                ASSERT_LT(index, meshlet.mVertexCount);
+                face[a] = mesh->mMeshletVertices[meshlet.mVertexOffset + index];
+                EXPECT_LE((mesh->mVertices[face[a]] - meshlet.mCenter).Length(), meshlet.mRadius + 1e-4f);
+            }
+            faces.push_back(face);
+        }
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const unsigned int *idx = mesh->mFaces[i].mIndices;
+        expected.push_back({ { idx[0], idx[1], idx[2] } });
+    }
+    std::sort(faces.begin(), faces.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, faces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshlets, coversAllFacesWithinLimits) {
+    std::unique_ptr<aiMesh> grid(TestModelFacttory::createGridMesh(32));
+    ASSERT_TRUE(mProcess.ProcessMesh(grid.get()));
+    CheckMeshlets(grid.get());
+
+    // 2048 triangles need at least 17 meshlets of 124 triangles, a good partition
+    // of a regular grid stays close to that
+    EXPECT_GE(grid->mNumMeshlets, 17u);
+    EXPECT_LE(grid->mNumMeshlets, 48u);
+
+    mProcess.mMaxVertices = 16;
+    mProcess.mMaxTriangles = 10;
+    ASSERT_TRUE(mProcess.ProcessMesh(grid.get()));
+    CheckMeshlets(grid.get());
+    EXPECT_GE(grid->mNumMeshlets, 205u);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshlets, computesCullingCones) {
+    std::unique_ptr<aiMesh> grid(TestModelFacttory::createGridMesh(16));
+    ASSERT_TRUE(mProcess.ProcessMesh(grid.get()));
+
+    for (unsigned int i = 0; i < grid->mNumMeshlets; ++i) {
+        const aiMeshlet &meshlet = grid->mMeshlets[i];
+        EXPECT_NEAR(1.0f, meshlet.mConeAxis.z, 1e-5f);
+        EXPECT_LT(meshlet.mConeCutoff, 1.0f);
+
+        // visible from above, culled from below
+        aiVector3D above = meshlet.mConeApex - aiVector3D(8, 8, 10);
+        aiVector3D below = meshlet.mConeApex - aiVector3D(8, 8, -10);
+        EXPECT_LT(above.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+        EXPECT_GE(below.Normalize() * meshlet.mConeAxis, meshlet.mConeCutoff);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshlets, skipsOtherPrimitives) {
+    aiMesh lines;
+    lines.mPrimitiveTypes = aiPrimitiveType_LINE;
+    lines.mNumVertices = 2;
+    lines.mVertices = new aiVector3D[2];
+    lines.mNumFaces = 1;
+    lines.mFaces = new aiFace[1];
+    lines.mFaces[0].mNumIndices = 2;
+    lines.mFaces[0].mIndices = new unsigned int[2];
+    lines.mFaces[0].mIndices[0] = 0;
+    lines.mFaces[0].mIndices[1] = 1;
+
+    EXPECT_FALSE(mProcess.ProcessMesh(&lines));
+    EXPECT_FALSE(lines.HasMeshlets());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utGenMeshlets, generatesMeshletsOnImport) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_ML_ENABLE, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_ValidateDataStructure | aiProcess_Triangulate | aiProcess_SortByPType |
+                    aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality);
+    ASSERT_NE(nullptr, scene);
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        CheckMeshlets(scene->mMeshes[i]);
+    }
+
+    // copies of the scene keep the meshlets
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, scene);
+    ASSERT_NE(nullptr, copy);
+    for (unsigned int i = 0; i < copy->mNumMeshes; ++i) {
+        const aiMesh *mesh = copy->mMeshes[i];
+        ASSERT_EQ(scene->mMeshes[i]->mNumMeshlets, mesh->mNumMeshlets);
+        EXPECT_NE(scene->mMeshes[i]->mMeshlets, mesh->mMeshlets);
+        EXPECT_TRUE(std::equal(mesh->mMeshletIndices, mesh->mMeshletIndices + mesh->mNumMeshletIndices,
+                scene->mMeshes[i]->mMeshletIndices));
+    }
+    delete copy;
+}
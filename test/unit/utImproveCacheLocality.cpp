@@ -40,3 +40,171 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/ImproveCacheLocality.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+
+using namespace Assimp;
+
+class utImproveCacheLocality : public ::testing::Test {
+protected:
+    typedef std::array<ai_real, 9> Triangle;
+
+    // Scene with one mesh made of size x size quads per layer, the layers are stacked along z.
+    // Faces and vertices are shuffled unless the layers should stay in order.
+    static aiScene *CreateScene(unsigned int size, unsigned int numLayers, bool shuffle);
+
+    static unsigned int CountCacheMisses(const aiMesh *mesh);
+
+    static std::vector<Triangle> GetTriangles(const aiMesh *mesh);
+
+    void Run(aiScene *scene, const Importer &importer) {
+        mProcess.SetupProperties(&importer);
+        mProcess.Execute(scene);
+    }
+
+    ImproveCacheLocalityProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+aiScene *utImproveCacheLocality::CreateScene(unsigned int size, unsigned int numLayers, bool shuffle) {
+    aiMesh *mesh = TestModelFacttory::createGridMesh(size, numLayers);
+    if (shuffle) {
+        std::mt19937 random(42);
+        std::vector<unsigned int> remap(mesh->mNumVertices);
+        for (unsigned int i = 0; i < remap.size(); ++i) {
+            remap[i] = i;
+        }
+        std::vector<unsigned int> faceOrder(mesh->mNumFaces);
+        for (unsigned int i = 0; i < faceOrder.size(); ++i) {
+            faceOrder[i] = i;
+        }
+        std::shuffle(remap.begin(), remap.end(), random);
+        std::shuffle(faceOrder.begin(), faceOrder.end(), random);
+
+        aiVector3D *const streams[] = { mesh->mVertices, mesh->mNormals, mesh->mTextureCoords[0] };
+        for (aiVector3D *stream : streams) {
+            const std::vector<aiVector3D> values(stream, stream + mesh->mNumVertices);
+            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+                stream[remap[i]] = values[i];
+            }
+        }
+
+        aiFace *faces = new aiFace[mesh->mNumFaces];
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            std::swap(faces[i], mesh->mFaces[faceOrder[i]]);
+            for (unsigned int c = 0; c < 3; ++c) {
+                faces[i].mIndices[c] = remap[faces[i].mIndices[c]];
+            }
+        }
+        delete[] mesh->mFaces;
+        mesh->mFaces = faces;
+    }
+
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = mesh;
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int utImproveCacheLocality::CountCacheMisses(const aiMesh *mesh) {
+    std::vector<unsigned int> fifo;
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const unsigned int index = mesh->mFaces[i].mIndices[c];
+            if (std::find(fifo.begin(), fifo.end(), index) == fifo.end()) {
+                ++misses;
+                fifo.push_back(index);
+                if (fifo.size() > PP_ICL_PTCACHE_SIZE) {
+                    fifo.erase(fifo.begin());
+                }
+            }
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<utImproveCacheLocality::Triangle> utImproveCacheLocality::GetTriangles(const aiMesh *mesh) {
+    std::vector<Triangle> triangles;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        Triangle triangle;
+        for (unsigned int c = 0; c < 3; ++c) {
+            const aiVector3D &v = mesh->mVertices[mesh->mFaces[i].mIndices[c]];
+            triangle[c * 3] = v.x;
+            triangle[c * 3 + 1] = v.y;
+            triangle[c * 3 + 2] = v.z;
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, reducesCacheMisses) {
+    std::unique_ptr<aiScene> scene(CreateScene(16, 1, true));
+    const unsigned int missesBefore = CountCacheMisses(scene->mMeshes[0]);
+    const std::vector<Triangle> trianglesBefore = GetTriangles(scene->mMeshes[0]);
+
+    Importer importer;
+    Run(scene.get(), importer);
+    EXPECT_LT(CountCacheMisses(scene->mMeshes[0]), missesBefore / 2);
+    EXPECT_EQ(trianglesBefore, GetTriangles(scene->mMeshes[0]));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, reordersVerticesForFetch) {
+    std::unique_ptr<aiScene> scene(CreateScene(16, 1, true));
+    const std::vector<Triangle> trianglesBefore = GetTriangles(scene->mMeshes[0]);
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH, true);
+    Run(scene.get(), importer);
+
+    // every face only introduces vertices following the ones used before
+    const aiMesh *mesh = scene->mMeshes[0];
+    unsigned int next = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const unsigned int index = mesh->mFaces[i].mIndices[c];
+            EXPECT_LE(index, next);
+            next = std::max(next, index + 1);
+        }
+    }
+    EXPECT_EQ(mesh->mNumVertices, next);
+    EXPECT_EQ(trianglesBefore, GetTriangles(mesh));
+    EXPECT_EQ(aiVector3D(0, 0, 1), mesh->mNormals[0]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utImproveCacheLocality, drawsOuterClustersFirst) {
+    std::unique_ptr<aiScene> scene(CreateScene(4, 2, false));
+    const std::vector<Triangle> trianglesBefore = GetTriangles(scene->mMeshes[0]);
+    EXPECT_EQ(0.0f, scene->mMeshes[0]->mVertices[scene->mMeshes[0]->mFaces[0].mIndices[0]].z);
+
+    Importer importer;
+    importer.SetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD, 1.05f);
+    Run(scene.get(), importer);
+
+    // both layers face +z, so the upper one occludes the lower one
+    const aiMesh *mesh = scene->mMeshes[0];
+    const unsigned int half = mesh->mNumFaces / 2;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            EXPECT_EQ(i < half ? 1.0f : 0.0f, mesh->mVertices[mesh->mFaces[i].mIndices[c]].z);
+        }
+    }
+    EXPECT_EQ(trianglesBefore, GetTriangles(mesh));
+}
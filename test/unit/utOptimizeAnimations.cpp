@@ -0,0 +1,193 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2021, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/OptimizeAnimationsProcess.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+using namespace Assimp;
+
+class utOptimizeAnimations : public ::testing::Test {
+public:
+    utOptimizeAnimations() :
+            Test(), mProcess(nullptr), mChannel(nullptr) {
+        // empty
+    }
+
+protected:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    OptimizeAnimationsProcess *mProcess;
+    aiNodeAnim *mChannel;
+};
+
+// ------------------------------------------------------------------------------------------------
+void utOptimizeAnimations::SetUp() {
+    mProcess = new OptimizeAnimationsProcess();
+
+    // a key per frame: linear motion, constant scaling and a rotation about one axis
+    // which changes its direction halfway
+    const unsigned int numKeys = 21;
+    mChannel = new aiNodeAnim();
+    mChannel->mNumPositionKeys = numKeys;
+    mChannel->mPositionKeys = new aiVectorKey[numKeys];
+    mChannel->mNumRotationKeys = numKeys;
+    mChannel->mRotationKeys = new aiQuatKey[numKeys];
+    mChannel->mNumScalingKeys = numKeys;
+    mChannel->mScalingKeys = new aiVectorKey[numKeys];
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        const double time = i;
+        const ai_real angle = ai_real(0.05) * (i <= 10 ? i : 20 - i);
+        mChannel->mPositionKeys[i] = aiVectorKey(time, aiVector3D(ai_real(i), ai_real(2 * i), 0));
+        mChannel->mRotationKeys[i] = aiQuatKey(time, aiQuaternion(aiVector3D(0, 1, 0), angle));
+        mChannel->mScalingKeys[i] = aiVectorKey(time, aiVector3D(2, 2, 2));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void utOptimizeAnimations::TearDown() {
+    delete mChannel;
+    delete mProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, removesRedundantKeys) {
+    mProcess->ProcessChannel(mChannel);
+
+    ASSERT_EQ(2u, mChannel->mNumPositionKeys);
+    EXPECT_EQ(0.0, mChannel->mPositionKeys[0].mTime);
+    EXPECT_EQ(20.0, mChannel->mPositionKeys[1].mTime);
+
+    ASSERT_EQ(3u, mChannel->mNumRotationKeys);
+    EXPECT_EQ(10.0, mChannel->mRotationKeys[1].mTime);
+
+    ASSERT_EQ(1u, mChannel->mNumScalingKeys);
+    EXPECT_EQ(aiVector3D(2, 2, 2), mChannel->mScalingKeys[0].mValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, keepsKeysOutsideOfTolerance) {
+    mChannel->mPositionKeys[5].mValue.z = ai_real(0.01);
+    mProcess->ProcessChannel(mChannel);
+
+    // the keys next to the displaced one can't be interpolated across it either
+    ASSERT_EQ(5u, mChannel->mNumPositionKeys);
+    EXPECT_EQ(4.0, mChannel->mPositionKeys[1].mTime);
+    EXPECT_EQ(5.0, mChannel->mPositionKeys[2].mTime);
+    EXPECT_EQ(6.0, mChannel->mPositionKeys[3].mTime);
+
+    mProcess->mPositionTolerance = ai_real(0.1);
+    mProcess->ProcessChannel(mChannel);
+    EXPECT_EQ(2u, mChannel->mNumPositionKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, limitsInterpolatedRange) {
+    const unsigned int numKeys = 200;
+    delete[] mChannel->mPositionKeys;
+    mChannel->mNumPositionKeys = numKeys;
+    mChannel->mPositionKeys = new aiVectorKey[numKeys];
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        mChannel->mPositionKeys[i] = aiVectorKey(i, aiVector3D(ai_real(i), 0, 0));
+    }
+    mProcess->ProcessChannel(mChannel);
+
+    // a key is kept at least every 64 keys, even on a straight line
+    ASSERT_EQ(5u, mChannel->mNumPositionKeys);
+    EXPECT_EQ(64.0, mChannel->mPositionKeys[1].mTime);
+    EXPECT_EQ(128.0, mChannel->mPositionKeys[2].mTime);
+    EXPECT_EQ(192.0, mChannel->mPositionKeys[3].mTime);
+    EXPECT_EQ(199.0, mChannel->mPositionKeys[4].mTime);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, reportsCompressionRatio) {
+    aiScene scene;
+    scene.mNumAnimations = 1;
+    scene.mAnimations = new aiAnimation *[1];
+    scene.mAnimations[0] = new aiAnimation();
+    scene.mAnimations[0]->mNumChannels = 1;
+    scene.mAnimations[0]->mChannels = new aiNodeAnim *[1];
+    scene.mAnimations[0]->mChannels[0] = mChannel;
+
+    mProcess->Execute(&scene);
+    EXPECT_FLOAT_EQ(63.0f / 6.0f, mProcess->GetCompressionRatio());
+
+    // owned by the scene now
+    mChannel = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, isEnabledByProperty) {
+    Importer importer;
+    EXPECT_FALSE(mProcess->IsRequested(&importer));
+    importer.SetPropertyBool(AI_CONFIG_PP_OA_ENABLE, true);
+    EXPECT_TRUE(mProcess->IsRequested(&importer));
+    EXPECT_FALSE(mProcess->IsActive(~0u));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeAnimations, runsWithoutFlags) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BVH/01_01.bvh", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_LT(0u, scene->mNumAnimations);
+    size_t numKeys = 0;
+    for (unsigned int i = 0; i < scene->mAnimations[0]->mNumChannels; ++i) {
+        numKeys += scene->mAnimations[0]->mChannels[i]->mNumRotationKeys;
+    }
+
+    Importer optimizer;
+    optimizer.SetPropertyBool(AI_CONFIG_PP_OA_ENABLE, true);
+    scene = optimizer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BVH/01_01.bvh", 0);
+    ASSERT_NE(nullptr, scene);
+    size_t numOptimizedKeys = 0;
+    for (unsigned int i = 0; i < scene->mAnimations[0]->mNumChannels; ++i) {
+        numOptimizedKeys += scene->mAnimations[0]->mChannels[i]->mNumRotationKeys;
+    }
+    EXPECT_LT(numOptimizedKeys, numKeys);
+}
@@ -115,6 +115,34 @@ TEST_F(utPLYImportExport, importPLYwithUV) {
     EXPECT_EQ(true, scene->mMeshes[0]->HasTextureCoords(0));
 }
 
+TEST_F(utPLYImportExport, contiguousIndicesTest) {
+    for (const char *file : { ASSIMP_TEST_MODELS_DIR "/PLY/cube_uv.ply", ASSIMP_TEST_MODELS_DIR "/PLY/cube_binary.ply" }) {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene);
+
+        Assimp::Importer contiguousImporter;
+        contiguousImporter.SetPropertyBool(AI_CONFIG_IMPORT_CONTIGUOUS_INDICES, true);
+        const aiScene *contiguousScene = contiguousImporter.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, contiguousScene);
+
+        const aiMesh *mesh = scene->mMeshes[0];
+        const aiMesh *contiguousMesh = contiguousScene->mMeshes[0];
+        EXPECT_FALSE(mesh->HasIndexBuffer());
+        ASSERT_TRUE(contiguousMesh->HasIndexBuffer());
+        ASSERT_EQ(mesh->mNumFaces, contiguousMesh->mNumFaces);
+        const unsigned int *next = contiguousMesh->mIndices;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            const aiFace &face = contiguousMesh->mFaces[i];
+            ASSERT_EQ(mesh->mFaces[i].mNumIndices, face.mNumIndices);
+            EXPECT_EQ(next, face.mIndices);
+            EXPECT_EQ(0, memcmp(mesh->mFaces[i].mIndices, face.mIndices, face.mNumIndices * sizeof(unsigned int)));
+            next += face.mNumIndices;
+        }
+        EXPECT_EQ(contiguousMesh->mIndices + contiguousMesh->mNumIndices, next);
+    }
+}
+
 TEST_F(utPLYImportExport, importBinaryPLY) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/cube_binary.ply", aiProcess_ValidateDataStructure);
@@ -180,3 +208,124 @@ TEST_F(utPLYImportExport, parseErrorTest) {
     const aiScene *scene = importer.ReadFileFromMemory(test_file, strlen(test_file), 0);
     EXPECT_NE(nullptr, scene);
 }
+
+TEST_F(utPLYImportExport, asciiVertexAttributesTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(test_file, strlen(test_file), 0);
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(4u, mesh->mNumVertices);
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasVertexColors(0));
+
+    EXPECT_EQ(aiVector3D(0.0f, 1.0f, 1.0f), mesh->mVertices[3]);
+    EXPECT_EQ(aiVector3D(1.0f, 0.0f, 0.0f), mesh->mNormals[2]);
+    EXPECT_FLOAT_EQ(0.0f, mesh->mColors[0][1].g);
+    EXPECT_FLOAT_EQ(1.0f, mesh->mColors[0][1].b);
+    EXPECT_FLOAT_EQ(1.0f, mesh->mColors[0][1].a);
+}
+
+namespace {
+
+template <typename T>
+void AppendBinary(std::string &out, T value, bool bigEndian) {
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    if (bigEndian) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    out.append(bytes, sizeof(T));
+}
+
+// A triangle fan over numVertices vertices, host byte order is assumed little endian
+std::string MakeBinaryMesh(unsigned int numVertices, bool bigEndian) {
+    std::string data = "ply\n";
+    data += bigEndian ? "format binary_big_endian 1.0\n" : "format binary_little_endian 1.0\n";
+    data += "element vertex " + std::to_string(numVertices) + "\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "property float nx\n"
+            "property float ny\n"
+            "property float nz\n"
+            "property uchar red\n"
+            "property uchar green\n"
+            "property uchar blue\n"
+            "property float s\n"
+            "property float t\n"
+            "element face 1\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n";
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        AppendBinary<float>(data, static_cast<float>(i), bigEndian);
+        AppendBinary<float>(data, static_cast<float>(i) * 2.0f, bigEndian);
+        AppendBinary<float>(data, -1.0f, bigEndian);
+        AppendBinary<float>(data, 0.0f, bigEndian);
+        AppendBinary<float>(data, 0.0f, bigEndian);
+        AppendBinary<float>(data, 1.0f, bigEndian);
+        AppendBinary<uint8_t>(data, 255, bigEndian);
+        AppendBinary<uint8_t>(data, 0, bigEndian);
+        AppendBinary<uint8_t>(data, static_cast<uint8_t>(i * 51), bigEndian);
+        AppendBinary<float>(data, 0.5f * (i % 4), bigEndian);
+        AppendBinary<float>(data, 0.25f, bigEndian);
+    }
+    AppendBinary<uint8_t>(data, 3, bigEndian);
+    AppendBinary<int32_t>(data, 0, bigEndian);
+    AppendBinary<int32_t>(data, 1, bigEndian);
+    AppendBinary<int32_t>(data, 2, bigEndian);
+
+    return data;
+}
+
+void CheckBinaryMesh(const aiScene *scene, unsigned int numVertices) {
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(numVertices, mesh->mNumVertices);
+    ASSERT_EQ(1u, mesh->mNumFaces);
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasVertexColors(0));
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        EXPECT_EQ(aiVector3D(static_cast<ai_real>(i), i * 2.0f, -1.0f), mesh->mVertices[i]);
+        EXPECT_EQ(aiVector3D(0.0f, 0.0f, 1.0f), mesh->mNormals[i]);
+        EXPECT_FLOAT_EQ(1.0f, mesh->mColors[0][i].r);
+        EXPECT_FLOAT_EQ(0.0f, mesh->mColors[0][i].g);
+        EXPECT_FLOAT_EQ(static_cast<uint8_t>(i * 51) / 255.0f, mesh->mColors[0][i].b);
+        EXPECT_FLOAT_EQ(1.0f, mesh->mColors[0][i].a);
+        EXPECT_FLOAT_EQ(0.5f * (i % 4), mesh->mTextureCoords[0][i].x);
+        EXPECT_FLOAT_EQ(0.25f, mesh->mTextureCoords[0][i].y);
+    }
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, mesh->mFaces[0].mIndices[i]);
+    }
+}
+
+} // namespace
+
+TEST_F(utPLYImportExport, binaryVertexAttributesTest) {
+    const std::string data = MakeBinaryMesh(3, false);
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "ply");
+    CheckBinaryMesh(scene, 3);
+}
+
+TEST_F(utPLYImportExport, binaryBigEndianVertexAttributesTest) {
+    const std::string data = MakeBinaryMesh(3, true);
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "ply");
+    CheckBinaryMesh(scene, 3);
+}
+
+TEST_F(utPLYImportExport, binaryVerticesAcrossReadBlocksTest) {
+    // 42 bytes per vertex, spans several blocks of the 1MB read buffer
+    const unsigned int numVertices = 60000;
+    const std::string data = MakeBinaryMesh(numVertices, false);
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "ply");
+    CheckBinaryMesh(scene, numVertices);
+}
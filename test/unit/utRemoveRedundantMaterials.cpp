@@ -175,3 +175,53 @@ TEST_F(RemoveRedundantMatsTest, testRedundantMaterialsWithExcludeList) {
     EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[3], AI_MATKEY_NAME, &sName));
     EXPECT_STREQ("Complex material name", sName.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+aiTexture *getCompressedTexture(const char *data, const char *filename) {
+    aiTexture *pcTex = new aiTexture();
+    pcTex->mWidth = 4;
+    pcTex->pcData = new aiTexel[1];
+    ::memcpy(pcTex->pcData, data, 4);
+    ::memcpy(pcTex->achFormatHint, "png", 3);
+    pcTex->mFilename.Set(filename);
+    return pcTex;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testRedundantTextures) {
+    // texture 2 is a duplicate of texture 0
+    pcScene1->mNumTextures = 3;
+    pcScene1->mTextures = new aiTexture *[3];
+    pcScene1->mTextures[0] = getCompressedTexture("abcd", "first.png");
+    pcScene1->mTextures[1] = getCompressedTexture("efgh", "other.png");
+    pcScene1->mTextures[2] = getCompressedTexture("abcd", "dir/dup.png");
+
+    // materials 0 and 2 as well as 1 and 3 only differ in the way they refer to their texture
+    aiString sPath;
+    sPath.Set("*0");
+    pcScene1->mMaterials[0]->AddProperty(&sPath, AI_MATKEY_TEXTURE_DIFFUSE(0));
+    sPath.Set("*2");
+    pcScene1->mMaterials[2]->AddProperty(&sPath, AI_MATKEY_TEXTURE_DIFFUSE(0));
+    sPath.Set("textures\\wood.png");
+    pcScene1->mMaterials[1]->AddProperty(&sPath, AI_MATKEY_TEXTURE_SPECULAR(0));
+    sPath.Set("./textures//sub/../wood.png");
+    pcScene1->mMaterials[3]->AddProperty(&sPath, AI_MATKEY_TEXTURE_SPECULAR(0));
+    sPath.Set("dup.png");
+    pcScene1->mMaterials[4]->AddProperty(&sPath, AI_MATKEY_TEXTURE_DIFFUSE(0));
+
+    piProcess->SetFixedMaterialsString();
+    piProcess->SetRemoveRedundantTextures(true);
+    piProcess->Execute(pcScene1);
+
+    ASSERT_EQ(2U, pcScene1->mNumTextures);
+    EXPECT_STREQ("first.png", pcScene1->mTextures[0]->mFilename.C_Str());
+    EXPECT_STREQ("other.png", pcScene1->mTextures[1]->mFilename.C_Str());
+
+    ASSERT_EQ(3U, pcScene1->mNumMaterials);
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[0], AI_MATKEY_TEXTURE_DIFFUSE(0), &sPath));
+    EXPECT_STREQ("*0", sPath.data);
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[1], AI_MATKEY_TEXTURE_SPECULAR(0), &sPath));
+    EXPECT_STREQ("textures\\wood.png", sPath.data);
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[2], AI_MATKEY_TEXTURE_DIFFUSE(0), &sPath));
+    EXPECT_STREQ("*0", sPath.data);
+}
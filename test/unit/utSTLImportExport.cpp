@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
 
+#include <fstream>
+#include <iterator>
 #include <vector>
 
 using namespace Assimp;
@@ -99,6 +101,114 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+TEST_F(utSTLImporterExporter, binaryFromFileMatchesMemory) {
+    // files are decoded from a mapping, memory buffers from a copy
+    Assimp::Importer fileImporter;
+    const aiScene *fileScene = fileImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, fileScene);
+
+    std::ifstream stream(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    Assimp::Importer memoryImporter;
+    const aiScene *memoryScene = memoryImporter.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, memoryScene);
+
+    const aiMesh *a = fileScene->mMeshes[0];
+    const aiMesh *b = memoryScene->mMeshes[0];
+    ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+    ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+    for (unsigned int i = 0; i < a->mNumVertices; ++i) {
+        EXPECT_EQ(a->mVertices[i], b->mVertices[i]);
+        EXPECT_EQ(a->mNormals[i], b->mNormals[i]);
+    }
+}
+
+namespace {
+
+// Two triangles of a unit quad sharing the diagonal
+std::string MakeBinaryQuad() {
+    std::string data(80, ' ');
+    const uint32_t numFaces = 2;
+    data.append(reinterpret_cast<const char *>(&numFaces), sizeof(numFaces));
+
+    const float facets[2][12] = {
+        { 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0 },
+        { 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0 }
+    };
+    for (unsigned int i = 0; i < 2; ++i) {
+        data.append(reinterpret_cast<const char *>(facets[i]), sizeof(facets[i]));
+        data.append(2, '\0');
+    }
+    return data;
+}
+
+} // namespace
+
+TEST_F(utSTLImporterExporter, weldBinaryVertices) {
+    const std::string data = MakeBinaryQuad();
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(6u, scene->mMeshes[0]->mNumVertices);
+
+    Assimp::Importer welder;
+    welder.SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, true);
+    const aiScene *welded = welder.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, welded);
+
+    const aiMesh *mesh = welded->mMeshes[0];
+    ASSERT_EQ(4u, mesh->mNumVertices);
+    ASSERT_EQ(2u, mesh->mNumFaces);
+    ASSERT_NE(nullptr, mesh->mNormals);
+
+    // faces still reference the original positions
+    const aiMesh *source = scene->mMeshes[0];
+    for (unsigned int f = 0; f < 2; ++f) {
+        for (unsigned int v = 0; v < 3; ++v) {
+            EXPECT_EQ(source->mVertices[f * 3 + v], mesh->mVertices[mesh->mFaces[f].mIndices[v]]);
+            EXPECT_EQ(aiVector3D(0, 0, 1), mesh->mNormals[mesh->mFaces[f].mIndices[v]]);
+        }
+    }
+}
+
+TEST_F(utSTLImporterExporter, largeAsciiSolidsKeepFileOrder) {
+    // large enough to be split into several chunks which are parsed in parallel
+    const unsigned int numFacets[2] = { 15000, 7000 };
+    std::string data;
+    for (unsigned int s = 0; s < 2; ++s) {
+        const std::string name = "part" + std::to_string(s);
+        data += "solid " + name + "\n";
+        for (unsigned int i = 0; i < numFacets[s]; ++i) {
+            const std::string x = std::to_string(i);
+            data += "  facet normal 0 0 " + std::to_string(s + 1) + "\n"
+                    "    outer loop\n"
+                    "      vertex " + x + " 0 0\n"
+                    "      vertex " + x + " 1 0\n"
+                    "      vertex " + x + " 0 1\n"
+                    "    endloop\n"
+                    "  endfacet\n";
+        }
+        data += "endsolid " + name + "\n";
+    }
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.c_str(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    for (unsigned int s = 0; s < 2; ++s) {
+        const aiMesh *mesh = scene->mMeshes[s];
+        EXPECT_EQ("part" + std::to_string(s), std::string(mesh->mName.C_Str()));
+        ASSERT_EQ(numFacets[s], mesh->mNumFaces);
+        ASSERT_EQ(numFacets[s] * 3, mesh->mNumVertices);
+        for (unsigned int i = 0; i < numFacets[s]; ++i) {
+            EXPECT_EQ(aiVector3D(static_cast<ai_real>(i), 0, 0), mesh->mVertices[i * 3]);
+            EXPECT_EQ(aiVector3D(static_cast<ai_real>(i), 0, 1), mesh->mVertices[i * 3 + 2]);
+            EXPECT_EQ(aiVector3D(0, 0, static_cast<ai_real>(s + 1)), mesh->mNormals[i * 3 + 1]);
+        }
+    }
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utSTLImporterExporter, exporterTest) {
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/mesh.h>
+#include <assimp/scene.h>
 #include <memory>
 
 using namespace ::Assimp;
@@ -75,3 +76,41 @@ TEST_F(utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion) {
     EXPECT_NO_THROW(SceneCombiner::CopyScene(nullptr, nullptr));
     EXPECT_NO_THROW(SceneCombiner::CopySceneFlat(nullptr, nullptr));
 }
+
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+TEST_F(utSceneCombiner, CopySceneRemapsBoneNodes) {
+    aiScene src;
+    src.mRootNode = new aiNode("armature");
+    aiNode *boneNode = new aiNode("bone");
+    aiNode *children[] = { boneNode };
+    src.mRootNode->addChildren(1, children);
+
+    aiBone *bone = new aiBone();
+    bone->mName.Set("bone");
+    bone->mArmature = src.mRootNode;
+    bone->mNode = boneNode;
+
+    aiMesh *mesh = new aiMesh();
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone *[1];
+    mesh->mBones[0] = bone;
+    src.mNumMeshes = 1;
+    src.mMeshes = new aiMesh *[1];
+    src.mMeshes[0] = mesh;
+
+    aiScene *dest = nullptr;
+    SceneCombiner::CopyScene(&dest, &src);
+    ASSERT_NE(nullptr, dest);
+    std::unique_ptr<aiScene> owner(dest);
+
+    const aiBone *copy = dest->mMeshes[0]->mBones[0];
+    EXPECT_EQ(dest->mRootNode, copy->mArmature);
+    EXPECT_EQ(dest->mRootNode->mChildren[0], copy->mNode);
+
+    // a bone without armature keeps both pointers null
+    aiBone unbound;
+    aiBone unboundCopy(unbound);
+    EXPECT_EQ(nullptr, unboundCopy.mArmature);
+    EXPECT_EQ(nullptr, unboundCopy.mNode);
+}
+#endif
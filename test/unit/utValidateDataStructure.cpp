@@ -42,9 +42,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 
+#include <assimp/Exceptional.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
-#include <ValidateDataStructure.h>
+#include "PostProcessing/ValidateDataStructure.h"
 
 using namespace std;
 using namespace Assimp;
@@ -59,11 +60,36 @@ public:
 
 protected:
 
+    // adds numMeshes triangles to the scene, all referenced by the root node
+    void AddMeshes(unsigned int numMeshes);
 
     ValidateDSProcess* vds;
     aiScene* scene;
 };
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDataStructureTest::AddMeshes(unsigned int numMeshes)
+{
+    scene->mNumMeshes = numMeshes;
+    scene->mMeshes = new aiMesh*[numMeshes];
+    scene->mRootNode->mNumMeshes = numMeshes;
+    scene->mRootNode->mMeshes = new unsigned int[numMeshes];
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        aiMesh* mesh = scene->mMeshes[i] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[3];
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[1];
+        mesh->mFaces[0].mNumIndices = 3;
+        mesh->mFaces[0].mIndices = new unsigned int[3];
+        for (unsigned int a = 0; a < 3; ++a) {
+            mesh->mFaces[0].mIndices[a] = a;
+        }
+        scene->mRootNode->mMeshes[i] = i;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDataStructureTest::SetUp()
 {
@@ -195,5 +221,74 @@ void ValidateDataStructureTest::TearDown()
 //965: ReportError("aiString::length is too large (%i, maximum is %lu)",
 //974: ReportError("aiString::data is invalid: the terminal zero is at a wrong offset");
 //979: ReportError("aiString::data is invalid. There is no terminal character");
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, acceptsValidMeshes)
+{
+    AddMeshes(16);
+    EXPECT_NO_THROW(vds->Execute(scene));
+    vds->SetLightMode(true);
+    EXPECT_NO_THROW(vds->Execute(scene));
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, reportsIndexOutOfRange)
+{
+    AddMeshes(16);
+    scene->mMeshes[11]->mFaces[0].mIndices[2] = 3;
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+    vds->SetLightMode(true);
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    // the same with an index buffer
+    scene->mMeshes[11]->CompactIndices();
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+    scene->mMeshes[11]->mIndices[2] = 2;
+    EXPECT_NO_THROW(vds->Execute(scene));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, reportsFirstInvalidMesh)
+{
+    AddMeshes(16);
+    scene->mMeshes[3]->mPrimitiveTypes = aiPrimitiveType_POINT;
+    scene->mMeshes[12]->mFaces[0].mIndices[2] = 3;
+
+    // the meshes are validated in parallel, the error of the first one wins nonetheless
+    for (unsigned int i = 0; i < 8; ++i) {
+        try {
+            vds->Execute(scene);
+            FAIL() << "the scene is invalid";
+        } catch (const DeadlyImportError &error) {
+            EXPECT_NE(std::string::npos, std::string(error.what()).find("is a TRIANGLE"));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, lightModeSkipsSemanticChecks)
+{
+    AddMeshes(2);
+    scene->mMeshes[1]->mPrimitiveTypes = aiPrimitiveType_POINT;
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+    vds->SetLightMode(true);
+    EXPECT_NO_THROW(vds->Execute(scene));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, reportsMeshReferencedTwiceByANode)
+{
+    AddMeshes(2);
+    scene->mRootNode->mMeshes[1] = 0;
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    // other nodes may reference the same meshes again
+    scene->mRootNode->mMeshes[1] = 1;
+    aiNode* child = new aiNode("child");
+    child->mNumMeshes = 2;
+    child->mMeshes = new unsigned int[2];
+    child->mMeshes[0] = 1;
+    child->mMeshes[1] = 0;
+    scene->mRootNode->addChildren(1, &child);
+    EXPECT_NO_THROW(vds->Execute(scene));
+}